@@ -368,6 +368,20 @@ namespace LLC
 	}
 
 
+	/** SK512
+     *
+     *  512-bit hashing of a batch of equal length messages, such as the leaf pairs of a merkle tree level.
+     *  The Keccak stage hashes four messages at a time.
+     *
+     *  @param[in] vData The messages stored back to back.
+     *  @param[in] nSize The size of each message in bytes.
+     *
+     *  @return The hash of each message in order.
+     *
+     **/
+	std::vector<uint512_t> SK512(const std::vector<uint8_t>& vData, const uint64_t nSize);
+
+
 	/** SK576
      *
      * 576-bit hashing template used for Private Keys.
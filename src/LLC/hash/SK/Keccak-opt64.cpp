@@ -17,12 +17,11 @@ http://creativecommons.org/publicdomain/zero/1.0/
 
 #include <LLC/hash/SK/brg_endian.h>
 #include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/hash/SK/KeccakF-1600-unrolling.h>
 
 #include <algorithm>
 
 #define USE_MEMSET
-//#define DIVISION_INSTRUCTION    //comment if no division instruction or more compact when not using division
-#define UNROLL_CHILOOP        //comment more compact using for loop
 
 
 typedef uint8_t UINT8;
@@ -51,56 +50,10 @@ typedef uint64_t tKeccakLane;
 #define ROL64(a, offset) ((((uint64_t)a) << offset) ^ (((uint64_t)a) >> (64-offset)))
 #endif
 
-#define    cKeccakNumberOfRounds    24
-
-const UINT8 KeccakF_RotationConstants[25] =
-{
-     1,  3,  6, 10, 15, 21, 28, 36, 45, 55,  2, 14, 27, 41, 56,  8, 25, 43, 62, 18, 39, 61, 20, 44
-};
-
-const UINT8 KeccakF_PiLane[25] =
-{
-    10,  7, 11, 17, 18,  3,  5, 16,  8, 21, 24,  4, 15, 23, 19, 13, 12,  2, 20, 14, 22,  9,  6,  1
-};
-
-#if    defined(DIVISION_INSTRUCTION)
-#define    MOD5(argValue)    ((argValue) % 5)
-#else
-const UINT8 KeccakF_Mod5[10] =
-{
-    0, 1, 2, 3, 4, 0, 1, 2, 3, 4
-};
-#define    MOD5(argValue)    KeccakF_Mod5[argValue]
-#endif
-
-/* ---------------------------------------------------------------- */
-
-static tKeccakLane KeccakF1600_GetNextRoundConstant(UINT8 *LFSR);
-static tKeccakLane KeccakF1600_GetNextRoundConstant(UINT8 *LFSR)
-{
-    tSmaUtilInt i;
-    tKeccakLane    roundConstant;
-    tSmaUtilInt doXOR;
-    tSmaUtilInt tempLSFR;
-
-    roundConstant = 0;
-    tempLSFR = *LFSR;
-    for(i=1; i<128; i <<= 1)
-    {
-        doXOR = tempLSFR & 1;
-        if((tempLSFR & 0x80) != 0)
-            // Primitive polynomial over GF(2): x^8+x^6+x^5+x^4+1
-            tempLSFR = (tempLSFR << 1) ^ 0x71;
-        else
-            tempLSFR <<= 1;
-
-        if(doXOR != 0)
-            roundConstant ^= (tKeccakLane)1ULL << (i - 1);
-    }
-    *LFSR = (UINT8)tempLSFR;
-    return (roundConstant);
-}
-
+#define KECCAK_XOR(a, b)    ((a) ^ (b))
+#define KECCAK_ANDN(a, b)   ((~(a)) & (b))
+#define KECCAK_ROL(a, n)    ROL64(a, n)
+#define KECCAK_CONST(c)     (c)
 
 /* ---------------------------------------------------------------- */
 
@@ -186,65 +139,27 @@ void KeccakF1600_StateComplementBit(void *state, uint32_t position)
 
 void KeccakF1600_StatePermute(void *argState)
 {
-    tSmaUtilInt x, y, round;
-    tKeccakLane        temp;
-    tKeccakLane        BC[5];
-    tKeccakLane     *state;
-    UINT8             LFSRstate;
-
-    state = reinterpret_cast<tKeccakLane *>(argState);
-    LFSRstate = 0x01;
-    round = cKeccakNumberOfRounds;
-    do
-    {
-        // Theta
-        for(x = 0; x < 5; ++x)
-        {
-            BC[x] = state[x] ^ state[5 + x] ^ state[10 + x] ^ state[15 + x] ^ state[20 + x];
-        }
-        for(x = 0; x < 5; ++x)
-        {
-            temp = BC[MOD5(x+4)] ^ ROL64(BC[MOD5(x+1)], 1);
-            for(y = 0; y < 25; y += 5)
-            {
-                state[y + x] ^= temp;
-            }
-        }
-
-        // Rho Pi
-        temp = state[1];
-        for(x = 0; x < 24; ++x)
-        {
-            BC[0] = state[KeccakF_PiLane[x]];
-            state[KeccakF_PiLane[x]] = ROL64(temp, KeccakF_RotationConstants[x]);
-            temp = BC[0];
-        }
-
-        //    Chi
-        for(y = 0; y < 25; y += 5)
-        {
-#if defined(UNROLL_CHILOOP)
-            BC[0] = state[y + 0];
-            BC[1] = state[y + 1];
-            BC[2] = state[y + 2];
-            BC[3] = state[y + 3];
-            BC[4] = state[y + 4];
-#else
-            for(x = 0; x < 5; ++x)
-            {
-                BC[x] = state[y + x];
-            }
-#endif
-            for(x = 0; x < 5; ++x)
-            {
-                state[y + x] = BC[x] ^((~BC[MOD5(x+1)]) & BC[MOD5(x+2)]);
-            }
-        }
-
-        //    Iota
-        state[0] ^= KeccakF1600_GetNextRoundConstant(&LFSRstate);
-    }
-    while(--round != 0);
+    KECCAK_DECLARE(tKeccakLane, A)
+    KECCAK_DECLARE(tKeccakLane, E)
+    tKeccakLane Ca, Ce, Ci, Co, Cu;
+    tKeccakLane Da, De, Di, Do, Du;
+    tKeccakLane BCa, BCe, BCi, BCo, BCu;
+
+    /* Keep the whole state in registers for all 24 rounds. */
+    tKeccakLane *state = reinterpret_cast<tKeccakLane *>(argState);
+    Aba = state[ 0]; Abe = state[ 1]; Abi = state[ 2]; Abo = state[ 3]; Abu = state[ 4];
+    Aga = state[ 5]; Age = state[ 6]; Agi = state[ 7]; Ago = state[ 8]; Agu = state[ 9];
+    Aka = state[10]; Ake = state[11]; Aki = state[12]; Ako = state[13]; Aku = state[14];
+    Ama = state[15]; Ame = state[16]; Ami = state[17]; Amo = state[18]; Amu = state[19];
+    Asa = state[20]; Ase = state[21]; Asi = state[22]; Aso = state[23]; Asu = state[24];
+
+    KECCAK_PERMUTE()
+
+    state[ 0] = Aba; state[ 1] = Abe; state[ 2] = Abi; state[ 3] = Abo; state[ 4] = Abu;
+    state[ 5] = Aga; state[ 6] = Age; state[ 7] = Agi; state[ 8] = Ago; state[ 9] = Agu;
+    state[10] = Aka; state[11] = Ake; state[12] = Aki; state[13] = Ako; state[14] = Aku;
+    state[15] = Ama; state[16] = Ame; state[17] = Ami; state[18] = Amo; state[19] = Amu;
+    state[20] = Asa; state[21] = Ase; state[22] = Asi; state[23] = Aso; state[24] = Asu;
 }
 
 /* ---------------------------------------------------------------- */
@@ -72,6 +72,22 @@ void KeccakF1600_StateComplementBit(void *state, uint32_t position);
   */
 void KeccakF1600_StatePermute(void *state);
 
+/** Function to apply Keccak-f[1600] on four states at once.
+  * The states are interleaved by lane, lane @a i of state @a k being stored at
+  * @a states[4*i + k]. AVX2 is used when the processor supports it at runtime,
+  * otherwise each state is permuted in turn with KeccakF1600_StatePermute().
+  * @param  states  Pointer to the four interleaved states.
+  */
+void KeccakF1600_StatePermute4(uint64_t *states);
+
+/** Function to choose whether KeccakF1600_StatePermute4() uses AVX2.
+  * AVX2 is only enabled if the processor supports it, so that both paths
+  * can be checked against each other on any processor that has it.
+  * @param  fEnable True to use AVX2 when supported, false to use the generic permutation.
+  * @return True if AVX2 is now in use.
+  */
+bool KeccakF1600_StatePermute4_SetAVX2(bool fEnable);
+
 /** Function to retrieve data from the state into bytes.
   * The bits to output are restricted to be consecutive and to be in the same lane.
   * The bit positions that are retrieved by this function are
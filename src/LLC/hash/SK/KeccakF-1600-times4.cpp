@@ -0,0 +1,156 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers and Ronny Van Keer,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include <atomic>
+#include <inttypes.h>
+
+#include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/hash/SK/KeccakF-1600-unrolling.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define KECCAK_TIMES4_AVX2
+#include <immintrin.h>
+#endif
+
+/* ---------------------------------------------------------------- */
+
+static void KeccakF1600_StatePermute4_Generic(uint64_t *states)
+{
+    uint64_t state[25];
+    for(uint32_t k = 0; k < 4; ++k)
+    {
+        for(uint32_t i = 0; i < 25; ++i)
+            state[i] = states[4 * i + k];
+
+        KeccakF1600_StatePermute(state);
+
+        for(uint32_t i = 0; i < 25; ++i)
+            states[4 * i + k] = state[i];
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+#if defined(KECCAK_TIMES4_AVX2)
+
+#define KECCAK_XOR(a, b)    _mm256_xor_si256(a, b)
+#define KECCAK_ANDN(a, b)   _mm256_andnot_si256(a, b)
+#define KECCAK_ROL(a, n)    _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define KECCAK_CONST(c)     _mm256_set1_epi64x(static_cast<long long>(c))
+
+__attribute__((target("avx2")))
+static void KeccakF1600_StatePermute4_AVX2(uint64_t *states)
+{
+    KECCAK_DECLARE(__m256i, A)
+    KECCAK_DECLARE(__m256i, E)
+    __m256i Ca, Ce, Ci, Co, Cu;
+    __m256i Da, De, Di, Do, Du;
+    __m256i BCa, BCe, BCi, BCo, BCu;
+
+    /* Each vector holds the same lane of all four states. */
+    Aba = _mm256_loadu_si256((const __m256i *)&states[ 0]);
+    Abe = _mm256_loadu_si256((const __m256i *)&states[ 4]);
+    Abi = _mm256_loadu_si256((const __m256i *)&states[ 8]);
+    Abo = _mm256_loadu_si256((const __m256i *)&states[12]);
+    Abu = _mm256_loadu_si256((const __m256i *)&states[16]);
+    Aga = _mm256_loadu_si256((const __m256i *)&states[20]);
+    Age = _mm256_loadu_si256((const __m256i *)&states[24]);
+    Agi = _mm256_loadu_si256((const __m256i *)&states[28]);
+    Ago = _mm256_loadu_si256((const __m256i *)&states[32]);
+    Agu = _mm256_loadu_si256((const __m256i *)&states[36]);
+    Aka = _mm256_loadu_si256((const __m256i *)&states[40]);
+    Ake = _mm256_loadu_si256((const __m256i *)&states[44]);
+    Aki = _mm256_loadu_si256((const __m256i *)&states[48]);
+    Ako = _mm256_loadu_si256((const __m256i *)&states[52]);
+    Aku = _mm256_loadu_si256((const __m256i *)&states[56]);
+    Ama = _mm256_loadu_si256((const __m256i *)&states[60]);
+    Ame = _mm256_loadu_si256((const __m256i *)&states[64]);
+    Ami = _mm256_loadu_si256((const __m256i *)&states[68]);
+    Amo = _mm256_loadu_si256((const __m256i *)&states[72]);
+    Amu = _mm256_loadu_si256((const __m256i *)&states[76]);
+    Asa = _mm256_loadu_si256((const __m256i *)&states[80]);
+    Ase = _mm256_loadu_si256((const __m256i *)&states[84]);
+    Asi = _mm256_loadu_si256((const __m256i *)&states[88]);
+    Aso = _mm256_loadu_si256((const __m256i *)&states[92]);
+    Asu = _mm256_loadu_si256((const __m256i *)&states[96]);
+
+    KECCAK_PERMUTE()
+
+    _mm256_storeu_si256((__m256i *)&states[ 0], Aba);
+    _mm256_storeu_si256((__m256i *)&states[ 4], Abe);
+    _mm256_storeu_si256((__m256i *)&states[ 8], Abi);
+    _mm256_storeu_si256((__m256i *)&states[12], Abo);
+    _mm256_storeu_si256((__m256i *)&states[16], Abu);
+    _mm256_storeu_si256((__m256i *)&states[20], Aga);
+    _mm256_storeu_si256((__m256i *)&states[24], Age);
+    _mm256_storeu_si256((__m256i *)&states[28], Agi);
+    _mm256_storeu_si256((__m256i *)&states[32], Ago);
+    _mm256_storeu_si256((__m256i *)&states[36], Agu);
+    _mm256_storeu_si256((__m256i *)&states[40], Aka);
+    _mm256_storeu_si256((__m256i *)&states[44], Ake);
+    _mm256_storeu_si256((__m256i *)&states[48], Aki);
+    _mm256_storeu_si256((__m256i *)&states[52], Ako);
+    _mm256_storeu_si256((__m256i *)&states[56], Aku);
+    _mm256_storeu_si256((__m256i *)&states[60], Ama);
+    _mm256_storeu_si256((__m256i *)&states[64], Ame);
+    _mm256_storeu_si256((__m256i *)&states[68], Ami);
+    _mm256_storeu_si256((__m256i *)&states[72], Amo);
+    _mm256_storeu_si256((__m256i *)&states[76], Amu);
+    _mm256_storeu_si256((__m256i *)&states[80], Asa);
+    _mm256_storeu_si256((__m256i *)&states[84], Ase);
+    _mm256_storeu_si256((__m256i *)&states[88], Asi);
+    _mm256_storeu_si256((__m256i *)&states[92], Aso);
+    _mm256_storeu_si256((__m256i *)&states[96], Asu);
+}
+
+#endif
+
+/* ---------------------------------------------------------------- */
+
+#if defined(KECCAK_TIMES4_AVX2)
+
+/* Whether the AVX2 permutation is in use, set from the processor the first time it is needed. */
+static std::atomic<bool>& KeccakF1600_AVX2()
+{
+    static std::atomic<bool> fAVX2(__builtin_cpu_supports("avx2"));
+    return fAVX2;
+}
+
+#endif
+
+/* ---------------------------------------------------------------- */
+
+bool KeccakF1600_StatePermute4_SetAVX2(bool fEnable)
+{
+#if defined(KECCAK_TIMES4_AVX2)
+    KeccakF1600_AVX2().store(fEnable && __builtin_cpu_supports("avx2"));
+    return KeccakF1600_AVX2().load();
+#else
+    return false;
+#endif
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StatePermute4(uint64_t *states)
+{
+#if defined(KECCAK_TIMES4_AVX2)
+    if(KeccakF1600_AVX2().load(std::memory_order_relaxed))
+    {
+        KeccakF1600_StatePermute4_AVX2(states);
+        return;
+    }
+#endif
+
+    KeccakF1600_StatePermute4_Generic(states);
+}
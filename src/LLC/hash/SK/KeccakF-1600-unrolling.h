@@ -0,0 +1,117 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers and Ronny Van Keer,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakF1600Unrolling_h_
+#define _KeccakF1600Unrolling_h_
+
+#include <inttypes.h>
+
+/** Round constants of Keccak-f[1600], precomputed from the LFSR of the reference implementation.
+  */
+static const uint64_t KeccakF1600_RoundConstants[24] =
+{
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/** Chi step for one plane of five lanes E##x##a to E##x##u, from the rotated lanes BCa to BCu.
+  */
+#define KECCAK_CHI(E, x)                                                       \
+    E##x##a = KECCAK_XOR(BCa, KECCAK_ANDN(BCe, BCi));                          \
+    E##x##e = KECCAK_XOR(BCe, KECCAK_ANDN(BCi, BCo));                          \
+    E##x##i = KECCAK_XOR(BCi, KECCAK_ANDN(BCo, BCu));                          \
+    E##x##o = KECCAK_XOR(BCo, KECCAK_ANDN(BCu, BCa));                          \
+    E##x##u = KECCAK_XOR(BCu, KECCAK_ANDN(BCa, BCe));
+
+/** Fully unrolled Keccak-f[1600] round, reading the lanes A## and writing the lanes E##.
+  * The includer defines the lane type through the following operations:
+  * - KECCAK_XOR(a, b)  a ^ b
+  * - KECCAK_ANDN(a, b) (~a) & b
+  * - KECCAK_ROL(a, n)  rotate a left by n bits, 0 < n < 64
+  * - KECCAK_CONST(c)   a lane holding the constant c
+  * The temporaries Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du, BCa, BCe, BCi, BCo and BCu
+  * must be declared by the includer.
+  */
+#define KECCAK_ROUND(A, E, nRound)                                             \
+    Ca = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(A##ba, A##ga), KECCAK_XOR(A##ka, A##ma)), A##sa); \
+    Ce = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(A##be, A##ge), KECCAK_XOR(A##ke, A##me)), A##se); \
+    Ci = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(A##bi, A##gi), KECCAK_XOR(A##ki, A##mi)), A##si); \
+    Co = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(A##bo, A##go), KECCAK_XOR(A##ko, A##mo)), A##so); \
+    Cu = KECCAK_XOR(KECCAK_XOR(KECCAK_XOR(A##bu, A##gu), KECCAK_XOR(A##ku, A##mu)), A##su); \
+                                                                               \
+    Da = KECCAK_XOR(Cu, KECCAK_ROL(Ce, 1));                                    \
+    De = KECCAK_XOR(Ca, KECCAK_ROL(Ci, 1));                                    \
+    Di = KECCAK_XOR(Ce, KECCAK_ROL(Co, 1));                                    \
+    Do = KECCAK_XOR(Ci, KECCAK_ROL(Cu, 1));                                    \
+    Du = KECCAK_XOR(Co, KECCAK_ROL(Ca, 1));                                    \
+                                                                               \
+    BCa = KECCAK_XOR(A##ba, Da);                                               \
+    BCe = KECCAK_ROL(KECCAK_XOR(A##ge, De), 44);                               \
+    BCi = KECCAK_ROL(KECCAK_XOR(A##ki, Di), 43);                               \
+    BCo = KECCAK_ROL(KECCAK_XOR(A##mo, Do), 21);                               \
+    BCu = KECCAK_ROL(KECCAK_XOR(A##su, Du), 14);                               \
+    KECCAK_CHI(E, b)                                                           \
+    E##ba = KECCAK_XOR(E##ba, KECCAK_CONST(KeccakF1600_RoundConstants[nRound])); \
+                                                                               \
+    BCa = KECCAK_ROL(KECCAK_XOR(A##bo, Do), 28);                               \
+    BCe = KECCAK_ROL(KECCAK_XOR(A##gu, Du), 20);                               \
+    BCi = KECCAK_ROL(KECCAK_XOR(A##ka, Da),  3);                               \
+    BCo = KECCAK_ROL(KECCAK_XOR(A##me, De), 45);                               \
+    BCu = KECCAK_ROL(KECCAK_XOR(A##si, Di), 61);                               \
+    KECCAK_CHI(E, g)                                                           \
+                                                                               \
+    BCa = KECCAK_ROL(KECCAK_XOR(A##be, De),  1);                               \
+    BCe = KECCAK_ROL(KECCAK_XOR(A##gi, Di),  6);                               \
+    BCi = KECCAK_ROL(KECCAK_XOR(A##ko, Do), 25);                               \
+    BCo = KECCAK_ROL(KECCAK_XOR(A##mu, Du),  8);                               \
+    BCu = KECCAK_ROL(KECCAK_XOR(A##sa, Da), 18);                               \
+    KECCAK_CHI(E, k)                                                           \
+                                                                               \
+    BCa = KECCAK_ROL(KECCAK_XOR(A##bu, Du), 27);                               \
+    BCe = KECCAK_ROL(KECCAK_XOR(A##ga, Da), 36);                               \
+    BCi = KECCAK_ROL(KECCAK_XOR(A##ke, De), 10);                               \
+    BCo = KECCAK_ROL(KECCAK_XOR(A##mi, Di), 15);                               \
+    BCu = KECCAK_ROL(KECCAK_XOR(A##so, Do), 56);                               \
+    KECCAK_CHI(E, m)                                                           \
+                                                                               \
+    BCa = KECCAK_ROL(KECCAK_XOR(A##bi, Di), 62);                               \
+    BCe = KECCAK_ROL(KECCAK_XOR(A##go, Do), 55);                               \
+    BCi = KECCAK_ROL(KECCAK_XOR(A##ku, Du), 39);                               \
+    BCo = KECCAK_ROL(KECCAK_XOR(A##ma, Da), 41);                               \
+    BCu = KECCAK_ROL(KECCAK_XOR(A##se, De),  2);                               \
+    KECCAK_CHI(E, s)
+
+/** Declare the 25 lanes of a state with the given prefix.
+  */
+#define KECCAK_DECLARE(type, X)                                                \
+    type X##ba, X##be, X##bi, X##bo, X##bu;                                    \
+    type X##ga, X##ge, X##gi, X##go, X##gu;                                    \
+    type X##ka, X##ke, X##ki, X##ko, X##ku;                                    \
+    type X##ma, X##me, X##mi, X##mo, X##mu;                                    \
+    type X##sa, X##se, X##si, X##so, X##su;
+
+/** Apply the 24 rounds of Keccak-f[1600], two rounds per iteration so that the
+  * lanes ping-pong between the A## and E## sets without copying.
+  */
+#define KECCAK_PERMUTE()                                                       \
+    for(uint32_t nRound = 0; nRound < 24; nRound += 2)                         \
+    {                                                                          \
+        KECCAK_ROUND(A, E, nRound)                                             \
+        KECCAK_ROUND(E, A, nRound + 1)                                         \
+    }
+
+#endif
@@ -13,6 +13,8 @@ http://creativecommons.org/publicdomain/zero/1.0/
 
 #include <string.h>
 
+#include <algorithm>
+
 #include <LLC/hash/SK/KeccakHash.h>
 #include <LLC/hash/SK/KeccakF-1600-interface.h>
 
@@ -81,3 +83,96 @@ HashReturn Keccak_HashSqueeze(Keccak_HashInstance *instance, BitSequence *data,
         return FAIL;
     return static_cast<HashReturn>(Keccak_SpongeSqueeze(&instance->sponge, data, databitlen/8));
 }
+
+/* ---------------------------------------------------------------- */
+
+static uint64_t Keccak_LoadLane(const uint8_t *data)
+{
+    uint64_t lane = 0;
+    for(uint32_t i = 0; i < 8; ++i)
+        lane |= static_cast<uint64_t>(data[i]) << (8 * i);
+
+    return lane;
+}
+
+/* ---------------------------------------------------------------- */
+
+static void Keccak_StoreLane(uint64_t lane, uint8_t *data)
+{
+    for(uint32_t i = 0; i < 8; ++i)
+        data[i] = static_cast<uint8_t>(lane >> (8 * i));
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Keccak_HashBatch(uint32_t rate, uint32_t capacity, uint32_t hashbitlen, uint8_t delimitedSuffix,
+    const BitSequence *data, DataLength databytelen, uint64_t count, BitSequence *hashval)
+{
+    if((rate + capacity) != 1600 || rate == 0 || (rate % 64) != 0 || (hashbitlen % 8) != 0)
+        return FAIL;
+    if(delimitedSuffix == 0 || (delimitedSuffix & 0x80) != 0)
+        return FAIL;
+
+    const uint32_t rateInBytes  = rate / 8;
+    const uint32_t rateInLanes  = rate / 64;
+    const uint64_t hashbytelen  = hashbitlen / 8;
+
+    /* Lane i of message k lives at states[4*i + k]. */
+    uint64_t states[100];
+    uint8_t  block[200];
+    for(uint64_t first = 0; first < count; first += 4)
+    {
+        const uint32_t instances = static_cast<uint32_t>(std::min(count - first, uint64_t(4)));
+        memset(states, 0, sizeof(states));
+
+        /* Absorb all the full blocks. */
+        uint64_t offset = 0;
+        for( ; offset + rateInBytes <= databytelen; offset += rateInBytes)
+        {
+            for(uint32_t k = 0; k < instances; ++k)
+            {
+                const BitSequence *input = data + (first + k) * databytelen + offset;
+                for(uint32_t i = 0; i < rateInLanes; ++i)
+                    states[4 * i + k] ^= Keccak_LoadLane(input + 8 * i);
+            }
+
+            KeccakF1600_StatePermute4(states);
+        }
+
+        /* Absorb the last partial block with the suffix and the final bit of the padding. */
+        for(uint32_t k = 0; k < instances; ++k)
+        {
+            memset(block, 0, rateInBytes);
+            memcpy(block, data + (first + k) * databytelen + offset, databytelen - offset);
+
+            block[databytelen - offset] ^= delimitedSuffix;
+            block[rateInBytes - 1]      ^= 0x80;
+
+            for(uint32_t i = 0; i < rateInLanes; ++i)
+                states[4 * i + k] ^= Keccak_LoadLane(block + 8 * i);
+        }
+
+        KeccakF1600_StatePermute4(states);
+
+        /* Squeeze the output, permuting again whenever a whole rate was extracted. */
+        for(uint64_t extracted = 0; ; )
+        {
+            const uint64_t length = std::min(hashbytelen - extracted, uint64_t(rateInBytes));
+            for(uint32_t k = 0; k < instances; ++k)
+            {
+                for(uint32_t i = 0; i < rateInLanes; ++i)
+                    Keccak_StoreLane(states[4 * i + k], block + 8 * i);
+
+                memcpy(hashval + (first + k) * hashbytelen + extracted, block, length);
+            }
+
+            extracted += length;
+            if(extracted >= hashbytelen)
+                break;
+
+            KeccakF1600_StatePermute4(states);
+        }
+    }
+
+    return SUCCESS;
+}
@@ -105,4 +105,24 @@ HashReturn Keccak_HashFinal(Keccak_HashInstance *hashInstance, BitSequence *hash
   */
 HashReturn Keccak_HashSqueeze(Keccak_HashInstance *hashInstance, BitSequence *data, DataLength databitlen);
 
+/**
+  * Function to hash a batch of messages of equal length with the same Keccak[r, c] parameters,
+  * four messages at a time using KeccakF1600_StatePermute4().
+  * The output of each message is identical to calling in order Keccak_HashInitialize(),
+  * Keccak_HashUpdate() and Keccak_HashFinal() on it.
+  * @param  rate        The value of the rate r, which must be a multiple of 64 bits.
+  * @param  capacity    The value of the capacity c.
+  * @param  hashbitlen  The number of output bits for each message, a multiple of 8.
+  * @param  delimitedSuffix Bits appended to the end of each message, as in Keccak_HashInitialize(),
+  *                         with its most significant bit cleared.
+  * @param  data        Pointer to the messages, stored back to back.
+  * @param  databytelen The length of each message in bytes.
+  * @param  count       The number of messages.
+  * @param  hashval     Pointer to the buffer where to store the hashes, back to back.
+  * @pre    One must have r+c=1600.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_HashBatch(uint32_t rate, uint32_t capacity, uint32_t hashbitlen, uint8_t delimitedSuffix,
+    const BitSequence *data, DataLength databytelen, uint64_t count, BitSequence *hashval);
+
 #endif
@@ -20,4 +20,31 @@ namespace LLC
     LLD::TemplateLRU<std::vector<uint8_t>, uint256_t>  cache256  (32);
     LLD::TemplateLRU<std::vector<uint8_t>, uint512_t>  cache512  (32);
     LLD::TemplateLRU<std::vector<uint8_t>, uint1024_t> cache1024 (32);
+
+
+    /* 512-bit hashing of a batch of equal length messages. */
+    std::vector<uint512_t> SK512(const std::vector<uint8_t>& vData, const uint64_t nSize)
+    {
+        static_assert(sizeof(uint512_t) == 64, "uint512_t must be tightly packed for batch hashing");
+
+        /* Check that our messages fill the data evenly. */
+        const uint64_t nCount = (nSize == 0 ? 0 : vData.size() / nSize);
+
+        /* Run the Skein stage for each message. */
+        std::vector<uint8_t> vSkein(nCount * 64);
+        for(uint64_t n = 0; n < nCount; ++n)
+        {
+            Skein_512_Ctxt_t ctxSkein;
+            Skein_512_Init  (&ctxSkein, 512);
+            Skein_512_Update(&ctxSkein, &vData[n * nSize], nSize);
+            Skein_512_Final (&ctxSkein, &vSkein[n * 64]);
+        }
+
+        /* Run the Keccak stage four messages at a time. */
+        std::vector<uint512_t> vHashes(nCount);
+        if(!vHashes.empty())
+            Keccak_HashBatch(576, 1024, 512, 0x06, &vSkein[0], 64, vHashes.size(), (uint8_t *)&vHashes[0]);
+
+        return vHashes;
+    }
 }
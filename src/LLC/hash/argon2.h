@@ -430,6 +430,22 @@ ARGON2_PUBLIC size_t argon2_encodedlen(uint32_t t_cost, uint32_t m_cost,
                                        uint32_t parallelism, uint32_t saltlen,
                                        uint32_t hashlen, argon2_type type);
 
+/* The cores that fill memory blocks, which all give the same output */
+typedef enum Argon2_core {
+    ARGON2_CORE_AUTO = -1, /* widest core the running cpu supports */
+    ARGON2_CORE_REF  = 0,
+    ARGON2_CORE_SSE2 = 1,
+    ARGON2_CORE_AVX2 = 2
+} argon2_core;
+
+/**
+ * Selects the core used to fill memory blocks, so that each core can be
+ * checked against the reference core. Not thread safe with running hashes.
+ * @param core  The core to select
+ * @return  Zero if the core isn't available on this build or cpu
+ */
+ARGON2_PUBLIC int argon2_select_core(argon2_core core);
+
 #if defined(__cplusplus)
 }
 #endif
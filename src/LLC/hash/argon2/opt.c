@@ -15,6 +15,15 @@
  * software. If not, they may be obtained at the above URLs.
  */
 
+/* The optimized cores need SSE2, which every x86_64 cpu has. */
+#if defined(__x86_64__)
+
+/* opt_avx2.c includes this file again with its own name for fill_segment. */
+#if !defined(ARGON2_FILL_SEGMENT)
+#define ARGON2_FILL_SEGMENT fill_segment_sse2
+#define ARGON2_DISPATCH
+#endif
+
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
@@ -171,8 +180,8 @@ static void next_addresses(block *address_block, block *input_block) {
     fill_block(zero2_block, address_block, address_block, 0);
 }
 
-void fill_segment(const argon2_instance_t *instance,
-                  argon2_position_t position) {
+void ARGON2_FILL_SEGMENT(const argon2_instance_t *instance,
+                         argon2_position_t position) {
     block *ref_block = NULL, *curr_block = NULL;
     block address_block, input_block;
     uint64_t pseudo_rand, ref_index, ref_lane;
@@ -281,3 +290,69 @@ void fill_segment(const argon2_instance_t *instance,
         }
     }
 }
+
+#if defined(ARGON2_DISPATCH)
+
+void fill_segment_ref(const argon2_instance_t *instance, argon2_position_t position);
+void fill_segment_sse2(const argon2_instance_t *instance, argon2_position_t position);
+
+#if defined(__GNUC__) && !defined(__clang__)
+void fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position);
+#endif
+
+/* The core selected with argon2_select_core. */
+static argon2_core selected = ARGON2_CORE_AUTO;
+
+/* Checks if the running cpu supports AVX2, since our builds only assume SSE2 at compile time. */
+static int has_avx2(void) {
+#if defined(__GNUC__) && !defined(__clang__)
+    static int avx2 = -1;
+    if(avx2 < 0) {
+        avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+
+    return avx2;
+#else
+    return 0;
+#endif
+}
+
+int argon2_select_core(argon2_core core) {
+    if(core == ARGON2_CORE_AVX2 && !has_avx2()) {
+        return 0;
+    }
+
+    selected = core;
+    return 1;
+}
+
+/*
+ * Runs the selected core, or the widest core the running cpu supports.
+ */
+void fill_segment(const argon2_instance_t *instance,
+                  argon2_position_t position) {
+    argon2_core core = selected;
+    if(core == ARGON2_CORE_AUTO) {
+        core = has_avx2() ? ARGON2_CORE_AVX2 : ARGON2_CORE_SSE2;
+    }
+
+    switch(core) {
+    case ARGON2_CORE_REF:
+        fill_segment_ref(instance, position);
+        return;
+
+#if defined(__GNUC__) && !defined(__clang__)
+    case ARGON2_CORE_AVX2:
+        fill_segment_avx2(instance, position);
+        return;
+#endif
+
+    default:
+        fill_segment_sse2(instance, position);
+        return;
+    }
+}
+
+#endif /* ARGON2_DISPATCH */
+
+#endif /* __x86_64__ */
@@ -0,0 +1,30 @@
+/*
+ * Argon2 reference source code package - reference C implementations
+ *
+ * Copyright 2015
+ * Daniel Dinu, Dmitry Khovratovich, Jean-Philippe Aumasson, and Samuel Neves
+ *
+ * You may use this work under the terms of a Creative Commons CC0 1.0
+ * License/Waiver or the Apache Public License 2.0, at your option. The terms of
+ * these licenses can be found at:
+ *
+ * - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+ * - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * You should have received a copy of both of these licenses along with this
+ * software. If not, they may be obtained at the above URLs.
+ */
+
+/*
+ * AVX2 build of the optimized core in opt.c. The target pragma defines
+ * __AVX2__ for everything that follows, so opt.c and blamka-round-opt.h take
+ * their 256-bit paths, while the rest of the binary stays at our baseline.
+ */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+
+#pragma GCC target("avx2")
+
+#define ARGON2_FILL_SEGMENT fill_segment_avx2
+#include "opt.c"
+
+#endif
@@ -15,6 +15,11 @@
  * software. If not, they may be obtained at the above URLs.
  */
 
+/* x86_64 builds dispatch to the SSE2/AVX2 cores in opt.c, keeping this core to check them against. */
+#if defined(__x86_64__)
+#define fill_segment fill_segment_ref
+#endif
+
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
@@ -192,3 +197,9 @@ void fill_segment(const argon2_instance_t *instance,
         }
     }
 }
+
+#if !defined(__x86_64__)
+int argon2_select_core(argon2_core core) {
+    return (core == ARGON2_CORE_AUTO || core == ARGON2_CORE_REF) ? 1 : 0;
+}
+#endif
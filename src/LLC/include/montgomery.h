@@ -0,0 +1,52 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLC_INCLUDE_MONTGOMERY_H
+#define NEXUS_LLC_INCLUDE_MONTGOMERY_H
+
+#include <vector>
+
+#include <LLC/types/uint1024.h>
+
+namespace LLC
+{
+
+    /** FermatTest
+     *
+     *  Calculate the base 2 Fermat remainder 2^(n-1) mod n using fixed width
+     *  Montgomery arithmetic on the stack, without any bignum allocations.
+     *  Processors without 128-bit integers fall back to an OpenSSL exponentiation.
+     *
+     *  @param[in] hashTest The number to test, must be odd and greater than one.
+     *
+     *  @return The remainder of the fermat test, 1 if the number is a probable prime.
+     *
+     **/
+    uint1024_t FermatTest(const uint1024_t& hashTest);
+
+
+    /** FermatTest
+     *
+     *  Calculate the base 2 Fermat remainders for a batch of numbers, such as
+     *  all the members of a prime cluster.
+     *
+     *  @param[in] vTests The numbers to test, each must be odd and greater than one.
+     *  @param[out] vRemainders The remainders of the fermat tests, in the same order.
+     *
+     **/
+    void FermatTest(const std::vector<uint1024_t>& vTests, std::vector<uint1024_t> &vRemainders);
+
+}
+
+#endif
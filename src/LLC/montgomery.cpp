@@ -0,0 +1,343 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/montgomery.h>
+#include <LLC/types/bignum.h>
+
+#include <openssl/bn.h>
+
+namespace LLC
+{
+
+    /* Our limb products need a tetra-int from GCC, which is only available for 64-bit processors. */
+    #ifdef __SIZEOF_INT128__
+
+    /* The total 64-bit limbs in a 1024-bit number. */
+    const uint32_t MONTGOMERY_LIMBS = 16;
+
+
+    /* Double width type used for limb products. */
+    typedef unsigned __int128 limb_product_t;
+
+
+    /* Load a 1024-bit number into little endian 64-bit limbs. */
+    static inline void load_limbs(uint64_t* x, const uint1024_t& hash)
+    {
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+            x[i] = static_cast<uint64_t>(hash.get(i * 2)) | (static_cast<uint64_t>(hash.get(i * 2 + 1)) << 32);
+    }
+
+
+    /* Store little endian 64-bit limbs into a 1024-bit number. */
+    static inline void store_limbs(uint1024_t& hash, const uint64_t* x)
+    {
+        uint8_t* pBytes = hash.begin();
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+            for(uint32_t n = 0; n < 8; ++n)
+                pBytes[i * 8 + n] = static_cast<uint8_t>(x[i] >> (n * 8));
+    }
+
+
+    /* Calculate -n^-1 mod 2^64 with newton iterations, n must be odd. */
+    static inline uint64_t inverse_limb(const uint64_t n)
+    {
+        uint64_t x = n; //correct to 3 bits for any odd n
+        for(uint32_t i = 0; i < 5; ++i)
+            x *= 2 - n * x;
+
+        return ~x + 1;
+    }
+
+
+    /* Check if x (with an extra carry limb) is greater or equal to n. */
+    static inline bool greater_equal(const uint64_t* x, const uint64_t nCarry, const uint64_t* n)
+    {
+        if(nCarry)
+            return true;
+
+        for(int32_t i = MONTGOMERY_LIMBS - 1; i >= 0; --i)
+        {
+            if(x[i] != n[i])
+                return x[i] > n[i];
+        }
+
+        return true;
+    }
+
+
+    /* Calculate z = x - n, ignoring the final borrow. */
+    static inline void subtract(uint64_t* z, const uint64_t* x, const uint64_t* n)
+    {
+        uint64_t nBorrow = 0;
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+        {
+            const uint64_t nDiff = x[i] - n[i];
+            const uint64_t nNext = (x[i] < n[i]) | (nDiff < nBorrow);
+
+            z[i]    = nDiff - nBorrow;
+            nBorrow = nNext;
+        }
+    }
+
+
+    /* Calculate x = 2x mod n, x must be reduced. */
+    static inline void double_mod(uint64_t* x, const uint64_t* n)
+    {
+        const uint64_t nCarry = x[MONTGOMERY_LIMBS - 1] >> 63;
+        for(int32_t i = MONTGOMERY_LIMBS - 1; i > 0; --i)
+            x[i] = (x[i] << 1) | (x[i - 1] >> 63);
+
+        x[0] <<= 1;
+
+        if(greater_equal(x, nCarry, n))
+            subtract(x, x, n);
+    }
+
+
+    /* Add the product of two limbs into a three limb column accumulator. */
+    static inline void mul_add(limb_product_t& nColumn, uint64_t& nOverflow, const uint64_t a, const uint64_t b)
+    {
+        const limb_product_t nProduct = static_cast<limb_product_t>(a) * b;
+
+        nColumn   += nProduct;
+        nOverflow += (nColumn < nProduct);
+    }
+
+
+    /* Add twice the value of one column accumulator into another. */
+    static inline void add_double(limb_product_t& nColumn, uint64_t& nOverflow, const limb_product_t nCross, const uint64_t nCrossOverflow)
+    {
+        const limb_product_t nDouble = nCross << 1;
+
+        nColumn   += nDouble;
+        nOverflow += (nColumn < nDouble) + (nCrossOverflow << 1) + static_cast<uint64_t>(nCross >> 127);
+    }
+
+
+    /* Shift the column accumulator down by one limb. */
+    static inline void next_column(limb_product_t& nColumn, uint64_t& nOverflow)
+    {
+        nColumn   = (nColumn >> 64) | (static_cast<limb_product_t>(nOverflow) << 64);
+        nOverflow = 0;
+    }
+
+
+    /* Calculate z = x^2 / 2^1024 mod n, interleaving the squaring and reduction column by column. Summing
+     * each column of independent products keeps the multiplies out of a single long carry chain. */
+    static inline void sqr_redc(uint64_t* z, const uint64_t* x, const uint64_t* n, const uint64_t nInverse)
+    {
+        uint64_t m[MONTGOMERY_LIMBS];
+
+        limb_product_t nColumn = 0;
+        uint64_t nOverflow = 0;
+
+        /* Low columns, each one produces a limb of our reduction multiplier. The loops are fully unrolled
+         * so that every column has constant bounds. */
+        #pragma GCC unroll 16
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+        {
+            /* Cross products are counted twice in the square. */
+            limb_product_t nCross = 0;
+            uint64_t nCrossOverflow = 0;
+            #pragma GCC unroll 16
+            for(uint32_t j = 0; j < i - j; ++j)
+                mul_add(nCross, nCrossOverflow, x[j], x[i - j]);
+
+            add_double(nColumn, nOverflow, nCross, nCrossOverflow);
+
+            if((i & 1) == 0)
+                mul_add(nColumn, nOverflow, x[i >> 1], x[i >> 1]);
+
+            #pragma GCC unroll 16
+            for(uint32_t j = 0; j < i; ++j)
+                mul_add(nColumn, nOverflow, m[j], n[i - j]);
+
+            /* Pick the multiplier that clears the lowest limb. */
+            m[i] = static_cast<uint64_t>(nColumn) * nInverse;
+            mul_add(nColumn, nOverflow, m[i], n[0]);
+
+            next_column(nColumn, nOverflow);
+        }
+
+        /* High columns, each one produces a limb of our result. */
+        #pragma GCC unroll 16
+        for(uint32_t i = MONTGOMERY_LIMBS; i < MONTGOMERY_LIMBS * 2 - 1; ++i)
+        {
+            limb_product_t nCross = 0;
+            uint64_t nCrossOverflow = 0;
+            #pragma GCC unroll 16
+            for(uint32_t j = i - MONTGOMERY_LIMBS + 1; j < i - j; ++j)
+                mul_add(nCross, nCrossOverflow, x[j], x[i - j]);
+
+            add_double(nColumn, nOverflow, nCross, nCrossOverflow);
+
+            if((i & 1) == 0)
+                mul_add(nColumn, nOverflow, x[i >> 1], x[i >> 1]);
+
+            #pragma GCC unroll 16
+            for(uint32_t j = i - MONTGOMERY_LIMBS + 1; j < MONTGOMERY_LIMBS; ++j)
+                mul_add(nColumn, nOverflow, m[j], n[i - j]);
+
+            z[i - MONTGOMERY_LIMBS] = static_cast<uint64_t>(nColumn);
+            next_column(nColumn, nOverflow);
+        }
+
+        z[MONTGOMERY_LIMBS - 1] = static_cast<uint64_t>(nColumn);
+
+        /* The result is less than 2n, so one subtraction fully reduces it. */
+        if(greater_equal(z, static_cast<uint64_t>(nColumn >> 64), n))
+            subtract(z, z, n);
+    }
+
+
+    /* Calculate z = x / 2^1024 mod n, taking a number out of montgomery form. */
+    static inline void redc(uint64_t* z, const uint64_t* x, const uint64_t* n, const uint64_t nInverse)
+    {
+        uint64_t t[MONTGOMERY_LIMBS + 1];
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+            t[i] = x[i];
+
+        t[MONTGOMERY_LIMBS] = 0;
+
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+        {
+            const uint64_t m = t[0] * nInverse;
+
+            /* The lowest limb always cancels out to zero. */
+            limb_product_t nProduct = static_cast<limb_product_t>(m) * n[0] + t[0];
+            uint64_t nCarry = static_cast<uint64_t>(nProduct >> 64);
+
+            for(uint32_t j = 1; j < MONTGOMERY_LIMBS; ++j)
+            {
+                nProduct = static_cast<limb_product_t>(m) * n[j] + t[j] + nCarry;
+
+                t[j - 1] = static_cast<uint64_t>(nProduct);
+                nCarry   = static_cast<uint64_t>(nProduct >> 64);
+            }
+
+            const limb_product_t nSum = static_cast<limb_product_t>(t[MONTGOMERY_LIMBS]) + nCarry;
+            t[MONTGOMERY_LIMBS - 1] = static_cast<uint64_t>(nSum);
+            t[MONTGOMERY_LIMBS]     = static_cast<uint64_t>(nSum >> 64);
+        }
+
+        if(greater_equal(t, t[MONTGOMERY_LIMBS], n))
+            subtract(z, t, n);
+        else
+        {
+            for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+                z[i] = t[i];
+        }
+    }
+
+
+    /* Calculate x = 2^(n-1) mod n. */
+    static void fermat_limbs(uint64_t* x, const uint64_t* n)
+    {
+        const uint64_t nInverse = inverse_limb(n[0]);
+
+        /* Our exponent is n - 1, which only differs from n in the lowest bit since n is odd. */
+        uint64_t e[MONTGOMERY_LIMBS];
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+            e[i] = n[i];
+
+        e[0] &= ~uint64_t(1);
+
+        /* Find the most significant bit of our modulus, which is also the top bit of our exponent. */
+        int32_t nTop = MONTGOMERY_LIMBS * 64 - 1;
+        while(nTop > 0 && !((n[nTop >> 6] >> (nTop & 63)) & 1))
+            --nTop;
+
+        /* Start at 2^top which is less than n, and double it up to 2^1024 mod n, the montgomery form of 1. */
+        for(uint32_t i = 0; i < MONTGOMERY_LIMBS; ++i)
+            x[i] = 0;
+
+        x[nTop >> 6] = uint64_t(1) << (nTop & 63);
+        for(uint32_t i = nTop; i < MONTGOMERY_LIMBS * 64; ++i)
+            double_mod(x, n);
+
+        /* Left to right binary exponentiation. With a constant base of 2 every multiply is a modular doubling,
+         * which is far cheaper than a window table lookup and multiplication. */
+        for(int32_t i = nTop; i >= 0; --i)
+        {
+            sqr_redc(x, x, n, nInverse);
+
+            if((e[i >> 6] >> (i & 63)) & 1)
+                double_mod(x, n);
+        }
+
+        /* Take our result out of montgomery form. */
+        redc(x, x, n, nInverse);
+    }
+
+    /* Otherwise revert to OpenSSL for 32-bit processors or incompatible compilers. */
+    #else
+
+    /* Calculate 2^(n-1) mod n with a bignum exponentiation. */
+    static uint1024_t fermat_bignum(const uint1024_t& hashTest)
+    {
+        LLC::CAutoBN_CTX pctx;
+
+        LLC::CBigNum bnPrime(hashTest);
+        LLC::CBigNum bnBase(2);
+        LLC::CBigNum bnExp = bnPrime - 1;
+
+        LLC::CBigNum bnResult;
+        BN_mod_exp(bnResult.getBN(), bnBase.getBN(), bnExp.getBN(), bnPrime.getBN(), pctx);
+
+        return bnResult.getuint1024();
+    }
+
+    #endif
+
+
+    /* Calculate the base 2 Fermat remainder 2^(n-1) mod n. */
+    uint1024_t FermatTest(const uint1024_t& hashTest)
+    {
+    #ifndef __SIZEOF_INT128__
+        return fermat_bignum(hashTest);
+    #else
+        uint64_t n[MONTGOMERY_LIMBS];
+        load_limbs(n, hashTest);
+
+        uint64_t x[MONTGOMERY_LIMBS];
+        fermat_limbs(x, n);
+
+        uint1024_t hashRet;
+        store_limbs(hashRet, x);
+
+        return hashRet;
+    #endif
+    }
+
+
+    /* Calculate the base 2 Fermat remainders for a batch of numbers. */
+    void FermatTest(const std::vector<uint1024_t>& vTests, std::vector<uint1024_t> &vRemainders)
+    {
+        vRemainders.resize(vTests.size());
+
+    #ifndef __SIZEOF_INT128__
+        for(uint32_t i = 0; i < vTests.size(); ++i)
+            vRemainders[i] = fermat_bignum(vTests[i]);
+    #else
+        uint64_t n[MONTGOMERY_LIMBS];
+        uint64_t x[MONTGOMERY_LIMBS];
+        for(uint32_t i = 0; i < vTests.size(); ++i)
+        {
+            load_limbs(n, vTests[i]);
+            fermat_limbs(x, n);
+
+            store_limbs(vRemainders[i], x);
+        }
+    #endif
+    }
+}
@@ -18,159 +18,205 @@ ________________________________________________________________________________
 #include <Util/include/debug.h>
 #include <Util/include/hex.h>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace LLD
 {
-    /*  Node to hold the binary data of the double linked list. */
+    /* The memory used to track a node, on top of its data. */
+    const uint32_t BINARY_NODE_OVERHEAD = 96;
+
+
+    /* The smallest a single shard of the cache can be. */
+    const uint32_t MIN_SHARD_SIZE = 1024 * 64;
+
+
+    /* The maximum shards that a cache is split into. */
+    const uint32_t MAX_SHARDS = 32;
+
+
+    /*  Node to hold the binary data in the eviction clock. */
     struct BinaryNode
     {
     public:
 
-        /** Linked list pointers. **/
-        BinaryNode* pprev;
-        BinaryNode* pnext;
-
         /** Store the key as 64-bit hash, since we have checksum to verify against too. **/
         uint64_t hashKey;
 
         /** The data in the binary node. **/
         std::vector<uint8_t> vData;
 
+        /** Reference bit, set by readers to give this node a second chance before eviction. **/
+        std::atomic<bool> fReferenced;
+
         /** Default constructor **/
-        BinaryNode(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vDataIn)
-        : pprev   (nullptr)
-        , pnext   (nullptr)
-        , hashKey (XXH64(&vKey[0], vKey.size(), 0))
-        , vData   (vDataIn)
+        BinaryNode()
+        : hashKey     (0)
+        , vData       ( )
+        , fReferenced (false)
         {
         }
 
-        /** bucket Node is Assigned to. **/
-        uint32_t Bucket(const uint64_t nBuckets)
+
+        /** Check if node is in null state. **/
+        bool IsNull() const
         {
-            return static_cast<uint32_t>(hashKey % static_cast<uint64_t>(nBuckets));
+            return hashKey == 0;
         }
 
 
-        /** Erase the data. **/
-        void Erase()
+        /** Set node into null state. **/
+        void SetNull()
         {
+            hashKey = 0;
+            fReferenced.store(false);
+
             std::vector<uint8_t>().swap(vData);
         }
+    };
 
 
-        /** Check if node is in null state. **/
-        bool IsNull() const
+    /*  Independent section of the cache with its own lock and eviction clock. */
+    struct BinaryShard
+    {
+    public:
+
+        /** Reader/writer lock, readers never modify the structure of the shard. **/
+        mutable std::shared_mutex MUTEX;
+
+        /** Map of key hashes to their node in the clock. **/
+        std::unordered_map<uint64_t, uint32_t> mapIndex;
+
+        /** The nodes of our clock, deque so nodes never move when growing. **/
+        std::deque<BinaryNode> vNodes;
+
+        /** Nodes that were evicted or removed and can be reused. **/
+        std::vector<uint32_t> vFree;
+
+        /** The current position of the clock hand. **/
+        uint32_t nHand;
+
+        /** The current size of this shard. **/
+        uint64_t nCurrentSize;
+
+        /** The maximum size of this shard. **/
+        const uint64_t nMaxSize;
+
+
+        /** Shard Size Constructor **/
+        BinaryShard(const uint64_t nMaxSizeIn)
+        : MUTEX        ( )
+        , mapIndex     ( )
+        , vNodes       ( )
+        , vFree        ( )
+        , nHand        (0)
+        , nCurrentSize (0)
+        , nMaxSize     (nMaxSizeIn)
         {
-            return hashKey == 0;
         }
 
 
-        /** Set node into null state. **/
-        void SetNull()
+        /** Find a node by its key hash, expects MUTEX to be held. **/
+        BinaryNode* find(const uint64_t hashKey)
         {
-            pprev   = nullptr;
-            pnext   = nullptr;
-            hashKey = 0;
+            const auto it = mapIndex.find(hashKey);
+            if(it == mapIndex.end())
+                return nullptr;
 
-            Erase();
+            return &vNodes[it->second];
+        }
+
+
+        /** Release a node back to the free list, expects MUTEX to be held exclusively. **/
+        void release(const uint32_t nSlot)
+        {
+            BinaryNode& node = vNodes[nSlot];
+
+            /* Reduce the current size. */
+            nCurrentSize -= (node.vData.size() + BINARY_NODE_OVERHEAD);
+
+            /* Free the memory. */
+            mapIndex.erase(node.hashKey);
+            node.SetNull();
+
+            vFree.push_back(nSlot);
         }
     };
 
 
+    /*  Get the 64-bit hash of a key, zero is reserved for null nodes. */
+    inline uint64_t KeyHash(const std::vector<uint8_t>& vKey)
+    {
+        const uint64_t hashKey = XXH64(&vKey[0], vKey.size(), 0);
+        return (hashKey == 0) ? 1 : hashKey;
+    }
+
+
     /** Cache Size Constructor **/
     BinaryLRU::BinaryLRU(const uint32_t nCacheSizeIn)
     : MAX_CACHE_SIZE    (nCacheSizeIn)
-    , MAX_CACHE_BUCKETS (nCacheSizeIn / 128)
-    , nCurrentSize      (MAX_CACHE_BUCKETS * 16)
-    , MUTEX             ( )
-    , hashmap           (MAX_CACHE_BUCKETS, nullptr)
-    , indexes           (MAX_CACHE_BUCKETS, 0)
-    , pfirst            (nullptr)
-    , plast             (nullptr)
+    , MAX_CACHE_SHARDS  (std::max(1u, std::min(MAX_SHARDS, nCacheSizeIn / MIN_SHARD_SIZE)))
+    , vShards           ( )
     {
+        /* Split our cache size evenly between our shards. */
+        for(uint32_t n = 0; n < MAX_CACHE_SHARDS; ++n)
+            vShards.push_back(new BinaryShard(MAX_CACHE_SIZE / MAX_CACHE_SHARDS));
     }
 
 
     /** Class Destructor. **/
     BinaryLRU::~BinaryLRU()
     {
-        LOCK(MUTEX);
-
-        /* Loop through the linked list. */
-        for(auto& item : hashmap)
-            if(item != nullptr)
-                delete item;
+        /* Loop through our shards. */
+        for(auto& pshard : vShards)
+            delete pshard;
     }
 
 
     /*  Check if data exists. */
     bool BinaryLRU::Has(const std::vector<uint8_t>& vKey) const
     {
-        LOCK(MUTEX);
-
-        /* Get the data. */
-        const uint64_t& nIndex  = indexes[bucket(vKey)];
-        if(nIndex == 0)
-            return false;
+        const uint64_t hashKey = KeyHash(vKey);
 
-        /* Check if the Record Exists. */
-        const BinaryNode* pthis = hashmap[slot(nIndex)];
-        if(pthis == nullptr)
-            return false;
+        /* Get our shard for this key. */
+        BinaryShard* pshard = shard(hashKey);
+        std::shared_lock<std::shared_mutex> lock(pshard->MUTEX);
 
-        /* Check for null state. */
-        if(pthis->IsNull())
-            return false;
-
-        /* Check the data is expected. */
-        return (pthis->hashKey == XXH64(&vKey[0], vKey.size(), 0));
+        return pshard->mapIndex.count(hashKey);
     }
 
 
-    /*  Find a bucket for cache key management. */
-    uint32_t BinaryLRU::bucket(const std::vector<uint8_t>& vKey) const
+    /*  Find the shard responsible for a given key hash. */
+    BinaryShard* BinaryLRU::shard(const uint64_t hashKey) const
     {
-        /* Get an xxHash. */
-        uint64_t nBucket = XXH64(&vKey[0], vKey.size(), 0);
-
-        return static_cast<uint32_t>(nBucket % static_cast<uint64_t>(MAX_CACHE_BUCKETS));
+        /* Use the high bits so our shard is independent of the shard's own hashing. */
+        return vShards[(hashKey >> 32) % MAX_CACHE_SHARDS];
     }
 
 
     /*  Get the data by index */
     bool BinaryLRU::Get(const std::vector<uint8_t>& vKey, std::vector<uint8_t>& vData)
     {
-        LOCK(MUTEX);
+        const uint64_t hashKey = KeyHash(vKey);
 
-        /* Check for data. */
-        uint64_t& nIndex  = indexes[bucket(vKey)];
-        if(nIndex == 0)
-            return false;
+        /* Readers share the lock, and only touch the node's atomic reference bit. */
+        BinaryShard* pshard = shard(hashKey);
+        std::shared_lock<std::shared_mutex> lock(pshard->MUTEX);
 
-        /* Get the binary node. */
-        BinaryNode* pthis = hashmap[slot(nIndex)];
+        /* Check if the Record Exists. */
+        BinaryNode* pthis = pshard->find(hashKey);
         if(pthis == nullptr)
-        {
-            nIndex = 0; //reset by reference
-            return false;
-        }
-
-        /* Check for null state. */
-        if(pthis->IsNull())
-        {
-            nIndex = 0; //reset by reference
-            return false;
-        }
-
-        /* Check the keys are correct. */
-        if(pthis->hashKey != XXH64(&vKey[0], vKey.size(), 0))
             return false;
 
         /* Get the data. */
         vData = pthis->vData;
 
-        /* Move to front of double linked list. */
-        move_to_front(pthis);
+        /* Mark as recently used so the clock passes over it. */
+        if(!pthis->fReferenced.load(std::memory_order_relaxed))
+            pthis->fReferenced.store(true, std::memory_order_relaxed);
 
         return true;
     }
@@ -179,90 +225,71 @@ namespace LLD
     /*  Add data in the Pool. */
     void BinaryLRU::Put(const SectorKey& key, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, bool fReserve)
     {
-        LOCK(MUTEX);
+        const uint64_t hashKey = KeyHash(vKey);
 
-        /* Get the binary node. */
-        uint64_t& nIndex = indexes[bucket(vKey)];
-        if(nIndex != 0)
-        {
-            /* Get the node from checksum. */
-            uint32_t nSlot    = slot(nIndex);
-            BinaryNode* pthis = hashmap[nSlot];
+        /* Writers take the shard exclusively. */
+        BinaryShard* pshard = shard(hashKey);
+        std::unique_lock<std::shared_mutex> lock(pshard->MUTEX);
 
-            /* Check for dereferencing nullptr. */
-            if(pthis != nullptr && !pthis->IsNull())
-            {
-                /* Reduce the current size. */
-                nCurrentSize -= static_cast<uint32_t>(pthis->vData.size());
+        /* Check for an existing node to replace. */
+        uint32_t nSlot = 0;
 
-                /* Free the memory. */
-                remove_node(pthis);
-                pthis->SetNull();
-            }
-        }
-
-        /* Update index hashmap through reference: NOTE nSectorFile and nSectorStart are 0-based so we add 1 to it to ensure we always have an index */
-        nIndex = ((key.nSectorFile + 1) * (key.nSectorStart + 1));
-
-        /* Cleanup if colliding with another bucket. */
-        uint32_t nSlot = slot(nIndex);
-        if(hashmap[nSlot] != nullptr)
+        const auto it = pshard->mapIndex.find(hashKey);
+        if(it != pshard->mapIndex.end())
         {
-            /* Claiming an empty hashmap slot. */
-            if(!hashmap[nSlot]->IsNull())
-            {
-                /* Erase data on collision. */
-                nCurrentSize -= static_cast<uint32_t>(hashmap[nSlot]->vData.size());
-                hashmap[nSlot]->Erase();
-            }
-
-            /* Set new values. */
-            hashmap[nSlot]->hashKey = XXH64(&vKey[0], vKey.size(), 0);
-            hashmap[nSlot]->vData   = vData;
+            nSlot = it->second;
 
-            /* Move to front of list. */
-            move_to_front(hashmap[nSlot]);
+            /* Reduce the current size. */
+            pshard->nCurrentSize -= pshard->vNodes[nSlot].vData.size();
         }
         else
         {
-            /* Add cache node to objects map. */
-            hashmap[nSlot] = new BinaryNode(vKey, vData);;
-            move_to_front(hashmap[nSlot]);
+            /* Claim a free node or grow the clock. */
+            if(!pshard->vFree.empty())
+            {
+                nSlot = pshard->vFree.back();
+                pshard->vFree.pop_back();
+            }
+            else
+            {
+                nSlot = static_cast<uint32_t>(pshard->vNodes.size());
+                pshard->vNodes.emplace_back();
+            }
 
             /* Account for the node's memory size. */
-            nCurrentSize += sizeof(*hashmap[nSlot]);
+            pshard->nCurrentSize += BINARY_NODE_OVERHEAD;
+            pshard->mapIndex[hashKey] = nSlot;
         }
 
-        /* Remove the last node if cache too large. */
-        while(nCurrentSize > MAX_CACHE_SIZE)
+        /* Set new values. */
+        BinaryNode& node = pshard->vNodes[nSlot];
+        node.hashKey = hashKey;
+        node.vData   = vData;
+        node.fReferenced.store(true);
+
+        pshard->nCurrentSize += vData.size();
+
+        /* Sweep the clock until the shard is small enough, giving referenced nodes a second chance. */
+        const uint64_t nNodes = pshard->vNodes.size();
+        for(uint64_t nSweep = 0; pshard->nCurrentSize > pshard->nMaxSize && nSweep < nNodes * 2; ++nSweep)
         {
-            /* Get last pointer. */
-            BinaryNode* pnode = plast;
-            if(!pnode || pnode->IsNull())
-                break;
-
-            /* Set the new links. */
-            plast = plast->pprev;
-            if (plast)
-                plast->pnext = nullptr;
-
-            /* Reset the memory linking. */
-            pnode->pprev = nullptr;
-            pnode->pnext = nullptr;
-
-            /* Reduce memory size. */
-            nCurrentSize -= static_cast<uint32_t>(pnode->vData.size());
-
-            /* Calculate the buckets for the node being deleted */
-            uint32_t  nBucket = pnode->Bucket(MAX_CACHE_BUCKETS);
-            uint64_t& nRemove = indexes[nBucket];
-
-            /* Reset the slot. */
-            hashmap[slot(nRemove)]->SetNull();
-            nRemove                = 0;
-        }
+            /* Wrap the hand around the clock. */
+            if(pshard->nHand >= nNodes)
+                pshard->nHand = 0;
+
+            const uint32_t nEvict = pshard->nHand++;
+
+            /* Skip empty nodes and the node we just added. */
+            BinaryNode& evict = pshard->vNodes[nEvict];
+            if(evict.IsNull() || nEvict == nSlot)
+                continue;
 
-        nCurrentSize += static_cast<uint32_t>(vData.size());
+            /* Clear the reference bit on the first pass. */
+            if(evict.fReferenced.exchange(false))
+                continue;
+
+            pshard->release(nEvict);
+        }
     }
 
 
@@ -275,103 +302,20 @@ namespace LLD
     /*  Force Remove Object by Index. */
     bool BinaryLRU::Remove(const std::vector<uint8_t>& vKey)
     {
-        LOCK(MUTEX);
+        const uint64_t hashKey = KeyHash(vKey);
 
-        /* Get the data. */
-        uint64_t& nIndex = indexes[bucket(vKey)];
-        if(nIndex == 0)
-            return false;
+        /* Writers take the shard exclusively. */
+        BinaryShard* pshard = shard(hashKey);
+        std::unique_lock<std::shared_mutex> lock(pshard->MUTEX);
 
-        /* Get the binary node. */
-        uint32_t nSlot = slot(nIndex);
-        if(hashmap[nSlot] == nullptr)
-        {
-            nIndex = 0; //reset by reference
+        /* Get the data. */
+        const auto it = pshard->mapIndex.find(hashKey);
+        if(it == pshard->mapIndex.end())
             return false;
-        }
 
-        /* Remove from the linked list. */
-        BinaryNode* pthis = hashmap[nSlot];
-        remove_node(pthis);
-
-        /* Set to null state. */
-        hashmap[nSlot]->SetNull();
-
-        /* Free the memory. */
-        nCurrentSize  -= static_cast<uint32_t>(pthis->vData.size() + 48);
-        nIndex         = 0; //reset by reference
+        /* Set to null state and free the memory. */
+        pshard->release(it->second);
 
         return true;
     }
-
-
-    /*  Find a bucket for checksum key management. */
-    uint32_t BinaryLRU::slot(const uint64_t nIndex) const
-    {
-        return static_cast<uint32_t>(nIndex % static_cast<uint64_t>(MAX_CACHE_BUCKETS));
-    }
-
-
-    /*  Remove a node from the double linked list. */
-    void BinaryLRU::remove_node(BinaryNode* pthis)
-    {
-        /* Relink last pointer. */
-        if(pthis == plast)
-        {
-            plast = plast->pprev;
-            if(plast)
-                plast->pnext = nullptr;
-        }
-
-        /* Relink first pointer. */
-        if(pthis == pfirst)
-        {
-            pfirst = pfirst->pnext;
-            if(pfirst)
-                pfirst->pprev = nullptr;
-        }
-
-        /* Link the next pointer if not null */
-        if (pthis->pnext)
-            pthis->pnext->pprev = pthis->pprev;
-
-        /* Link the previous pointer if not null. */
-        if (pthis->pprev)
-            pthis->pprev->pnext = pthis->pnext;
-
-        /* Unlink next and prev. */
-        pthis->pnext = nullptr;
-        pthis->pprev = nullptr;
-    }
-
-
-    /*  Move the node in double linked list to front. */
-    void BinaryLRU::move_to_front(BinaryNode* pthis)
-    {
-        /* Don't move to front if already in the front. */
-        if(pthis == pfirst)
-            return;
-
-        /* Move last pointer if moving from back. */
-        remove_node(pthis);
-
-        /* Link to front. */
-        pthis->pprev = nullptr;
-        pthis->pnext = pfirst;
-
-        /* Update the first reference prev */
-        if(pfirst)
-        {
-            /* Set last for second iteration. */
-            pfirst->pprev = pthis;
-            if(!plast)
-            {
-                plast = pfirst;
-                plast->pnext = nullptr;
-            }
-        }
-
-        /* Update the first reference. */
-        pfirst        = pthis;
-    }
 }
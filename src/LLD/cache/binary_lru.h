@@ -14,7 +14,6 @@ ________________________________________________________________________________
 #ifndef NEXUS_LLD_CACHE_BINARY_LRU_H
 #define NEXUS_LLD_CACHE_BINARY_LRU_H
 
-#include <mutex>
 #include <cstdint>
 #include <vector>
 
@@ -25,12 +24,12 @@ namespace LLD
     class SectorKey;
 
 
-    /** BinaryNode
+    /** BinaryShard
      *
-     *  Node to hold the binary data of the double linked list.
+     *  Independent section of the cache with its own lock and eviction clock.
      *
      **/
-    struct BinaryNode;
+    struct BinaryShard;
 
 
     /** BinaryLRU
@@ -39,6 +38,10 @@ namespace LLD
     *   This class is responsible for holding data that is partially processed.
     *   This class has no types, all objects are in binary forms.
     *
+    *   The cache is split into shards keyed by the hash of the key, each with its own
+    *   reader/writer lock. Recently used entries are approximated with a CLOCK, so that
+    *   reads only need a shared lock and set a reference bit instead of relinking a list.
+    *
     **/
     class BinaryLRU
     {
@@ -46,32 +49,12 @@ namespace LLD
         uint32_t MAX_CACHE_SIZE;
 
 
-        /* The total buckets available. */
-        uint32_t MAX_CACHE_BUCKETS;
-
-
-        /* The current size of the pool. */
-        uint32_t nCurrentSize;
-
-
-        /* Mutex for thread concurrency. */
-        mutable std::mutex MUTEX;
-
-
-        /* Map of the current holding data. */
-        std::vector<BinaryNode*> hashmap;
-
+        /* The total shards available. */
+        uint32_t MAX_CACHE_SHARDS;
 
-        /* Map of the current data indexes. */
-        std::vector<uint64_t> indexes;
 
-
-        /* Keep track of the first object in linked list. */
-        BinaryNode* pfirst;
-
-
-        /* Keep track of the last object in linked list. */
-        BinaryNode* plast;
+        /* The independent shards of this cache. */
+        std::vector<BinaryShard*> vShards;
 
 
     public:
@@ -171,44 +154,14 @@ namespace LLD
 
     private:
 
-        /** RemoveNode
-         *
-         *  Remove a node from the double linked list.
-         *
-         *  @param[in] pthis The node to remove from list.
-         *
-         **/
-        void remove_node(BinaryNode* pthis);
-
-
-        /** MoveToFront
-         *
-         *  Move the node in double linked list to front.
-         *
-         *  @param[in] pthis The node to move to front.
-         *
-         **/
-        void move_to_front(BinaryNode* pthis);
-
-
-        /** Bucket
-         *
-         *  Find a bucket for cache key management.
-         *
-         *  @param[in] vKey The key to get bucket for.
-         *
-         **/
-        uint32_t bucket(const std::vector<uint8_t>& vKey) const;
-
-
-        /** Bucket
+        /** shard
          *
-         *  Find a bucket for checksum key management.
+         *  Find the shard responsible for a given key hash.
          *
-         *  @param[in] nIndex The checksum to get bucket for.
+         *  @param[in] hashKey The 64-bit hash of the key.
          *
          **/
-        uint32_t slot(const uint64_t nIndex) const;
+        BinaryShard* shard(const uint64_t hashKey) const;
     };
 }
 
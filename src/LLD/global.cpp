@@ -38,14 +38,14 @@ namespace LLD
         /* Create the contract database instance. */
         uint32_t nContractCacheSize = config::GetArg("-contractcache", 1);
         Contract = new ContractDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | FLAGS::COMPACT,
                         77773,
                         nContractCacheSize * 1024 * 1024);
 
         /* Create the contract database instance. */
         uint32_t nRegisterCacheSize = config::GetArg("-registercache", 2);
         Register = new RegisterDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | FLAGS::COMPACT,
                         77773,
                         nRegisterCacheSize * 1024 * 1024);
 
@@ -78,7 +78,7 @@ namespace LLD
         /* Create the local database instance. */
         uint32_t nLogicalCacheSize = config::GetArg("-logicalcache", 2);
         Logical    = new LogicalDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | FLAGS::COMPACT,
                         256 * 256 * config::GetArg("-logicalbuckets", 16), nLogicalCacheSize * 1024 * 1024);
 
 
@@ -86,13 +86,16 @@ namespace LLD
         {
             /* Create new client database if enabled. */
             Client    = new ClientDB(
-                            FLAGS::CREATE | FLAGS::FORCE,
+                            FLAGS::CREATE | FLAGS::FORCE | FLAGS::COMPACT,
                             1000000);
         }
 
         /* Handle database recovery mode. */
         TxnRecovery();
 
+        /* Handle database compaction mode. */
+        if(config::GetBoolArg("-compact", false))
+            Compact();
     }
 
 
@@ -154,6 +157,25 @@ namespace LLD
     }
 
 
+    /* Compact the sector files of all LLD instances that allow it. */
+    void Compact()
+    {
+        debug::log(0, FUNCTION, "Compacting LLD");
+
+        /* Compact the contract database. */
+        while(Contract && Contract->Compact(true));
+
+        /* Compact the register database. */
+        while(Register && Register->Compact(true));
+
+        /* Compact the logical database. */
+        while(Logical && Logical->Compact(true));
+
+        /* Compact the client database. */
+        while(Client && Client->Compact(true));
+    }
+
+
     /* Check the transactions for recovery. */
     void TxnRecovery()
     {
@@ -17,10 +17,13 @@ ________________________________________________________________________________
 #include <LLD/hash/xxh3.h>
 
 #include <Util/templates/datastream.h>
+#include <Util/include/args.h>
 #include <Util/include/filesystem.h>
 #include <Util/include/debug.h>
 #include <Util/include/hex.h>
+#include <Util/include/runtime.h>
 
+#include <algorithm>
 #include <iomanip>
 
 namespace LLD
@@ -33,10 +36,12 @@ namespace LLD
     , fileCache              (new TemplateLRU<uint16_t, std::fstream*>(8))
     , pindex                 (nullptr)
     , hashmap                (nBucketsIn)
+    , vFingerprints          ( )
     , HASHMAP_TOTAL_BUCKETS  (nBucketsIn)
     , HASHMAP_MAX_KEY_SIZE   (32)
     , HASHMAP_KEY_ALLOCATION (static_cast<uint16_t>(HASHMAP_MAX_KEY_SIZE + 13))
     , nFlags                 (nFlagsIn)
+    , fFilter                (config::GetBoolArg("-lldfilter", true))
     , RECORD_MUTEX           (1024)
     {
         Initialize();
@@ -50,10 +55,12 @@ namespace LLD
     , fileCache              (map.fileCache)
     , pindex                 (map.pindex)
     , hashmap                (map.hashmap)
+    , vFingerprints          (map.vFingerprints)
     , HASHMAP_TOTAL_BUCKETS  (map.HASHMAP_TOTAL_BUCKETS)
     , HASHMAP_MAX_KEY_SIZE   (map.HASHMAP_MAX_KEY_SIZE)
     , HASHMAP_KEY_ALLOCATION (map.HASHMAP_KEY_ALLOCATION)
     , nFlags                 (map.nFlags)
+    , fFilter                (map.fFilter)
     , RECORD_MUTEX           (map.RECORD_MUTEX.size())
     {
         Initialize();
@@ -67,10 +74,12 @@ namespace LLD
     , fileCache              (std::move(map.fileCache))
     , pindex                 (std::move(map.pindex))
     , hashmap                (std::move(map.hashmap))
+    , vFingerprints          (std::move(map.vFingerprints))
     , HASHMAP_TOTAL_BUCKETS  (std::move(map.HASHMAP_TOTAL_BUCKETS))
     , HASHMAP_MAX_KEY_SIZE   (std::move(map.HASHMAP_MAX_KEY_SIZE))
     , HASHMAP_KEY_ALLOCATION (std::move(map.HASHMAP_KEY_ALLOCATION))
     , nFlags                 (std::move(map.nFlags))
+    , fFilter                (std::move(map.fFilter))
     , RECORD_MUTEX           (map.RECORD_MUTEX.size())
     {
         Initialize();
@@ -84,10 +93,12 @@ namespace LLD
         fileCache              = map.fileCache;
         pindex                 = map.pindex;
         hashmap                = map.hashmap;
+        vFingerprints          = map.vFingerprints;
         HASHMAP_TOTAL_BUCKETS  = map.HASHMAP_TOTAL_BUCKETS;
         HASHMAP_MAX_KEY_SIZE   = map.HASHMAP_MAX_KEY_SIZE;
         HASHMAP_KEY_ALLOCATION = map.HASHMAP_KEY_ALLOCATION;
         nFlags                 = map.nFlags;
+        fFilter                = map.fFilter;
 
         Initialize();
 
@@ -102,10 +113,12 @@ namespace LLD
         fileCache              = std::move(map.fileCache);
         pindex                 = std::move(map.pindex);
         hashmap                = std::move(map.hashmap);
+        vFingerprints          = std::move(map.vFingerprints);
         HASHMAP_TOTAL_BUCKETS  = std::move(map.HASHMAP_TOTAL_BUCKETS);
         HASHMAP_MAX_KEY_SIZE   = std::move(map.HASHMAP_MAX_KEY_SIZE);
         HASHMAP_KEY_ALLOCATION = std::move(map.HASHMAP_KEY_ALLOCATION);
         nFlags                 = std::move(map.nFlags);
+        fFilter                = std::move(map.fFilter);
 
         Initialize();
 
@@ -155,6 +168,131 @@ namespace LLD
     }
 
 
+    /* Calculates the in-memory fingerprint of a compressed key. */
+    uint8_t BinaryHashMap::GetFingerprint(const uint8_t* pKey, const uint16_t nSize) const
+    {
+        /* Ignore the zero padding that follows short keys on disk. */
+        uint16_t nLength = nSize;
+        while(nLength > 0 && pKey[nLength - 1] == 0)
+            --nLength;
+
+        /* Use the high byte of the hash so it is independent of our bucket. */
+        const uint8_t nFingerprint = static_cast<uint8_t>(XXH3_64bits(pKey, nLength) >> 56);
+
+        /* Zero is reserved for empty buckets. */
+        return (nFingerprint == 0 ? 1 : nFingerprint);
+    }
+
+
+    /* Sets the fingerprint for a given file and bucket. */
+    void BinaryHashMap::SetFingerprint(const uint16_t nFile, const uint32_t nBucket, const uint8_t nFingerprint)
+    {
+        /* Check that filtering is enabled. */
+        if(!fFilter)
+            return;
+
+        /* Allocate new file levels as the hashmap grows. */
+        if(nFile >= vFingerprints.size())
+            vFingerprints.resize(nFile + 1, std::vector<uint8_t>(HASHMAP_TOTAL_BUCKETS, 0));
+
+        vFingerprints[nFile][nBucket] = nFingerprint;
+    }
+
+
+    /* Determines if the fingerprint table rules out a file for a key. */
+    bool BinaryHashMap::Filtered(const uint16_t nFile, const uint32_t nBucket, const uint8_t nFingerprint, const bool fEmpty) const
+    {
+        /* We can't rule anything out without our filter. */
+        if(!fFilter || nFile >= vFingerprints.size())
+            return false;
+
+        /* Check for empty buckets if requested. */
+        const uint8_t nStored = vFingerprints[nFile][nBucket];
+        if(fEmpty && nStored == 0)
+            return false;
+
+        return (nStored != nFingerprint);
+    }
+
+
+    /* Scan the hashmap files on disk to build the fingerprint table. */
+    void BinaryHashMap::BuildFingerprints()
+    {
+        /* Clear any previous fingerprints. */
+        vFingerprints.clear();
+        if(!fFilter)
+            return;
+
+        /* Find the total number of hashmap files in use. */
+        uint16_t nFiles = 0;
+        for(const auto& nDepth : hashmap)
+            nFiles = std::max(nFiles, nDepth);
+
+        /* Allocate our fingerprint levels. */
+        vFingerprints.resize(nFiles, std::vector<uint8_t>(HASHMAP_TOTAL_BUCKETS, 0));
+
+        /* Track the time it takes to build our table. */
+        runtime::timer timer;
+        timer.Start();
+
+        /* Read the hashmap files sequentially in large chunks. */
+        const uint32_t nChunk = 16384;
+        std::vector<uint8_t> vBuffer(nChunk * HASHMAP_KEY_ALLOCATION, 0);
+        for(uint16_t nFile = 0; nFile < nFiles; ++nFile)
+        {
+            /* Open the hashmap file for reading. */
+            const std::string strFile = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile);
+            std::ifstream stream(strFile, std::ios::in | std::ios::binary);
+            if(!stream.is_open())
+            {
+                /* Disable our filter so lookups fall back to the disk. */
+                debug::error(FUNCTION, "failed to open ", strFile, ", disabling fingerprints");
+
+                fFilter = false;
+                vFingerprints.clear();
+
+                return;
+            }
+
+            /* Iterate the buckets in chunks. */
+            for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; nBucket += nChunk)
+            {
+                /* Read the next chunk of buckets. */
+                const uint32_t nBuckets = std::min(nChunk, HASHMAP_TOTAL_BUCKETS - nBucket);
+                if(!stream.read((char*)&vBuffer[0], nBuckets * HASHMAP_KEY_ALLOCATION))
+                {
+                    /* Disable our filter so lookups fall back to the disk. */
+                    debug::error(FUNCTION, "failed to read ", strFile, ", disabling fingerprints");
+
+                    fFilter = false;
+                    vFingerprints.clear();
+
+                    return;
+                }
+
+                /* Build fingerprints for the buckets that are in use. */
+                for(uint32_t n = 0; n < nBuckets; ++n)
+                {
+                    /* Skip over buckets that don't reach this file. */
+                    if(hashmap[nBucket + n] <= nFile)
+                        continue;
+
+                    /* Skip over empty buckets. */
+                    const uint8_t* pBucket = &vBuffer[n * HASHMAP_KEY_ALLOCATION];
+                    if(pBucket[0] == STATE::EMPTY)
+                        continue;
+
+                    vFingerprints[nFile][nBucket + n] = GetFingerprint(pBucket + 13, HASHMAP_MAX_KEY_SIZE);
+                }
+            }
+        }
+
+        /* Debug output showing our fingerprint table. */
+        debug::log(0, FUNCTION, "Built Fingerprints of ", uint64_t(nFiles) * HASHMAP_TOTAL_BUCKETS,
+            " bytes for ", nFiles, " files in ", timer.ElapsedMilliseconds(), " ms");
+    }
+
+
     /* Read a key index from the disk hashmaps. */
     void BinaryHashMap::Initialize()
     {
@@ -223,6 +361,9 @@ namespace LLD
 
         /* Load the stream object into the stream LRU cache. */
         fileCache->Put(0, new std::fstream(file, std::ios::in | std::ios::out | std::ios::binary));
+
+        /* Build our in-memory fingerprints. */
+        BuildFingerprints();
     }
 
 
@@ -244,10 +385,17 @@ namespace LLD
         std::vector<uint8_t> vKeyCompressed = vKey;
         CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
 
+        /* Get the fingerprint to filter our disk reads. */
+        const uint8_t nFingerprint = GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size());
+
         /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
         std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
         for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
         {
+            /* Skip files that can't hold our key. */
+            if(Filtered(i, nBucket, nFingerprint))
+                continue;
+
             /* Find the file stream for LRU cache. */
             std::fstream *pstream;
             if(!fileCache->Get(i, pstream))
@@ -312,191 +460,39 @@ namespace LLD
     {
         LOCK(KEY_MUTEX);
 
-        /* Get the assigned bucket for the hashmap. */
-        uint32_t nBucket = GetBucket(cKey.vKey);
-
-        /* Get the file binary position. */
-        uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
-
-        /* Compress any keys larger than max size. */
-        std::vector<uint8_t> vKeyCompressed = cKey.vKey;
-        CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
-
-        /* Handle if not in append mode which will update the key. */
-        if(!(nFlags & FLAGS::APPEND))
-        {
-            /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
-            std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
-            for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
-            {
-                /* Find the file stream for LRU cache. */
-                std::fstream* pstream;
-                if(!fileCache->Get(i, pstream))
-                {
-                    std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
-
-                    /* Set the new stream pointer. */
-                    pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
-                    if(!pstream->is_open())
-                    {
-                        delete pstream;
-                        return debug::error(FUNCTION, "couldn't create hashmap object at: ",
-                            filename, " (", strerror(errno), ")");
-                    }
-
-                    /* If file not found add to LRU cache. */
-                    fileCache->Put(i, pstream);
-                }
-
-                /* Check that file is open. */
-                if(!pstream->is_open())
-                    pstream->open(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i), std::ios::in | std::ios::out | std::ios::binary);
-
-                /* Seek to the hashmap index in file. */
-                pstream->seekg (nFilePos, std::ios::beg);
-
-                /* Read the bucket binary data from file stream */
-                pstream->read((char*) &vBucket[0], vBucket.size());
-
-                /* Check if this bucket has the key or is in an empty state. */
-                if(vBucket[0] == STATE::EMPTY || std::equal(vBucket.begin() + 13, vBucket.begin() + 13 + vKeyCompressed.size(), vKeyCompressed.begin()))
-                {
-                    /* Serialize the key and return if found. */
-                    DataStream ssKey(SER_LLD, DATABASE_VERSION);
-                    ssKey << cKey;
-
-                    /* Serialize the key into the end of the vector. */
-                    ssKey.write((char*)&vKeyCompressed[0], vKeyCompressed.size());
-
-                    /* Find the file stream for LRU cache. */
-                    std::fstream* pstream;
-                    if(!fileCache->Get(i, pstream))
-                    {
-                        std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
-
-                        /* Set the new stream pointer. */
-                        pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
-                        if(!pstream->is_open())
-                        {
-                            delete pstream;
-                            return debug::error(FUNCTION, "couldn't create hashmap object at: ",
-                                filename, " (", strerror(errno), ")");
-                        }
-
-                        /* If file not found add to LRU cache. */
-                        fileCache->Put(i, pstream);
-                    }
-
-                    /* Check that file is open. */
-                    if(!pstream->is_open())
-                        pstream->open(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i), std::ios::in | std::ios::out | std::ios::binary);
-
-
-                    /* Handle the disk writing operations. */
-                    pstream->seekp (nFilePos, std::ios::beg);
-                    pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
-                    pstream->flush();
-
-
-                    /* Debug Output of Sector Key Information. */
-                    if(config::nVerbose >= 4)
-                        debug::log(4, FUNCTION, "State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
-                            " | Length: ", cKey.nLength,
-                            " | Bucket ", nBucket,
-                            " | Location: ", nFilePos,
-                            " | File: ", hashmap[nBucket] - 1,
-                            " | Sector File: ", cKey.nSectorFile,
-                            " | Sector Size: ", cKey.nSectorSize,
-                            " | Sector Start: ", cKey.nSectorStart, "\n",
-                            HexStr(vKeyCompressed.begin(), vKeyCompressed.end(), true));
-
-                    return true;
-                }
-            }
-        }
+        return put(cKey, true);
+    }
 
-        /* Create a new disk hashmap object in linked list if it doesn't exist. */
-        std::string file = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), hashmap[nBucket]);
-        if(!filesystem::exists(file))
-        {
-            /* Blank vector to write empty space in new disk file. */
-            std::vector<uint8_t> vSpace(HASHMAP_KEY_ALLOCATION, 0);
 
-            /* Write the blank data to the new file handle. */
-            std::ofstream stream(file, std::ios::out | std::ios::binary | std::ios::app);
-            if(!stream)
-                return debug::error(FUNCTION, strerror(errno));
-
-            for(uint32_t i = 0; i < HASHMAP_TOTAL_BUCKETS; ++i)
-                stream.write((char*)&vSpace[0], vSpace.size());
+    /* Write a batch of keys to the disk hashmaps. */
+    bool BinaryHashMap::Put(const std::vector<SectorKey>& vKeys)
+    {
+        LOCK(KEY_MUTEX);
 
-            //stream.flush();
-            stream.close();
-        }
+        /* Order our keys by bucket so each hashmap file is written front to back. */
+        std::vector<std::pair<uint32_t, uint32_t>> vOrder;
+        vOrder.reserve(vKeys.size());
 
-        /* Read the State and Size of Sector Header. */
-        DataStream ssKey(SER_LLD, DATABASE_VERSION);
-        ssKey << cKey;
+        for(uint32_t n = 0; n < vKeys.size(); ++n)
+            vOrder.emplace_back(GetBucket(vKeys[n].vKey), n);
 
-        /* Serialize the key into the end of the vector. */
-        ssKey.write((char*)&vKeyCompressed[0], vKeyCompressed.size());
+        std::stable_sort(vOrder.begin(), vOrder.end());
 
-        /* Find the file stream for LRU cache. */
-        std::fstream* pstream;
-        if(!fileCache->Get(hashmap[nBucket], pstream))
+        /* Write all the keys without flushing our streams. */
+        bool fSuccess = true;
+        for(const auto& pairKey : vOrder)
         {
-            /* Set the new stream pointer. */
-            pstream = new std::fstream(file, std::ios::in | std::ios::out | std::ios::binary);
-            if(!pstream->is_open())
+            if(!put(vKeys[pairKey.second], false))
             {
-                delete pstream;
-                return debug::error(FUNCTION, "Failed to generate file object");
+                fSuccess = false;
+                break;
             }
-
-            /* If not in cache, add to the LRU. */
-            fileCache->Put(hashmap[nBucket], pstream);
         }
 
-        /* Check that file is open. */
-        if(!pstream->is_open())
-            pstream->open(file, std::ios::in | std::ios::out | std::ios::binary);
+        /* Flush our hashmap files and index once for the whole batch. */
+        Flush();
 
-        /* Flush the key file to disk. */
-        pstream->seekp (nFilePos, std::ios::beg);
-        pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
-        pstream->flush();
-
-        /* Check index file handle is open. */
-        if(!pindex->is_open())
-            pindex->open(debug::safe_printstr(strBaseLocation, "_hashmap.index"), std::ios::in | std::ios::out | std::ios::binary);
-
-        /* Seek to the index position. */
-        pindex->seekp((nBucket * 2), std::ios::beg);
-
-        /* Write the index to disk. */
-        uint16_t nIndex = ++hashmap[nBucket];
-
-        /* Get the bucket data. */
-        std::vector<uint8_t> vBucket((uint8_t*)&nIndex, (uint8_t*)&nIndex + 2);
-
-        /* Write the index into hashmap. */
-        pindex->write((char*)&vBucket[0], vBucket.size());
-        pindex->flush();
-
-        /* Debug Output of Sector Key Information. */
-        if(config::nVerbose >= 4)
-            debug::log(4, FUNCTION, "State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
-                " | Length: ", cKey.nLength,
-                " | Bucket ", nBucket,
-                " | Hashmap ", hashmap[nBucket],
-                " | Location: ", nFilePos,
-                " | File: ", hashmap[nBucket] - 1,
-                " | Sector File: ", cKey.nSectorFile,
-                " | Sector Size: ", cKey.nSectorSize,
-                " | Sector Start: ", cKey.nSectorStart,
-                " | Key: ",  HexStr(vKeyCompressed.begin(), vKeyCompressed.end()));
-
-        return true;
+        return fSuccess;
     }
 
 
@@ -512,7 +508,7 @@ namespace LLD
 
         /* Iterate the linked list until end. */
         TemplateNode<uint16_t, std::fstream*>* pnode = fileCache->pfirst;
-        while(pnode && pnode->pnext)
+        while(pnode)
         {
             /* Flush to disk. */
             pnode->Data->flush();
@@ -539,10 +535,17 @@ namespace LLD
         std::vector<uint8_t> vKeyCompressed = vKey;
         CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
 
+        /* Get the fingerprint to filter our disk reads. */
+        const uint8_t nFingerprint = GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size());
+
         /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
         std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
         for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
         {
+            /* Skip files that can't hold our key. */
+            if(Filtered(i, nBucket, nFingerprint))
+                continue;
+
             /* Find the file stream for LRU cache. */
             std::fstream* pstream;
             if(!fileCache->Get(i, pstream))
@@ -578,6 +581,9 @@ namespace LLD
                 pstream->write((char*) &vEmpty[0], vEmpty.size());
                 pstream->flush();
 
+                /* Mark this bucket as empty in our fingerprints. */
+                SetFingerprint(i, nBucket, 0);
+
                 /* Debug Output of Sector Key Information. */
                 if(config::nVerbose >= 4)
                     debug::log(4, FUNCTION, "Erased State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
@@ -674,4 +680,331 @@ namespace LLD
 
         return false;
     }
+
+
+    /* Iterate all ready keys in the hashmap files with their sector locations. */
+    void BinaryHashMap::Sectors(const std::function<void (const uint16_t, const uint32_t, const SectorKey&)>& fnCallback)
+    {
+        /* Find the total number of hashmap files in use. */
+        std::vector<uint16_t> vDepth;
+        {
+            LOCK(KEY_MUTEX);
+            vDepth = hashmap;
+        }
+
+        /* Get the deepest file level. */
+        uint16_t nFiles = 0;
+        for(const auto& nDepth : vDepth)
+            nFiles = std::max(nFiles, nDepth);
+
+        /* Read the hashmap files sequentially in large chunks. */
+        const uint32_t nChunk = 16384;
+        std::vector<uint8_t> vBuffer(nChunk * HASHMAP_KEY_ALLOCATION, 0);
+        for(uint16_t nFile = 0; nFile < nFiles; ++nFile)
+        {
+            /* Open the hashmap file for reading. */
+            std::ifstream stream(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile), std::ios::in | std::ios::binary);
+            if(!stream.is_open())
+                continue;
+
+            /* Iterate the buckets in chunks. */
+            for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; nBucket += nChunk)
+            {
+                /* Read the next chunk of buckets. */
+                const uint32_t nBuckets = std::min(nChunk, HASHMAP_TOTAL_BUCKETS - nBucket);
+                if(!stream.read((char*)&vBuffer[0], nBuckets * HASHMAP_KEY_ALLOCATION))
+                    break;
+
+                /* Check every bucket in this chunk. */
+                for(uint32_t n = 0; n < nBuckets; ++n)
+                {
+                    /* Skip over buckets that don't reach this file. */
+                    if(vDepth[nBucket + n] <= nFile)
+                        continue;
+
+                    /* Skip over empty buckets. */
+                    const uint8_t* pBucket = &vBuffer[n * HASHMAP_KEY_ALLOCATION];
+                    if(pBucket[0] != STATE::READY)
+                        continue;
+
+                    /* Deserialize the key header. */
+                    DataStream ssKey(std::vector<uint8_t>(pBucket, pBucket + 13), SER_LLD, DATABASE_VERSION);
+
+                    SectorKey cKey;
+                    ssKey >> cKey;
+
+                    fnCallback(nFile, nBucket + n, cKey);
+                }
+            }
+        }
+    }
+
+
+    /* Move a key to a new sector location if it still points to its old location. */
+    bool BinaryHashMap::Relocate(const uint16_t nFile, const uint32_t nBucket, const SectorKey& cOld, const SectorKey& cNew)
+    {
+        LOCK(KEY_MUTEX);
+
+        /* Get the file binary position. */
+        const uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
+
+        /* Find the file stream for LRU cache. */
+        std::fstream* pstream;
+        if(!fileCache->Get(nFile, pstream))
+        {
+            /* Set the new stream pointer. */
+            pstream = new std::fstream(
+              debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile),
+              std::ios::in | std::ios::out | std::ios::binary);
+
+            if(!pstream->is_open())
+            {
+                delete pstream;
+                return false;
+            }
+
+            /* If file not found add to LRU cache. */
+            fileCache->Put(nFile, pstream);
+        }
+
+        /* Read the current key header from disk. */
+        std::vector<uint8_t> vBucket(13, 0);
+        pstream->seekg(nFilePos, std::ios::beg);
+        if(!pstream->read((char*) &vBucket[0], vBucket.size()))
+            return false;
+
+        /* Deserialize the key header. */
+        DataStream ssKey(vBucket, SER_LLD, DATABASE_VERSION);
+
+        SectorKey cKey;
+        ssKey >> cKey;
+
+        /* Check that the key hasn't moved since we scanned it. */
+        if(!cKey.Ready() || cKey.nSectorFile != cOld.nSectorFile
+        || cKey.nSectorStart != cOld.nSectorStart || cKey.nSectorSize != cOld.nSectorSize)
+            return false;
+
+        /* Update the location, keeping the original key length. */
+        cKey.nSectorFile  = cNew.nSectorFile;
+        cKey.nSectorStart = cNew.nSectorStart;
+        cKey.nSectorSize  = cNew.nSectorSize;
+
+        /* Serialize the new key header. */
+        DataStream ssNew(SER_LLD, DATABASE_VERSION);
+        ssNew << cKey;
+
+        /* Write the header back to disk, leaving the key bytes untouched. */
+        pstream->seekp(nFilePos, std::ios::beg);
+        pstream->write((char*)&ssNew.Bytes()[0], ssNew.size());
+        pstream->flush();
+
+        return true;
+    }
+
+
+    /* Write a key to the disk hashmaps, optionally deferring the stream flush to the caller. */
+    bool BinaryHashMap::put(const SectorKey& cKey, const bool fFlush)
+    {
+        /* Get the assigned bucket for the hashmap. */
+        uint32_t nBucket = GetBucket(cKey.vKey);
+
+        /* Get the file binary position. */
+        uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
+
+        /* Compress any keys larger than max size. */
+        std::vector<uint8_t> vKeyCompressed = cKey.vKey;
+        CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
+
+        /* Get the fingerprint to filter our disk reads. */
+        const uint8_t nFingerprint = GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size());
+
+        /* Handle if not in append mode which will update the key. */
+        if(!(nFlags & FLAGS::APPEND))
+        {
+            /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
+            std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
+            for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
+            {
+                /* Skip files that are neither empty nor holding our key. */
+                if(Filtered(i, nBucket, nFingerprint, true))
+                    continue;
+
+                /* Find the file stream for LRU cache. */
+                std::fstream* pstream;
+                if(!fileCache->Get(i, pstream))
+                {
+                    std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
+
+                    /* Set the new stream pointer. */
+                    pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
+                    if(!pstream->is_open())
+                    {
+                        delete pstream;
+                        return debug::error(FUNCTION, "couldn't create hashmap object at: ",
+                            filename, " (", strerror(errno), ")");
+                    }
+
+                    /* If file not found add to LRU cache. */
+                    fileCache->Put(i, pstream);
+                }
+
+                /* Check that file is open. */
+                if(!pstream->is_open())
+                    pstream->open(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i), std::ios::in | std::ios::out | std::ios::binary);
+
+                /* Seek to the hashmap index in file. */
+                pstream->seekg (nFilePos, std::ios::beg);
+
+                /* Read the bucket binary data from file stream */
+                pstream->read((char*) &vBucket[0], vBucket.size());
+
+                /* Check if this bucket has the key or is in an empty state. */
+                if(vBucket[0] == STATE::EMPTY || std::equal(vBucket.begin() + 13, vBucket.begin() + 13 + vKeyCompressed.size(), vKeyCompressed.begin()))
+                {
+                    /* Serialize the key and return if found. */
+                    DataStream ssKey(SER_LLD, DATABASE_VERSION);
+                    ssKey << cKey;
+
+                    /* Serialize the key into the end of the vector. */
+                    ssKey.write((char*)&vKeyCompressed[0], vKeyCompressed.size());
+
+                    /* Find the file stream for LRU cache. */
+                    std::fstream* pstream;
+                    if(!fileCache->Get(i, pstream))
+                    {
+                        std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
+
+                        /* Set the new stream pointer. */
+                        pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
+                        if(!pstream->is_open())
+                        {
+                            delete pstream;
+                            return debug::error(FUNCTION, "couldn't create hashmap object at: ",
+                                filename, " (", strerror(errno), ")");
+                        }
+
+                        /* If file not found add to LRU cache. */
+                        fileCache->Put(i, pstream);
+                    }
+
+                    /* Check that file is open. */
+                    if(!pstream->is_open())
+                        pstream->open(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i), std::ios::in | std::ios::out | std::ios::binary);
+
+
+                    /* Handle the disk writing operations. */
+                    pstream->seekp (nFilePos, std::ios::beg);
+                    pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
+                    if(fFlush)
+                        pstream->flush();
+
+                    /* Update our fingerprint for this file. */
+                    SetFingerprint(i, nBucket, nFingerprint);
+
+
+                    /* Debug Output of Sector Key Information. */
+                    if(config::nVerbose >= 4)
+                        debug::log(4, FUNCTION, "State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
+                            " | Length: ", cKey.nLength,
+                            " | Bucket ", nBucket,
+                            " | Location: ", nFilePos,
+                            " | File: ", hashmap[nBucket] - 1,
+                            " | Sector File: ", cKey.nSectorFile,
+                            " | Sector Size: ", cKey.nSectorSize,
+                            " | Sector Start: ", cKey.nSectorStart, "\n",
+                            HexStr(vKeyCompressed.begin(), vKeyCompressed.end(), true));
+
+                    return true;
+                }
+            }
+        }
+
+        /* Create a new disk hashmap object in linked list if it doesn't exist. */
+        std::string file = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), hashmap[nBucket]);
+        if(!filesystem::exists(file))
+        {
+            /* Blank vector to write empty space in new disk file. */
+            std::vector<uint8_t> vSpace(HASHMAP_KEY_ALLOCATION, 0);
+
+            /* Write the blank data to the new file handle. */
+            std::ofstream stream(file, std::ios::out | std::ios::binary | std::ios::app);
+            if(!stream)
+                return debug::error(FUNCTION, strerror(errno));
+
+            for(uint32_t i = 0; i < HASHMAP_TOTAL_BUCKETS; ++i)
+                stream.write((char*)&vSpace[0], vSpace.size());
+
+            //stream.flush();
+            stream.close();
+        }
+
+        /* Read the State and Size of Sector Header. */
+        DataStream ssKey(SER_LLD, DATABASE_VERSION);
+        ssKey << cKey;
+
+        /* Serialize the key into the end of the vector. */
+        ssKey.write((char*)&vKeyCompressed[0], vKeyCompressed.size());
+
+        /* Find the file stream for LRU cache. */
+        std::fstream* pstream;
+        if(!fileCache->Get(hashmap[nBucket], pstream))
+        {
+            /* Set the new stream pointer. */
+            pstream = new std::fstream(file, std::ios::in | std::ios::out | std::ios::binary);
+            if(!pstream->is_open())
+            {
+                delete pstream;
+                return debug::error(FUNCTION, "Failed to generate file object");
+            }
+
+            /* If not in cache, add to the LRU. */
+            fileCache->Put(hashmap[nBucket], pstream);
+        }
+
+        /* Check that file is open. */
+        if(!pstream->is_open())
+            pstream->open(file, std::ios::in | std::ios::out | std::ios::binary);
+
+        /* Flush the key file to disk. */
+        pstream->seekp (nFilePos, std::ios::beg);
+        pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
+        if(fFlush)
+            pstream->flush();
+
+        /* Add our fingerprint for the new file. */
+        SetFingerprint(hashmap[nBucket], nBucket, nFingerprint);
+
+        /* Check index file handle is open. */
+        if(!pindex->is_open())
+            pindex->open(debug::safe_printstr(strBaseLocation, "_hashmap.index"), std::ios::in | std::ios::out | std::ios::binary);
+
+        /* Seek to the index position. */
+        pindex->seekp((nBucket * 2), std::ios::beg);
+
+        /* Write the index to disk. */
+        uint16_t nIndex = ++hashmap[nBucket];
+
+        /* Get the bucket data. */
+        std::vector<uint8_t> vBucket((uint8_t*)&nIndex, (uint8_t*)&nIndex + 2);
+
+        /* Write the index into hashmap. */
+        pindex->write((char*)&vBucket[0], vBucket.size());
+        if(fFlush)
+            pindex->flush();
+
+        /* Debug Output of Sector Key Information. */
+        if(config::nVerbose >= 4)
+            debug::log(4, FUNCTION, "State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
+                " | Length: ", cKey.nLength,
+                " | Bucket ", nBucket,
+                " | Hashmap ", hashmap[nBucket],
+                " | Location: ", nFilePos,
+                " | File: ", hashmap[nBucket] - 1,
+                " | Sector File: ", cKey.nSectorFile,
+                " | Sector Size: ", cKey.nSectorSize,
+                " | Sector Start: ", cKey.nSectorStart,
+                " | Key: ",  HexStr(vKeyCompressed.begin(), vKeyCompressed.end()));
+
+        return true;
+    }
 }
@@ -29,7 +29,8 @@ namespace LLD
         READONLY      = (1 << 2),
         CREATE        = (1 << 3),
         WRITE         = (1 << 4),
-        FORCE         = (1 << 5)
+        FORCE         = (1 << 5),
+        COMPACT       = (1 << 6)  //records can be moved by compaction, don't use with BatchRead
     };
 
 
@@ -83,6 +83,14 @@ namespace LLD
     void Shutdown();
 
 
+    /** Compact
+     *
+     *  Compact the sector files of all LLD instances that allow it.
+     *
+     **/
+    void Compact();
+
+
     /** TxnRecover
      *
      *  Check the transactions for recovery.
@@ -0,0 +1,127 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_INCLUDE_MMAP_H
+#define NEXUS_LLD_INCLUDE_MMAP_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace LLD
+{
+
+    /** MemoryMap
+     *
+     *  Read-only shared memory mapping of a single sector file.
+     *
+     *  The mapping covers the file as it was sized when it was opened. Since the
+     *  mapping is shared with the page cache, in-place updates written through a
+     *  file stream are visible to readers, but appends beyond the mapped size
+     *  require a new mapping to be created.
+     *
+     **/
+    class MemoryMap
+    {
+        /* The beginning of the mapped region. */
+        uint8_t* pBegin;
+
+
+        /* The total bytes that are mapped. */
+        uint64_t nSize;
+
+
+    public:
+
+        /** Default Constructor. **/
+        MemoryMap() = delete;
+
+
+        /** Copy Constructor. **/
+        MemoryMap(const MemoryMap& map) = delete;
+
+
+        /** Move Constructor. **/
+        MemoryMap(MemoryMap&& map) = delete;
+
+
+        /** Copy Assignment Operator. **/
+        MemoryMap& operator=(const MemoryMap& map) = delete;
+
+
+        /** Move Assignment Operator. **/
+        MemoryMap& operator=(MemoryMap&& map) = delete;
+
+
+        /** Constructor
+         *
+         *  Map the given file into memory for reading.
+         *
+         *  @param[in] strPath The path of the file to map.
+         *
+         **/
+        MemoryMap(const std::string& strPath);
+
+
+        /** Default Destructor. **/
+        ~MemoryMap();
+
+
+        /** IsMapped
+         *
+         *  Check if the file was successfully mapped.
+         *
+         *  @return true if the mapping is valid.
+         *
+         **/
+        bool IsMapped() const;
+
+
+        /** Size
+         *
+         *  Get the total bytes mapped for this file.
+         *
+         *  @return the size of the mapped region.
+         *
+         **/
+        uint64_t Size() const;
+
+
+        /** Read
+         *
+         *  Copy a range of bytes out of the mapped region.
+         *
+         *  @param[in] nPos The binary position to read from.
+         *  @param[in] nLength The total bytes to read.
+         *  @param[out] vData The buffer to read into.
+         *
+         *  @return true if the range was inside the mapped region.
+         *
+         **/
+        bool Read(const uint64_t nPos, const uint64_t nLength, std::vector<uint8_t> &vData) const;
+
+    };
+
+
+    /** MemoryMapSupported
+     *
+     *  Check if memory mapped reads are supported on this platform.
+     *
+     *  @return true if we can map sector files.
+     *
+     **/
+    bool MemoryMapSupported();
+}
+
+#endif
@@ -24,6 +24,7 @@ ________________________________________________________________________________
 #include <fstream>
 #include <vector>
 #include <mutex>
+#include <functional>
 
 namespace LLD
 {
@@ -61,6 +62,10 @@ namespace LLD
         std::vector<uint16_t> hashmap;
 
 
+        /** Fingerprints of the keys held in each bucket, indexed by file then bucket. **/
+        std::vector<std::vector<uint8_t>> vFingerprints;
+
+
         /** The Maximum buckets allowed in the hashmap. */
         uint32_t HASHMAP_TOTAL_BUCKETS;
 
@@ -77,6 +82,10 @@ namespace LLD
         uint8_t nFlags;
 
 
+        /** Flag to determine if fingerprints are used to filter disk reads. **/
+        bool fFilter;
+
+
         /* The key level locking hashmap. */
         mutable std::vector<std::mutex> RECORD_MUTEX;
 
@@ -136,6 +145,55 @@ namespace LLD
         uint32_t GetBucket(const std::vector<uint8_t>& vKey);
 
 
+        /** GetFingerprint
+         *
+         *  Calculates the in-memory fingerprint of a compressed key.
+         *  A fingerprint of zero is reserved to mark an empty bucket.
+         *
+         *  @param[in] pKey Pointer to the compressed key bytes.
+         *  @param[in] nSize The length of the compressed key.
+         *
+         *  @return The fingerprint of the key.
+         *
+         **/
+        uint8_t GetFingerprint(const uint8_t* pKey, const uint16_t nSize) const;
+
+
+        /** SetFingerprint
+         *
+         *  Sets the fingerprint for a given file and bucket, allocating a new file level if needed.
+         *
+         *  @param[in] nFile The hashmap file the bucket lives in.
+         *  @param[in] nBucket The bucket to set fingerprint for.
+         *  @param[in] nFingerprint The fingerprint to set.
+         *
+         **/
+        void SetFingerprint(const uint16_t nFile, const uint32_t nBucket, const uint8_t nFingerprint);
+
+
+        /** Filtered
+         *
+         *  Determines if the fingerprint table rules out a file for a key.
+         *
+         *  @param[in] nFile The hashmap file to check.
+         *  @param[in] nBucket The bucket to check.
+         *  @param[in] nFingerprint The fingerprint of the key being searched for.
+         *  @param[in] fEmpty Flag to determine if an empty bucket is considered a match.
+         *
+         *  @return True if the file can be skipped without a disk read.
+         *
+         **/
+        bool Filtered(const uint16_t nFile, const uint32_t nBucket, const uint8_t nFingerprint, const bool fEmpty = false) const;
+
+
+        /** BuildFingerprints
+         *
+         *  Scan the hashmap files on disk to build the fingerprint table.
+         *
+         **/
+        void BuildFingerprints();
+
+
         /** Initialize
          *
          *  Initialize the binary hash map keychain.
@@ -169,6 +227,19 @@ namespace LLD
         bool Put(const SectorKey& cKey);
 
 
+        /** Put
+         *
+         *  Write a batch of keys to the disk hashmaps under a single lock, in bucket order,
+         *  flushing the hashmap files only once the whole batch is written.
+         *
+         *  @param[in] vKeys The key objects to write.
+         *
+         *  @return True if all keys were written, false otherwise.
+         *
+         **/
+        bool Put(const std::vector<SectorKey>& vKeys);
+
+
         /** Flush
          *
          *  Flush all buffers to disk if using ACID transaction.
@@ -200,6 +271,48 @@ namespace LLD
          *
          **/
         bool Erase(const std::vector<uint8_t> &vKey);
+
+
+        /** Sectors
+         *
+         *  Iterate all ready keys in the hashmap files with their sector locations.
+         *  Keys are scanned from disk without holding the key lock, so any action
+         *  taken on them needs to be verified with Relocate().
+         *
+         *  @param[in] fnCallback The function to call for each key with its file and bucket.
+         *
+         **/
+        void Sectors(const std::function<void (const uint16_t, const uint32_t, const SectorKey&)>& fnCallback);
+
+
+        /** Relocate
+         *
+         *  Move a key to a new sector location if it still points to its old location.
+         *
+         *  @param[in] nFile The hashmap file the key lives in.
+         *  @param[in] nBucket The bucket the key lives in.
+         *  @param[in] cOld The sector location the key is expected to hold.
+         *  @param[in] cNew The sector location to write into the key.
+         *
+         *  @return True if the key was relocated, false if it no longer points to the old location.
+         *
+         **/
+        bool Relocate(const uint16_t nFile, const uint32_t nBucket, const SectorKey& cOld, const SectorKey& cNew);
+
+
+    private:
+
+        /** put
+         *
+         *  Write a key to the disk hashmaps, expects KEY_MUTEX to be held.
+         *
+         *  @param[in] cKey The key object to write.
+         *  @param[in] fFlush Flag to flush our streams after the write, false when the caller flushes.
+         *
+         *  @return True if the key was written, false otherwise.
+         *
+         **/
+        bool put(const SectorKey& cKey, const bool fFlush);
     };
 }
 
@@ -29,6 +29,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/types/merkle.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/client.h>
+#include <TAO/Ledger/types/metrics.h>
 
 #include <tuple>
 
@@ -1282,6 +1283,34 @@ namespace LLD
     }
 
 
+    /* Writes the chain metrics for a bucket of time. */
+    bool LedgerDB::WriteMetrics(const uint64_t nBucket, const TAO::Ledger::Metrics& metrics)
+    {
+        return Write(std::make_pair(std::string("metrics"), nBucket), metrics);
+    }
+
+
+    /* Reads the chain metrics for a bucket of time. */
+    bool LedgerDB::ReadMetrics(const uint64_t nBucket, TAO::Ledger::Metrics &metrics)
+    {
+        return Read(std::make_pair(std::string("metrics"), nBucket), metrics);
+    }
+
+
+    /* Writes the height that the chain metrics were first indexed from. */
+    bool LedgerDB::WriteMetricsHeight(const uint32_t nHeight)
+    {
+        return Write(std::string("metrics.height"), nHeight);
+    }
+
+
+    /* Reads the height that the chain metrics were first indexed from. */
+    bool LedgerDB::ReadMetricsHeight(uint32_t &nHeight)
+    {
+        return Read(std::string("metrics.height"), nHeight);
+    }
+
+
     /* Begin a memory transaction following ACID properties. */
     void LedgerDB::MemoryBegin(const uint8_t nFlags)
     {
@@ -192,6 +192,27 @@ namespace LLD
     }
 
 
+    /* Write the txid found at a sequence number in a sigchain. */
+    bool LogicalDB::WriteSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence, const uint512_t& hashTx)
+    {
+        return Write(std::make_tuple(std::string("sigchain.index"), nSequence, hashGenesis), hashTx);
+    }
+
+
+    /* Read the txid found at a sequence number in a sigchain. */
+    bool LogicalDB::ReadSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence, uint512_t &hashTx)
+    {
+        return Read(std::make_tuple(std::string("sigchain.index"), nSequence, hashGenesis), hashTx);
+    }
+
+
+    /* Erase the txid found at a sequence number in a sigchain. */
+    bool LogicalDB::EraseSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence)
+    {
+        return Erase(std::make_tuple(std::string("sigchain.index"), nSequence, hashGenesis));
+    }
+
+
     /* Push an register transaction to process for given genesis-id. */
     bool LogicalDB::PushTransaction(const uint256_t& hashRegister, const uint512_t& hashTx)
     {
@@ -273,6 +294,10 @@ namespace LLD
         if(!Write(std::make_tuple(std::string("register.tx.index"), (nOwnerSequence % 5), hashRegister), hashTx))
             return false;
 
+        /* Add our full history entry so that any sequence can be seeked to. */
+        if(!Write(std::make_tuple(std::string("register.tx.history"), nOwnerSequence, hashRegister), hashTx))
+            return false;
+
         /* Write our new events sequence to disk. */
         if(!Write(std::make_pair(std::string("register.tx.sequence"), hashRegister), ++nOwnerSequence))
             return false;
@@ -295,6 +320,10 @@ namespace LLD
         if(!Erase(std::make_tuple(std::string("register.tx.index"), (--nOwnerSequence % 5), hashRegister)))
             return false;
 
+        /* Erase our full history entry. */
+        if(!Erase(std::make_tuple(std::string("register.tx.history"), nOwnerSequence, hashRegister)))
+            return false;
+
         /* Write our new events sequence to disk. */
         if(!Write(std::make_pair(std::string("register.tx.sequence"), hashRegister), nOwnerSequence))
             return false;
@@ -321,6 +350,20 @@ namespace LLD
     }
 
 
+    /* Get the txid that modified a register at a given sequence number. */
+    bool LogicalDB::ReadRegisterTx(const uint256_t& hashRegister, const uint32_t nSequence, uint512_t &hashTx)
+    {
+        return Read(std::make_tuple(std::string("register.tx.history"), nSequence, hashRegister), hashTx);
+    }
+
+
+    /* Get the number of transactions that modified a register. */
+    bool LogicalDB::ReadRegisterSequence(const uint256_t& hashRegister, uint32_t &nSequence)
+    {
+        return Read(std::make_pair(std::string("register.tx.sequence"), hashRegister), nSequence);
+    }
+
+
     /* Push an register to process for given genesis-id. */
     bool LogicalDB::PushRegister(const uint256_t& hashGenesis, const uint256_t& hashRegister)
     {
@@ -983,6 +1026,10 @@ namespace LLD
         if(!Write(std::make_pair(nMarketSequence, pairMarket), std::make_pair(hashTx, nContract)))
             return false;
 
+        /* Map our order back to its market and sequence for when it is closed or re-opened. */
+        if(!Write(std::make_tuple(std::string("order.market"), hashTx, nContract), std::make_pair(pairMarket, nMarketSequence)))
+            return false;
+
         /* Add an additional indexing entry for owner level orders. */
         if(!Index(std::make_pair(nOwnerSequence, hashOwner), std::make_pair(nMarketSequence, pairMarket)))
             return false;
@@ -1234,6 +1281,88 @@ namespace LLD
     }
 
 
+    /* List the open orders for given market pair. */
+    bool LogicalDB::ListOpenOrders(const std::pair<uint256_t, uint256_t>& pairMarket, std::vector<std::pair<uint512_t, uint32_t>> &vOrders)
+    {
+        /* Start from the first order that could still be open. */
+        uint32_t nSequence = 0;
+        Read(std::make_pair(std::string("market.first"), pairMarket), nSequence);
+
+        /* Cache our txid and contract as a pair. */
+        std::pair<uint512_t, uint32_t> pairOrder;
+
+        /* Loop until we have failed. */
+        while(!config::fShutdown.load()) //we want to early terminate on shutdown
+        {
+            /* Read our current record. */
+            if(!Read(std::make_pair(nSequence++, pairMarket), pairOrder))
+                break;
+
+            /* Skip over orders that have been claimed. */
+            if(LLD::Contract->HasContract(pairOrder))
+                continue;
+
+            vOrders.push_back(pairOrder);
+        }
+
+        return !vOrders.empty();
+    }
+
+
+    /* Reads the market-pair an order was pushed to. */
+    bool LogicalDB::ReadOrder(const uint512_t& hashTx, const uint32_t nContract, std::pair<uint256_t, uint256_t> &pairMarket)
+    {
+        /* Read our market and sequence. */
+        std::pair<std::pair<uint256_t, uint256_t>, uint32_t> pairIndex;
+        if(!Read(std::make_tuple(std::string("order.market"), hashTx, nContract), pairIndex))
+            return false;
+
+        /* Set our market pair. */
+        pairMarket = pairIndex.first;
+
+        return true;
+    }
+
+
+    /* Moves the first open order of a market past any orders that have been executed or cancelled. */
+    bool LogicalDB::CloseOrder(const std::pair<uint256_t, uint256_t>& pairMarket)
+    {
+        /* Get our current first open order. */
+        uint32_t nFirst = 0;
+        Read(std::make_pair(std::string("market.first"), pairMarket), nFirst);
+
+        /* Move past any claimed orders, checking the claims since they could have been disconnected. */
+        uint32_t nSequence = nFirst;
+
+        std::pair<uint512_t, uint32_t> pairOrder;
+        while(Read(std::make_pair(nSequence, pairMarket), pairOrder) && LLD::Contract->HasContract(pairOrder))
+            ++nSequence;
+
+        /* Check that we have moved forward. */
+        if(nSequence == nFirst)
+            return true;
+
+        return Write(std::make_pair(std::string("market.first"), pairMarket), nSequence);
+    }
+
+
+    /* Re-opens an order when the contract that claimed it has been disconnected. */
+    bool LogicalDB::ReopenOrder(const uint512_t& hashTx, const uint32_t nContract, const std::pair<uint256_t, uint256_t>& pairMarket)
+    {
+        /* Get the sequence of our order, starting at the beginning of our market if it was indexed before it was mapped. */
+        std::pair<std::pair<uint256_t, uint256_t>, uint32_t> pairIndex = std::make_pair(pairMarket, 0);
+        Read(std::make_tuple(std::string("order.market"), hashTx, nContract), pairIndex);
+
+        /* Move our first open order back if we were already past this order. */
+        uint32_t nFirst = 0;
+        Read(std::make_pair(std::string("market.first"), pairMarket), nFirst);
+        if(pairIndex.second < nFirst)
+            return Write(std::make_pair(std::string("market.first"), pairMarket), pairIndex.second);
+
+        return true;
+    }
+
+
     /* Checks if an order has been indexed in the database already. */
     bool LogicalDB::HasOrder(const uint512_t& hashTx, const uint32_t nContract)
     {
@@ -1269,7 +1398,7 @@ namespace LLD
     }
 
 
-    /* Build indexes for transactions over a rolling modulus. For -indexregister flag. */
+    /* Build indexes for transactions over a rolling modulus and full history. For -indexregister flag. */
     void LogicalDB::IndexRegisters()
     {
         /* Not allowed in -client mode. */
@@ -0,0 +1,121 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/mmap.h>
+
+#include <Util/include/debug.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <cstring>
+#include <cerrno>
+
+namespace LLD
+{
+
+    /* Map the given file into memory for reading. */
+    MemoryMap::MemoryMap(const std::string& strPath)
+    : pBegin (nullptr)
+    , nSize  (0)
+    {
+    #ifndef WIN32
+        /* Open our file descriptor, it can be closed once the mapping is created. */
+        const int nFile = open(strPath.c_str(), O_RDONLY);
+        if(nFile < 0)
+        {
+            debug::error(FUNCTION, "failed to open ", strPath, ": ", strerror(errno));
+            return;
+        }
+
+        /* Get the current size of our file. */
+        struct stat statbuf;
+        if(fstat(nFile, &statbuf) != 0 || statbuf.st_size <= 0)
+        {
+            close(nFile);
+            return;
+        }
+
+        /* Map the file as shared so that in-place updates are visible to us. */
+        void* pMap = mmap(nullptr, statbuf.st_size, PROT_READ, MAP_SHARED, nFile, 0);
+        close(nFile);
+
+        /* Check for mapping failures. */
+        if(pMap == MAP_FAILED)
+        {
+            debug::error(FUNCTION, "failed to map ", strPath, ": ", strerror(errno));
+            return;
+        }
+
+        /* Sector reads are random access, don't waste the page cache on read-ahead. */
+        madvise(pMap, statbuf.st_size, MADV_RANDOM);
+
+        /* Set our internal values now. */
+        pBegin = static_cast<uint8_t*>(pMap);
+        nSize  = static_cast<uint64_t>(statbuf.st_size);
+    #endif
+    }
+
+
+    /* Default Destructor. */
+    MemoryMap::~MemoryMap()
+    {
+    #ifndef WIN32
+        if(pBegin)
+            munmap(pBegin, nSize);
+    #endif
+    }
+
+
+    /* Check if the file was successfully mapped. */
+    bool MemoryMap::IsMapped() const
+    {
+        return pBegin != nullptr;
+    }
+
+
+    /* Get the total bytes mapped for this file. */
+    uint64_t MemoryMap::Size() const
+    {
+        return nSize;
+    }
+
+
+    /* Copy a range of bytes out of the mapped region. */
+    bool MemoryMap::Read(const uint64_t nPos, const uint64_t nLength, std::vector<uint8_t> &vData) const
+    {
+        /* Check our ranges are within the mapping. */
+        if(!pBegin || nPos > nSize || nLength > nSize - nPos)
+            return false;
+
+        /* Copy our bytes out. */
+        vData.assign(pBegin + nPos, pBegin + nPos + nLength);
+
+        return true;
+    }
+
+
+    /* Check if memory mapped reads are supported on this platform. */
+    bool MemoryMapSupported()
+    {
+    #ifndef WIN32
+        return true;
+    #else
+        return false;
+    #endif
+    }
+}
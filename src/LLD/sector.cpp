@@ -22,7 +22,9 @@ ________________________________________________________________________________
 #include <Util/include/filesystem.h>
 #include <Util/include/hex.h>
 
+#include <algorithm>
 #include <functional>
+#include <tuple>
 
 namespace LLD
 {
@@ -37,6 +39,9 @@ namespace LLD
     , SECTOR_MUTEX()
     , BUFFER_MUTEX()
     , TRANSACTION_MUTEX()
+    , COMPACTOR_MUTEX()
+    , MAPPING_MUTEX()
+    , COMPACT_MUTEX()
     , strBaseLocation(config::GetDataDir() + strNameIn + "/datachain/")
     , strName(strNameIn)
     , runtime()
@@ -44,10 +49,14 @@ namespace LLD
     , pSectorKeys(new KeychainType((config::GetDataDir() + strName + "/keychain/"), nFlagsIn, nBucketsIn))
     , cachePool(new CacheType(nCacheIn))
     , fileCache(new TemplateLRU<uint32_t, std::fstream*>(8))
+    , mapMemory()
     , nCurrentFile(0)
     , nCurrentFileSize(0)
     , CacheWriterThread()
     , MeterThread()
+    , CompactorThread()
+    , nReaders()
+    , nReadEpoch(0)
     , vDiskBuffer()
     , nBufferBytes(0)
     , nBytesRead(0)
@@ -56,6 +65,7 @@ namespace LLD
     , fDestruct(false)
     , fInitialized(false)
     , nFlags(nFlagsIn)
+    , fMemoryMap(config::GetBoolArg("-lldmmap", false) && MemoryMapSupported())
     {
         /* Set readonly flag if write or append are not specified. */
         if(!(nFlags & FLAGS::FORCE) && !(nFlags & FLAGS::WRITE) && !(nFlags & FLAGS::APPEND))
@@ -72,6 +82,7 @@ namespace LLD
 
         CacheWriterThread = std::thread(std::bind(&SectorDatabase::CacheWriter, this));
         MeterThread = std::thread(std::bind(&SectorDatabase::Meter, this));
+        CompactorThread = std::thread(std::bind(&SectorDatabase::Compactor, this));
     }
 
 
@@ -88,6 +99,9 @@ namespace LLD
         if(MeterThread.joinable())
             MeterThread.join();
 
+        if(CompactorThread.joinable())
+            CompactorThread.join();
+
         if(pTransaction)
             delete pTransaction;
 
@@ -157,10 +171,25 @@ namespace LLD
         if(cachePool->Get(vKey, vData))
             return true;
 
+        /* Count our read until we are done with its location, so compaction can't release the file under us. */
+        const ReadEpoch tEpoch(*this);
+
         /* Get the key from the keychain. */
         SectorKey cKey;
         if(pSectorKeys->Get(vKey, cKey))
         {
+            /* Get compact size from record. */
+            const uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
+
+            /* Read from our memory mapped file without locking the sector mutex. */
+            const std::shared_ptr<MemoryMap> pMap = GetMapping(cKey.nSectorFile, cKey.nSectorStart + cKey.nSectorSize);
+            if(pMap)
+            {
+                /* Copy the record out of the mapping. */
+                if(!pMap->Read(cKey.nSectorStart + nSize, cKey.nSectorSize - nSize, vData))
+                    return debug::error(FUNCTION, "record out of range of mapped file ", cKey.nSectorFile);
+            }
+            else
             {
                 LOCK(SECTOR_MUTEX);
 
@@ -184,9 +213,6 @@ namespace LLD
                 if(!pstream->is_open())
                     pstream->open(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), cKey.nSectorFile), std::ios::in | std::ios::out | std::ios::binary);
 
-                /* Get compact size from record. */
-                uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
-
                 /* Seek to the Sector Position on Disk. */
                 pstream->seekg(cKey.nSectorStart + nSize, std::ios::beg);
 
@@ -219,15 +245,31 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Get(const SectorKey& cKey, std::vector<uint8_t>& vData)
     {
+        /* Check the cache pool for key first. */
+        if(cachePool->Get(cKey.vKey, vData))
+            return true;
+
+        /* Count our read until we are done with its location, so compaction can't release the file under us. */
+        const ReadEpoch tEpoch(*this);
+
+        /* Read from our memory mapped file without locking the sector mutex. */
+        const std::shared_ptr<MemoryMap> pMap = GetMapping(cKey.nSectorFile, cKey.nSectorStart + cKey.nSectorSize);
+        if(pMap)
+        {
+            nBytesRead += static_cast<uint32_t>(cKey.vKey.size() + cKey.nSectorSize);
+
+            /* Get compact size from record. */
+            const uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
+
+            /* Copy the record out of the mapping. */
+            return pMap->Read(cKey.nSectorStart + nSize, cKey.nSectorSize - nSize, vData);
+        }
+
         {
             LOCK(SECTOR_MUTEX);
 
             nBytesRead += static_cast<uint32_t>(cKey.vKey.size() + vData.size());
 
-            /* Check the cache pool for key first. */
-            if(cachePool->Get(cKey.vKey, vData))
-                return true;
-
             /* Find the file stream for LRU cache. */
             std::fstream *pstream;
             if(!fileCache->Get(cKey.nSectorFile, pstream))
@@ -271,10 +313,56 @@ namespace LLD
     }
 
 
+    /*  Get the memory mapping of a sector file. */
+    template<class KeychainType, class CacheType>
+    std::shared_ptr<MemoryMap> SectorDatabase<KeychainType, CacheType>::GetMapping(const uint32_t nFile, const uint64_t nRequired)
+    {
+        /* Check that memory mapping is enabled. */
+        if(!fMemoryMap)
+            return nullptr;
+
+        /* Check for an existing mapping that covers our range. */
+        {
+            std::shared_lock<std::shared_mutex> lock(MAPPING_MUTEX);
+
+            /* Readers hold their own reference, so a remap never invalidates a read in progress. */
+            const auto it = mapMemory.find(nFile);
+            if(it != mapMemory.end() && it->second->Size() >= nRequired)
+                return it->second;
+        }
+
+        /* Map under the exclusive lock so that files can't be truncated while being mapped. */
+        std::unique_lock<std::shared_mutex> lock(MAPPING_MUTEX);
+
+        /* Check if another thread already mapped a large enough region. */
+        const auto it = mapMemory.find(nFile);
+        if(it != mapMemory.end() && it->second->Size() >= nRequired)
+            return it->second;
+
+        /* Map the file again to pick up any data appended since last mapped. */
+        const std::shared_ptr<MemoryMap> pMap = std::make_shared<MemoryMap>
+        (
+            debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile)
+        );
+
+        /* Check that our new mapping is valid. */
+        if(!pMap->IsMapped() || pMap->Size() < nRequired)
+            return nullptr;
+
+        /* Replace our previous mapping, readers still using it hold their own reference. */
+        mapMemory[nFile] = pMap;
+
+        return pMap;
+    }
+
+
     /*  Update a record on disk. */
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
     {
+        /* Don't let our record move while we are updating it. */
+        RECURSIVE(COMPACT_MUTEX);
+
         /* Check the keychain for key. */
         SectorKey key;
         if(!pSectorKeys->Get(vKey, key))
@@ -343,6 +431,9 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Force(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
     {
+        /* Don't let our record move while we are writing it. */
+        RECURSIVE(COMPACT_MUTEX);
+
         if(nFlags & FLAGS::APPEND || !Update(vKey, vData))
         {
 
@@ -430,6 +521,259 @@ namespace LLD
     }
 
 
+    /*  Write a batch of records to disk with one append per sector file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Flush(const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords)
+    {
+        /* Don't let any records move while we are writing them. */
+        RECURSIVE(COMPACT_MUTEX);
+
+        /* Only the last write of a key needs to reach the disk, unless we are keeping every version. */
+        std::map<std::vector<uint8_t>, uint32_t> mapLatest;
+
+        uint64_t nTotal = 0;
+        for(uint32_t nIndex = 0; nIndex < vRecords.size(); ++nIndex)
+        {
+            if(!(nFlags & FLAGS::APPEND))
+                mapLatest[vRecords[nIndex].first] = nIndex;
+
+            nTotal += vRecords[nIndex].second.size() + GetSizeOfCompactSize(vRecords[nIndex].second.size());
+        }
+
+        /* Build our contiguous append buffer and the keys that will point into it. */
+        DataStream ssAppend(SER_LLD, DATABASE_VERSION);
+        ssAppend.reserve(std::min(nTotal, uint64_t(MAX_SECTOR_FILE_SIZE)));
+
+        std::vector<SectorKey> vKeys;
+        std::vector<uint32_t>  vAppended;
+
+        std::vector<std::pair<SectorKey, uint32_t>> vUpdates;
+        for(uint32_t nIndex = 0; nIndex < vRecords.size(); ++nIndex)
+        {
+            const std::vector<uint8_t>& vKey  = vRecords[nIndex].first;
+            const std::vector<uint8_t>& vData = vRecords[nIndex].second;
+
+            /* Skip over records that are written again later in this batch. */
+            if(!(nFlags & FLAGS::APPEND) && mapLatest[vKey] != nIndex)
+                continue;
+
+            /* Records that keep their size are updated in place. */
+            if(!(nFlags & FLAGS::APPEND))
+            {
+                SectorKey key;
+                if(pSectorKeys->Get(vKey, key) && key.nSectorSize == vData.size() + GetSizeOfCompactSize(vData.size()))
+                {
+                    vUpdates.emplace_back(key, nIndex);
+                    continue;
+                }
+            }
+
+            /* Write out our buffer and create a new file if above current file size. */
+            if(nCurrentFileSize + ssAppend.size() > MAX_SECTOR_FILE_SIZE)
+            {
+                if(!Append(ssAppend))
+                    return false;
+
+                ssAppend.clear();
+
+                LOCK(SECTOR_MUTEX);
+
+                debug::log(4, FUNCTION, "allocating new sector file ", nCurrentFile + 1);
+
+                ++nCurrentFile;
+                nCurrentFileSize = 0;
+
+                std::ofstream stream
+                (
+                    debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile),
+                    std::ios::out | std::ios::binary | std::ios::trunc
+                );
+                stream.close();
+            }
+
+            /* Get current size */
+            const uint64_t nSize =
+                (vData.size() + GetSizeOfCompactSize(vData.size()));
+
+            /* Create a new Sector Key pointing to where this record will be appended. */
+            vKeys.emplace_back(STATE::READY, vKey, static_cast<uint16_t>(nCurrentFile),
+                            static_cast<uint32_t>(nCurrentFileSize + ssAppend.size()), static_cast<uint32_t>(nSize));
+            vAppended.push_back(nIndex);
+
+            /* Write the record into our append buffer. */
+            WriteCompactSize(ssAppend, vData.size());
+            ssAppend.write((char*) &vData[0], vData.size());
+        }
+
+        /* Write the remaining records, they must be on disk before their keys are. */
+        if(!Append(ssAppend))
+            return false;
+
+        /* Write our records that are updated in place. */
+        if(!Update(vUpdates, vRecords))
+            return false;
+
+        /* Assign the keys to the keychain in one batch. */
+        if(!pSectorKeys->Put(vKeys))
+            return debug::error(FUNCTION, "failed to write keys to keychain");
+
+        /* Write the data into the memory cache. */
+        for(uint32_t nIndex = 0; nIndex < vKeys.size(); ++nIndex)
+            cachePool->Put(vKeys[nIndex], vRecords[vAppended[nIndex]].first, vRecords[vAppended[nIndex]].second, false);
+
+        /* Records flushed indicator. */
+        nRecordsFlushed += static_cast<uint32_t>(vKeys.size());
+
+        return true;
+    }
+
+
+    /*  Update a batch of records in place, with one flush per sector file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Update(std::vector<std::pair<SectorKey, uint32_t>>& vUpdates,
+        const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords)
+    {
+        /* Check that we have anything to write. */
+        if(vUpdates.empty())
+            return true;
+
+        /* Order our updates by their position on disk. */
+        std::sort(vUpdates.begin(), vUpdates.end(),
+            [](const std::pair<SectorKey, uint32_t>& a, const std::pair<SectorKey, uint32_t>& b)
+            {
+                if(a.first.nSectorFile != b.first.nSectorFile)
+                    return a.first.nSectorFile < b.first.nSectorFile;
+
+                return a.first.nSectorStart < b.first.nSectorStart;
+            }
+        );
+
+        LOCK(SECTOR_MUTEX);
+
+        /* Records that are next to each other on disk are written as one run. */
+        DataStream ssRun(SER_LLD, DATABASE_VERSION);
+
+        std::fstream* pstream = nullptr;
+        uint32_t nFile  = 0;
+        uint64_t nStart = 0;
+        for(uint32_t nIndex = 0; nIndex <= vUpdates.size(); ++nIndex)
+        {
+            /* Write our run once the next record doesn't follow it. */
+            const bool fEnd = (nIndex == vUpdates.size());
+            if(ssRun.size() > 0 && (fEnd || vUpdates[nIndex].first.nSectorFile != nFile
+                || vUpdates[nIndex].first.nSectorStart != nStart + ssRun.size()))
+            {
+                pstream->seekp(nStart, std::ios::beg);
+                if(!pstream->write((char*) &ssRun.Bytes()[0], ssRun.size()))
+                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", ssRun.size(), " bytes written");
+
+                ssRun.clear();
+
+                /* Flush once we are done with this file, rather than once per record as Force does. */
+                if(fEnd || vUpdates[nIndex].first.nSectorFile != nFile)
+                    pstream->flush();
+            }
+
+            /* Check for the end of our updates. */
+            if(fEnd)
+                break;
+
+            /* Get our key and data. */
+            const SectorKey& key = vUpdates[nIndex].first;
+            const std::vector<uint8_t>& vData = vRecords[vUpdates[nIndex].second].second;
+
+            /* Find the file stream when we move to a new file. */
+            if(!pstream || key.nSectorFile != nFile)
+            {
+                nFile = key.nSectorFile;
+                if(!fileCache->Get(nFile, pstream))
+                {
+                    /* Set the new stream pointer. */
+                    pstream = new std::fstream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile), std::ios::in | std::ios::out | std::ios::binary);
+                    if(!pstream->is_open())
+                    {
+                        delete pstream;
+                        return debug::error(FUNCTION, "couldn't open stream file ", nFile);
+                    }
+
+                    /* If file not found add to LRU cache. */
+                    fileCache->Put(nFile, pstream);
+                }
+
+                /* Check stream file is still open. */
+                if(!pstream->is_open())
+                    pstream->open(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile), std::ios::in | std::ios::out | std::ios::binary);
+            }
+
+            /* Start a new run at this record. */
+            if(ssRun.size() == 0)
+                nStart = key.nSectorStart;
+
+            /* Write the record into our run. */
+            WriteCompactSize(ssRun, vData.size());
+            ssRun.write((char*) &vData[0], vData.size());
+
+            /* Write the data into the memory cache. */
+            cachePool->Put(key, vRecords[vUpdates[nIndex].second].first, vData, false);
+
+            /* Records flushed indicator. */
+            ++nRecordsFlushed;
+            nBytesWrote += static_cast<uint32_t>(vData.size());
+        }
+
+        return true;
+    }
+
+
+    /*  Append a contiguous buffer of records to the end of the current sector file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Append(const DataStream& ssData)
+    {
+        /* Check that we have anything to write. */
+        if(ssData.size() == 0)
+            return true;
+
+        LOCK(SECTOR_MUTEX);
+
+        /* Find the file stream for LRU cache. */
+        std::fstream* pstream;
+        if(!fileCache->Get(nCurrentFile, pstream))
+        {
+            /* Set the new stream pointer. */
+            pstream = new std::fstream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile), std::ios::in | std::ios::out | std::ios::binary);
+            if(!pstream->is_open())
+            {
+                delete pstream;
+                return debug::error(FUNCTION, "couldn't create stream file");
+            }
+
+            /* If file not found add to LRU cache. */
+            fileCache->Put(nCurrentFile, pstream);
+        }
+
+        /* Check stream file is still open. */
+        if(!pstream->is_open())
+            pstream->open(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile), std::ios::in | std::ios::out | std::ios::binary);
+
+        /* Write all of our records with a single write. */
+        pstream->seekp(nCurrentFileSize, std::ios::beg);
+        if(!pstream->write((char*) &ssData.Bytes()[0], ssData.size()))
+            return debug::error(FUNCTION, "only ", pstream->gcount(), "/", ssData.size(), " bytes written");
+
+        pstream->flush();
+
+        /* Increment the current filesize */
+        nCurrentFileSize += static_cast<uint32_t>(ssData.size());
+        nBytesWrote      += static_cast<uint32_t>(ssData.size());
+
+        /* Verbose output. */
+        if(config::nVerbose >= 5)
+            debug::log(5, FUNCTION, "Current File: ", nCurrentFile, " | Appended ", ssData.size(), " bytes");
+
+        return true;
+    }
+
+
     /*  Write a record into the cache and disk buffer for flushing to disk. */
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Put(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
@@ -464,6 +808,9 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Delete(const std::vector<uint8_t>& vKey)
     {
+        /* Don't let our record move while we are deleting it. */
+        RECURSIVE(COMPACT_MUTEX);
+
         /* Check the keychain for key. */
         SectorKey key;
         if(!pSectorKeys->Get(vKey, key))
@@ -552,10 +899,12 @@ namespace LLD
                 return;
 
             /* Check for data to be written. */
-            std::unique_lock<std::mutex> CONDITION_LOCK(CONDITION_MUTEX);
-            CONDITION.wait(CONDITION_LOCK, [this]{ return fDestruct.load() || nBufferBytes.load() > 0; });
+            {
+                std::unique_lock<std::mutex> CONDITION_LOCK(CONDITION_MUTEX);
+                CONDITION.wait(CONDITION_LOCK, [this]{ return fDestruct.load() || nBufferBytes.load() > 0; });
+            }
 
-            /* Swap the buffer object to get ready for writes. */
+            /* Swap the buffer object so that writers can fill the next buffer while we flush this one. */
             std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> > vIndexes;
             {
                 LOCK(BUFFER_MUTEX);
@@ -564,33 +913,13 @@ namespace LLD
                 nBufferBytes = 0;
             }
 
-            /* Create a new file if the sector file size is over file size limits. */
-            if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
-            {
-                debug::log(0, FUNCTION, "allocating new sector file ", nCurrentFile + 1);
-
-                /* Iterate the current file and reset current file sie. */
-                ++nCurrentFile;
-                nCurrentFileSize = 0;
-
-                /* Create a new file for next writes. */
-                std::fstream stream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile), std::ios::out | std::ios::binary | std::ios::trunc);
-                stream.close();
-            }
-
-            /* Iterate through buffer to queue disk writes. */
-            for(const auto& vObj : vIndexes)
-            {
-                /* Force write data. */
-                Force(vObj.first, vObj.second);
-
-                /* Set no longer reserved in cache pool. */
-                cachePool->Reserve(vObj.first, false);
-            }
-
-            /* Notify the condition. */
+            /* Let any writers waiting on a full buffer continue. */
             CONDITION.notify_all();
 
+            /* Write the whole buffer as one batch. */
+            if(!Flush(vIndexes))
+                debug::error(FUNCTION, strBaseLocation, " failed to flush ", vIndexes.size(), " records");
+
             /* Verbose logging. */
             debug::log(3, FUNCTION, "Flushed ", nRecordsFlushed.load(),
                 " Records of ", nBytesWrote.load(), " Bytes");
@@ -644,6 +973,282 @@ namespace LLD
     }
 
 
+    /*  Rewrite the live records of the sparsest sector file into the current append file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Compact(const bool fOffline)
+    {
+        /* Check that we are able to write, and that our records are allowed to move. */
+        if((nFlags & FLAGS::READONLY) || !(nFlags & FLAGS::COMPACT))
+            return false;
+
+        /* Only one compaction can run at a time. */
+        LOCK(COMPACTOR_MUTEX);
+
+        /* We never compact the file we are appending to, which is read under our sector lock since appends move it. */
+        uint32_t nAppendFile = 0;
+        {
+            LOCK(SECTOR_MUTEX);
+            nAppendFile = nCurrentFile;
+        }
+
+        if(nAppendFile == 0)
+            return false;
+
+        /* Tally the live bytes held in each sealed sector file. */
+        std::map<uint32_t, uint64_t> mapLive;
+        pSectorKeys->Sectors([&](const uint16_t nFile, const uint32_t nBucket, const SectorKey& cKey)
+        {
+            if(cKey.nSectorSize > 0 && cKey.nSectorFile < nAppendFile)
+                mapLive[cKey.nSectorFile] += cKey.nSectorSize;
+        });
+
+        /* Find the sparsest file, and any files that have nothing left. */
+        std::vector<uint32_t> vEmpty;
+        uint32_t nCompact = nAppendFile;
+        uint64_t nLowest  = MIN_SECTOR_LIVE_PERCENT;
+        for(uint32_t nFile = 0; nFile < nAppendFile; ++nFile)
+        {
+            /* Skip over files that were already truncated. */
+            const int64_t nSize =
+                filesystem::size(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile));
+
+            if(nSize <= 0)
+                continue;
+
+            /* Files with nothing left are released below. */
+            if(mapLive[nFile] == 0)
+            {
+                vEmpty.push_back(nFile);
+                continue;
+            }
+
+            /* Check for the lowest percentage of live data. */
+            const uint64_t nPercent = (mapLive[nFile] * 100) / nSize;
+            if(nPercent < nLowest)
+            {
+                nCompact = nFile;
+                nLowest  = nPercent;
+            }
+        }
+
+        /* Release empty files once any readers of their old locations are done. */
+        if(!vEmpty.empty())
+        {
+            WaitReaders();
+            for(const uint32_t nFile : vEmpty)
+                Truncate(nFile);
+        }
+
+        /* Check that we found a file worth compacting. */
+        if(nCompact == nAppendFile)
+            return false;
+
+        /* Gather the keys that point into this file. */
+        std::vector<std::tuple<uint16_t, uint32_t, SectorKey>> vKeys;
+        pSectorKeys->Sectors([&](const uint16_t nFile, const uint32_t nBucket, const SectorKey& cKey)
+        {
+            if(cKey.nSectorSize > 0 && cKey.nSectorFile == nCompact)
+                vKeys.emplace_back(nFile, nBucket, cKey);
+        });
+
+        /* Sort by sector position so that the file is read sequentially. */
+        std::sort(vKeys.begin(), vKeys.end(), [](const auto& a, const auto& b)
+        {
+            return std::get<2>(a).nSectorStart < std::get<2>(b).nSectorStart;
+        });
+
+        debug::log(0, FUNCTION, strName, " compacting sector file ", nCompact, " with ", nLowest, "% live data in ", vKeys.size(), " keys");
+
+        /* Track records that were already moved, since multiple keys can share a sector. */
+        std::map<uint32_t, SectorKey> mapMoved;
+
+        /* Relocate our records in batches so writers are only briefly held up. */
+        uint32_t nRelocated = 0;
+        for(uint64_t nIndex = 0; nIndex < vKeys.size(); )
+        {
+            /* Stop early on shutdown, any records not yet moved are still valid. */
+            if(fDestruct.load() && !fOffline)
+                return false;
+
+            RECURSIVE(COMPACT_MUTEX);
+
+            const uint64_t nEnd = std::min(nIndex + MAX_SECTOR_COMPACT_BATCH, uint64_t(vKeys.size()));
+            for( ; nIndex < nEnd; ++nIndex)
+            {
+                const uint16_t   nHashFile = std::get<0>(vKeys[nIndex]);
+                const uint32_t   nBucket   = std::get<1>(vKeys[nIndex]);
+                const SectorKey& cOld      = std::get<2>(vKeys[nIndex]);
+
+                /* Copy the record to the end of our append file if it wasn't already moved. */
+                if(!mapMoved.count(cOld.nSectorStart))
+                {
+                    LOCK(SECTOR_MUTEX);
+
+                    /* Read the full record, including its compact size. */
+                    std::ifstream stream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCompact), std::ios::in | std::ios::binary);
+                    std::vector<uint8_t> vRecord(cOld.nSectorSize, 0);
+
+                    stream.seekg(cOld.nSectorStart, std::ios::beg);
+                    if(!stream.read((char*) &vRecord[0], vRecord.size()))
+                        return debug::error(FUNCTION, "only ", stream.gcount(), "/", vRecord.size(), " bytes read");
+
+                    /* Create new file if above current file size. */
+                    if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
+                    {
+                        debug::log(4, FUNCTION, "allocating new sector file ", nCurrentFile + 1);
+
+                        ++nCurrentFile;
+                        nCurrentFileSize = 0;
+
+                        std::ofstream stream
+                        (
+                            debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile),
+                            std::ios::out | std::ios::binary | std::ios::trunc
+                        );
+                        stream.close();
+                    }
+
+                    /* Find the file stream for LRU cache. */
+                    std::fstream* pstream;
+                    if(!fileCache->Get(nCurrentFile, pstream))
+                    {
+                        /* Set the new stream pointer. */
+                        pstream = new std::fstream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile), std::ios::in | std::ios::out | std::ios::binary);
+                        if(!pstream->is_open())
+                        {
+                            delete pstream;
+                            return false;
+                        }
+
+                        /* If file not found add to LRU cache. */
+                        fileCache->Put(nCurrentFile, pstream);
+                    }
+
+                    /* Append the record as is. */
+                    pstream->seekp(nCurrentFileSize, std::ios::beg);
+                    if(!pstream->write((char*) &vRecord[0], vRecord.size()))
+                        return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vRecord.size(), " bytes written");
+
+                    pstream->flush();
+
+                    /* Track our new location. */
+                    SectorKey cNew = cOld;
+                    cNew.nSectorFile  = static_cast<uint16_t>(nCurrentFile);
+                    cNew.nSectorStart = nCurrentFileSize;
+
+                    mapMoved[cOld.nSectorStart] = cNew;
+
+                    /* Increment the current filesize */
+                    nCurrentFileSize += cOld.nSectorSize;
+                    nBytesWrote      += cOld.nSectorSize;
+                }
+
+                /* Point the key at its new location if nothing else has changed it. */
+                if(pSectorKeys->Relocate(nHashFile, nBucket, cOld, mapMoved[cOld.nSectorStart]))
+                    ++nRelocated;
+            }
+        }
+
+        debug::log(0, FUNCTION, strName, " compacted sector file ", nCompact, ", relocated ", nRelocated, " keys in ", mapMoved.size(), " records");
+
+        /* Keys that were changed while we were compacting moved on their own, so our next pass releases the file. */
+        if(nRelocated != vKeys.size())
+        {
+            if(fOffline)
+                return debug::error(FUNCTION, strName, " failed to relocate ", vKeys.size() - nRelocated, " keys from sector file ", nCompact);
+
+            return true;
+        }
+
+        /* Release the file once any readers of its old locations are done. */
+        WaitReaders();
+        Truncate(nCompact);
+
+        return true;
+    }
+
+
+    /*  LLD Compaction Thread. Periodically compacts sparse sector files. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::Compactor()
+    {
+        /* Check for our compaction interval in minutes. */
+        const uint64_t nInterval = config::GetArg("-lldcompact", 0);
+        if(nInterval == 0 || (nFlags & FLAGS::READONLY) || !(nFlags & FLAGS::COMPACT))
+            return;
+
+        runtime::timer TIMER;
+        TIMER.Start();
+
+        while(!fDestruct.load())
+        {
+            runtime::sleep(100);
+            if(TIMER.Elapsed() < nInterval * 60)
+                continue;
+
+            /* Compact a single file per interval to limit our disk load. */
+            Compact();
+
+            TIMER.Reset();
+        }
+    }
+
+
+    /*  Wait for every read that could have found a sector location before now. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::WaitReaders()
+    {
+        /* Move new readers to the other epoch, so only reads that started before us are left in ours. */
+        const uint64_t nEpoch = nReadEpoch++;
+
+        /* Reads only hold their location for a single record, so this is a short wait. */
+        while(nReaders[nEpoch & 1].load() > 0)
+            runtime::sleep(1);
+    }
+
+
+    /*  Release the disk space of a sector file with no live records. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Truncate(const uint32_t nFile)
+    {
+        /* Never truncate the file we are appending to. */
+        {
+            LOCK(SECTOR_MUTEX);
+            if(nFile >= nCurrentFile)
+                return false;
+        }
+
+        /* Hold the mapping lock so that nobody can map this file while it shrinks. */
+        std::unique_lock<std::shared_mutex> lock(MAPPING_MUTEX);
+
+        /* Check that no readers are still copying out of our mapping. */
+        const auto it = mapMemory.find(nFile);
+        if(it != mapMemory.end())
+        {
+            if(it->second.use_count() > 1)
+                return false;
+
+            mapMemory.erase(it);
+        }
+
+        /* Truncate the file rather than remove it so that our file numbering stays contiguous. */
+        {
+            LOCK(SECTOR_MUTEX);
+
+            std::ofstream stream
+            (
+                debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile),
+                std::ios::out | std::ios::binary | std::ios::trunc
+            );
+            stream.close();
+        }
+
+        debug::log(0, FUNCTION, strName, " released sector file ", nFile);
+
+        return true;
+    }
+
+
     /*  Start a database transaction. */
     template<class KeychainType, class CacheType>
     void SectorDatabase<KeychainType, CacheType>::TxnBegin()
@@ -715,26 +1320,38 @@ namespace LLD
         if(!pTransaction)
             return false;
 
+        /* Don't let records move while we are committing and indexing them. */
+        RECURSIVE(COMPACT_MUTEX);
+
         /* Erase data set to be removed. */
         for(const auto& item : pTransaction->setErasedData)
             if(!pSectorKeys->Erase(item))
                 return debug::error(FUNCTION, "failed to erase from keychain");
 
-        /* Commit the sector data. */
-        for(const auto& item : pTransaction->mapTransactions)
-            if(!Force(item.first, item.second))
+        /* Commit the sector data, as one contiguous append per sector file. */
+        if(!pTransaction->mapTransactions.empty())
+        {
+            const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> > vRecords
+            (
+                pTransaction->mapTransactions.begin(), pTransaction->mapTransactions.end()
+            );
+
+            if(!Flush(vRecords))
                 return debug::error(FUNCTION, "failed to commit sector data");
+        }
+
+        /* Commit keychain entries, which are all written to the keychain as one batch below. */
+        std::vector<SectorKey> vKeys;
+        vKeys.reserve(pTransaction->setKeychain.size() + pTransaction->mapIndex.size());
 
-        /* Commit keychain entries. */
+        std::map<std::vector<uint8_t>, SectorKey> mapIndex;
         for(const auto& item : pTransaction->setKeychain)
         {
-            SectorKey cKey(STATE::READY, item, 0, 0, 0);
-            if(!pSectorKeys->Put(cKey))
-                return debug::error(FUNCTION, "failed to commit to keychain");
+            vKeys.emplace_back(STATE::READY, item, 0, 0, 0);
+            mapIndex[item] = vKeys.back();
         }
 
         /* Commit the index data. */
-        std::map<std::vector<uint8_t>, SectorKey> mapIndex;
         for(const auto& item : pTransaction->mapIndex)
         {
             /* Get the key. */
@@ -745,17 +1362,26 @@ namespace LLD
             {
                 /* Check for the new indexing entry. */
                 if(!pSectorKeys->Get(item.second, cKey))
+                {
+                    /* Keep the keys we have so far, so our sector data committed above can still be read. */
+                    if(!vKeys.empty())
+                        pSectorKeys->Put(vKeys);
+
                     return debug::error(FUNCTION, "failed to read indexing entry");
+                }
 
                 mapIndex[item.second] = cKey;
             }
 
-            /* Write the new sector key. */
+            /* Add the new sector key. */
             cKey.SetKey(item.first);
-            if(!pSectorKeys->Put(cKey))
-                return debug::error(FUNCTION, "failed to write indexing entry");
+            vKeys.push_back(cKey);
         }
 
+        /* Write our keys in bucket order with one flush of the keychain. */
+        if(!vKeys.empty() && !pSectorKeys->Put(vKeys))
+            return debug::error(FUNCTION, "failed to commit to keychain");
+
         /* Cleanup the transaction object. */
         delete pTransaction;
         pTransaction = nullptr;
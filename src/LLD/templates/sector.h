@@ -17,6 +17,7 @@ ________________________________________________________________________________
 
 
 #include <LLD/include/enum.h>
+#include <LLD/include/mmap.h>
 #include <LLD/include/version.h>
 #include <LLD/templates/key.h>
 #include <LLD/templates/transaction.h>
@@ -33,6 +34,9 @@ ________________________________________________________________________________
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <map>
 #include <condition_variable>
 
 namespace LLD
@@ -50,6 +54,14 @@ namespace LLD
     const uint32_t MAX_SECTOR_BUFFER_SIZE = 1024 * 1024 * 4; //32 MB Max Disk Buffer
 
 
+    /* The percentage of live data below which a sector file is compacted. */
+    const uint32_t MIN_SECTOR_LIVE_PERCENT = 50;
+
+
+    /* The maximum records to relocate while holding the compaction lock. */
+    const uint32_t MAX_SECTOR_COMPACT_BATCH = 1024;
+
+
     /** SectorDatabase
      *
      *  Base Template Class for a Sector Database.
@@ -94,6 +106,15 @@ namespace LLD
         std::mutex SECTOR_MUTEX;
         std::mutex BUFFER_MUTEX;
         std::mutex TRANSACTION_MUTEX;
+        std::mutex COMPACTOR_MUTEX;
+
+
+        /* Mutex for the memory mapped files, readers only take shared locks. */
+        std::shared_mutex MAPPING_MUTEX;
+
+
+        /* Mutex to keep writers from moving records while they are being compacted. */
+        std::recursive_mutex COMPACT_MUTEX;
 
 
         /* The String to hold the Disk Location of Database File. */
@@ -121,6 +142,10 @@ namespace LLD
         mutable TemplateLRU<uint32_t, std::fstream*>* fileCache;
 
 
+        /* Memory mapped sector files for reading without the sector lock. */
+        std::map<uint32_t, std::shared_ptr<MemoryMap>> mapMemory;
+
+
         /* The current File Position. */
         mutable uint32_t nCurrentFile;
         mutable uint32_t nCurrentFileSize;
@@ -134,6 +159,18 @@ namespace LLD
         std::thread MeterThread;
 
 
+        /* The compaction thread. */
+        std::thread CompactorThread;
+
+
+        /* Reads in flight in each read epoch, so compaction knows when nobody can still hold an old sector location. */
+        std::atomic<uint32_t> nReaders[2];
+
+
+        /* The current read epoch, which compaction moves on before waiting out the readers of the last one. */
+        std::atomic<uint64_t> nReadEpoch;
+
+
         /* Disk Buffer Vector. */
         std::vector< std::pair< std::vector<uint8_t>, std::vector<uint8_t> > > vDiskBuffer;
 
@@ -158,6 +195,49 @@ namespace LLD
         uint8_t nFlags;
 
 
+        /** Flag to determine if sector reads are memory mapped. **/
+        bool fMemoryMap;
+
+
+        /** ReadEpoch
+         *
+         *  Counts a read in the current read epoch for as long as it is in scope.
+         *
+         **/
+        class ReadEpoch
+        {
+            /* The reader count we were added to. */
+            std::atomic<uint32_t>* pReaders;
+
+        public:
+
+            /** Constructor. Retries if the epoch moves before we are counted, so WaitReaders can't miss us. **/
+            ReadEpoch(SectorDatabase& rDB)
+            : pReaders(nullptr)
+            {
+                while(true)
+                {
+                    const uint64_t nEpoch = rDB.nReadEpoch.load();
+
+                    pReaders = &rDB.nReaders[nEpoch & 1];
+                    ++(*pReaders);
+
+                    if(rDB.nReadEpoch.load() == nEpoch)
+                        break;
+
+                    --(*pReaders);
+                }
+            }
+
+
+            /** Default Destructor **/
+            ~ReadEpoch()
+            {
+                --(*pReaders);
+            }
+        };
+
+
     public:
 
 
@@ -362,8 +442,11 @@ namespace LLD
                 uint64_t nBufferSize =
                     (nLimit == -1) ? nFileSize : (1024 * 1024); //1 MB read buffer
 
+                /* Track when a memory mapped read has reached the end of file. */
+                bool fEndOfFile = false;
+
                 /* Loop until stream encounters exceptions. */
-                while(stream)
+                while(stream && !fEndOfFile)
                 {
                     /* Check that we aren't seeking past end of file. */
                     if(nStart >= nFileSize)
@@ -371,11 +454,29 @@ namespace LLD
 
                     /* Read into serialize stream. */
                     DataStream ssData(SER_LLD, DATABASE_VERSION);
-                    ssData.resize(nBufferSize);
 
+                    /* Read directly from our memory mapped file if enabled. */
+                    const std::shared_ptr<MemoryMap> pMap = GetMapping(nFile, nFileSize);
+                    if(pMap)
+                    {
+                        /* Truncate our read if we are at the end of the mapping. */
+                        const uint64_t nRead = std::min(nBufferSize, pMap->Size() - nStart);
+                        if(!pMap->Read(nStart, nRead, ssData.Bytes()))
+                            break;
+
+                        /* Iterate if meters are enabled. */
+                        nBytesRead += static_cast<uint32_t>(nRead);
+
+                        /* Mirror the stream's eof behavior so we move on to the next file. */
+                        fEndOfFile = (nStart + nRead >= pMap->Size());
+                    }
+                    else
                     {
                         LOCK(SECTOR_MUTEX);
 
+                        /* Allocate our read buffer. */
+                        ssData.resize(nBufferSize);
+
                         /* Seek stream to beginning. */
                         stream.seekg(nStart, std::ios::beg);
 
@@ -573,6 +674,9 @@ namespace LLD
                 }
             }
 
+            /* Don't let the indexed record move while we copy its location. */
+            RECURSIVE(COMPACT_MUTEX);
+
             /* Get the key. */
             SectorKey cKey;
             if(!pSectorKeys->Get(vIndex, cKey))
@@ -714,6 +818,20 @@ namespace LLD
         bool Get(const SectorKey& cKey, std::vector<uint8_t>& vData);
 
 
+        /** GetMapping
+         *
+         *  Get the memory mapping of a sector file, remapping it if the
+         *  file has grown past the requested size since it was last mapped.
+         *
+         *  @param[in] nFile The sector file to get mapping for.
+         *  @param[in] nRequired The minimum bytes that need to be mapped.
+         *
+         *  @return The mapping, or nullptr if memory mapping is unavailable.
+         *
+         **/
+        std::shared_ptr<MemoryMap> GetMapping(const uint32_t nFile, const uint64_t nRequired);
+
+
         /** Update
          *
          *  Update a record on disk.
@@ -727,6 +845,24 @@ namespace LLD
         bool Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
 
 
+        /** Update
+         *
+         *  Update a batch of records in place. Records are written in disk order, with records
+         *  that are next to each other written as one run, and each sector file flushed once.
+         *
+         *  Unlike the single record Update, which flushes after every record, a crash part way through
+         *  a batch can leave some of a file's records unwritten, which the transaction journal recovers.
+         *
+         *  @param[in] vUpdates The sector keys to write to, with the index of their record.
+         *  @param[in] vRecords The binary key and data pairs the updates index into.
+         *
+         *  @return True if the update was successful.
+         *
+         **/
+        bool Update(std::vector<std::pair<SectorKey, uint32_t>>& vUpdates,
+            const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords);
+
+
         /** Force
          *
          *  Force a write to disk immediately bypassing write buffers.
@@ -740,6 +876,32 @@ namespace LLD
         bool Force(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
 
 
+        /** Flush
+         *
+         *  Write a batch of records to disk, updating records of the same size in place and
+         *  coalescing all other records into one contiguous append per sector file. The keys
+         *  are then written to the keychain as a single batch.
+         *
+         *  @param[in] vRecords The binary key and data pairs to flush, in write order.
+         *
+         *  @return True if the flush was successful.
+         *
+         **/
+        bool Flush(const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords);
+
+
+        /** Append
+         *
+         *  Append a contiguous buffer of records to the end of the current sector file.
+         *
+         *  @param[in] ssData The serialized records, each prefixed with its compact size.
+         *
+         *  @return True if the append was successful.
+         *
+         **/
+        bool Append(const DataStream& ssData);
+
+
         /** Put
          *
          *  Write a record into the cache and disk buffer for flushing to disk.
@@ -770,6 +932,10 @@ namespace LLD
          *
          *  Flushes periodically data from the cache buffer to disk.
          *
+         *  This is a single writer thread that flushes each swapped buffer as one batch while
+         *  writers fill the next one. Batches are not split across threads, since our in-place
+         *  updates and append positions depend on the keychain written by the batch before.
+         *
          **/
         void CacheWriter();
 
@@ -782,6 +948,47 @@ namespace LLD
         void Meter();
 
 
+        /** Compact
+         *
+         *  Rewrite the live records of the sparsest sector file into the current
+         *  append file, and truncate sector files that no longer hold live records.
+         *
+         *  @param[in] fOffline Flag to determine if we keep going when shutting down, since no readers are active.
+         *
+         *  @return True if a sector file was compacted.
+         *
+         **/
+        bool Compact(const bool fOffline = false);
+
+
+        /** Compactor
+         *
+         *  LLD Compaction Thread. Periodically compacts sparse sector files.
+         *
+         **/
+        void Compactor();
+
+
+        /** WaitReaders
+         *
+         *  Wait for every read that could have found a sector location before now.
+         *
+         **/
+        void WaitReaders();
+
+
+        /** Truncate
+         *
+         *  Release the disk space of a sector file with no live records.
+         *
+         *  @param[in] nFile The sector file to truncate.
+         *
+         *  @return True if the file was truncated.
+         *
+         **/
+        bool Truncate(const uint32_t nFile);
+
+
         /** TxnBegin
          *
          *  Start a database transaction.
@@ -808,7 +1015,8 @@ namespace LLD
 
         /** TxnCommit
          *
-         *  Commit data from transaction object.
+         *  Commit data from transaction object, writing its records with one append per sector
+         *  file and its keychain entries as a single batch.
          *
          *  @return True, if commit is successful, false otherwise.
          *
@@ -38,6 +38,7 @@ namespace TAO
     namespace Ledger
     {
         class BlockState;
+        class Metrics;
         class Transaction;
     }
 
@@ -848,6 +849,56 @@ namespace LLD
         bool EraseFirst(const uint256_t& hashGenesis);
 
 
+        /** WriteMetrics
+         *
+         *  Writes the chain metrics for a bucket of time.
+         *
+         *  @param[in] nBucket The time bucket to write.
+         *  @param[in] metrics The metrics to write.
+         *
+         *  @return True if successfully written, false otherwise.
+         *
+         **/
+        bool WriteMetrics(const uint64_t nBucket, const TAO::Ledger::Metrics& metrics);
+
+
+        /** ReadMetrics
+         *
+         *  Reads the chain metrics for a bucket of time.
+         *
+         *  @param[in] nBucket The time bucket to read.
+         *  @param[out] metrics The metrics that were read.
+         *
+         *  @return True if successfully read, false otherwise.
+         *
+         **/
+        bool ReadMetrics(const uint64_t nBucket, TAO::Ledger::Metrics &metrics);
+
+
+        /** WriteMetricsHeight
+         *
+         *  Writes the height that the chain metrics were first indexed from.
+         *
+         *  @param[in] nHeight The height to write.
+         *
+         *  @return True if successfully written, false otherwise.
+         *
+         **/
+        bool WriteMetricsHeight(const uint32_t nHeight);
+
+
+        /** ReadMetricsHeight
+         *
+         *  Reads the height that the chain metrics were first indexed from.
+         *
+         *  @param[out] nHeight The height that was read.
+         *
+         *  @return True if the metrics have been indexed, false otherwise.
+         *
+         **/
+        bool ReadMetricsHeight(uint32_t &nHeight);
+
+
         /** MemoryBegin
          *
          *  Begin a memory transaction following ACID properties.
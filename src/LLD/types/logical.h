@@ -258,6 +258,47 @@ namespace LLD
         bool ReadTx(const uint512_t& hashTx, TAO::API::Transaction &tx);
 
 
+        /** WriteSigchainTx
+         *
+         *  Write the txid found at a sequence number in a sigchain.
+         *
+         *  @param[in] hashGenesis The genesis-id of the sigchain.
+         *  @param[in] nSequence The sequence number of the transaction.
+         *  @param[in] hashTx The txid found at this sequence.
+         *
+         *  @return True if written successfully.
+         *
+         **/
+        bool WriteSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence, const uint512_t& hashTx);
+
+
+        /** ReadSigchainTx
+         *
+         *  Read the txid found at a sequence number in a sigchain.
+         *
+         *  @param[in] hashGenesis The genesis-id of the sigchain.
+         *  @param[in] nSequence The sequence number of the transaction.
+         *  @param[out] hashTx The txid found at this sequence.
+         *
+         *  @return True if the sequence was indexed.
+         *
+         **/
+        bool ReadSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence, uint512_t &hashTx);
+
+
+        /** EraseSigchainTx
+         *
+         *  Erase the txid found at a sequence number in a sigchain.
+         *
+         *  @param[in] hashGenesis The genesis-id of the sigchain.
+         *  @param[in] nSequence The sequence number of the transaction.
+         *
+         *  @return True if erased successfully.
+         *
+         **/
+        bool EraseSigchainTx(const uint256_t& hashGenesis, const uint32_t nSequence);
+
+
         /** PushTransaction
          *
          *  Push an register transaction to process for given genesis-id.
@@ -336,6 +377,33 @@ namespace LLD
         bool LastRegisterTx(const uint256_t& hashRegister, uint512_t &hashTx);
 
 
+        /** ReadRegisterTx
+         *
+         *  Get the txid that modified a register at a given sequence number.
+         *
+         *  @param[in] hashRegister The address of register to read for
+         *  @param[in] nSequence The sequence number of the modification, starting at zero.
+         *  @param[out] hashTx The txid found at this sequence.
+         *
+         *  @return True if the sequence was indexed.
+         *
+         **/
+        bool ReadRegisterTx(const uint256_t& hashRegister, const uint32_t nSequence, uint512_t &hashTx);
+
+
+        /** ReadRegisterSequence
+         *
+         *  Get the number of transactions that modified a register.
+         *
+         *  @param[in] hashRegister The address of register to read for
+         *  @param[out] nSequence The number of indexed transactions.
+         *
+         *  @return True if the register has been indexed.
+         *
+         **/
+        bool ReadRegisterSequence(const uint256_t& hashRegister, uint32_t &nSequence);
+
+
         /** PushRegister
          *
          *  Push an register to process for given genesis-id.
@@ -860,6 +928,62 @@ namespace LLD
         bool ListExecuted(const std::pair<uint256_t, uint256_t>& pairMarket, std::vector<std::pair<uint512_t, uint32_t>> &vExecuted);
 
 
+        /** ListOpenOrders
+         *
+         *  List the open orders for given market pair. This walks the orderbook from the first order that could
+         *  still be open, which is moved forward as orders are claimed and back when claims are disconnected.
+         *  Listing is read-only, claimed orders past our first open order are skipped over.
+         *
+         *  @param[in] pairMarket The market-pair of token-id's
+         *  @param[out] vOrders The list of open orders.
+         *
+         *  @return true if the market has any open orders.
+         *
+         **/
+        bool ListOpenOrders(const std::pair<uint256_t, uint256_t>& pairMarket, std::vector<std::pair<uint512_t, uint32_t>> &vOrders);
+
+
+        /** ReadOrder
+         *
+         *  Reads the market-pair an order was pushed to, for orders indexed with their market.
+         *
+         *  @param[in] hashTx The txid of the order.
+         *  @param[in] nContract The contract-id of the order.
+         *  @param[out] pairMarket The market-pair the order is listed in.
+         *
+         *  @return true if the order was indexed with its market.
+         *
+         **/
+        bool ReadOrder(const uint512_t& hashTx, const uint32_t nContract, std::pair<uint256_t, uint256_t> &pairMarket);
+
+
+        /** CloseOrder
+         *
+         *  Moves the first open order of a market past any orders that have been executed or cancelled.
+         *
+         *  @param[in] pairMarket The market-pair an order was claimed in.
+         *
+         *  @return true if written successfully.
+         *
+         **/
+        bool CloseOrder(const std::pair<uint256_t, uint256_t>& pairMarket);
+
+
+        /** ReopenOrder
+         *
+         *  Re-opens an order when the contract that claimed it has been disconnected. Orders indexed before they
+         *  were mapped to their market move the first open order back to the start of the market.
+         *
+         *  @param[in] hashTx The txid of the order.
+         *  @param[in] nContract The contract-id of the order.
+         *  @param[in] pairMarket The market-pair the order is listed in.
+         *
+         *  @return true if written successfully.
+         *
+         **/
+        bool ReopenOrder(const uint512_t& hashTx, const uint32_t nContract, const std::pair<uint256_t, uint256_t>& pairMarket);
+
+
         /** HasOrder
          *
          *  Checks if an order has been indexed in the database already.
@@ -922,7 +1046,7 @@ namespace LLD
         bool HasPTR(const uint256_t& hashAddress);
 
 
-        /** Build indexes for transactions over a rolling modulus. For -indexregister flag. **/
+        /** Build indexes for transactions over a rolling modulus and full history. For -indexregister flag. **/
         void IndexRegisters();
 
     };
@@ -19,11 +19,13 @@ ________________________________________________________________________________
 #include <TAO/API/include/json.h>
 #include <TAO/API/types/commands.h>
 #include <TAO/API/types/exception.h>
+#include <TAO/API/types/workers.h>
 
 #include <Util/include/string.h>
 #include <Util/include/urlencode.h>
 #include <Util/include/config.h>
 #include <Util/include/base64.h>
+#include <Util/include/mutex.h>
 
 namespace LLP
 {
@@ -32,12 +34,20 @@ namespace LLP
     /** Default Constructor **/
     APINode::APINode()
     : HTTPNode()
+    , std::enable_shared_from_this<APINode> ( )
+    , PENDING_MUTEX ( )
+    , queuePending  ( )
+    , fProcessing   (false)
     {
     }
 
     /** Constructor **/
     APINode::APINode(const LLP::Socket &SOCKET_IN, LLP::DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : HTTPNode(SOCKET_IN, DDOS_IN, fDDOSIn)
+    , std::enable_shared_from_this<APINode> ( )
+    , PENDING_MUTEX ( )
+    , queuePending  ( )
+    , fProcessing   (false)
     {
     }
 
@@ -45,6 +55,10 @@ namespace LLP
     /** Constructor **/
     APINode::APINode(LLP::DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : HTTPNode(DDOS_IN, fDDOSIn)
+    , std::enable_shared_from_this<APINode> ( )
+    , PENDING_MUTEX ( )
+    , queuePending  ( )
+    , fProcessing   (false)
     {
     }
 
@@ -71,6 +85,15 @@ namespace LLP
             return;
         }
 
+        /* Keep our connection from timing out while a worker is still running our request. */
+        if(EVENT == EVENTS::GENERIC)
+        {
+            if(fProcessing.load())
+                nLastRecv = runtime::timestamp(true);
+
+            return;
+        }
+
         /* Handle for a HEADER event. */
         if(EVENT == EVENTS::HEADER)
         {
@@ -115,6 +138,47 @@ namespace LLP
     }
 
 
+    /** Local helper function to get the response for an API exception. **/
+    encoding::json ExceptionToJSON(const TAO::API::Exception& e, const std::string& strErrorCode, uint16_t &nStatus)
+    {
+        /* Get error from exception. */
+        encoding::json jError = e.ToJSON();
+
+        /* Check to see if the caller has specified an error code to use for general API errors */
+        if(!strErrorCode.empty())
+            nStatus = std::stoi(strErrorCode);
+        else
+            /* Default error status code is 400. */
+            nStatus = 400;
+
+        /* Cache our error code here. */
+        const int32_t nError =
+            jError["code"].get<int32_t>();
+
+        /* Set status by error code. */
+        switch(nError)
+        {
+            //API not found error code
+            case -4:
+                nStatus = 404;
+                break;
+
+            //unsupported content type
+            case -5:
+                nStatus = 500;
+                break;
+
+            //content type not provided
+            case -6:
+                nStatus = 500;
+                break;
+        }
+
+        /* Populate the return JSON to the error */
+        return { { "error", jError } };
+    }
+
+
     /** Main message handler once a packet is recieved. **/
     bool APINode::ProcessPacket()
     {
@@ -137,22 +201,22 @@ namespace LLP
         /* Parse the packet request. */
         const std::string::size_type nPos = INCOMING.strRequest.find('/', 1);
 
-        /* Extract the API requested. */
-        std::string strCommands = INCOMING.strRequest.substr(1, nPos - 1);
-        std::string strMethod   = INCOMING.strRequest.substr(nPos + 1);
-
-        /* The JSON response */
-        encoding::json jRet;
-
-        /* The HTTP response status code, default to 200 unless an error is encountered */
-        uint16_t nStatus = 200;
+        /* Capture our request, since our incoming packet is reset before a worker runs it. */
+        Request tRequest;
+        tRequest.strCommands  = INCOMING.strRequest.substr(1, nPos - 1);
+        tRequest.strMethod    = INCOMING.strRequest.substr(nPos + 1);
+        tRequest.strOrigin    = INCOMING.mapHeaders.count("origin") ? INCOMING.mapHeaders["origin"] : "";
+        tRequest.strErrorCode = INCOMING.mapHeaders.count("api-error-code") ? INCOMING.mapHeaders["api-error-code"] : "";
+        tRequest.fKeepAlive   = (INCOMING.mapHeaders.count("connection") && INCOMING.mapHeaders["connection"] == "keep-alive");
 
         /* Log the starting time for this command. */
-        runtime::timer tLatency;
-        tLatency.Start();
+        tRequest.tLatency.Start();
+
+        /* Get some references to keep our parsing easy to read. */
+        std::string& strMethod = tRequest.strMethod;
+        encoding::json& jParams = tRequest.jParams;
 
         /* Handle basic HTTP logic here. */
-        encoding::json jParams;
         try
         {
             /* Handle for the POST call. */
@@ -236,8 +300,8 @@ namespace LLP
                 //RESPONSE.mapHeaders["Content-Length"]         = "0";
                 RESPONSE.mapHeaders["Accept"]                 = "*/*";
 
-                /* Add content. */
-                this->WritePacket(RESPONSE);
+                /* Add content behind any request in progress. */
+                Sequence([this, RESPONSE]() { this->WritePacket(RESPONSE); });
 
                 return true;
             }
@@ -253,53 +317,72 @@ namespace LLP
             /* Add our request information before invoking command. */
             jParams["request"] =
             {
-                {"commands", strCommands },
-                {"method",   strMethod   }
+                {"commands", tRequest.strCommands },
+                {"method",   strMethod            }
             };
+        }
 
+        /* Handle for custom API exceptions. */
+        catch(const TAO::API::Exception& e)
+        {
+            /* Respond with our error behind any request in progress, as there is no command to run. */
+            uint16_t nStatus = 400;
+            encoding::json jRet = ExceptionToJSON(e, tRequest.strErrorCode, nStatus);
+            Sequence([this, tRequest, nStatus, jRet]() mutable { Respond(tRequest, nStatus, jRet); });
+
+            return true;
+        }
+
+        catch(const std::exception& e)
+        {
+            /* Populate the return JSON to the error */
+            encoding::json jRet = { { "error", { { "code", -1 }, { "message", e.what() }} } };
+            Sequence([this, tRequest, jRet]() mutable { Respond(tRequest, 500, jRet); });
+
+            return true;
+        }
+
+        /* Run our command on the data thread if the workers aren't running, or we aren't owned by a data thread. */
+        const std::shared_ptr<APINode> pThis = weak_from_this().lock();
+        if(!TAO::API::Workers::Active() || !pThis)
+        {
+            Execute(tRequest);
+            return true;
+        }
+
+        /* Hand our command off to the workers. */
+        const uint8_t nClass = TAO::API::Workers::Classify(tRequest.strCommands, strMethod);
+        if(!Dispatch(nClass, [pThis, tRequest]() mutable { pThis->Execute(tRequest); }))
+        {
+            /* Let the caller know to try again when our queue is full. */
+            encoding::json jRet = { { "error", { { "code", -1 }, { "message", "API server is busy, try again later" }} } };
+            Sequence([this, tRequest, jRet]() mutable { Respond(tRequest, 503, jRet); });
+        }
+
+        return true; //XXX: assess if we can return false here, if my memory serves we had issues here a couple years ago
+        //because if we disconnect immediately, we break the pipe. We need to wait for buffer to clear before disconnect
+    }
+
+
+    /* Invoke the command of a request and write its response. */
+    void APINode::Execute(Request& tRequest)
+    {
+        /* The JSON response */
+        encoding::json jRet;
+
+        /* The HTTP response status code, default to 200 unless an error is encountered */
+        uint16_t nStatus = 200;
+        try
+        {
             /* Execute the api and methods. */
             jRet["result"] =
-                TAO::API::Commands::Invoke(strCommands, strMethod, jParams);
+                TAO::API::Commands::Invoke(tRequest.strCommands, tRequest.strMethod, tRequest.jParams);
         }
 
         /* Handle for custom API exceptions. */
         catch(const TAO::API::Exception& e)
         {
-            /* Get error from exception. */
-            encoding::json jError = e.ToJSON();
-
-            /* Check to see if the caller has specified an error code to use for general API errors */
-            if(INCOMING.mapHeaders.count("api-error-code"))
-                nStatus = std::stoi(INCOMING.mapHeaders["api-error-code"]);
-            else
-                /* Default error status code is 400. */
-                nStatus = 400;
-
-            /* Cache our error code here. */
-            const int32_t nError =
-                jError["code"].get<int32_t>();
-
-            /* Set status by error code. */
-            switch(nError)
-            {
-                //API not found error code
-                case -4:
-                    nStatus = 404;
-                    break;
-
-                //unsupported content type
-                case -5:
-                    nStatus = 500;
-                    break;
-
-                //content type not provided
-                case -6:
-                    nStatus = 500;
-                    break;
-            }
-
-            /* Populate the return JSON to the error */
-            jRet = { { "error", jError } };
+            jRet = ExceptionToJSON(e, tRequest.strErrorCode, nStatus);
         }
 
         catch(const std::exception& e)
@@ -310,30 +393,37 @@ namespace LLP
             jRet = { { "error", { { "code", -1 }, { "message", e.what() }} } };
         }
 
+        Respond(tRequest, nStatus, jRet);
+    }
+
+
+    /* Write the response for a request. */
+    void APINode::Respond(const Request& tRequest, const uint16_t nStatus, encoding::json& jRet)
+    {
         /* Build packet. */
         HTTPPacket RESPONSE(nStatus);
 
         /* Add the origin header if supplied in the request */
-        if(INCOMING.mapHeaders.count("origin"))
-            RESPONSE.mapHeaders["Access-Control-Allow-Origin"] = INCOMING.mapHeaders["origin"];
+        if(!tRequest.strOrigin.empty())
+            RESPONSE.mapHeaders["Access-Control-Allow-Origin"] = tRequest.strOrigin;
 
         /* Add the connection header */
-        if(INCOMING.mapHeaders.count("connection") && INCOMING.mapHeaders["connection"] == "keep-alive")
+        if(tRequest.fKeepAlive)
             RESPONSE.mapHeaders["Connection"] = "keep-alive";
         else
             RESPONSE.mapHeaders["Connection"] = "close";
 
         /* Track the stopping time of this command. */
         const double nLatency =
-            (tLatency.ElapsedNanoseconds() / 1000000.0);
+            (tRequest.tLatency.ElapsedNanoseconds() / 1000000.0);
 
         /* Add some micro-benchamrks to response data. */
         jRet["info"] =
         {
-            {"method",    strCommands + "/" + strMethod                      },
-            {"status",    TAO::API::Commands::Status(strCommands, strMethod) },
-            {"address",   this->addr.ToString()                              },
-            {"latency",   debug::safe_printstr(std::fixed, nLatency, " ms")  }
+            {"method",    tRequest.strCommands + "/" + tRequest.strMethod                      },
+            {"status",    TAO::API::Commands::Status(tRequest.strCommands, tRequest.strMethod) },
+            {"address",   this->addr.ToString()                                                },
+            {"latency",   debug::safe_printstr(std::fixed, nLatency, " ms")                    }
         };
 
         /* Log our response if argument is specified. */
@@ -345,9 +435,87 @@ namespace LLP
 
         /* Write the response */
         this->WritePacket(RESPONSE);
+    }
 
-        return true; //XXX: assess if we can return false here, if my memory serves we had issues here a couple years ago
-        //because if we disconnect immediately, we break the pipe. We need to wait for buffer to clear before disconnect
+
+    /* Hand a request off to the API workers, behind any request already in progress on this connection. */
+    bool APINode::Dispatch(const uint8_t nClass, const std::function<void()>& fnRequest)
+    {
+        LOCK(PENDING_MUTEX);
+
+        /* Wait behind our request in progress so that our responses stay in order. */
+        if(fProcessing.load())
+        {
+            queuePending.push(std::make_pair(nClass, fnRequest));
+            return true;
+        }
+
+        /* Submit to our workers, moving on to any pending requests once complete. */
+        const std::shared_ptr<APINode> pThis = shared_from_this();
+        if(!TAO::API::Workers::Submit(nClass, [pThis, fnRequest]() { fnRequest(); pThis->Next(); }))
+            return false;
+
+        fProcessing.store(true);
+        return true;
+    }
+
+
+    /* Write a response that has no command to run, behind any request in progress on this connection. */
+    void APINode::Sequence(const std::function<void()>& fnResponse)
+    {
+        LOCK(PENDING_MUTEX);
+
+        /* Wait behind our request in progress so that our responses stay in order. */
+        if(fProcessing.load())
+        {
+            queuePending.push(std::make_pair(uint8_t(TAO::API::Workers::CLASS::TOTAL), fnResponse));
+            return;
+        }
+
+        /* Nothing is in progress, so we can respond right away. */
+        fnResponse();
+    }
+
+
+    /* Hand the next pending request on this connection off to the API workers. */
+    void APINode::Next()
+    {
+        while(true)
+        {
+            /* Get our next pending request. */
+            std::pair<uint8_t, std::function<void()>> pairRequest;
+            {
+                LOCK(PENDING_MUTEX);
+
+                /* Check if we are finished, dropping anything left if our workers are shutting down. */
+                if(queuePending.empty() || !TAO::API::Workers::Active())
+                {
+                    queuePending = std::queue<std::pair<uint8_t, std::function<void()>>>();
+                    fProcessing.store(false);
+
+                    return;
+                }
+
+                pairRequest = std::move(queuePending.front());
+                queuePending.pop();
+            }
+
+            /* Responses with no command to run are written in order from this worker. */
+            if(pairRequest.first == TAO::API::Workers::CLASS::TOTAL)
+            {
+                pairRequest.second();
+                continue;
+            }
+
+            /* Submit to our workers, moving on to any pending requests once complete. */
+            const std::shared_ptr<APINode> pThis = shared_from_this();
+            const std::function<void()> fnRequest = pairRequest.second;
+            if(TAO::API::Workers::Submit(pairRequest.first, [pThis, fnRequest]() { fnRequest(); pThis->Next(); }))
+                return;
+
+            /* Run it on this worker if its queue is full, since it has already been accepted. */
+            fnRequest();
+        }
     }
 
 
@@ -27,6 +27,8 @@ ________________________________________________________________________________
 
 #include <Util/include/runtime.h>
 
+#include <cstring>
+
 
 namespace LLP
 {
@@ -69,6 +71,9 @@ namespace LLP
     , EVENT_CONDITION ( )
     , TRIGGER_MUTEX   ( )
     , TRIGGERS        ( )
+    , vRecv           ( )
+    , nRecvBegin      (0)
+    , nRecvEnd        (0)
     {
         INCOMING.SetNull();
     }
@@ -91,6 +96,9 @@ namespace LLP
     , EVENT_CONDITION ( )
     , TRIGGER_MUTEX   ( )
     , TRIGGERS        ( )
+    , vRecv           ( )
+    , nRecvBegin      (0)
+    , nRecvEnd        (0)
     {
     }
 
@@ -113,6 +121,9 @@ namespace LLP
     , EVENT_CONDITION ( )
     , TRIGGER_MUTEX   ( )
     , TRIGGERS        ( )
+    , vRecv           ( )
+    , nRecvBegin      (0)
+    , nRecvEnd        (0)
     {
     }
 
@@ -188,6 +199,8 @@ namespace LLP
         fCONNECTED      = false;
         nDataThread     = -1;
         nDataIndex      = -1;
+        nRecvBegin      = 0;
+        nRecvEnd        = 0;
 
         INCOMING.SetNull();
     }
@@ -226,37 +239,95 @@ namespace LLP
     }
 
 
+    /* Get the total bytes in our receive buffer that haven't been parsed yet. */
+    template <class PacketType>
+    uint32_t BaseConnection<PacketType>::Received() const
+    {
+        return nRecvEnd - nRecvBegin;
+    }
+
+
+    /* Read everything waiting on the socket into our receive buffer with a single read. */
+    template <class PacketType>
+    int32_t BaseConnection<PacketType>::Receive()
+    {
+        /* Check that there is data waiting on the socket. */
+        if(Available() <= 0)
+            return 0;
+
+        /* Allocate our buffer the first time we read, so connections that parse their own packets don't pay for it. */
+        if(vRecv.empty())
+            vRecv.resize(RECV_BUFFER_SIZE);
+
+        /* Move any unparsed bytes to the front so the rest of the buffer is free for this read. */
+        if(nRecvBegin > 0)
+        {
+            std::memmove(&vRecv[0], &vRecv[nRecvBegin], nRecvEnd - nRecvBegin);
+
+            nRecvEnd  -= nRecvBegin;
+            nRecvBegin = 0;
+        }
+
+        /* Check that we have room left to read into. */
+        if(nRecvEnd >= vRecv.size())
+            return 0;
+
+        /* Read as much as we have room for, in one call to the socket. */
+        const int32_t nRead = Read(&vRecv[nRecvEnd], vRecv.size() - nRecvEnd);
+        if(nRead > 0)
+            nRecvEnd += nRead;
+
+        return nRead;
+    }
+
+
+    /* Take bytes from the front of our receive buffer. */
+    template <class PacketType>
+    const uint8_t* BaseConnection<PacketType>::Consume(const uint32_t nBytes)
+    {
+        const uint8_t* pData = &vRecv[nRecvBegin];
+        nRecvBegin += nBytes;
+
+        return pData;
+    }
+
+
     /*  Write a single packet to the TCP stream. */
     template <class PacketType>
     void BaseConnection<PacketType>::WritePacket(const PacketType& PACKET)
+    {
+        WritePacket(std::make_shared<const std::vector<uint8_t>>(PACKET.GetBytes()));
+    }
+
+
+    /*  Write the bytes of a serialized packet to the TCP stream, sharing the buffer instead of copying it. */
+    template <class PacketType>
+    void BaseConnection<PacketType>::WritePacket(const std::shared_ptr<const std::vector<uint8_t>>& pBytes, const bool fSend)
     {
         /* Only get this value one time. */
         static const uint64_t nMaxSendBuffer =
             config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER);
 
-        /* Get the bytes of the packet. */
-        const std::vector<uint8_t> vBytes = PACKET.GetBytes();
-
         /* Stop sending packets if send buffer is full. */
-        if(Buffered() + vBytes.size() + 1024 < nMaxSendBuffer //reserve 1Kb of buffer for critical messages
-        || (fBufferFull.load() && Buffered() + vBytes.size() < nMaxSendBuffer)) //catch for critical messages (< 1 Kb)
+        if(Buffered() + pBytes->size() + 1024 < nMaxSendBuffer //reserve 1Kb of buffer for critical messages
+        || (fBufferFull.load() && Buffered() + pBytes->size() < nMaxSendBuffer)) //catch for critical messages (< 1 Kb)
         {
             /* Debug dump of message type. */
-            debug::log(4, NODE, "sent packet (", vBytes.size(), " bytes)");
+            debug::log(4, NODE, "sent packet (", pBytes->size(), " bytes)");
 
             /* Debug dump of packet data. */
             if(config::nVerbose >= 5)
-                PrintHex(vBytes);
+                PrintHex(*pBytes);
 
             /* Write the packet to socket buffer. */
-            Write(vBytes, vBytes.size());
+            Write(pBytes, fSend);
 
             /* Update packet count. */
             ++PACKETS;
         }
         else
         {
-            debug::log(4, NODE, "Socket buffer full. Packet size: ", vBytes.size(), " bytes.  Buffered: ", Buffered(), " bytes");
+            debug::log(4, NODE, "Socket buffer full. Packet size: ", pBytes->size(), " bytes.  Buffered: ", Buffered(), " bytes");
 
             /* set buffer to full */
             fBufferFull.store(true);
@@ -47,55 +47,53 @@ namespace LLP
     /*  Regular Connection Read Packet Method. */
     void Connection::ReadPacket()
     {
-
-        /* Handle Reading Packet Type Header. */
-        if(Available() >= 1 && INCOMING.IsNull())
+        /* Parse from our receive buffer first, and only read the socket if that doesn't complete our packet. */
+        for(uint32_t nPass = 0; nPass < 2; ++nPass)
         {
-            std::vector<uint8_t> HEADER(1, 255);
-            if(Read(HEADER, 1) == 1)
-                INCOMING.HEADER = HEADER[0];
-        }
+            /* Read everything waiting on the socket in one call. */
+            if(nPass > 0 && Receive() <= 0)
+                return;
 
-        /* At this point we need to check agin whether the packet is considered complete as some
-           packet types only require a header and no length or data*/
-        if(!INCOMING.IsNull() && !INCOMING.Complete())
-        {
-            /* Read the packet length. */
-            if(Available() >= 4 && INCOMING.LENGTH == 0)
+            /* Handle Reading Packet Type Header. */
+            if(INCOMING.IsNull() && Received() >= 1)
             {
-                /* Handle Reading Packet Length Header. */
-                std::vector<uint8_t> BYTES(4, 0);
-                if(Read(BYTES, 4) == 4)
-                {
-                    INCOMING.SetLength(BYTES);
-                    Event(EVENTS::HEADER);
-                }
+                /* Release packet storage that a large packet left behind, smaller storage is reused. */
+                if(INCOMING.DATA.capacity() > MAX_PACKET_RESERVE)
+                    std::vector<uint8_t>().swap(INCOMING.DATA);
+
+                INCOMING.HEADER = *Consume(1);
             }
 
-            /* Handle Reading Packet Data. */
-            uint32_t nAvailable = Available();
-            if(INCOMING.Header() && nAvailable > 0 && !INCOMING.IsNull() && INCOMING.DATA.size() < INCOMING.LENGTH)
+            /* At this point we need to check agin whether the packet is considered complete as some
+               packet types only require a header and no length or data*/
+            if(!INCOMING.IsNull() && !INCOMING.Complete())
             {
-                /* The maximum number of bytes to read is th number of bytes specified in the message length,
-                   minus any already read on previous reads*/
-                uint32_t nMaxRead = (uint32_t)(INCOMING.LENGTH - INCOMING.DATA.size());
-
-                /* Vector to receve the read bytes. This should be the smaller of the number of bytes currently available or the
-                   maximum amount to read */
-                std::vector<uint8_t> DATA(std::min(nAvailable, nMaxRead), 0);
+                /* Read the packet length. */
+                if(INCOMING.LENGTH == 0 && Received() >= 4)
+                {
+                    INCOMING.SetLength(Consume(4));
+                    Event(EVENTS::HEADER);
+                }
 
-                /* Read up to the buffer size. */
-                int32_t nRead = Read(DATA, DATA.size());
+                /* Handle Reading Packet Data. */
+                const uint32_t nReceived = Received();
+                if(INCOMING.Header() && nReceived > 0 && !INCOMING.IsNull() && INCOMING.DATA.size() < INCOMING.LENGTH)
+                {
+                    /* Take the smaller of what is buffered, or what is left of our packet. */
+                    const uint32_t nRead = std::min(nReceived, static_cast<uint32_t>(INCOMING.LENGTH - INCOMING.DATA.size()));
 
-                /* If something was read, insert it into the packet data.  NOTE: that due to SSL packet framing we could end up
-                   reading less bytes than appear available.  Therefore we only copy the number of bytes actually read */
-                if(nRead > 0)
-                    INCOMING.DATA.insert(INCOMING.DATA.end(), DATA.begin(), DATA.begin() + nRead);
+                    const uint8_t* pData = Consume(nRead);
+                    INCOMING.DATA.insert(INCOMING.DATA.end(), pData, pData + nRead);
 
-                /* If the packet is now considered complete, fire the packet complete event */
-                if(INCOMING.Complete())
-                    Event(EVENTS::PACKET, static_cast<uint32_t>(DATA.size()));
+                    /* If the packet is now considered complete, fire the packet complete event */
+                    if(INCOMING.Complete())
+                        Event(EVENTS::PACKET, nRead);
+                }
             }
+
+            /* Check if our buffer completed our packet. */
+            if(INCOMING.Complete())
+                return;
         }
     }
 
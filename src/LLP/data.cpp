@@ -26,9 +26,38 @@ ________________________________________________________________________________
 
 #include <Util/include/hex.h>
 
+#include <algorithm>
+#include <memory>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 
 namespace LLP
 {
+#ifdef __linux__
+    /* Convert epoll events into the poll flags that our connections are checked against. */
+    static uint32_t poll_events(const uint32_t nEvents)
+    {
+        uint32_t nFlags = 0;
+        if(nEvents & EPOLLIN)
+            nFlags |= POLLIN;
+
+        if(nEvents & EPOLLERR)
+            nFlags |= POLLERR;
+
+        if(nEvents & EPOLLHUP)
+            nFlags |= POLLHUP;
+
+        return nFlags;
+    }
+#endif
+
+
     /** Default Constructor **/
     template <class ProtocolType>
     DataThread<ProtocolType>::DataThread(const uint32_t nID, const bool ffDDOSIn,
@@ -43,6 +72,7 @@ namespace LLP
     , TIMEOUT         (nTimeout)
     , DDOS_rSCORE     (rScore)
     , DDOS_cSCORE     (cScore)
+    , nEpoll          (open_epoll())
     , CONNECTIONS     (util::atomic::lock_unique_ptr<std::vector<std::shared_ptr<ProtocolType>> >(new std::vector<std::shared_ptr<ProtocolType>>()))
     , RELAY           (util::atomic::lock_unique_ptr<std::queue<std::pair<typename ProtocolType::message_t, DataStream>> >(new std::queue<std::pair<typename ProtocolType::message_t, DataStream>>()))
     , CONDITION       ( )
@@ -69,6 +99,12 @@ namespace LLP
         /* Wait for any threads still flushing buffers. */
         if(FLUSH_THREAD.joinable())
             FLUSH_THREAD.join();
+
+    #ifdef __linux__
+        /* Close our epoll instance now that our threads are done with it. */
+        if(nEpoll >= 0)
+            close(nEpoll);
+    #endif
     }
 
 
@@ -108,6 +144,9 @@ namespace LLP
             else
                 CONNECTIONS->at(nSlot) = pNodeRet;
 
+            /* Start watching our new socket. */
+            watch_connection(nSlot, pnode->fd);
+
             /* Check for inbound socket. */
             if(pnode->Incoming())
                 ++nIncoming;
@@ -187,6 +226,19 @@ namespace LLP
          */
         std::vector<pollfd> POLLFDS;
 
+        /* Track if poll left any connections with packets in their receive buffers. */
+        bool fPending = false;
+
+    #ifdef __linux__
+        /* Events returned from epoll, and the connections that still have packets buffered. */
+        std::vector<epoll_event> vEvents(MAX_EPOLL_EVENTS);
+        std::vector<uint32_t> vPending;
+
+        /* Track the last time we checked every connection for timeouts and generic events. */
+        runtime::timer tScan;
+        tScan.Start();
+    #endif
+
         /* The main connection handler loop. */
         while(!fDestruct.load() && !config::fShutdown.load())
         {
@@ -223,6 +275,83 @@ namespace LLP
                 continue;
             }
 
+        #ifdef __linux__
+            /* Only visit the sockets that epoll says are ready, since our registrations persist between calls. */
+            if(nEpoll >= 0)
+            {
+                /* Don't block if we have packets left in a receive buffer. */
+                const int32_t nReady = epoll_wait(nEpoll, &vEvents[0], MAX_EPOLL_EVENTS, vPending.empty() ? 100 : 0);
+                if(nReady < 0)
+                {
+                    runtime::sleep(1);
+                    continue;
+                }
+
+                /* Take our pending connections from the last pass. */
+                std::vector<uint32_t> vVisit;
+                vVisit.swap(vPending);
+
+                /* Check every connection at the same interval that poll would time out, for timeouts and generic events. */
+                if(tScan.ElapsedMilliseconds() >= 100)
+                {
+                    tScan.Reset();
+
+                    /* Build the events for every connection, so that each is only visited once. */
+                    const uint32_t nSize = static_cast<uint32_t>(CONNECTIONS->size());
+                    std::vector<uint32_t> vFlags(nSize, 0);
+                    for(int32_t nEvent = 0; nEvent < nReady; ++nEvent)
+                    {
+                        /* Get our index and socket that were registered. */
+                        const uint32_t nIndex  = static_cast<uint32_t>(vEvents[nEvent].data.u64);
+                        const int32_t  nSocket = static_cast<int32_t>(vEvents[nEvent].data.u64 >> 32);
+
+                        /* Check that this slot wasn't given to another connection since it was registered. */
+                        if(nIndex >= nSize || !CONNECTIONS->at(nIndex) || CONNECTIONS->at(nIndex)->fd != nSocket)
+                            continue;
+
+                        vFlags[nIndex] |= poll_events(vEvents[nEvent].events);
+                    }
+
+                    /* Visit every connection. */
+                    for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
+                    {
+                        if(handle_connection(nIndex, vFlags[nIndex], nWait))
+                            vPending.push_back(nIndex);
+                    }
+
+                    continue;
+                }
+
+                /* Visit the connections with events. */
+                for(int32_t nEvent = 0; nEvent < nReady; ++nEvent)
+                {
+                    /* Get our index and socket that were registered. */
+                    const uint32_t nIndex  = static_cast<uint32_t>(vEvents[nEvent].data.u64);
+                    const int32_t  nSocket = static_cast<int32_t>(vEvents[nEvent].data.u64 >> 32);
+
+                    /* Check that this slot wasn't given to another connection since it was registered. */
+                    if(nIndex >= CONNECTIONS->size() || !CONNECTIONS->at(nIndex) || CONNECTIONS->at(nIndex)->fd != nSocket)
+                        continue;
+
+                    /* Skip connections that are pending, since they are visited below. */
+                    if(std::find(vVisit.begin(), vVisit.end(), nIndex) != vVisit.end())
+                        continue;
+
+                    if(handle_connection(nIndex, poll_events(vEvents[nEvent].events), nWait))
+                        vPending.push_back(nIndex);
+                }
+
+                /* Visit the connections that had packets left in their receive buffers. */
+                for(const uint32_t nIndex : vVisit)
+                {
+                    if(handle_connection(nIndex, 0, nWait))
+                        vPending.push_back(nIndex);
+                }
+
+                continue;
+            }
+        #endif
+
             /* Wrapped mutex lock. */
             const uint32_t nSize = static_cast<uint32_t>(CONNECTIONS->size());
 
@@ -258,11 +387,12 @@ namespace LLP
                 }
             }
 
-            /* Poll the sockets. */
+            /* Poll the sockets, without blocking if we have packets left in a receive buffer. */
+            const int32_t nTimeout = fPending ? 0 : 100;
 #ifdef WIN32
-            int32_t nPoll = WSAPoll((pollfd*)&POLLFDS[0], nSize, 100);
+            int32_t nPoll = WSAPoll((pollfd*)&POLLFDS[0], nSize, nTimeout);
 #else
-            int32_t nPoll = poll((pollfd*)&POLLFDS[0], nSize, 100);
+            int32_t nPoll = poll((pollfd*)&POLLFDS[0], nSize, nTimeout);
 #endif
 
             /* Check poll for available sockets. */
@@ -274,129 +404,148 @@ namespace LLP
 
 
             /* Check all connections for data and packets. */
+            fPending = false;
             for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
-                /* Access the shared pointer. */
-                std::shared_ptr<ProtocolType> CONNECTION = CONNECTIONS->at(nIndex);
-                try
-                {
-                    /* Skip over Inactive Connections. */
-                    if(!CONNECTION || !CONNECTION->Connected())
-                        continue;
+                if(handle_connection(nIndex, POLLFDS.at(nIndex).revents, nWait))
+                    fPending = true;
+            }
+        }
+    }
 
-                    /* Disconnect if there was a polling error */
-                    if(POLLFDS.at(nIndex).revents & POLLERR)
-                    {
-                         remove_connection_with_event(nIndex, DISCONNECT::POLL_ERROR);
-                         continue;
-                    }
 
-                    /* Disconnect if the socket was disconnected by peer (need for Windows) */
-                    if(POLLFDS.at(nIndex).revents & POLLHUP)
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::PEER);
-                        continue;
-                    }
+    /* Check a connection for errors and timeouts, then read and process its packets. */
+    template <class ProtocolType>
+    bool DataThread<ProtocolType>::handle_connection(const uint32_t nIndex, const uint32_t nEvents, const uint32_t nWait)
+    {
+        /* Access the shared pointer. */
+        std::shared_ptr<ProtocolType> CONNECTION = CONNECTIONS->at(nIndex);
+        try
+        {
+            /* Skip over Inactive Connections. */
+            if(!CONNECTION || !CONNECTION->Connected())
+                return false;
 
-                    /* Remove Connection if it has Timed out or had any read/write Errors. */
-                    if(CONNECTION->Errors())
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::ERRORS);
-                        continue;
-                    }
+            /* Disconnect if there was a polling error */
+            if(nEvents & POLLERR)
+            {
+                 remove_connection_with_event(nIndex, DISCONNECT::POLL_ERROR);
+                 return false;
+            }
 
-                    /* Remove Connection if it has Timed out or had any Errors. */
-                    if(CONNECTION->Timeout(TIMEOUT * 1000, Socket::READ))
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::TIMEOUT);
-                        continue;
-                    }
+            /* Disconnect if the socket was disconnected by peer (need for Windows) */
+            if(nEvents & POLLHUP)
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::PEER);
+                return false;
+            }
 
-                    /* Disconnect if pollin signaled with no data for 1ms consistently (This happens on Linux). */
-                    if((POLLFDS.at(nIndex).revents & POLLIN)
-                    && CONNECTION->Timeout(nWait, Socket::READ)
-                    && CONNECTION->Available() == 0)
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::POLL_EMPTY);
-                        continue;
-                    }
+            /* Remove Connection if it has Timed out or had any read/write Errors. */
+            if(CONNECTION->Errors())
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::ERRORS);
+                return false;
+            }
 
-                    /* Disconnect if buffer is full and remote host isn't reading at all. */
-                    if(CONNECTION->Buffered()
-                    && CONNECTION->Timeout(15000, Socket::WRITE))
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::TIMEOUT_WRITE);
-                        continue;
-                    }
+            /* Remove Connection if it has Timed out or had any Errors. */
+            if(CONNECTION->Timeout(TIMEOUT * 1000, Socket::READ))
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::TIMEOUT);
+                return false;
+            }
 
-                    /* Check that write buffers aren't overflowed. */
-                    if(CONNECTION->Buffered() > config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER))
-                    {
-                        remove_connection_with_event(nIndex, DISCONNECT::BUFFER);
-                        continue;
-                    }
+            /* Disconnect if pollin signaled with no data for 1ms consistently (This happens on Linux). */
+            if((nEvents & POLLIN)
+            && CONNECTION->Timeout(nWait, Socket::READ)
+            && CONNECTION->Available() == 0)
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::POLL_EMPTY);
+                return false;
+            }
 
-                    /* Generic event for Connection. */
-                    CONNECTION->Event(EVENTS::GENERIC);
+            /* Disconnect if buffer is full and remote host isn't reading at all. */
+            if(CONNECTION->Buffered()
+            && CONNECTION->Timeout(15000, Socket::WRITE))
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::TIMEOUT_WRITE);
+                return false;
+            }
 
-                    /* Work on Reading a Packet. **/
-                    CONNECTION->ReadPacket();
+            /* Check that write buffers aren't overflowed. */
+            if(CONNECTION->Buffered() > config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER))
+            {
+                remove_connection_with_event(nIndex, DISCONNECT::BUFFER);
+                return false;
+            }
 
-                    /* Handle any DDOS Filters. */
-                    if(fDDOS.load() && CONNECTION->DDOS && !CONNECTION->addr.IsLocal())
-                    {
-                        /* Ban a node if it has too many Requests per Second. **/
-                        if(CONNECTION->DDOS->rSCORE.Score() > DDOS_rSCORE
-                        || CONNECTION->DDOS->cSCORE.Score() > DDOS_cSCORE)
-                            CONNECTION->DDOS->Ban();
+            /* Generic event for Connection. */
+            CONNECTION->Event(EVENTS::GENERIC);
 
-                        /* Remove a connection if it was banned by DDOS Protection. */
-                        if(!CONNECTION->GetAddress().IsLocal() && CONNECTION->DDOS->Banned())
-                        {
-                            debug::log(0, ProtocolType::Name(), " BANNED: ", CONNECTION->GetAddress().ToString());
-                            remove_connection_with_event(nIndex, DISCONNECT::DDOS);
-                            continue;
-                        }
-                    }
+            /* Work on Reading a Packet. **/
+            CONNECTION->ReadPacket();
 
-                    /* If a Packet was received successfully, increment request count [and DDOS count if enabled]. */
-                    if(CONNECTION->PacketComplete())
-                    {
-                        /* Debug dump of message type. */
-                        if(config::nVerbose.load() >= 4)
-                            debug::log(4, FUNCTION, "Received Message (", CONNECTION->INCOMING.GetBytes().size(), " bytes)");
+            /* Handle any DDOS Filters. */
+            if(fDDOS.load() && CONNECTION->DDOS && !CONNECTION->addr.IsLocal())
+            {
+                /* Ban a node if it has too many Requests per Second. **/
+                if(CONNECTION->DDOS->rSCORE.Score() > DDOS_rSCORE
+                || CONNECTION->DDOS->cSCORE.Score() > DDOS_cSCORE)
+                    CONNECTION->DDOS->Ban();
 
-                        /* Debug dump of packet data. */
-                        if(config::nVerbose.load() >= 5)
-                            PrintHex(CONNECTION->INCOMING.GetBytes());
+                /* Remove a connection if it was banned by DDOS Protection. */
+                if(!CONNECTION->GetAddress().IsLocal() && CONNECTION->DDOS->Banned())
+                {
+                    debug::log(0, ProtocolType::Name(), " BANNED: ", CONNECTION->GetAddress().ToString());
+                    remove_connection_with_event(nIndex, DISCONNECT::DDOS);
+                    return false;
+                }
+            }
 
-                        /* Handle Meters and DDOS. */
-                        if(fMETER)
-                            ++ProtocolType::REQUESTS;
+            /* Process every packet our receive buffer completes, up to a limit so one connection can't starve the rest. */
+            for(uint32_t nPackets = 0; nPackets < MAX_PACKETS_PER_READ && CONNECTION->PacketComplete(); ++nPackets)
+            {
+                /* Debug dump of message type. */
+                if(config::nVerbose.load() >= 4)
+                    debug::log(4, FUNCTION, "Received Message (", CONNECTION->INCOMING.GetBytes().size(), " bytes)");
 
-                        /* Packet Process return value of False will flag Data Thread to Disconnect. */
-                        if(!CONNECTION->ProcessPacket())
-                        {
-                            remove_connection_with_event(nIndex, DISCONNECT::FORCE);
-                            continue;
-                        }
+                /* Debug dump of packet data. */
+                if(config::nVerbose.load() >= 5)
+                    PrintHex(CONNECTION->INCOMING.GetBytes());
 
-                        /* Increment rScore. */
-                        if(fDDOS.load() && CONNECTION->DDOS)
-                            CONNECTION->DDOS->rSCORE += 1;
+                /* Handle Meters and DDOS. */
+                if(fMETER)
+                    ++ProtocolType::REQUESTS;
 
-                        /* Run procssed event for connection triggers. */
-                        CONNECTION->Event(EVENTS::PROCESSED);
-                        CONNECTION->ResetPacket();
-                    }
-                }
-                catch(const std::exception& e)
+                /* Packet Process return value of False will flag Data Thread to Disconnect. */
+                if(!CONNECTION->ProcessPacket())
                 {
-                    debug::error(FUNCTION, "Data Connection: ", e.what());
-                    remove_connection_with_event(nIndex, DISCONNECT::ERRORS);
+                    remove_connection_with_event(nIndex, DISCONNECT::FORCE);
+                    return false;
                 }
+
+                /* Increment rScore. */
+                if(fDDOS.load() && CONNECTION->DDOS)
+                    CONNECTION->DDOS->rSCORE += 1;
+
+                /* Run procssed event for connection triggers. */
+                CONNECTION->Event(EVENTS::PROCESSED);
+                CONNECTION->ResetPacket();
+
+                /* Parse our next packet if we have more buffered. */
+                if(CONNECTION->Connected() && CONNECTION->Received() > 0)
+                    CONNECTION->ReadPacket();
             }
+
+            /* Check if we have more packets buffered than we processed this pass. */
+            return CONNECTION->Connected() && CONNECTION->Received() > 0;
         }
+        catch(const std::exception& e)
+        {
+            debug::error(FUNCTION, "Data Connection: ", e.what());
+            remove_connection_with_event(nIndex, DISCONNECT::ERRORS);
+        }
+
+        return false;
     }
 
 
@@ -466,27 +615,29 @@ namespace LLP
                 continue;
             }
 
-            /* Pair to store the relay from the queue. */
-            std::pair<typename ProtocolType::message_t, DataStream> qRelay =
-                std::make_pair(typename ProtocolType::message_t(), DataStream(SER_NETWORK, MIN_PROTO_VERSION));
+            /* Take every queued relay at once, so that they all go out to each connection in one flush. */
+            std::queue<std::pair<typename ProtocolType::message_t, DataStream>> queueRelay;
+            RELAY->swap(queueRelay);
 
-            /* Grab data from queue. */
-            if(!RELAY->empty())
+            /* Move our relays into a vector so connections can walk them in order. */
+            std::vector<std::pair<typename ProtocolType::message_t, DataStream>> vRelay;
+            vRelay.reserve(queueRelay.size());
+            while(!queueRelay.empty())
             {
-                /* Make a copy of the relay data. */
-                qRelay = RELAY->front();
-                RELAY->pop();
+                vRelay.push_back(std::move(queueRelay.front()));
+                queueRelay.pop();
             }
 
+            /* Packets we've serialized for each relay, by the length of their filtered data. Connections that filter a
+               relay down to the same data share one immutable buffer, rather than each getting their own copy. */
+            std::vector<std::vector<std::pair<uint32_t, std::shared_ptr<const std::vector<uint8_t>>>>> vPackets(vRelay.size());
+
             /* Check all connections for data and packets. */
             uint32_t nSize = CONNECTIONS->size();
             for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
             {
                 try
                 {
-                    /* Reset stream read position. */
-                    qRelay.second.Reset();
-
                     /* Get shared pointer to prevent race condition on the internal connection pointer. */
                     std::shared_ptr<ProtocolType> CONNECTION = CONNECTIONS->at(nIndex);
 
@@ -494,16 +645,42 @@ namespace LLP
                     if(!CONNECTION || !CONNECTION->Connected())
                         continue;
 
-                    /* Relay if there are active subscriptions. */
-                    const DataStream ssRelay = CONNECTION->RelayFilter(qRelay.first, qRelay.second);
-                    if(ssRelay.size() != 0)
+                    /* Queue each of our relays without sending, so that our flush can gather them together. */
+                    for(uint32_t nRelay = 0; nRelay < vRelay.size(); ++nRelay)
                     {
-                        /* Build the sender packet. */
-                        typename ProtocolType::packet_t PACKET = typename ProtocolType::packet_t(qRelay.first);
-                        PACKET.SetData(ssRelay);
+                        /* Reset stream read position. */
+                        vRelay[nRelay].second.Reset();
+
+                        /* Relay if there are active subscriptions. */
+                        const DataStream ssRelay = CONNECTION->RelayFilter(vRelay[nRelay].first, vRelay[nRelay].second);
+                        if(ssRelay.size() == 0)
+                            continue;
+
+                        /* Check for a packet we already built with this same data. */
+                        std::shared_ptr<const std::vector<uint8_t>> pPacket;
+                        for(const auto& pairPacket : vPackets[nRelay])
+                        {
+                            /* Our data is at the end of the packet, after its header. */
+                            if(pairPacket.first == ssRelay.size()
+                            && std::equal(ssRelay.begin(), ssRelay.end(), pairPacket.second->end() - ssRelay.size()))
+                            {
+                                pPacket = pairPacket.second;
+                                break;
+                            }
+                        }
+
+                        /* Build the sender packet if this is new data. */
+                        if(!pPacket)
+                        {
+                            typename ProtocolType::packet_t PACKET = typename ProtocolType::packet_t(vRelay[nRelay].first);
+                            PACKET.SetData(ssRelay);
+
+                            pPacket = std::make_shared<const std::vector<uint8_t>>(PACKET.GetBytes());
+                            vPackets[nRelay].push_back(std::make_pair(static_cast<uint32_t>(ssRelay.size()), pPacket));
+                        }
 
                         /* Write packet to socket. */
-                        CONNECTION->WritePacket(PACKET);
+                        CONNECTION->WritePacket(pPacket, false);
                     }
 
                     /* Attempt to flush data when buffer is available. */
@@ -604,12 +781,72 @@ namespace LLP
         else
             --nOutbound;
 
+        /* Stop watching the socket, since a worker may keep the connection open after we drop it. */
+        forget_connection(CONNECTIONS->at(nIndex)->fd);
+
         /* Free the memory and notify threads. */
         CONNECTIONS->at(nIndex) = nullptr;
         CONDITION.notify_all();
     }
 
 
+    /* Register a connection's socket with our epoll instance. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::watch_connection(const uint32_t nSlot, const int32_t nSocket)
+    {
+    #ifdef __linux__
+        /* Check that we are using epoll. */
+        if(nEpoll < 0)
+            return;
+
+        /* Keep our socket with our slot, so we can tell if an event is for a connection that has since been replaced. */
+        epoll_event tEvent;
+        tEvent.events   = EPOLLIN;
+        tEvent.data.u64 = (static_cast<uint64_t>(static_cast<uint32_t>(nSocket)) << 32) | nSlot;
+
+        if(epoll_ctl(nEpoll, EPOLL_CTL_ADD, nSocket, &tEvent) < 0)
+            debug::error(FUNCTION, "epoll_ctl failed to add socket ", nSocket, " (", strerror(errno), ")");
+    #endif
+    }
+
+
+    /* Remove a connection's socket from our epoll instance. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::forget_connection(const int32_t nSocket)
+    {
+    #ifdef __linux__
+        /* Check that we are using epoll and that our socket is still open. */
+        if(nEpoll < 0 || nSocket < 0)
+            return;
+
+        /* A socket that was already closed has left our epoll set on its own, so we don't report errors here. */
+        epoll_event tEvent;
+        epoll_ctl(nEpoll, EPOLL_CTL_DEL, nSocket, &tEvent);
+    #endif
+    }
+
+
+    /* Open the epoll instance for a data thread if it is enabled. */
+    template <class ProtocolType>
+    int32_t DataThread<ProtocolType>::open_epoll()
+    {
+    #ifdef __linux__
+        /* Check if we should fall back to poll. */
+        if(!config::GetBoolArg("-llpepoll", true))
+            return -1;
+
+        /* Create our instance, falling back to poll if this fails. */
+        const int32_t nEpoll = epoll_create1(EPOLL_CLOEXEC);
+        if(nEpoll < 0)
+            debug::error(FUNCTION, "epoll_create1 failed, falling back to poll (", strerror(errno), ")");
+
+        return nEpoll;
+    #else
+        return -1;
+    #endif
+    }
+
+
     /* Returns the index of a component of the CONNECTIONS vector that has been flagged Disconnected */
     template <class ProtocolType>
     uint32_t DataThread<ProtocolType>::find_slot()
@@ -87,8 +87,18 @@ namespace LLP
                 /* Read content if there is some. */
                 if(INCOMING.fHeader)
                 {
-                    INCOMING.strContent += std::string(vchBuffer.begin(), vchBuffer.end());
-                    vchBuffer.clear();
+                    /* Requests without a body leave anything after their header for the next request. */
+                    if(INCOMING.strType == "GET")
+                        return;
+
+                    /* Only take up to our content length, so that pipelined requests stay in our buffer. */
+                    uint64_t nTake = vchBuffer.size();
+                    if(INCOMING.nContentLength > 0)
+                        nTake = std::min(nTake, uint64_t(INCOMING.nContentLength - INCOMING.strContent.size()));
+
+                    INCOMING.strContent += std::string(vchBuffer.begin(), vchBuffer.begin() + nTake);
+                    vchBuffer.erase(vchBuffer.begin(), vchBuffer.begin() + nTake);
+
                     return;
                 }
 
@@ -162,6 +172,17 @@ namespace LLP
     }
 
 
+    /* Get the total bytes in our read buffer that we can parse. */
+    uint32_t HTTPNode::Received() const
+    {
+        /* Partial header lines can't be parsed until the rest arrives on our socket. */
+        if(!INCOMING.fHeader && std::find(vchBuffer.begin(), vchBuffer.end(), '\n') == vchBuffer.end())
+            return 0;
+
+        return static_cast<uint32_t>(vchBuffer.size());
+    }
+
+
     /* Returns an HTTP packet with response code and content. */
     void HTTPNode::PushResponse(const uint16_t nMsg, const std::string& strContent)
     {
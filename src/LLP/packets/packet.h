@@ -186,7 +186,20 @@ namespace LLP
          **/
         void SetLength(const std::vector<uint8_t> &BYTES)
         {
-            LENGTH = (BYTES[0] << 24) + (BYTES[1] << 16) + (BYTES[2] << 8) + (BYTES[3]);
+            SetLength(&BYTES[0]);
+        }
+
+
+        /** SetLength
+         *
+         *  Sets the size of the packet from a buffer of bytes.
+         *
+         *  @param[in] pBytes The four bytes to set length from.
+         *
+         **/
+        void SetLength(const uint8_t* pBytes)
+        {
+            LENGTH = (pBytes[0] << 24) + (pBytes[1] << 16) + (pBytes[2] << 8) + (pBytes[3]);
         }
 
 
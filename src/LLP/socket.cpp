@@ -11,6 +11,7 @@
 
 ____________________________________________________________________________________________*/
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <stdio.h>
@@ -24,6 +25,7 @@ ________________________________________________________________________________
 #ifndef WIN32
 #include <arpa/inet.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #endif
 
 #include <openssl/ssl.h>
@@ -43,7 +45,8 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , queueBuffer        ( )
+    , nBufferOffset      (0)
     , nBufferSize        (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
@@ -67,7 +70,8 @@ namespace LLP
     , nLastSend          (socket.nLastSend.load())
     , nLastRecv          (socket.nLastRecv.load())
     , nError             (socket.nError.load())
-    , vBuffer            (socket.vBuffer)
+    , queueBuffer        (socket.queueBuffer)
+    , nBufferOffset      (socket.nBufferOffset)
     , nBufferSize        (socket.nBufferSize.load())
     , fBufferFull        (socket.fBufferFull.load())
     , nConsecutiveErrors (socket.nConsecutiveErrors.load())
@@ -103,7 +107,8 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , queueBuffer        ( )
+    , nBufferOffset      (0)
     , nBufferSize        (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
@@ -258,7 +263,8 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , queueBuffer        ( )
+    , nBufferOffset      (0)
     , nBufferSize        (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
@@ -655,6 +661,13 @@ namespace LLP
 
     /* Read data from the socket buffer non-blocking */
     int Socket::Read(std::vector<uint8_t> &vData, size_t nBytes)
+    {
+        return Read(&vData[0], nBytes);
+    }
+
+
+    /* Read data from the socket buffer non-blocking */
+    int32_t Socket::Read(uint8_t* pData, size_t nBytes)
     {
         RECURSIVE(SOCKET_MUTEX);
 
@@ -664,13 +677,13 @@ namespace LLP
         int32_t nRead = 0;
 
         if(pSSL)
-            nRead = SSL_read(pSSL, (int8_t*)&vData[0], nBytes);
+            nRead = SSL_read(pSSL, (int8_t*)pData, nBytes);
         else
         {
         #ifdef WIN32
-            nRead = static_cast<int32_t>(recv(fd, (char*)&vData[0], nBytes, MSG_DONTWAIT));
+            nRead = static_cast<int32_t>(recv(fd, (char*)pData, nBytes, MSG_DONTWAIT));
         #else
-            nRead = static_cast<int32_t>(recv(fd, (int8_t*)&vData[0], nBytes, MSG_DONTWAIT));
+            nRead = static_cast<int32_t>(recv(fd, (int8_t*)pData, nBytes, MSG_DONTWAIT));
         #endif
         }
 
@@ -833,60 +846,73 @@ namespace LLP
     /* Write data into the socket buffer non-blocking */
     int32_t Socket::Write(const std::vector<uint8_t>& vData, size_t nBytes)
     {
-        int32_t nSent = 0;
+        LOCK(BUFFER_MUTEX);
 
-        /* Check overflow buffer. */
-        if(nBufferSize.load() > 0)
+        /* Check overflow buffer, since our data must go out after what's already queued. */
+        if(!queueBuffer.empty())
         {
-            LOCK(BUFFER_MUTEX);
-
-            /* Insert data into the buffer. */
-            vBuffer.insert(vBuffer.end(), vData.begin(), vData.end());
+            /* Queue a copy of our data. */
+            queueBuffer.push_back(std::make_shared<const std::vector<uint8_t>>(vData.begin(), vData.end()));
 
-            /* Set our atomic with size of vector. */
-            nBufferSize.store(vBuffer.size());
+            /* Set our atomic with size of our queue. */
+            nBufferSize += vData.size();
 
             return static_cast<int32_t>(nBytes);
         }
 
         /* Write the packet. */
+        const int32_t nSent = send_bytes(&vData[0], nBytes);
+
+        /* If not all data was sent non-blocking, queue the rest for Flush. */
+        if(nSent >= 0 && nSent != vData.size())
         {
-            RECURSIVE(SOCKET_MUTEX);
+            /* Insert remaining data into the buffer. */
+            queueBuffer.push_back(std::make_shared<const std::vector<uint8_t>>(vData.begin() + nSent, vData.end()));
 
-            if(pSSL)
-                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t*)&vData[0], nBytes));
-            else
-            {
-            #ifdef WIN32
-                nSent = static_cast<int32_t>(send(fd, (char*)&vData[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #else
-                nSent = static_cast<int32_t>(send(fd, (int8_t*)&vData[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #endif
-            }
+            /* Set our atomic with size of our queue. */
+            nBufferSize += (vData.size() - nSent);
         }
+        else if(nSent > 0) //don't update last sent unless all the data was written to the buffer
+            nLastSend = runtime::timestamp(true);
+
+        return nSent;
+    }
 
 
-        /* Handle for error state. */
-        if(nSent < 0)
+    /* Write a shared buffer to the socket non-blocking. */
+    int32_t Socket::Write(const std::shared_ptr<const std::vector<uint8_t>>& pData, const bool fSend)
+    {
+        /* Check for empty buffers, which we never queue. */
+        if(!pData || pData->empty())
+            return 0;
+
+        LOCK(BUFFER_MUTEX);
+
+        /* Check overflow buffer, since our data must go out after what's already queued. */
+        if(!fSend || !queueBuffer.empty())
         {
-            if(pSSL)
-                nError = SSL_get_error(pSSL, nSent);
-            else
-                nError = WSAGetLastError();
+            /* Queue our buffer by reference. */
+            queueBuffer.push_back(pData);
+
+            /* Set our atomic with size of our queue. */
+            nBufferSize += pData->size();
+
+            return static_cast<int32_t>(pData->size());
         }
 
-        /* If not all data was sent non-blocking, recurse until it is complete. */
-        else if(nSent != vData.size())
-        {
-            LOCK(BUFFER_MUTEX);
+        /* Write the packet. */
+        const int32_t nSent = send_bytes(&(*pData)[0], pData->size());
 
-            /* Insert remaining data into the buffer. */
-            vBuffer.insert(vBuffer.end(), vData.begin() + nSent, vData.end());
+        /* If not all data was sent non-blocking, queue the buffer from where our send stopped. */
+        if(nSent >= 0 && nSent != pData->size())
+        {
+            queueBuffer.push_back(pData);
+            nBufferOffset = nSent;
 
-            /* Set our atomic with size of vector. */
-            nBufferSize.store(vBuffer.size());
+            /* Set our atomic with size of our queue. */
+            nBufferSize += (pData->size() - nSent);
         }
-        else //don't update last sent unless all the data was written to the buffer
+        else if(nSent > 0) //don't update last sent unless all the data was written to the buffer
             nLastSend = runtime::timestamp(true);
 
         return nSent;
@@ -896,60 +922,84 @@ namespace LLP
     /* Flushes data out of the overflow buffer */
     int Socket::Flush()
     {
-        int32_t nSent   = 0;
-        uint32_t nBytes = 0;
-        uint32_t nSize  =
-            static_cast<uint32_t>(nBufferSize.load());
-
         /* Don't flush if buffer doesn't have any data. */
-        if(nSize == 0)
+        if(nBufferSize.load() == 0)
             return 0;
 
         /* maximum transmission unit. */
-        const uint32_t MTU = 16384;
+        const uint64_t MTU = 16384;
 
         /* Set the maximum bytes to flush to 2^16 or maximum socket buffers. */
-        nBytes = std::min(nSize, std::min((uint32_t)config::GetArg("-maxsendsize", MTU), MTU));
+        const uint64_t nMaxSend =
+            std::min(static_cast<uint64_t>(config::GetArg("-maxsendsize", MTU)), MTU);
+
+        LOCK(BUFFER_MUTEX);
+
+        /* Check our queue again now that we hold the lock. */
+        if(queueBuffer.empty())
+            return 0;
 
         /* If there were any errors, handle them gracefully. */
+        int32_t nSent = 0;
+    #ifndef WIN32
+        if(!pSSL)
         {
-            RECURSIVE(SOCKET_MUTEX);
+            /* Gather as many queued buffers as fit in one send, so batched messages only cost one syscall. */
+            iovec vIO[64];
 
-            if(pSSL)
-                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t *)&vBuffer[0], nBytes));
-            else
+            uint32_t nCount  = 0;
+            uint64_t nTotal  = 0;
+            uint64_t nOffset = nBufferOffset;
+            for(const auto& pBuffer : queueBuffer)
             {
-            #ifdef WIN32
-                nSent = static_cast<int32_t>(send(fd, (char*)&vBuffer[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #else
-                nSent = static_cast<int32_t>(send(fd, (int8_t*)&vBuffer[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #endif
+                /* Check our limits. */
+                if(nCount == 64 || nTotal >= nMaxSend)
+                    break;
+
+                /* Add as much of this buffer as we have room for. */
+                const uint64_t nBytes = std::min(pBuffer->size() - nOffset, nMaxSend - nTotal);
+                vIO[nCount].iov_base  = const_cast<uint8_t*>(&(*pBuffer)[nOffset]);
+                vIO[nCount].iov_len   = nBytes;
+
+                nTotal += nBytes;
+                nOffset = 0;
+
+                ++nCount;
+            }
+
+            /* Build our message for sendmsg, since writev can't take flags to suppress SIGPIPE. */
+            msghdr tMessage;
+            std::memset(&tMessage, 0, sizeof(tMessage));
+
+            tMessage.msg_iov    = vIO;
+            tMessage.msg_iovlen = nCount;
+
+            {
+                RECURSIVE(SOCKET_MUTEX);
+                nSent = static_cast<int32_t>(sendmsg(fd, &tMessage, MSG_NOSIGNAL | MSG_DONTWAIT));
             }
+
+            /* Handle for error state. */
+            if(nSent < 0)
+                nError = WSAGetLastError();
+        }
+        else
+    #endif
+        {
+            /* SSL records can't be gathered, so send from the front buffer only. */
+            const std::vector<uint8_t>& vFront = *queueBuffer.front();
+            nSent = send_bytes(&vFront[nBufferOffset], std::min(vFront.size() - nBufferOffset, nMaxSend));
         }
 
         /* Handle errors on flush. */
         if(nSent < 0)
-        {
-            if(pSSL)
-                nError = SSL_get_error(pSSL, nSent);
-            else
-                nError = WSAGetLastError();
-
             ++nConsecutiveErrors;
-        }
 
         /* If not all data was sent non-blocking, recurse until it is complete. */
         else if(nSent > 0)
         {
-            {
-                LOCK(BUFFER_MUTEX);
-
-                /* Erase from current buffer. */
-                vBuffer.erase(vBuffer.begin(), vBuffer.begin() + nSent);
-
-                /* Set our atomic with size of vector. */
-                nBufferSize.store(vBuffer.size());
-            }
+            /* Remove what was sent from our queue. */
+            pop_sent(nSent);
 
             /* Update socket timers. */
             nLastSend          = runtime::timestamp(true);
@@ -1030,6 +1080,64 @@ namespace LLP
         return nError;
     }
 
+
+    /* Send bytes to the socket non-blocking, setting our error if the send failed. */
+    int32_t Socket::send_bytes(const uint8_t* pData, const size_t nBytes)
+    {
+        int32_t nSent = 0;
+        {
+            RECURSIVE(SOCKET_MUTEX);
+
+            if(pSSL)
+                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t*)pData, nBytes));
+            else
+            {
+            #ifdef WIN32
+                nSent = static_cast<int32_t>(send(fd, (char*)pData, nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+            #else
+                nSent = static_cast<int32_t>(send(fd, (int8_t*)pData, nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+            #endif
+            }
+        }
+
+        /* Handle for error state. */
+        if(nSent < 0)
+        {
+            if(pSSL)
+                nError = SSL_get_error(pSSL, nSent);
+            else
+                nError = WSAGetLastError();
+        }
+
+        return nSent;
+    }
+
+
+    /* Remove bytes that were sent from the front of our buffer queue. */
+    void Socket::pop_sent(uint64_t nSent)
+    {
+        /* Set our atomic with size of our queue. */
+        nBufferSize -= nSent;
+
+        /* Pop every buffer that was sent in full, which is constant time unlike erasing from the front of a vector. */
+        while(nSent > 0 && !queueBuffer.empty())
+        {
+            /* Check for a partial send of our front buffer. */
+            const uint64_t nRemaining = queueBuffer.front()->size() - nBufferOffset;
+            if(nSent < nRemaining)
+            {
+                nBufferOffset += nSent;
+                break;
+            }
+
+            /* Pop our buffer once it was sent in full. */
+            nSent -= nRemaining;
+            nBufferOffset = 0;
+
+            queueBuffer.pop_front();
+        }
+    }
+
     /*  Creates or destroys the SSL object depending on the flag set. */
     void Socket::SetSSL(bool fSSL)
     {
@@ -32,6 +32,14 @@ namespace LLP
     class DDOS_Filter;
 
 
+    /** Size of the buffer each connection receives socket data into. **/
+    const uint32_t RECV_BUFFER_SIZE = 64 * 1024; //64KB receive buffer
+
+
+    /** Largest packet storage a connection keeps between packets. **/
+    const uint32_t MAX_PACKET_RESERVE = 1024 * 1024; //1MB kept for reuse
+
+
     /** BaseConnection
      *
      *  Base Template class to handle outgoing / incoming LLP data for both Client and Server.
@@ -74,6 +82,28 @@ namespace LLP
         virtual bool ProcessPacket() = 0;
 
 
+        /** Receive
+         *
+         *  Read everything waiting on the socket into our receive buffer with a single read.
+         *
+         *  @return the total bytes that were read.
+         *
+         **/
+        int32_t Receive();
+
+
+        /** Consume
+         *
+         *  Take bytes from the front of our receive buffer. The returned pointer is only valid until the next Receive.
+         *
+         *  @param[in] nBytes The total bytes to take, which must not be more than Received().
+         *
+         *  @return a pointer to the bytes that were taken.
+         *
+         **/
+        const uint8_t* Consume(const uint32_t nBytes);
+
+
     public:
 
         /** Incoming Packet Being Built. **/
@@ -150,6 +180,18 @@ namespace LLP
         std::map<message_t, Trigger*> TRIGGERS;
 
 
+        /** Bytes received from the socket that haven't been parsed into packets yet. **/
+        std::vector<uint8_t> vRecv;
+
+
+        /** Offset of the first unparsed byte in our receive buffer. **/
+        uint32_t nRecvBegin;
+
+
+        /** Offset past the last received byte in our receive buffer. **/
+        uint32_t nRecvEnd;
+
+
     public:
 
 
@@ -280,6 +322,14 @@ namespace LLP
         bool PacketComplete() const;
 
 
+        /** Received
+         *
+         *  Get the total bytes in our receive buffer that haven't been parsed yet.
+         *
+         **/
+        virtual uint32_t Received() const;
+
+
         /** ResetPacket
          *
          *  Used to reset the packet to Null after it has been processed.
@@ -299,6 +349,17 @@ namespace LLP
         void WritePacket(const PacketType& PACKET);
 
 
+        /** WritePacket
+         *
+         *  Write the bytes of a serialized packet to the TCP stream, sharing the buffer instead of copying it.
+         *
+         *  @param[in] pBytes The serialized packet to write.
+         *  @param[in] fSend Flag to try sending right away, otherwise the packet waits for the next Flush.
+         *
+         **/
+        void WritePacket(const std::shared_ptr<const std::vector<uint8_t>>& pBytes, const bool fSend = true);
+
+
         /** ReadPacket
          *
          *  Non-Blocking Packet reader to build a packet from TCP Connection.
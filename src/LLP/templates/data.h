@@ -54,6 +54,14 @@ namespace LLP
     }
 
 
+    /** Maximum packets processed from one connection's receive buffer each pass of a data thread. **/
+    const uint32_t MAX_PACKETS_PER_READ = 32;
+
+
+    /** Maximum ready sockets returned from each call to epoll. **/
+    const uint32_t MAX_EPOLL_EVENTS = 256;
+
+
     /** DataThread
      *
      *  Base Template Thread Class for Server base. Used for Core LLP Packet Functionality.
@@ -80,6 +88,10 @@ namespace LLP
         uint32_t DDOS_cSCORE;
 
 
+        /** The epoll instance watching our sockets, or -1 when we poll every socket instead. **/
+        int32_t nEpoll;
+
+
         /* Vector to store Connections. */
         util::atomic::lock_unique_ptr<std::vector< std::shared_ptr<ProtocolType>>> CONNECTIONS;
 
@@ -145,6 +157,9 @@ namespace LLP
                 else
                     CONNECTIONS->at(nSlot) = std::shared_ptr<ProtocolType>(pnode);
 
+                /* Start watching our new socket. */
+                watch_connection(nSlot, pnode->fd);
+
                 /* Check for inbound socket. */
                 if(pnode->Incoming())
                 {
@@ -219,6 +234,9 @@ namespace LLP
                 else
                     CONNECTIONS->at(nSlot) = std::shared_ptr<ProtocolType>(pnode);
 
+                /* Start watching our new socket. */
+                watch_connection(nSlot, pnode->fd);
+
                 /* Check for inbound socket. */
                 if(pnode->Incoming())
                     ++nIncoming;
@@ -380,6 +398,51 @@ namespace LLP
         void remove_connection(const uint32_t nIndex);
 
 
+        /** handle_connection
+         *
+         *  Check a connection for errors and timeouts, then read and process its packets.
+         *
+         *  @param[in] nIndex The data thread index of the connection.
+         *  @param[in] nEvents The poll flags that were returned for the connection's socket.
+         *  @param[in] nWait The milliseconds to wait before an empty read disconnects.
+         *
+         *  @return true if the connection has packets buffered that it didn't process yet.
+         *
+         **/
+        bool handle_connection(const uint32_t nIndex, const uint32_t nEvents, const uint32_t nWait);
+
+
+        /** watch_connection
+         *
+         *  Register a connection's socket with our epoll instance.
+         *
+         *  @param[in] nSlot The data thread index of the connection.
+         *  @param[in] nSocket The socket of the connection.
+         *
+         **/
+        void watch_connection(const uint32_t nSlot, const int32_t nSocket);
+
+
+        /** forget_connection
+         *
+         *  Remove a connection's socket from our epoll instance.
+         *
+         *  @param[in] nSocket The socket of the connection.
+         *
+         **/
+        void forget_connection(const int32_t nSocket);
+
+
+        /** open_epoll
+         *
+         *  Open the epoll instance for a data thread, if it is enabled with -llpepoll and supported.
+         *
+         *  @return the epoll instance, or -1 to fall back to poll.
+         *
+         **/
+        static int32_t open_epoll();
+
+
         /** find_slot
          *
          *  Returns the index of a component of the CONNECTIONS vector that
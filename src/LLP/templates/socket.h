@@ -20,6 +20,8 @@ ________________________________________________________________________________
 
 #include <vector>
 #include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <atomic>
 
@@ -72,8 +74,12 @@ namespace LLP
         std::atomic<int32_t> nError;
 
 
-        /** Oversize buffer for large packets. **/
-        std::vector<uint8_t> vBuffer;
+        /** Queue of buffers waiting to be sent, which may be shared with other sockets. **/
+        std::deque<std::shared_ptr<const std::vector<uint8_t>>> queueBuffer;
+
+
+        /** Bytes of the front buffer in our queue that were already sent. **/
+        uint64_t nBufferOffset;
 
 
         /** Keep track of the buffer with an atomic. */
@@ -187,6 +193,19 @@ namespace LLP
         int32_t Read(std::vector<uint8_t>& vData, size_t nBytes);
 
 
+        /** Read
+         *
+         *  Read data from the socket buffer non-blocking
+         *
+         *  @param[out] pData The buffer to read into
+         *  @param[in] nBytes The total bytes to read
+         *
+         *  @return the total bytes that were read
+         *
+         **/
+        int32_t Read(uint8_t* pData, size_t nBytes);
+
+
         /** Read
          *
          *  Read data from the socket buffer non-blocking
@@ -213,6 +232,20 @@ namespace LLP
         int32_t Write(const std::vector<uint8_t>& vData, size_t nBytes);
 
 
+        /** Write
+         *
+         *  Write a shared buffer to the socket non-blocking. Whatever isn't sent right away is queued by reference,
+         *  so the same buffer can be queued on many sockets without being copied.
+         *
+         *  @param[in] pData The buffer of data to be written.
+         *  @param[in] fSend Flag to try sending right away, otherwise the buffer waits for the next Flush.
+         *
+         *  @return the total bytes that were written or queued.
+         *
+         **/
+        int32_t Write(const std::shared_ptr<const std::vector<uint8_t>>& pData, const bool fSend = true);
+
+
         /** Flush
          *
          *  Flushes data out of the overflow buffer
@@ -295,6 +328,30 @@ namespace LLP
          **/
         int32_t error_code() const;
 
+
+        /** send_bytes
+         *
+         *  Send bytes to the socket non-blocking, setting our error if the send failed.
+         *
+         *  @param[in] pData The bytes to send.
+         *  @param[in] nBytes The total bytes to send.
+         *
+         *  @return the total bytes that were sent.
+         *
+         **/
+        int32_t send_bytes(const uint8_t* pData, const size_t nBytes);
+
+
+        /** pop_sent
+         *
+         *  Remove bytes that were sent from the front of our buffer queue.
+         *  Must be called with BUFFER_MUTEX held.
+         *
+         *  @param[in] nSent The total bytes that were sent.
+         *
+         **/
+        void pop_sent(uint64_t nSent);
+
     };
 
 }
@@ -34,6 +34,7 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/headers.h>
 #include <TAO/Ledger/include/process.h>
 
 #include <TAO/Ledger/types/client.h>
@@ -1271,19 +1272,10 @@ namespace LLP
                                     /* Get a reference of our current locator. */
                                     const uint1024_t& tHave = locator.vHave[n];
 
-                                    /* Check the database for the ancestor block. */
-                                    if(LLD::Ledger->HasBlock(tHave))
+                                    /* Check our header index for the ancestor block being in main chain. */
+                                    if(TAO::Ledger::HeaderIndex::IsInMainChain(tHave))
                                     {
-                                        /* Grab the block that's found. */
-                                        TAO::Ledger::BlockState state;
-                                        if(!LLD::Ledger->ReadBlock(tHave, state))
-                                            return debug::drop(NODE, "failed to read locator block");
-
-                                        /* Check for being in main chain. */
-                                        if(!state.IsInMainChain())
-                                            continue;
-
-                                        hashStart = state.GetHash();
+                                        hashStart = tHave;
                                         break;
                                     }
                                 }
@@ -3166,44 +3158,41 @@ namespace LLP
      *  This keeps thread from spending too much time for each Connection. */
     void TritiumNode::ReadPacket()
     {
-        if(!INCOMING.Complete())
+        /* Parse from our receive buffer first, and only read the socket if that doesn't complete our packet. */
+        for(uint32_t nPass = 0; nPass < 2 && !INCOMING.Complete(); ++nPass)
         {
+            /* Read everything waiting on the socket in one call. */
+            if(nPass > 0 && Receive() <= 0)
+                return;
+
             /** Handle Reading Packet Length Header. **/
-            if(!INCOMING.Header() && Available() >= 8)
+            if(!INCOMING.Header() && Received() >= 8)
             {
-                std::vector<uint8_t> BYTES(8, 0);
-                if(Read(BYTES, 8) == 8)
-                {
-                    DataStream ssHeader(BYTES, SER_NETWORK, MIN_PROTO_VERSION);
-                    ssHeader >> INCOMING;
+                /* Release packet storage that a large packet left behind, smaller storage is reused. */
+                if(INCOMING.DATA.capacity() > MAX_PACKET_RESERVE)
+                    std::vector<uint8_t>().swap(INCOMING.DATA);
 
-                    Event(EVENTS::HEADER);
-                }
+                const char* pHeader = reinterpret_cast<const char*>(Consume(8));
+
+                DataStream ssHeader(pHeader, pHeader + 8, SER_NETWORK, MIN_PROTO_VERSION);
+                ssHeader >> INCOMING;
+
+                Event(EVENTS::HEADER);
             }
 
             /** Handle Reading Packet Data. **/
-            uint32_t nAvailable = Available();
-            if(INCOMING.Header() && nAvailable > 0 && !INCOMING.IsNull() && INCOMING.DATA.size() < INCOMING.LENGTH)
+            const uint32_t nReceived = Received();
+            if(INCOMING.Header() && nReceived > 0 && !INCOMING.IsNull() && INCOMING.DATA.size() < INCOMING.LENGTH)
             {
-                /* The maximum number of bytes to read is th number of bytes specified in the message length,
-                   minus any already read on previous reads*/
-                uint32_t nMaxRead = (uint32_t)(INCOMING.LENGTH - INCOMING.DATA.size());
-
-                /* Vector to receve the read bytes. This should be the smaller of the number of bytes currently available or the
-                   maximum amount to read */
-                std::vector<uint8_t> DATA(std::min(nAvailable, nMaxRead), 0);
-
-                /* Read up to the buffer size. */
-                int32_t nRead = Read(DATA, DATA.size());
+                /* Take the smaller of what is buffered, or what is left of our packet. */
+                const uint32_t nRead = std::min(nReceived, static_cast<uint32_t>(INCOMING.LENGTH - INCOMING.DATA.size()));
 
-                /* If something was read, insert it into the packet data.  NOTE: that due to SSL packet framing we could end up
-                   reading less bytes than appear available.  Therefore we only copy the number of bytes actually read */
-                if(nRead > 0)
-                    INCOMING.DATA.insert(INCOMING.DATA.end(), DATA.begin(), DATA.begin() + nRead);
+                const uint8_t* pData = Consume(nRead);
+                INCOMING.DATA.insert(INCOMING.DATA.end(), pData, pData + nRead);
 
                 /* If the packet is now considered complete, fire the packet complete event */
                 if(INCOMING.Complete())
-                    Event(EVENTS::PACKET, static_cast<uint32_t>(DATA.size()));
+                    Event(EVENTS::PACKET, nRead);
             }
         }
     }
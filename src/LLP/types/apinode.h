@@ -17,6 +17,13 @@ ________________________________________________________________________________
 
 #include <LLP/types/httpnode.h>
 #include <Util/include/json.h>
+#include <Util/include/runtime.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
 
 namespace LLP
 {
@@ -33,9 +40,60 @@ namespace LLP
      *
      *  This could also be used as the base for a HTTP-LLP server implementation.
      *
+     *  Commands are run on the API workers when they are active, so the data threads only parse requests and write
+     *  responses. Requests on the same connection are run one at a time so their responses stay in order.
+     *
      **/
-    class APINode : public HTTPNode
+    class APINode : public HTTPNode, public std::enable_shared_from_this<APINode>
     {
+        /** Request
+         *
+         *  The values of a request that are needed to run it after the incoming packet has been reset.
+         *
+         **/
+        struct Request
+        {
+            /** The command-set being invoked. **/
+            std::string strCommands;
+
+
+            /** The method being invoked. **/
+            std::string strMethod;
+
+
+            /** The parameters of the request. **/
+            encoding::json jParams;
+
+
+            /** The origin header, if supplied. **/
+            std::string strOrigin;
+
+
+            /** The api-error-code header, if supplied. **/
+            std::string strErrorCode;
+
+
+            /** Flag to tell if the connection should be kept alive. **/
+            bool fKeepAlive;
+
+
+            /** Timer for the latency of this request. **/
+            runtime::timer tLatency;
+        };
+
+
+        /** Mutex to protect our pending requests. **/
+        std::mutex PENDING_MUTEX;
+
+
+        /** Requests waiting on the request in progress for this connection, and responses queued behind it. **/
+        std::queue<std::pair<uint8_t, std::function<void()>>> queuePending;
+
+
+        /** Flag to tell if a request is in progress on the workers. **/
+        std::atomic<bool> fProcessing;
+
+
     public:
 
         /** Name
@@ -94,6 +152,61 @@ namespace LLP
          **/
         bool Authorized(std::map<std::string, std::string>& mapHeaders);
 
+
+    private:
+
+        /** Execute
+         *
+         *  Invoke the command of a request and write its response.
+         *
+         *  @param[in] tRequest The request to execute.
+         *
+         **/
+        void Execute(Request& tRequest);
+
+
+        /** Respond
+         *
+         *  Write the response for a request.
+         *
+         *  @param[in] tRequest The request we are responding to.
+         *  @param[in] nStatus The HTTP status code of the response.
+         *  @param[in] jRet The JSON to respond with.
+         *
+         **/
+        void Respond(const Request& tRequest, const uint16_t nStatus, encoding::json& jRet);
+
+
+        /** Dispatch
+         *
+         *  Hand a request off to the API workers, behind any request already in progress on this connection.
+         *
+         *  @param[in] nClass The class of worker queue to run on.
+         *  @param[in] fnRequest The request to run.
+         *
+         *  @return false if the worker queue is full.
+         *
+         **/
+        bool Dispatch(const uint8_t nClass, const std::function<void()>& fnRequest);
+
+
+        /** Sequence
+         *
+         *  Write a response that has no command to run, behind any request already in progress on this connection.
+         *
+         *  @param[in] fnResponse The function that writes our response.
+         *
+         **/
+        void Sequence(const std::function<void()>& fnResponse);
+
+
+        /** Next
+         *
+         *  Hand the next pending request on this connection off to the API workers.
+         *
+         **/
+        void Next();
+
     };
 }
 
@@ -111,6 +111,14 @@ namespace LLP
         void ReadPacket() final;
 
 
+        /** Received
+         *
+         *  Get the total bytes in our read buffer that we can parse, so partial header lines wait on our socket.
+         *
+         **/
+        uint32_t Received() const final;
+
+
         /** PushResponse
          *
          *  Returns an HTTP packet with response code and content.
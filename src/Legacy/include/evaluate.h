@@ -28,6 +28,9 @@ ________________________________________________________________________________
 
 namespace Legacy
 {
+    /* Forward declarations. */
+    class SignatureHasher;
+
 
     /** Eval Script
      *
@@ -38,11 +41,13 @@ namespace Legacy
      *  @param[in] txTo The transaction this is executing for.
      *  @param[in] nIn The input in.
      *  @param[in] nHashType The hash type enumeration.
+     *  @param[in] pHasher The precomputed signature hashes for txTo, if any.
      *
      *  @return true if the script evaluates to true.
      *
      **/
-    bool EvalScript(std::vector< std::vector<uint8_t> >& stack, const Script& script, const Transaction& txTo, uint32_t nIn, int32_t nHashType);
+    bool EvalScript(std::vector< std::vector<uint8_t> >& stack, const Script& script, const Transaction& txTo, uint32_t nIn,
+                    int32_t nHashType, SignatureHasher* pHasher = nullptr);
 
 
     /** Solver
@@ -165,11 +170,13 @@ namespace Legacy
      *  @param[in] txTo The destination transaciton being signed.
      *  @param[in] nIn The output to verify signature for.
      *  @param[in] nHashType The hash type for signature.
+     *  @param[in] pHasher The precomputed signature hashes for txTo, if any.
      *
      *  @return true if the script was verified valid.
      *
      **/
-    bool VerifyScript(const Script& scriptSig, const Script& scriptPubKey, const Transaction& txTo, uint32_t nIn, int32_t nHashType);
+    bool VerifyScript(const Script& scriptSig, const Script& scriptPubKey, const Transaction& txTo, uint32_t nIn,
+                      int32_t nHashType, SignatureHasher* pHasher = nullptr);
 
 
     /** ExtractRegister
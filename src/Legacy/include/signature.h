@@ -16,6 +16,7 @@ ________________________________________________________________________________
 #define NEXUS_LEGACY_INCLUDE_SIGNATURE_H
 
 #include <LLC/types/bignum.h>
+#include <LLC/hash/SK/skein.h>
 #include <Legacy/wallet/basickeystore.h>
 #include <Util/include/base58.h>
 
@@ -26,6 +27,121 @@ ________________________________________________________________________________
 namespace Legacy
 {
 
+    /** @class
+     *
+     *  Precomputed serialization of a transaction with its input scripts blanked out, along with the hash
+     *  midstate at the start of each input, so that the signature hash of every input doesn't copy and
+     *  re-serialize the whole transaction. Built lazily on first use, and only valid while txTo is unchanged.
+     *
+     **/
+    class SignatureHasher
+    {
+        /** The transaction that is being verified. **/
+        const Transaction& txTo;
+
+
+        /** The serialized transaction with every input script blanked out. **/
+        std::vector<uint8_t> vBlank;
+
+
+        /** The offset of each input into our blanked serialization, with the end of the inputs last. **/
+        std::vector<uint64_t> vOffsets;
+
+
+        /** The skein midstate of our blanked serialization at the start of each input. **/
+        std::vector<Skein_256_Ctxt_t> vMidstates;
+
+
+        /** The last signature hash we calculated, which multisig checks against every key. **/
+        Script scriptLast;
+        uint32_t nInLast;
+        int32_t nHashTypeLast;
+        uint256_t hashLast;
+
+
+    public:
+
+        /** Default Constructor. **/
+        SignatureHasher() = delete;
+
+
+        /** Constructor
+         *
+         *  @param[in] txToIn The transaction that is being verified.
+         *
+         **/
+        SignatureHasher(const Transaction& txToIn);
+
+
+        /** Copy Constructor. **/
+        SignatureHasher(const SignatureHasher& hasher) = delete;
+
+
+        /** Move Constructor. **/
+        SignatureHasher(SignatureHasher&& hasher) = delete;
+
+
+        /** Hash
+         *
+         *  Returns the same hash as SignatureHash for the given input of our transaction.
+         *
+         *  @param[in] scriptCode The input script object.
+         *  @param[in] nIn The input that is being signed.
+         *  @param[in] nHashType The hash type that is used to generate this signature hash.
+         *
+         *  @return The hash for use in signing.
+         *
+         **/
+        uint256_t Hash(const Script& scriptCode, const uint32_t nIn, const int32_t nHashType);
+
+
+    private:
+
+        /** build_midstates
+         *
+         *  Serialize our blanked transaction and record the midstate at each input.
+         *
+         **/
+        void build_midstates();
+
+    };
+
+
+    /** SignatureCache
+     *
+     *  Cache of signatures that have already been verified, so that a transaction verified when it is accepted
+     *  into the memory pool is not verified again when its block is connected.
+     *
+     **/
+    namespace SignatureCache
+    {
+        /** Has
+         *
+         *  Check if a signature has already been verified.
+         *
+         *  @param[in] hashSig The signature hash that was signed.
+         *  @param[in] vchPubKey The byte vector of the public key.
+         *  @param[in] vchSig The byte vector of signature data.
+         *
+         *  @return true if this signature was verified for this key and hash.
+         *
+         **/
+        bool Has(const uint256_t& hashSig, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig);
+
+
+        /** Add
+         *
+         *  Add a valid signature to the cache.
+         *
+         *  @param[in] hashSig The signature hash that was signed.
+         *  @param[in] vchPubKey The byte vector of the public key.
+         *  @param[in] vchSig The byte vector of signature data.
+         *
+         **/
+        void Add(const uint256_t& hashSig, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig);
+    }
+
+
     /** Sign 1
      *
      *  Signs for a single signature transaction.
@@ -83,11 +199,13 @@ namespace Legacy
      *  @param[in] txTo The transaction being sent to.
      *  @param[in] nIn The input being spent.
      *  @param[in] nHashType The hash type used for signature.
+     *  @param[in] pHasher The precomputed signature hashes for txTo, if any.
      *
      *  @return true if the signature is valid.
      *
      **/
-    bool CheckSig(std::vector<uint8_t> vchSig, std::vector<uint8_t> vchPubKey, Script scriptCode, const Transaction& txTo, uint32_t nIn, int32_t nHashType);
+    bool CheckSig(const std::vector<uint8_t>& vchSig, const std::vector<uint8_t>& vchPubKey, const Script& scriptCode,
+                  const Transaction& txTo, uint32_t nIn, int32_t nHashType, SignatureHasher* pHasher = nullptr);
 
 
     /** Sign Signature
@@ -114,11 +232,13 @@ namespace Legacy
      *  @param[in] txTo The destination transaciton being signed.
      *  @param[in] nIn The output to verify signature for.
      *  @param[in] nHashType The hash type for signature.
+     *  @param[in] pHasher The precomputed signature hashes for txTo, if any.
      *
      *  @return true if signature was verified successfully.
      *
      **/
-    bool VerifySignature(const Transaction& txFrom, const Transaction& txTo, uint32_t nIn, int32_t nHashType);
+    bool VerifySignature(const Transaction& txFrom, const Transaction& txTo, uint32_t nIn, int32_t nHashType,
+                         SignatureHasher* pHasher = nullptr);
 
 }
 
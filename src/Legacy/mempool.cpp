@@ -50,6 +50,7 @@ namespace TAO
 
             /* Add to the map. */
             mapLegacy[nTxHash] = tx;
+            ++nGeneration;
 
             return true;
         }
@@ -230,6 +231,7 @@ namespace TAO
 
             /* Add to the legacy map. */
             mapLegacy[hashTx] = tx;
+            ++nGeneration;
 
             /* Relay tx if creating ourselves. */
             if(!pnode && LLP::TRITIUM_SERVER)
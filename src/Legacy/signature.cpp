@@ -14,6 +14,8 @@ ________________________________________________________________________________
 #include <LLC/types/bignum.h>
 #include <LLC/hash/SK.h>
 
+#include <LLD/cache/template_lru.h>
+
 #include <Legacy/include/enum.h>
 #include <Legacy/include/evaluate.h>
 #include <Legacy/include/signature.h>
@@ -33,6 +35,161 @@ ________________________________________________________________________________
 namespace Legacy
 {
 
+    /* Constructor */
+    SignatureHasher::SignatureHasher(const Transaction& txToIn)
+    : txTo          (txToIn)
+    , vBlank        ( )
+    , vOffsets      ( )
+    , vMidstates    ( )
+    , scriptLast    ( )
+    , nInLast       (std::numeric_limits<uint32_t>::max())
+    , nHashTypeLast (0)
+    , hashLast      (0)
+    {
+    }
+
+
+    /* Returns the same hash as SignatureHash for the given input of our transaction. */
+    uint256_t SignatureHasher::Hash(const Script& scriptCode, const uint32_t nIn, const int32_t nHashType)
+    {
+        /* Only SIGHASH_ALL commits to every input and output, so other types are hashed the long way. */
+        if(nIn >= txTo.vin.size() || (nHashType & 0x1f) == SIGHASH_NONE || (nHashType & 0x1f) == SIGHASH_SINGLE
+        || (nHashType & SIGHASH_ANYONECANPAY))
+            return SignatureHash(scriptCode, txTo, nIn, nHashType);
+
+        /* Check for the same hash as our last call, which multisig asks for once per key. */
+        if(nIn == nInLast && nHashType == nHashTypeLast && scriptCode == scriptLast)
+            return hashLast;
+
+        /* Build our midstates on first use. */
+        if(vMidstates.empty())
+            build_midstates();
+
+        /* Handle codeseparators the same way as SignatureHash. */
+        Script scriptTmp(scriptCode);
+        scriptTmp.FindAndDelete(Script(OP_CODESEPARATOR));
+
+        /* Serialize our input with the script code in place of its signature. */
+        TxIn txin(txTo.vin[nIn]);
+        txin.scriptSig = scriptTmp;
+
+        DataStream ssInput(SER_GETHASH, 0);
+        ssInput << txin;
+
+        DataStream ssType(SER_GETHASH, 0);
+        ssType << nHashType;
+
+        /* Continue from the midstate at our input, then hash the rest of the blanked transaction. */
+        Skein_256_Ctxt_t ctxSkein = vMidstates[nIn];
+        Skein_256_Update(&ctxSkein, &ssInput.Bytes()[0], ssInput.size());
+        Skein_256_Update(&ctxSkein, &vBlank[vOffsets[nIn + 1]], vBlank.size() - vOffsets[nIn + 1]);
+        Skein_256_Update(&ctxSkein, &ssType.Bytes()[0], ssType.size());
+
+        uint256_t hashSkein = 0;
+        Skein_256_Final(&ctxSkein, (uint8_t *)&hashSkein);
+
+        /* Finish with keccak, the same as SK256. */
+        uint256_t hashKeccak = 0;
+        Keccak_HashInstance ctxKeccak;
+        Keccak_HashInitialize_SHA3_256(&ctxKeccak);
+        Keccak_HashUpdate(&ctxKeccak, (uint8_t *)&hashSkein, 256);
+        Keccak_HashFinal(&ctxKeccak, (uint8_t *)&hashKeccak);
+
+        /* Remember this hash for the next call. */
+        scriptLast    = scriptCode;
+        nInLast       = nIn;
+        nHashTypeLast = nHashType;
+        hashLast      = hashKeccak;
+
+        return hashKeccak;
+    }
+
+
+    /* Serialize our blanked transaction and record the midstate at each input. */
+    void SignatureHasher::build_midstates()
+    {
+        /* Blank out every input script, which is what every other input sees in its signature hash. */
+        Transaction txBlank(txTo);
+        for(auto& txin : txBlank.vin)
+            txin.scriptSig = Script();
+
+        DataStream ssBlank(SER_GETHASH, 0);
+        ssBlank << txBlank;
+
+        vBlank = ssBlank.Bytes();
+
+        /* Find where our inputs start by working back from the outputs and lock time. */
+        uint64_t nOffset = vBlank.size()
+            - ::GetSerializeSize(txBlank.vout, uint32_t(SER_GETHASH), 0) - ::GetSerializeSize(txBlank.nLockTime, uint32_t(SER_GETHASH), 0);
+
+        for(const auto& txin : txBlank.vin)
+            nOffset -= ::GetSerializeSize(txin, uint32_t(SER_GETHASH), 0);
+
+        /* Record the offset of each input. */
+        vOffsets.reserve(txBlank.vin.size() + 1);
+        for(const auto& txin : txBlank.vin)
+        {
+            vOffsets.push_back(nOffset);
+            nOffset += ::GetSerializeSize(txin, uint32_t(SER_GETHASH), 0);
+        }
+        vOffsets.push_back(nOffset);
+
+        /* Hash up to each input, keeping a copy of our state before each one. */
+        Skein_256_Ctxt_t ctxSkein;
+        Skein_256_Init(&ctxSkein, 256);
+        Skein_256_Update(&ctxSkein, &vBlank[0], vOffsets[0]);
+
+        vMidstates.reserve(txBlank.vin.size());
+        for(uint32_t n = 0; n < txBlank.vin.size(); ++n)
+        {
+            vMidstates.push_back(ctxSkein);
+            Skein_256_Update(&ctxSkein, &vBlank[vOffsets[n]], vOffsets[n + 1] - vOffsets[n]);
+        }
+    }
+
+
+    namespace SignatureCache
+    {
+        /* The number of shards, each with their own lock, so verifying threads don't contend on one cache. */
+        const uint32_t CACHE_SHARDS = 16;
+
+
+        /* The maximum signatures to keep in each shard. */
+        const uint32_t MAX_SIGNATURES = 65536 / CACHE_SHARDS;
+
+
+        /* Digests of verified hashes, keys, and signatures, split across our shards by digest. */
+        std::vector<LLD::TemplateLRU<uint256_t, bool>> vShards(CACHE_SHARDS, LLD::TemplateLRU<uint256_t, bool>(MAX_SIGNATURES));
+
+
+        /* Get the digest of a signature hash, public key, and signature. The public key is length prefixed
+         * so that bytes can't be moved between the key and the signature without changing the digest. */
+        uint256_t signature_digest(const uint256_t& hashSig, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig)
+        {
+            DataStream ssKey(SER_GETHASH, 0);
+            ssKey << hashSig << vchPubKey << vchSig;
+
+            return LLC::SK256(ssKey.Bytes());
+        }
+
+
+        /* Check if a signature has already been verified. */
+        bool Has(const uint256_t& hashSig, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig)
+        {
+            const uint256_t hashDigest = signature_digest(hashSig, vchPubKey, vchSig);
+            return vShards[hashDigest.Get64() % CACHE_SHARDS].Has(hashDigest);
+        }
+
+
+        /* Add a valid signature to the cache. */
+        void Add(const uint256_t& hashSig, const std::vector<uint8_t>& vchPubKey, const std::vector<uint8_t>& vchSig)
+        {
+            const uint256_t hashDigest = signature_digest(hashSig, vchPubKey, vchSig);
+            vShards[hashDigest.Get64() % CACHE_SHARDS].Put(hashDigest, true);
+        }
+    }
+
+
     /* Signs for a single signature transaction. */
     bool Sign1(const NexusAddress& address, const KeyStore& keystore, uint256_t hash, int32_t nHashType, Script& scriptSigRet)
     {
@@ -143,7 +300,8 @@ namespace Legacy
 
 
     /* Checks that the signature supplied is a valid one. */
-    bool CheckSig(std::vector<uint8_t> vchSig, std::vector<uint8_t> vchPubKey, Script scriptCode, const Transaction& txTo, uint32_t nIn, int32_t nHashType)
+    bool CheckSig(const std::vector<uint8_t>& vchSig, const std::vector<uint8_t>& vchPubKey, const Script& scriptCode,
+                  const Transaction& txTo, uint32_t nIn, int32_t nHashType, SignatureHasher* pHasher)
     {
         // Hash type is one byte tacked on to the end of the signature
         if(vchSig.empty())
@@ -153,15 +311,23 @@ namespace Legacy
         else if(nHashType != vchSig.back())
             return false;
 
-        vchSig.pop_back();
-        uint256_t sighash = SignatureHash(scriptCode, txTo, nIn, nHashType);
+        /* Use our precomputed hashes if we have them. */
+        const uint256_t sighash = pHasher ? pHasher->Hash(scriptCode, nIn, nHashType)
+                                          : SignatureHash(scriptCode, txTo, nIn, nHashType);
+
+        /* Check if we have verified this signature already. */
+        if(SignatureCache::Has(sighash, vchPubKey, vchSig))
+            return true;
 
         LLC::ECKey key;
         if(!key.SetPubKey(vchPubKey))
             return false;
-        if(!key.Verify(sighash, vchSig, 256))
+        if(!key.Verify(sighash, std::vector<uint8_t>(vchSig.begin(), vchSig.end() - 1), 256))
             return false;
 
+        /* Cache our valid signature. */
+        SignatureCache::Add(sighash, vchPubKey, vchSig);
+
         return true;
     }
 
@@ -217,7 +383,7 @@ namespace Legacy
 
 
     /* Verify a signature was valid */
-    bool VerifySignature(const Transaction& txFrom, const Transaction& txTo, uint32_t nIn, int nHashType)
+    bool VerifySignature(const Transaction& txFrom, const Transaction& txTo, uint32_t nIn, int nHashType, SignatureHasher* pHasher)
     {
         assert(nIn < txTo.vin.size());
         const TxIn& txin = txTo.vin[nIn];
@@ -228,7 +394,7 @@ namespace Legacy
         if(txin.prevout.hash != txFrom.GetHash())
             return false;
 
-        if(!VerifyScript(txin.scriptSig, txout.scriptPubKey, txTo, nIn, nHashType))
+        if(!VerifyScript(txin.scriptSig, txout.scriptPubKey, txTo, nIn, nHashType, pHasher))
             return false;
 
         return true;
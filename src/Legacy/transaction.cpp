@@ -1090,6 +1090,9 @@ namespace Legacy
         /* Read all of the inputs. */
         uint64_t nValueIn = 0;
 
+        /* Share our signature hash midstates between inputs, so that many inputs aren't re-serialized for each one. */
+        SignatureHasher hasher(*this);
+
         /* Get the number of inputs to the transaction. */
         uint32_t nSize = static_cast<uint32_t>(vin.size());
         for(uint32_t i = (uint32_t)fIsCoinStake; i < nSize; ++i)
@@ -1157,7 +1160,7 @@ namespace Legacy
                         return debug::error(FUNCTION, "prev tx ", prevout.hash.SubString(), " is already spent");
 
                     /* Check the ECDSA signatures. (...When not syncronizing) */
-                    if(!TAO::Ledger::ChainState::Synchronizing() && !VerifySignature(txPrev, *this, i, 0))
+                    if(!TAO::Ledger::ChainState::Synchronizing() && !VerifySignature(txPrev, *this, i, 0, &hasher))
                         return debug::error(FUNCTION, "signature is invalid");
 
                     /* Commit to disk if flagged. */
@@ -1225,7 +1228,7 @@ namespace Legacy
                             return debug::error(FUNCTION, "prevout.hash mismatch");
 
                         /* Verify the scripts. */
-                        if(!VerifyScript(vin[i].scriptSig, txout.scriptPubKey, *this, i, 0))
+                        if(!VerifyScript(vin[i].scriptSig, txout.scriptPubKey, *this, i, 0, &hasher))
                             return debug::error(FUNCTION, "invalid script");
                     }
 
@@ -89,6 +89,7 @@ namespace Legacy
     , vchDefaultKey     ( )
     , vchTrustKey       ( )
     , nWalletUnlockTime (0)
+    , setUnspent        ( )
     , cs_wallet         ( )
     , mapWallet         ( )
     {
@@ -730,9 +731,9 @@ namespace Legacy
              */
             RECURSIVE(cs_wallet);
 
-            for (const auto& item : mapWallet)
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx& wtx = item.second;
+                const WalletTx& wtx = mapWallet.at(hash);
 
                 /* Skip any transaction that isn't final, isn't completely confirmed, or has a future timestamp */
                 if (!wtx.IsFinal() || !wtx.IsConfirmed() || wtx.nTime > runtime::unifiedtimestamp())
@@ -755,9 +756,9 @@ namespace Legacy
         {
             RECURSIVE(cs_wallet);
             nBalance = 0;
-            for(auto it = mapWallet.begin(); it != mapWallet.end(); ++it)
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx* pcoin = &(*it).second;
+                const WalletTx* pcoin = &mapWallet.at(hash);
                 if(!pcoin->IsFinal())
                     continue;
 
@@ -817,9 +818,9 @@ namespace Legacy
              */
             RECURSIVE(cs_wallet);
 
-            for (const auto& item : mapWallet)
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx& wtx = item.second;
+                const WalletTx& wtx = mapWallet.at(hash);
 
                 if (wtx.IsFinal() && wtx.IsConfirmed())
                     continue;
@@ -842,9 +843,10 @@ namespace Legacy
         {
             RECURSIVE(cs_wallet);
 
-            for(const auto& item : mapWallet)
+            /* Immature outputs can't be spent, so they are always in our unspent index. */
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx& wtx = item.second;
+                const WalletTx& wtx = mapWallet.at(hash);
 
                 /* Amount currently being staked is that amount in a coinstake tx that is not yet mature but has been added to chain */
                 if (wtx.IsCoinStake() && wtx.GetBlocksToMaturity() > 0 && wtx.GetDepthInMainChain() > 0)
@@ -864,9 +866,10 @@ namespace Legacy
         {
             RECURSIVE(cs_wallet);
 
-            for(const auto& item : mapWallet)
+            /* Immature outputs can't be spent, so they are always in our unspent index. */
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx& wtx = item.second;
+                const WalletTx& wtx = mapWallet.at(hash);
 
                 if (wtx.IsCoinBase() && wtx.GetBlocksToMaturity() > 0 && wtx.GetDepthInMainChain() > 1)
                     nTotalMint += GetCredit(wtx);
@@ -885,9 +888,9 @@ namespace Legacy
 
             vCoins.clear();
 
-            for(const auto& item : mapWallet)
+            for(const auto& hash : UnspentTransactions())
             {
-                const WalletTx& wtx = item.second;
+                const WalletTx& wtx = mapWallet.at(hash);
 
                 /* Filter transactions not final */
                 if (!wtx.IsFinal())
@@ -966,6 +969,9 @@ namespace Legacy
 
             /* Inserts only if not already there, returns tx inserted or tx found */
             ret = mapWallet.insert(std::make_pair(hash, wtxIn));
+
+            /* Index as unspent, since merged spent flags or new outputs may have unspent balance. */
+            setUnspent.insert(hash);
         }
 
         WalletTx& wtx = (*ret.first).second;
@@ -1161,6 +1167,7 @@ namespace Legacy
 
             if(mapWallet.erase(hash))
             {
+                setUnspent.erase(hash);
                 WalletDB::EraseTx(hash);
             }
         }
@@ -1195,6 +1202,8 @@ namespace Legacy
                     {
                         txPrev.MarkUnspent(txin.prevout.n);
                         txPrev.WriteToDisk(tx.GetHash());
+
+                        setUnspent.insert(txin.prevout.hash);
                     }
                 }
             }
@@ -1597,7 +1606,10 @@ namespace Legacy
 
             /* Update mapWallet with repaired transactions */
             for (const auto& map : mapRepaired)
+            {
                 mapWallet[map.first] = map.second;
+                setUnspent.insert(map.first);
+            }
         }
     }
 
@@ -2140,13 +2152,8 @@ namespace Legacy
 
         const uint32_t nMinimumCoinAge = (config::fTestNet ? TAO::Ledger::MINIMUM_GENESIS_COIN_AGE_TESTNET : TAO::Ledger::MINIMUM_GENESIS_COIN_AGE);
 
-        /* Keep a local list of wallet pointers. */
-        std::vector<uint512_t> vCoins;
-
-        /* Build a set of wallet transactions from all transaction in the wallet map */
-        vCoins.reserve(mapWallet.size());
-        for (const auto& item : mapWallet)
-            vCoins.push_back(item.first);
+        /* Build a list of the wallet transactions that have unspent outputs. */
+        std::vector<uint512_t> vCoins = UnspentTransactions();
 
         /* Randomly order the transactions as potential inputs */
         LLC::random_shuffle(vCoins.begin(), vCoins.end());
@@ -2300,10 +2307,8 @@ namespace Legacy
         if(config::GetBoolArg("-printselectcoin", false))
             debug::log(0, FUNCTION, "Selecting coins for account ", strAccount);
 
-        /* Build a set of wallet transactions from all transaction in the wallet map */
-        vCoins.reserve(mapWallet.size());
-        for(const auto& item : mapWallet)
-            vCoins.push_back(item.first);
+        /* Build a list of the wallet transactions that have unspent outputs. */
+        vCoins = UnspentTransactions();
 
         /* Randomly order the transactions as potential inputs */
         LLC::random_shuffle(vCoins.begin(), vCoins.end());
@@ -2426,4 +2431,48 @@ namespace Legacy
         return true;
     }
 
+
+    /* Gets the wallet transactions that have unspent outputs belonging to this wallet, pruning fully spent ones. */
+    std::vector<uint512_t> Wallet::UnspentTransactions()
+    {
+        std::vector<uint512_t> vHashes;
+        vHashes.reserve(setUnspent.size());
+
+        for(auto it = setUnspent.begin(); it != setUnspent.end(); )
+        {
+            /* Prune transactions that were removed from the wallet. */
+            const TransactionMap::const_iterator mi = mapWallet.find(*it);
+            if(mi == mapWallet.end())
+            {
+                it = setUnspent.erase(it);
+                continue;
+            }
+
+            /* Check for any output that is ours and can still be spent. */
+            const WalletTx& wtx = mi->second;
+
+            bool fUnspent = false;
+            for(uint32_t n = 0; n < wtx.vout.size(); ++n)
+            {
+                if(!wtx.IsSpent(n) && wtx.vout[n].nValue > 0 && IsMine(wtx.vout[n]))
+                {
+                    fUnspent = true;
+                    break;
+                }
+            }
+
+            /* Prune transactions that are fully spent, since outputs are only unspent again through the wallet. */
+            if(!fUnspent)
+            {
+                it = setUnspent.erase(it);
+                continue;
+            }
+
+            vHashes.push_back(*it);
+            ++it;
+        }
+
+        return vHashes;
+    }
+
 }
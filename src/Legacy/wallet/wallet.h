@@ -255,6 +255,12 @@ namespace Legacy
         uint64_t nWalletUnlockTime;
 
 
+        /** Index of wallet transactions that may still have unspent outputs belonging to this wallet.
+         *  Transactions are added whenever an output may become unspent, and pruned once found to be fully spent.
+         **/
+        std::set<uint512_t> setUnspent;
+
+
 
     public:
         /** Mutex for thread concurrency across wallet operations **/
@@ -659,6 +665,17 @@ namespace Legacy
         void AvailableCoins(const uint32_t nSpendTime, std::vector<Output>& vCoins, const bool fOnlyConfirmed = true);
 
 
+        /** UnspentTransactions
+         *
+         *  Gets the wallet transactions that have unspent outputs belonging to this wallet, pruning any
+         *  transactions from the unspent index that have been fully spent. Caller must hold cs_wallet.
+         *
+         *  @return the hashes of the unspent wallet transactions
+         *
+         **/
+        std::vector<uint512_t> UnspentTransactions();
+
+
     /*----------------------------------------------------------------------------------------*/
     /*  Wallet Transactions                                                                   */
     /*----------------------------------------------------------------------------------------*/
@@ -569,6 +569,9 @@ namespace Legacy
                 /* Bind to wallet if valid. */
                 if(fBind)
                     wtx.BindWallet(wallet);
+
+                /* Index as unspent, to be pruned on first use if it is spent. */
+                wallet.setUnspent.insert(hash);
             }
 
             else if(strType == "defaultkey")
@@ -760,6 +763,7 @@ namespace Legacy
                 {
                     EraseTx(hash);
                     wallet.mapWallet.erase(hash);
+                    wallet.setUnspent.erase(hash);
                     ++nWalletDBUpdated;
                 }
 
@@ -11,8 +11,6 @@
 
 ____________________________________________________________________________________________*/
 
-#include <Legacy/include/evaluate.h>
-
 #include <LLD/include/global.h>
 
 #include <TAO/API/types/commands/ledger.h>
@@ -22,14 +20,9 @@ ________________________________________________________________________________
 #include <TAO/API/include/format.h>
 #include <TAO/API/include/json.h>
 
-#include <TAO/Operation/include/enum.h>
-
-#include <TAO/Register/include/unpack.h>
-
 #include <TAO/Ledger/include/chainstate.h>
-#include <TAO/Ledger/include/enum.h>
 
-#include <TAO/Ledger/types/transaction.h>
+#include <TAO/Ledger/types/metrics.h>
 
 /* Global TAO namespace. */
 namespace TAO::API
@@ -45,226 +38,58 @@ namespace TAO::API
         const uint64_t nBestTime =
             ExtractInteger<uint64_t>(jParams, "timestamp", tBestBlock.GetBlockTime());
 
-        /* Track our contracts change as unsigned. */
-        uint64_t nTotalTransactions [3] = {0, 0, 0};
-        uint64_t nTotalContracts    [3] = {0, 0, 0};
-        uint64_t nTotalDeposits     [3] = {0, 0, 0};
-        uint64_t nTotalWithdraw     [3] = {0, 0, 0};
+        /* Our windows for daily, weekly, and monthly metrics. */
+        const uint64_t nWindows[3] = { 86400, 86400 * 7, 86400 * 7 * 4 };
 
-        /* Track our stake change as integer. */
-        int64_t nStakeChange[3] = {0, 0, 0};
-
-        /* Track our mining change as unsigned. */
-        uint64_t nMiningEmmission [3] = {0, 0, 0};
-        uint64_t nStakingEmmission[3] = {0, 0, 0};
+        /* Find our range of buckets, including anything newer than our timestamp. */
+        const uint64_t nFirstBucket = std::max
+        (
+            TAO::Ledger::Metrics::Bucket(std::max(nBestTime, nWindows[2]) - nWindows[2]),
+            TAO::Ledger::Metrics::Bucket(TAO::Ledger::ChainState::tStateGenesis.GetBlockTime())
+        );
+        const uint64_t nLastBucket  = TAO::Ledger::Metrics::Bucket(tBestBlock.GetBlockTime());
 
-        /* Track unique account holders. */
-        std::set<uint256_t> setAccounts;
-
-        /* Accumulate these as unsigned values. */
-        uint64_t nUniqueAccounts[3] = {0, 0, 0};
-
-        /* Iterate backwards until we have reached one whole day. */
-        TAO::Ledger::BlockState tPrevBlock = tBestBlock;
-        while(!config::fShutdown.load())
+        /* Sum our buckets into each window. */
+        TAO::Ledger::Metrics tMetrics[3];
+        for(uint64_t nBucket = nFirstBucket; nBucket <= nLastBucket; ++nBucket)
         {
-            /* Track the amount of stake changed. */
-            int64_t nStake = 0;
-
-            /* Track total contracts for this block. */
-            uint64_t nContracts = 0, nDeposits = 0, nWithdraws = 0, nInflation = 0, nMining = 0, nAccounts = 0;
-
-            /* Check through all the transactions. */
-            for(const auto& proof : tPrevBlock.vtx)
-            {
-                /* Only work on tritium transactions for now. */
-                if(proof.first == TAO::Ledger::TRANSACTION::TRITIUM)
-                {
-                    /* Get the transaction hash. */
-                    const uint512_t& hash = proof.second;
-
-                    /* Make sure the transaction is on disk. */
-                    TAO::Ledger::Transaction tx;
-                    if(!LLD::Ledger->ReadTx(hash, tx))
-                        continue;
-
-                    /* Increment total contracts. */
-                    nContracts += tx.Size();
-
-                    /* Iterate all of our contracts. */
-                    for(uint32_t n = 0; n < tx.Size(); ++n)
-                    {
-                        /* Check for an available address that was modified. */
-                        uint256_t hashAddress;
-                        if(TAO::Register::Unpack(tx[n], hashAddress) && !setAccounts.count(hashAddress))
-                        {
-                            /* Insert into our set and increment totals. */
-                            setAccounts.insert(hashAddress);
-                            ++nAccounts;
-                        }
-
-                        /* Get our total NXS being spent. */
-                        uint64_t nTotal = 0;
-
-                        /* Unpack our total now from contracts. */
-                        if(TAO::Register::Unpack(tx[n], nTotal))
-                        {
-                            /* Check for trust transactions. */
-                            if(tx[n].Primitive() == TAO::Operation::OP::TRUST)
-                            {
-                                /* Accumulate our trust totals. */
-                                nInflation += nTotal;
-
-                                /* Jump to starting OP */
-                                tx[n].SeekToPrimitive();
-
-                                /* Skip to stake change. */
-                                tx[n].Seek(73);
-
-                                /* Get our stake change value. */
-                                int64_t nChange = 0;
-                                tx[n] >> nChange;
-
-                                /* Adjust our current stake. */
-                                nStake += nChange;
-                            }
-
-                            /* Check for trust transactions. */
-                            else if(tx[n].Primitive() == TAO::Operation::OP::GENESIS)
-                            {
-                                /* Accumulate our inflation totals. */
-                                nInflation += nTotal;
-
-                                /* Get our pre-state to find stake. */
-                                TAO::Register::Object tPreState =
-                                    tx[n].PreState();
-
-                                /* Parse our object. */
-                                if(!tPreState.Parse())
-                                    continue;
-
-                                /* Our balance is our committed stake. */
-                                nStake += tPreState.get<uint64_t>("balance");
-                            }
-
-                            /* Check only for debits. */
-                            else if(tx[n].Primitive() == TAO::Operation::OP::CREDIT)
-                            {
-                                /* Check only for credits from legagy. */
-                                uint512_t hashPrevTx;
-                                if(TAO::Register::Unpack(tx[n], hashPrevTx) && hashPrevTx.GetType() == TAO::Ledger::LEGACY)
-                                    nWithdraws += nTotal;
-                            }
-
-                            /* Check for a legacy deposit. */
-                            else if(tx[n].Primitive() == TAO::Operation::OP::LEGACY)
-                                nDeposits += nTotal;
-
-                            /* Check for our coinbase minting. */
-                            else if(tx[n].Primitive() == TAO::Operation::OP::COINBASE)
-                                nMining += nTotal;
-
-                        }
-                    }
-                }
-
-                /* Handle for legacy transactions and accounts. */
-                if(proof.first == TAO::Ledger::TRANSACTION::LEGACY)
-                {
-                    /* Get the transaction hash. */
-                    const uint512_t& hash = proof.second;
-
-                    /* Make sure the transaction is on disk. */
-                    Legacy::Transaction tx;
-                    if(!LLD::Legacy->ReadTx(hash, tx))
-                        continue;
-
-                    /* Loop through all of our outputs to check. */
-                    for(const Legacy::TxOut& out : tx.vout)
-                    {
-                        /* See if we are sending to register. */
-                        uint256_t hashAddress;
-                        if(Legacy::ExtractRegister(out.scriptPubKey, hashAddress) && !setAccounts.count(hashAddress))
-                        {
-                            /* Insert into our set and increment totals. */
-                            setAccounts.insert(hashAddress);
-                            ++nAccounts;
-                        }
-
-                        /* Check for legacy to legacy transacitons. */
-                        Legacy::NexusAddress addrAccount;
-                        if(Legacy::ExtractAddress(out.scriptPubKey, addrAccount) && !setAccounts.count(addrAccount.GetHash256()))
-                        {
-                            /* Insert into our set and increment totals. */
-                            setAccounts.insert(addrAccount.GetHash256());
-                            ++nAccounts;
-                        }
-                    }
-                }
-            }
-
-
-            /* Check our time for days. */
-            if(tPrevBlock.GetBlockTime() + 86400 > nBestTime)
+            /* Skip over buckets without any blocks. */
+            TAO::Ledger::Metrics tBucket;
+            if(!LLD::Ledger->ReadMetrics(nBucket, tBucket))
+                continue;
+
+            /* Check which windows this bucket ends inside of. */
+            const uint64_t nBucketEnd = (nBucket + 1) * TAO::Ledger::Metrics::BUCKET_SECONDS;
+            for(uint32_t n = 0; n < 3; ++n)
             {
-                /* Set our daily volume values. */
-                nTotalTransactions[0] += (tPrevBlock.vtx.size());
-                nTotalContracts   [0] += nContracts;
-                nTotalDeposits    [0] += nDeposits;
-                nTotalWithdraw    [0] += nWithdraws;
-                nUniqueAccounts   [0] += nAccounts;
-
-                /* Set our emmission values. */
-                nMiningEmmission [0]  += nMining;
-                nStakingEmmission[0]  += nInflation;
-
-                /* Set our daily accumulation values. */
-                nStakeChange[0]       += nStake;
+                if(nBucketEnd + nWindows[n] > nBestTime)
+                    tMetrics[n] += tBucket;
             }
+        }
 
+        /* Track our contracts change as unsigned. */
+        const uint64_t nTotalTransactions [3] =
+            { tMetrics[0].nTransactions, tMetrics[1].nTransactions, tMetrics[2].nTransactions };
+        const uint64_t nTotalContracts    [3] =
+            { tMetrics[0].nContracts,    tMetrics[1].nContracts,    tMetrics[2].nContracts };
+        const uint64_t nTotalDeposits     [3] =
+            { tMetrics[0].nDeposits,     tMetrics[1].nDeposits,     tMetrics[2].nDeposits };
+        const uint64_t nTotalWithdraw     [3] =
+            { tMetrics[0].nWithdraws,    tMetrics[1].nWithdraws,    tMetrics[2].nWithdraws };
 
-            /* Check our time for weeks. */
-            if(tPrevBlock.GetBlockTime() + 86400 * 7 > nBestTime)
-            {
-                /* Set our daily volume values. */
-                nTotalTransactions[1] += (tPrevBlock.vtx.size());
-                nTotalContracts   [1] += nContracts;
-                nTotalDeposits    [1] += nDeposits;
-                nTotalWithdraw    [1] += nWithdraws;
-                nUniqueAccounts   [1] += nAccounts;
-
-                /* Set our emmission values. */
-                nMiningEmmission [1]  += nMining;
-                nStakingEmmission[1]  += nInflation;
-
-                /* Set our daily accumulation values. */
-                nStakeChange[1]       += nStake;
-            }
-
-
-            /* Check our time for months. */
-            if(tPrevBlock.GetBlockTime() + 86400 * 7 * 4 > nBestTime)
-            {
-                /* Set our daily volume values. */
-                nTotalTransactions[2] += (tPrevBlock.vtx.size());
-                nTotalContracts   [2] += nContracts;
-                nTotalDeposits    [2] += nDeposits;
-                nTotalWithdraw    [2] += nWithdraws;
-                nUniqueAccounts   [2] += nAccounts;
-
-                /* Set our emmission values. */
-                nMiningEmmission [2]  += nMining;
-                nStakingEmmission[2]  += nInflation;
+        /* Track our stake change as integer. */
+        const int64_t nStakeChange[3] =
+            { tMetrics[0].nStakeChange, tMetrics[1].nStakeChange, tMetrics[2].nStakeChange };
 
-                /* Set our daily accumulation values. */
-                nStakeChange[2]       += nStake;
-            }
-            else
-                break;
+        /* Track our mining change as unsigned. */
+        const uint64_t nMiningEmmission [3] =
+            { tMetrics[0].nMining,  tMetrics[1].nMining,  tMetrics[2].nMining  };
+        const uint64_t nStakingEmmission[3] =
+            { tMetrics[0].nStaking, tMetrics[1].nStaking, tMetrics[2].nStaking };
 
-            /* Iterate to previous block. */
-            tPrevBlock = tPrevBlock.Prev();
-        }
+        /* Estimate our unique account holders, which can only be over-estimated after a reorg since our sketches can't be subtracted. */
+        const uint64_t nUniqueAccounts[3] =
+            { tMetrics[0].Accounts(), tMetrics[1].Accounts(), tMetrics[2].Accounts() };
 
         /* Track our list of volumes on network. */
         const encoding::json jVolumes =
@@ -292,6 +117,30 @@ namespace TAO::API
                     { "weekly",  nUniqueAccounts[1]  },
                     { "monthly", nUniqueAccounts[2] }
                 }
+            },
+            {
+                "debits",
+                {
+                    { "daily",   tMetrics[0].nDebits },
+                    { "weekly",  tMetrics[1].nDebits },
+                    { "monthly", tMetrics[2].nDebits }
+                }
+            },
+            {
+                "credits",
+                {
+                    { "daily",   tMetrics[0].nCredits },
+                    { "weekly",  tMetrics[1].nCredits },
+                    { "monthly", tMetrics[2].nCredits }
+                }
+            },
+            {
+                "moved",
+                {
+                    { "daily",   FormatBalance(tMetrics[0].nMoved) },
+                    { "weekly",  FormatBalance(tMetrics[1].nMoved) },
+                    { "monthly", FormatBalance(tMetrics[2].nMoved) }
+                }
             }
         };
 
@@ -347,6 +196,51 @@ namespace TAO::API
                     { "weekly",  FormatStake(nStakeChange[1]) },
                     { "monthly", FormatStake(nStakeChange[2]) }
                 }
+            },
+            {
+                "trust",
+                {
+                    { "daily",   tMetrics[0].nTrust },
+                    { "weekly",  tMetrics[1].nTrust },
+                    { "monthly", tMetrics[2].nTrust }
+                }
+            },
+            {
+                "genesis",
+                {
+                    { "daily",   tMetrics[0].nGenesis },
+                    { "weekly",  tMetrics[1].nGenesis },
+                    { "monthly", tMetrics[2].nGenesis }
+                }
+            },
+            {
+                "blocks",
+                {
+                    {
+                        "stake",
+                        {
+                            { "daily",   tMetrics[0].nBlocks[0] },
+                            { "weekly",  tMetrics[1].nBlocks[0] },
+                            { "monthly", tMetrics[2].nBlocks[0] }
+                        }
+                    },
+                    {
+                        "prime",
+                        {
+                            { "daily",   tMetrics[0].nBlocks[1] },
+                            { "weekly",  tMetrics[1].nBlocks[1] },
+                            { "monthly", tMetrics[2].nBlocks[1] }
+                        }
+                    },
+                    {
+                        "hash",
+                        {
+                            { "daily",   tMetrics[0].nBlocks[2] },
+                            { "weekly",  tMetrics[1].nBlocks[2] },
+                            { "monthly", tMetrics[2].nBlocks[2] }
+                        }
+                    }
+                }
             }
         };
 
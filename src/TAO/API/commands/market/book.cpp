@@ -0,0 +1,304 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/API/include/filter.h>
+#include <TAO/API/types/commands/market.h>
+
+#include <TAO/Register/include/unpack.h>
+
+#include <TAO/Ledger/include/enum.h>
+
+#include <algorithm>
+
+/* Global TAO namespace. */
+namespace TAO::API
+{
+    /* Get a copy of the order book for a market pair, loading it from our open orders if needed. */
+    Market::OrderBook Market::GetBook(const std::pair<uint256_t, uint256_t>& pairMarket)
+    {
+        /* Load our book from disk outside of our lock, trying again if our open orders changed while we read them. */
+        OrderBook tBook;
+        for(uint32_t nAttempt = 0; nAttempt < 3; ++nAttempt)
+        {
+            /* Check if this book is loaded already. */
+            uint64_t nUpdates = 0;
+            {
+                LOCK(BOOK_MUTEX);
+
+                const auto it = mapBooks.find(pairMarket);
+                if(it != mapBooks.end())
+                    return it->second;
+
+                nUpdates = nBookUpdates;
+            }
+
+            /* Read our open orders now. */
+            tBook = OrderBook();
+            LoadBook(pairMarket, tBook);
+
+            {
+                LOCK(BOOK_MUTEX);
+
+                /* Check if another request loaded this book while we were reading. */
+                const auto it = mapBooks.find(pairMarket);
+                if(it != mapBooks.end())
+                    return it->second;
+
+                /* Only keep our book if no orders were opened or closed while we were reading. */
+                if(nUpdates == nBookUpdates)
+                {
+                    mapBooks[pairMarket] = tBook;
+                    return tBook;
+                }
+            }
+        }
+
+        /* Our market is busy, so give back what we read without keeping it. */
+        return tBook;
+    }
+
+
+    /* Read and sort the open orders for a market pair from disk. */
+    void Market::LoadBook(const std::pair<uint256_t, uint256_t>& pairMarket, OrderBook &tBook)
+    {
+        /* Our bids are listed under our market pair. */
+        std::vector<std::pair<uint512_t, uint32_t>> vOrders;
+        if(LLD::Logical->ListOpenOrders(pairMarket, vOrders))
+        {
+            /* Build all of our orders before sorting them once. */
+            for(const auto& pairOrder : vOrders)
+            {
+                Order tOrder;
+                if(BuildOrder(pairOrder, pairMarket, tOrder))
+                    tBook.vBids.push_back(std::make_shared<const Order>(std::move(tOrder)));
+            }
+
+            /* Sort highest price first, then oldest first. */
+            std::stable_sort(tBook.vBids.begin(), tBook.vBids.end(),
+            [](const std::shared_ptr<const Order>& a, const std::shared_ptr<const Order>& b)
+            {
+                if(a->dPrice != b->dPrice)
+                    return a->dPrice > b->dPrice;
+
+                return a->nTimestamp < b->nTimestamp;
+            });
+        }
+
+        /* Our asks are listed under the reverse of our market pair. */
+        vOrders.clear();
+        if(LLD::Logical->ListOpenOrders(std::make_pair(pairMarket.second, pairMarket.first), vOrders))
+        {
+            /* Build all of our orders before sorting them once. */
+            for(const auto& pairOrder : vOrders)
+            {
+                Order tOrder;
+                if(BuildOrder(pairOrder, pairMarket, tOrder))
+                    tBook.vAsks.push_back(std::make_shared<const Order>(std::move(tOrder)));
+            }
+
+            /* Sort lowest price first, then oldest first. */
+            std::stable_sort(tBook.vAsks.begin(), tBook.vAsks.end(),
+            [](const std::shared_ptr<const Order>& a, const std::shared_ptr<const Order>& b)
+            {
+                if(a->dPrice != b->dPrice)
+                    return a->dPrice < b->dPrice;
+
+                return a->nTimestamp < b->nTimestamp;
+            });
+        }
+    }
+
+
+    /* Read an order from disk and build its order book entry. */
+    bool Market::BuildOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket,
+                            Order &tOrder)
+    {
+        try
+        {
+            /* Get our contract now. */
+            const TAO::Operation::Contract tContract =
+                LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
+
+            /* Unpack our register address. */
+            if(!TAO::Register::Unpack(tContract, tOrder.hashRegister))
+                return false;
+
+            /* Get our order's json. */
+            tOrder.jOrder = OrderToJSON(tContract, pairMarket);
+            if(tOrder.jOrder.is_null())
+                return false;
+
+            /* Set our sorting values. */
+            tOrder.pairOrder  = pairOrder;
+            tOrder.dPrice     = tOrder.jOrder["price"].get<double>();
+            tOrder.nTimestamp = tOrder.jOrder["timestamp"].get<uint64_t>();
+        }
+        catch(const std::exception& e)
+        {
+            return debug::error(FUNCTION, "order ", pairOrder.first.SubString(), " failed to load: ", e.what());
+        }
+
+        return true;
+    }
+
+
+    /* Insert an order into one side of an order book, keeping it sorted by price. */
+    void Market::InsertOrder(const std::shared_ptr<const Order>& pOrder, const bool fDesc,
+                             std::vector<std::shared_ptr<const Order>> &vOrders)
+    {
+        /* Check if an order is in our book already, since a claim can be disconnected before it closed the order. */
+        const auto itFind = std::find_if(vOrders.begin(), vOrders.end(),
+            [&pOrder](const std::shared_ptr<const Order>& pCheck){ return pCheck->pairOrder == pOrder->pairOrder; });
+
+        if(itFind != vOrders.end())
+            return;
+
+        /* Find our position after any orders with the same price, so that older orders stay ahead. */
+        const auto it = std::upper_bound(vOrders.begin(), vOrders.end(), pOrder,
+        [fDesc](const std::shared_ptr<const Order>& a, const std::shared_ptr<const Order>& b)
+        {
+            if(a->dPrice != b->dPrice)
+                return fDesc ? (a->dPrice > b->dPrice) : (a->dPrice < b->dPrice);
+
+            return a->nTimestamp < b->nTimestamp;
+        });
+
+        vOrders.insert(it, pOrder);
+    }
+
+
+    /* Add an open order to any order books it belongs in that have been loaded. */
+    void Market::AddOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket)
+    {
+        /* Orders listed under our market pair are bids for that book, and asks for the book of the reverse pair. */
+        const std::pair<uint256_t, uint256_t> pairReverse =
+            std::make_pair(pairMarket.second, pairMarket.first);
+
+        /* Check which of our books are loaded, books loaded after this read our order from disk themselves. */
+        bool fBids = false, fAsks = false;
+        {
+            LOCK(BOOK_MUTEX);
+
+            /* Let any book being loaded know that it could have missed our order. */
+            ++nBookUpdates;
+
+            fBids = (mapBooks.find(pairMarket)  != mapBooks.end());
+            fAsks = (mapBooks.find(pairReverse) != mapBooks.end());
+        }
+
+        /* Build our entries from disk before taking our lock again. */
+        std::shared_ptr<const Order> pBid, pAsk;
+        if(fBids)
+        {
+            Order tOrder;
+            if(BuildOrder(pairOrder, pairMarket, tOrder))
+                pBid = std::make_shared<const Order>(std::move(tOrder));
+        }
+
+        if(fAsks)
+        {
+            Order tOrder;
+            if(BuildOrder(pairOrder, pairReverse, tOrder))
+                pAsk = std::make_shared<const Order>(std::move(tOrder));
+        }
+
+        LOCK(BOOK_MUTEX);
+
+        /* Insert our bid. */
+        auto it = mapBooks.find(pairMarket);
+        if(pBid && it != mapBooks.end())
+            InsertOrder(pBid, true, it->second.vBids);
+
+        /* Insert our ask. */
+        it = mapBooks.find(pairReverse);
+        if(pAsk && it != mapBooks.end())
+            InsertOrder(pAsk, false, it->second.vAsks);
+    }
+
+
+    /* Remove a closed order from any order books it was loaded into. */
+    void Market::RemoveOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket)
+    {
+        /* Erase our order from one side of a book. */
+        const auto fnErase = [&pairOrder](std::vector<std::shared_ptr<const Order>> &vOrders)
+        {
+            const auto it = std::find_if(vOrders.begin(), vOrders.end(),
+                [&pairOrder](const std::shared_ptr<const Order>& pOrder){ return pOrder->pairOrder == pairOrder; });
+
+            if(it != vOrders.end())
+                vOrders.erase(it);
+        };
+
+        LOCK(BOOK_MUTEX);
+
+        /* Let any book being loaded know that it could have read our order before it was closed. */
+        ++nBookUpdates;
+
+        /* Orders listed under our market pair are bids for that book. */
+        auto it = mapBooks.find(pairMarket);
+        if(it != mapBooks.end())
+            fnErase(it->second.vBids);
+
+        /* And asks for the book of the reverse pair. */
+        it = mapBooks.find(std::make_pair(pairMarket.second, pairMarket.first));
+        if(it != mapBooks.end())
+            fnErase(it->second.vAsks);
+    }
+
+
+    /* List one side of an order book that are still open, applying filters and paging. */
+    encoding::json Market::ListBook(const std::vector<std::shared_ptr<const Order>>& vOrders, const encoding::json& jParams,
+                                    const uint32_t nLimit, const uint32_t nOffset)
+    {
+        /* Build our return value. */
+        encoding::json jRet = encoding::json::array();
+
+        /* Our book is already sorted, so we can stop as soon as our page is full. */
+        uint32_t nTotal = 0;
+        for(const auto& pOrder : vOrders)
+        {
+            /* Check the limit */
+            if(jRet.size() == nLimit)
+                break;
+
+            /* Check if the order has been claimed in the mempool. */
+            if(LLD::Contract->HasContract(pOrder->pairOrder, TAO::Ledger::FLAGS::MEMPOOL))
+                continue;
+
+            /* Check for a spent proof already. */
+            if(LLD::Ledger->HasProof(pOrder->hashRegister, pOrder->pairOrder.first, pOrder->pairOrder.second))
+                continue;
+
+            /* Copy our order's json for filtering. */
+            encoding::json jOrder = pOrder->jOrder;
+
+            /* Check that we match our filters. */
+            if(!FilterResults(jParams, jOrder))
+                continue;
+
+            /* Filter out our expected fieldnames if specified. */
+            if(!FilterFieldname(jParams, jOrder))
+                continue;
+
+            /* Check the offset. */
+            if(++nTotal <= nOffset)
+                continue;
+
+            jRet.push_back(jOrder);
+        }
+
+        return jRet;
+    }
+}
@@ -45,79 +45,184 @@ namespace TAO::API
             case TAO::Operation::OP::CONDITION:
             {
                 /* Check for valid exchange contract. */
-                if(Contracts::Verify(Contracts::Exchange::Token[0], rContract)) //checking for version 1
+                std::pair<uint256_t, uint256_t> pairMarket;
+                if(!ExtractOrder(rContract, pairMarket))
+                    break;
+
+                /* Write the order to logical database. */
+                if(!LLD::Logical->PushOrder(pairMarket, rContract, nContract))
+                {
+                    debug::warning(FUNCTION, "Indexing failed for tx ", rContract.Hash().SubString());
+                    break;
+                }
+
+                /* Add our order to any books that are loaded. */
+                AddOrder(std::make_pair(rContract.Hash(), nContract), pairMarket);
+
+                /* Give a verbose=3 debug log for the indexing entry. */
+                if(config::nVerbose >= 3)
                 {
-                    try //in case de-serialization fails from non-standard contracts
-                    {
-                        /* Get the next OP. */
-                        rContract.Seek(4, TAO::Operation::Contract::CONDITIONS);
-
-                        /* Get the comparison bytes. */
-                        TAO::Operation::Stream ssBytes;
-                        rContract >= ssBytes;
-
-                        /* Skip ahead to our token-id. */
-                        ssBytes.seek(33, STREAM::BEGIN);
-
-                        /* Grab our deposit token-id now. */
-                        uint256_t hashDeposit;
-                        ssBytes >> hashDeposit;
-
-                        /* Read the object to get token-id. */
-                        TAO::Register::Object oDeposit;
-                        if(!LLD::Register->ReadObject(hashDeposit, oDeposit))
-                            return;
-
-                        /* Grab our other withdraw token-id from pre-state. */
-                        TAO::Register::Object oWithdraw =
-                            rContract.PreState();
-
-                        /* Skip over non objects for now. */
-                        if(oWithdraw.nType != TAO::Register::REGISTER::OBJECT)
-                            return;
-
-                        /* Parse pre-state if needed. */
-                        oWithdraw.Parse();
-
-                        /* Create our market-pair. */
-                        const std::pair<uint256_t, uint256_t> pairMarket =
-                            std::make_pair(oDeposit.get<uint256_t>("token"), oWithdraw.get<uint256_t>("token"));
-
-                        /* Write the order to logical database. */
-                        if(!LLD::Logical->PushOrder(pairMarket, rContract, nContract))
-                            debug::warning(FUNCTION, "Indexing failed for tx ", rContract.Hash().SubString());
-
-                        /* Give a verbose=3 debug log for the indexing entry. */
-                        if(config::nVerbose >= 3)
-                        {
-                            /* This will hold our market name. */
-                            std::string strMarket =
-                                (TAO::Register::Address(pairMarket.first).ToString() + "/");
-
-                            /* Build our market-pair. */
-                            std::string strName;
-                            if(Names::ReverseLookup(pairMarket.first, strName))
-                                strMarket = strName + "/";
-
-                            /* Now add our second pair. */
-                            if(!Names::ReverseLookup(pairMarket.second, strName))
-                                strMarket += TAO::Register::Address(pairMarket.second).ToString();
-                            else
-                                strMarket += strName;
-
-                            /* Output our new debug info. */
-                            debug::log(3, "Market ", strMarket, " record created for ", rContract.Hash().SubString(), " txid");
-                        }
-
-                    }
-                    catch(const std::exception& e)
-                    {
-                        debug::warning(e.what());
-                    }
+                    /* This will hold our market name. */
+                    std::string strMarket =
+                        (TAO::Register::Address(pairMarket.first).ToString() + "/");
+
+                    /* Build our market-pair. */
+                    std::string strName;
+                    if(Names::ReverseLookup(pairMarket.first, strName))
+                        strMarket = strName + "/";
+
+                    /* Now add our second pair. */
+                    if(!Names::ReverseLookup(pairMarket.second, strName))
+                        strMarket += TAO::Register::Address(pairMarket.second).ToString();
+                    else
+                        strMarket += strName;
+
+                    /* Output our new debug info. */
+                    debug::log(3, "Market ", strMarket, " record created for ", rContract.Hash().SubString(), " txid");
                 }
 
                 break;
             }
+
+            /* Check for contracts that can claim an order. */
+            case TAO::Operation::OP::VALIDATE:
+            case TAO::Operation::OP::CREDIT:
+            {
+                /* Get the txid and contract-id being claimed. */
+                std::pair<uint512_t, uint32_t> pairOrder;
+                rContract >> pairOrder.first;
+                rContract >> pairOrder.second;
+
+                /* Check that we are claiming an order. */
+                std::pair<uint256_t, uint256_t> pairMarket;
+                if(!ClaimedOrder(pairOrder, pairMarket))
+                    break;
+
+                /* Move our first open order past this claim, and remove it from our books. */
+                if(!LLD::Logical->CloseOrder(pairMarket))
+                    debug::warning(FUNCTION, "Indexing failed for claim of ", pairOrder.first.SubString());
+
+                RemoveOrder(pairOrder, pairMarket);
+
+                break;
+            }
+        }
+    }
+
+
+    /* Generic handler for reversing indexes for this specific command-set. */
+    void Market::Deindex(const TAO::Operation::Contract& rContract, const uint32_t nContract)
+    {
+        /* Start our stream at 0. */
+        rContract.Reset();
+
+        /* Get the operation byte. */
+        uint8_t nType = 0;
+        rContract >> nType;
+
+        /* Switch based on type. */
+        switch(nType)
+        {
+            /* Check for contracts that claimed an order. */
+            case TAO::Operation::OP::VALIDATE:
+            case TAO::Operation::OP::CREDIT:
+            {
+                /* Get the txid and contract-id that was claimed. */
+                std::pair<uint512_t, uint32_t> pairOrder;
+                rContract >> pairOrder.first;
+                rContract >> pairOrder.second;
+
+                /* Check that we claimed an order. */
+                std::pair<uint256_t, uint256_t> pairMarket;
+                if(!ClaimedOrder(pairOrder, pairMarket))
+                    break;
+
+                /* Re-open the order now that its claim is disconnected, and add it back to our books. */
+                if(!LLD::Logical->ReopenOrder(pairOrder.first, pairOrder.second, pairMarket))
+                    debug::warning(FUNCTION, "Deindexing failed for claim of ", pairOrder.first.SubString());
+
+                AddOrder(pairOrder, pairMarket);
+
+                break;
+            }
+        }
+    }
+
+
+    /* Get the market pair an exchange order contract is listed in. */
+    bool Market::ExtractOrder(const TAO::Operation::Contract& rContract, std::pair<uint256_t, uint256_t> &pairMarket)
+    {
+        /* Check for valid exchange contract. */
+        if(!Contracts::Verify(Contracts::Exchange::Token[0], rContract)) //checking for version 1
+            return false;
+
+        try //in case de-serialization fails from non-standard contracts
+        {
+            /* Get the next OP. */
+            rContract.Seek(4, TAO::Operation::Contract::CONDITIONS);
+
+            /* Get the comparison bytes. */
+            TAO::Operation::Stream ssBytes;
+            rContract >= ssBytes;
+
+            /* Skip ahead to our token-id. */
+            ssBytes.seek(33, STREAM::BEGIN);
+
+            /* Grab our deposit token-id now. */
+            uint256_t hashDeposit;
+            ssBytes >> hashDeposit;
+
+            /* Read the object to get token-id. */
+            TAO::Register::Object oDeposit;
+            if(!LLD::Register->ReadObject(hashDeposit, oDeposit))
+                return false;
+
+            /* Grab our other withdraw token-id from pre-state. */
+            TAO::Register::Object oWithdraw =
+                rContract.PreState();
+
+            /* Skip over non objects for now. */
+            if(oWithdraw.nType != TAO::Register::REGISTER::OBJECT)
+                return false;
+
+            /* Parse pre-state if needed. */
+            oWithdraw.Parse();
+
+            /* Create our market-pair. */
+            pairMarket = std::make_pair(oDeposit.get<uint256_t>("token"), oWithdraw.get<uint256_t>("token"));
+        }
+        catch(const std::exception& e)
+        {
+            debug::warning(e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+
+    /* Get the market pair for an order that is being claimed. */
+    bool Market::ClaimedOrder(const std::pair<uint512_t, uint32_t>& pairOrder, std::pair<uint256_t, uint256_t> &pairMarket)
+    {
+        /* Check that we are claiming an order, most claims are credits of regular debits. */
+        if(!LLD::Logical->HasOrder(pairOrder.first, pairOrder.second))
+            return false;
+
+        /* Orders are indexed with their market. */
+        if(LLD::Logical->ReadOrder(pairOrder.first, pairOrder.second, pairMarket))
+            return true;
+
+        /* Older orders need their contract to find their market. */
+        try
+        {
+            const TAO::Operation::Contract tContract =
+                LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
+
+            return ExtractOrder(tContract, pairMarket);
+        }
+        catch(const std::exception& e)
+        {
+            return debug::error(FUNCTION, "order ", pairOrder.first.SubString(), " failed to load: ", e.what());
         }
     }
 }
@@ -59,169 +59,156 @@ namespace TAO::API
         encoding::json jRet =
             encoding::json::object();
 
-        /* Check for our bids type. */
-        if(setTypes.find("bid") != setTypes.end() || fAll)
+        /* Open orders are listed from our order book, which is already sorted by price. */
+        if(!fExecuted)
         {
-            /* Set our default sort by price for non executed. */
-            if(!fExecuted)
+            /* Get a copy of the book for our market pair, so we can check our orders on disk without holding our lock. */
+            const OrderBook tBook = GetBook(pairMarket);
+
+            /* Check for our bids type. */
+            if(setTypes.find("bid") != setTypes.end() || fAll)
+                jRet["bids"] = ListBook(tBook.vBids, jParams, nLimit, nOffset);
+
+            /* Check for our asks type. */
+            if(setTypes.find("ask") != setTypes.end() || fAll)
+                jRet["asks"] = ListBook(tBook.vAsks, jParams, nLimit, nOffset);
+
+            return jRet;
+        }
+
+        /* Get a list of our executed bids. */
+        std::vector<std::pair<uint512_t, uint32_t>> vBids;
+        if(LLD::Logical->ListAllOrders(pairMarket, vBids))
+        {
+            /* Build our object list and sort on insert. */
+            std::set<encoding::json, CompareResults> setBids({}, CompareResults(strOrder, strColumn));
+
+            /* Build our list of orders now. */
+            for(const auto& pairOrder : vBids)
             {
-                strColumn = "price";
-                strOrder  = "desc";
+                /* Check if the order has been executed. */
+                if(!LLD::Contract->HasContract(pairOrder, TAO::Ledger::FLAGS::MEMPOOL))
+                    continue;
+
+                /* Get our contract now. */
+                const TAO::Operation::Contract tContract =
+                    LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
+
+                /* Unpack our register address. */
+                uint256_t hashRegister;
+                if(!TAO::Register::Unpack(tContract, hashRegister))
+                    continue;
+
+                /* Get our order's json. */
+                encoding::json jOrder =
+                    OrderToJSON(tContract, pairMarket);
+
+                /* Check for null value. */
+                if(jOrder.is_null())
+                    continue;
+
+                /* Check that we match our filters. */
+                if(!FilterResults(jParams, jOrder))
+                    continue;
+
+                /* Filter out our expected fieldnames if specified. */
+                if(!FilterFieldname(jParams, jOrder))
+                    continue;
+
+                /* Insert into set and automatically sort. */
+                setBids.insert(jOrder);
             }
 
-            /* Get a list of our active orders. */
-            std::vector<std::pair<uint512_t, uint32_t>> vBids;
-            if(LLD::Logical->ListAllOrders(pairMarket, vBids))
+            /* Build our return value. */
+            encoding::json jBids = encoding::json::array();
+
+            /* Handle paging and offsets. */
+            uint32_t nTotal = 0;
+            for(const auto& jOrder : setBids)
             {
-                /* Build our object list and sort on insert. */
-                std::set<encoding::json, CompareResults> setBids({}, CompareResults(strOrder, strColumn));
-
-                /* Build our list of orders now. */
-                for(const auto& pairOrder : vBids)
-                {
-                    /* Get our contract now. */
-                    const TAO::Operation::Contract tContract =
-                        LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
-
-                    /* Unpack our register address. */
-                    uint256_t hashRegister;
-                    if(!TAO::Register::Unpack(tContract, hashRegister))
-                        continue;
-
-                    /* Check if the order has been executed. */
-                    if(LLD::Contract->HasContract(pairOrder, TAO::Ledger::FLAGS::MEMPOOL) != fExecuted)
-                        continue;
-
-                    /* Check for a spent proof already. */
-                    if(LLD::Ledger->HasProof(hashRegister, pairOrder.first, pairOrder.second) && !fExecuted)
-                        continue;
-
-                    /* Get our order's json. */
-                    encoding::json jOrder =
-                        OrderToJSON(tContract, pairMarket);
-
-                    /* Check for null value. */
-                    if(jOrder.is_null())
-                        continue;
-
-                    /* Check that we match our filters. */
-                    if(!FilterResults(jParams, jOrder))
-                        continue;
-
-                    /* Filter out our expected fieldnames if specified. */
-                    if(!FilterFieldname(jParams, jOrder))
-                        continue;
-
-                    /* Insert into set and automatically sort. */
-                    setBids.insert(jOrder);
-                }
-
-                /* Build our return value. */
-                encoding::json jBids = encoding::json::array();
-
-                /* Handle paging and offsets. */
-                uint32_t nTotal = 0;
-                for(const auto& jOrder : setBids)
-                {
-                    /* Check the offset. */
-                    if(++nTotal <= nOffset)
-                        continue;
-
-                    /* Check the limit */
-                    if(jBids.size() == nLimit)
-                        break;
-
-                    jBids.push_back(jOrder);
-                }
-
-                /* Add to our return value. */
-                jRet["bids"] = jBids;
+                /* Check the offset. */
+                if(++nTotal <= nOffset)
+                    continue;
+
+                /* Check the limit */
+                if(jBids.size() == nLimit)
+                    break;
+
+                jBids.push_back(jOrder);
             }
-            else
-                jRet["bids"] = encoding::json::array();
+
+            /* Add to our return value. */
+            jRet["bids"] = jBids;
         }
+        else
+            jRet["bids"] = encoding::json::array();
 
-        /* Check for our bids type. */
-        if(setTypes.find("ask") != setTypes.end() || fAll)
+        /* Get a list of our executed asks. */
+        std::vector<std::pair<uint512_t, uint32_t>> vAsks;
+        if(LLD::Logical->ListAllOrders(pairReverse, vAsks))
         {
-            /* Set our default sort by price for non executed. */
-            if(!fExecuted)
+            /* Build our object list and sort on insert. */
+            std::set<encoding::json, CompareResults> setAsks({}, CompareResults(strOrder, strColumn));
+
+            /* Build our list of orders now. */
+            for(const auto& pairOrder : vAsks)
             {
-                strColumn = "price";
-                strOrder  = "asc";
+                /* Check if the order has been executed. */
+                if(!LLD::Contract->HasContract(pairOrder, TAO::Ledger::FLAGS::MEMPOOL))
+                    continue;
+
+                /* Get our contract now. */
+                const TAO::Operation::Contract tContract =
+                    LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
+
+                /* Unpack our register address. */
+                uint256_t hashRegister;
+                if(!TAO::Register::Unpack(tContract, hashRegister))
+                    continue;
+
+                /* Get our order's json. */
+                encoding::json jOrder =
+                    OrderToJSON(tContract, pairMarket);
+
+                /* Check for null value. */
+                if(jOrder.is_null())
+                    continue;
+
+                /* Check that we match our filters. */
+                if(!FilterResults(jParams, jOrder))
+                    continue;
+
+                /* Filter out our expected fieldnames if specified. */
+                if(!FilterFieldname(jParams, jOrder))
+                    continue;
+
+                /* Insert into set and automatically sort. */
+                setAsks.insert(jOrder);
             }
 
-            /* Get a list of our active orders. */
-            std::vector<std::pair<uint512_t, uint32_t>> vAsks;
-            if(LLD::Logical->ListAllOrders(pairReverse, vAsks))
+            /* Build our return value. */
+            encoding::json jAsks = encoding::json::array();
+
+            /* Handle paging and offsets. */
+            uint32_t nTotal = 0;
+            for(const auto& jOrder : setAsks)
             {
-                /* Build our object list and sort on insert. */
-                std::set<encoding::json, CompareResults> setAsks({}, CompareResults(strOrder, strColumn));
-
-                /* Build our list of orders now. */
-                for(const auto& pairOrder : vAsks)
-                {
-                    /* Get our contract now. */
-                    const TAO::Operation::Contract tContract =
-                        LLD::Ledger->ReadContract(pairOrder.first, pairOrder.second);
-
-                    /* Unpack our register address. */
-                    uint256_t hashRegister;
-                    if(!TAO::Register::Unpack(tContract, hashRegister))
-                        continue;
-
-                    /* Check if the order has been executed. */
-                    if(LLD::Contract->HasContract(pairOrder, TAO::Ledger::FLAGS::MEMPOOL) != fExecuted)
-                        continue;
-
-                    /* Check for a spent proof already. */
-                    if(LLD::Ledger->HasProof(hashRegister, pairOrder.first, pairOrder.second) && !fExecuted)
-                        continue;
-
-                    /* Get our order's json. */
-                    encoding::json jOrder =
-                        OrderToJSON(tContract, pairMarket);
-
-                    /* Check for null value. */
-                    if(jOrder.is_null())
-                        continue;
-
-                    /* Check that we match our filters. */
-                    if(!FilterResults(jParams, jOrder))
-                        continue;
-
-                    /* Filter out our expected fieldnames if specified. */
-                    if(!FilterFieldname(jParams, jOrder))
-                        continue;
-
-                    /* Insert into set and automatically sort. */
-                    setAsks.insert(jOrder);
-                }
-
-                /* Build our return value. */
-                encoding::json jAsks = encoding::json::array();
-
-                /* Handle paging and offsets. */
-                uint32_t nTotal = 0;
-                for(const auto& jOrder : setAsks)
-                {
-                    /* Check the offset. */
-                    if(++nTotal <= nOffset)
-                        continue;
-
-                    /* Check the limit */
-                    if(jAsks.size() == nLimit)
-                        break;
-
-                    jAsks.push_back(jOrder);
-                }
-
-                /* Add to our return value. */
-                jRet["asks"] = jAsks;
+                /* Check the offset. */
+                if(++nTotal <= nOffset)
+                    continue;
+
+                /* Check the limit */
+                if(jAsks.size() == nLimit)
+                    break;
+
+                jAsks.push_back(jOrder);
             }
-            else
-                jRet["asks"] = encoding::json::array();
+
+            /* Add to our return value. */
+            jRet["asks"] = jAsks;
         }
+        else
+            jRet["asks"] = encoding::json::array();
 
         return jRet;
     }
@@ -13,8 +13,10 @@ ________________________________________________________________________________
 
 #include <LLD/include/global.h>
 
+#include <TAO/API/include/check.h>
 #include <TAO/API/include/extract.h>
 #include <TAO/API/include/global.h>
+#include <TAO/API/include/get.h>
 #include <TAO/API/include/filter.h>
 #include <TAO/API/include/json.h>
 #include <TAO/API/types/commands/profiles.h>
@@ -52,109 +54,95 @@ namespace TAO::API
         std::string strOrder = "desc";
         ExtractList(jParams, strOrder, nLimit, nOffset);
 
-        /* JSON return value. */
-        encoding::json jRet =
-            encoding::json::array();
+        /* Check for cursor paging, which resumes after the last result of a previous page. */
+        uint256_t hashCursor = 0;
+        uint32_t nCursor = 0;
 
-        /* Check for ascending order */
-        uint32_t nTotal = 0;
-        if(strOrder == "asc")
-        {
-            /* Get the last transaction. */
-            uint512_t hashFirst = 0;
-            if(!LLD::Logical->ReadFirst(hashGenesis, hashFirst))
-                throw Exception(-144, "No transactions found");
+        const bool fCursor = ExtractCursor(jParams, hashCursor, nCursor);
+        if(hashCursor != 0 && hashCursor != hashGenesis)
+            throw Exception(-57, "Invalid Parameter [cursor]");
 
-            /* Loop until genesis, storing all tx into a vector (these will be in descending order). */
-            while(hashFirst != 0)
-            {
-                /* Get the transaction from disk. */
-                TAO::API::Transaction tx;
-                if(!LLD::Logical->ReadTx(hashFirst, tx))
-                    throw Exception(-108, "Failed to read transaction");
-
-                /* Read the block state from the the ledger DB using the transaction hash index */
-                TAO::Ledger::BlockState bState;
-                LLD::Ledger->ReadBlock(hashFirst, bState);
-
-                /* Get the transaction JSON. */
-                encoding::json jResult =
-                    TAO::API::TransactionToJSON(tx, bState, nVerbose);
+        /* Get the last transaction to find the length of our sigchain. */
+        uint512_t hashLast = 0;
+        if(!LLD::Logical->ReadLast(hashGenesis, hashLast))
+            throw Exception(-144, "No transactions found");
 
-                /* Set the next last. */
-                hashFirst = tx.hashNextTx;
+        /* Get the last transaction from disk. */
+        TAO::API::Transaction txLast;
+        if(!LLD::Logical->ReadTx(hashLast, txLast))
+            throw Exception(-108, "Failed to read transaction");
 
-                /* Check to see whether the transaction has had all children filtered out */
-                if(jResult.empty())
-                    continue;
+        /* Find the sequence our page starts at. */
+        const bool fAscending = (strOrder == "asc");
+        int64_t nSequence = (fAscending ? 0 : txLast.nSequence);
+        if(hashCursor != 0)
+            nSequence = nCursor;
 
-                /* Apply our where filters now. */
-                if(!FilterResults(jParams, jResult))
-                    continue;
-
-                /* Filter out our expected fieldnames if specified. */
-                if(!FilterFieldname(jParams, jResult))
-                    continue;
-
-                /* Check the offset. */
-                if(++nTotal <= nOffset)
-                    continue;
+        /* Without filters every transaction is a result, so we can seek past our offset. */
+        if(jParams.find("where") == jParams.end() && !CheckRequest(jParams, "fieldname", "string, array"))
+        {
+            nSequence += (fAscending ? int64_t(nOffset) : -int64_t(nOffset));
+            nOffset    = 0;
+        }
 
-                /* Check the limit */
-                if(nTotal - nOffset > nLimit)
-                    break;
+        /* JSON return value. */
+        encoding::json jRet =
+            encoding::json::array();
 
-                jRet.push_back(jResult);
-            }
-        }
-        else
+        /* Loop through our sigchain by sequence. */
+        uint32_t nTotal = 0;
+        for( ; nSequence >= 0 && nSequence <= txLast.nSequence; nSequence += (fAscending ? 1 : -1))
         {
-            /* Get the last transaction. */
-            uint512_t hashLast = 0;
-            if(!LLD::Logical->ReadLast(hashGenesis, hashLast))
-                throw Exception(-144, "No transactions found");
-
-            /* Loop until genesis, storing all tx into a vector (these will be in descending order). */
-            while(hashLast != 0)
+            /* Get our txid by sequence, verifying that our index matches our sigchain. */
+            uint512_t hashTx = 0;
+            TAO::API::Transaction tx;
+            if(!LLD::Logical->ReadSigchainTx(hashGenesis, nSequence, hashTx)
+            || !LLD::Logical->ReadTx(hashTx, tx) || tx.hashGenesis != hashGenesis || tx.nSequence != nSequence)
             {
+                /* Build our index from the ledger if this sequence is missing. */
+                TAO::Ledger::Transaction txLedger;
+                if(!Indexing::ReadSequence(hashGenesis, nSequence, hashTx, txLedger))
+                    throw Exception(-108, "Failed to read transaction");
+
                 /* Get the transaction from disk. */
-                TAO::API::Transaction tx;
-                if(!LLD::Logical->ReadTx(hashLast, tx))
+                if(!LLD::Logical->ReadTx(hashTx, tx))
                     throw Exception(-108, "Failed to read transaction");
+            }
 
-                /* Read the block state from the the ledger DB using the transaction hash index */
-                TAO::Ledger::BlockState bState;
-                LLD::Ledger->ReadBlock(hashLast, bState);
+            /* Read the block state from the the ledger DB using the transaction hash index */
+            TAO::Ledger::BlockState bState;
+            LLD::Ledger->ReadBlock(hashTx, bState);
 
-                /* Get the transaction JSON. */
-                encoding::json jResult =
-                    TAO::API::TransactionToJSON(tx, bState, nVerbose);
+            /* Get the transaction JSON. */
+            encoding::json jResult =
+                TAO::API::TransactionToJSON(tx, bState, nVerbose);
 
-                /* Set the next last. */
-                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+            /* Check to see whether the transaction has had all children filtered out */
+            if(jResult.empty())
+                continue;
 
-                /* Check to see whether the transaction has had all children filtered out */
-                if(jResult.empty())
-                    continue;
+            /* Apply our where filters now. */
+            if(!FilterResults(jParams, jResult))
+                continue;
 
-                /* Apply our where filters now. */
-                if(!FilterResults(jParams, jResult))
-                    continue;
+            /* Filter out our expected fieldnames if specified. */
+            if(!FilterFieldname(jParams, jResult))
+                continue;
 
-                /* Filter out our expected fieldnames if specified. */
-                if(!FilterFieldname(jParams, jResult))
-                    continue;
+            /* Check the offset. */
+            if(++nTotal <= nOffset)
+                continue;
 
-                /* Check the offset. */
-                if(++nTotal <= nOffset)
-                    continue;
+            /* Check the limit */
+            if(nTotal - nOffset > nLimit)
+                break;
 
-                /* Check the limit */
-                if(nTotal - nOffset > nLimit)
-                    break;
+            /* Add our cursor to resume after this result, unless this is the end of our sigchain. */
+            const int64_t nNext = nSequence + (fAscending ? 1 : -1);
+            if(fCursor && jResult.is_object() && nNext >= 0 && nNext <= txLast.nSequence)
+                jResult["cursor"] = GetCursor(hashGenesis, nNext);
 
-                jRet.push_back(jResult);
-            }
+            jRet.push_back(jResult);
         }
 
         return jRet;
@@ -15,6 +15,7 @@ ________________________________________________________________________________
 
 #include <TAO/API/types/commands/register.h>
 #include <TAO/API/types/exception.h>
+#include <TAO/API/types/indexing.h>
 
 #include <TAO/API/include/build.h>
 #include <TAO/API/include/check.h>
@@ -22,6 +23,7 @@ ________________________________________________________________________________
 #include <TAO/API/include/extract.h>
 #include <TAO/API/include/execute.h>
 #include <TAO/API/include/filter.h>
+#include <TAO/API/include/get.h>
 #include <TAO/API/include/json.h>
 
 #include <TAO/Operation/include/enum.h>
@@ -62,30 +64,99 @@ namespace TAO::API
         /* Get the params to apply to the response. */
         ExtractList(jParams, strOrder, strColumn, nLimit, nOffset);
 
-        /* Get the last transaction. */
+        /* Check for cursor paging, which returns results in order and stops once our page is full. */
+        uint256_t hashCursor = 0;
+        uint32_t nCursor = 0;
+
+        const bool fCursor    = ExtractCursor(jParams, hashCursor, nCursor);
+        const bool fAscending = (strOrder == "asc");
+
+        /* Check if our register's history was indexed from its first transaction, which allows paging in both orders. */
+        uint32_t nCount = 0;
+        uint512_t hashFirst = 0;
+
+        const bool fIndexed = fCursor && (hashCursor == 0 || hashCursor == hashRegister) && config::fIndexRegister.load()
+            && LLD::Logical->ReadRegisterSequence(hashRegister, nCount)
+            && LLD::Logical->ReadRegisterTx(hashRegister, 0, hashFirst);
+
+        /* Cursors for our register need our index, otherwise cursors are for the sigchain we are walking. */
+        if(hashCursor == hashRegister && !fIndexed)
+            throw Exception(-57, "Invalid Parameter [cursor]");
+
+        /* Walking our sigchains can only page in descending order. */
+        if(fCursor && !fIndexed && fAscending)
+            throw Exception(-57, "Invalid Parameter [order], cursor paging requires [order=desc]");
+
+        /* Get the sequence of our index to start from. */
+        int64_t nIndex = (hashCursor != 0 ? nCursor : (fAscending ? 0 : int64_t(nCount) - 1));
+
+        /* Get the last transaction, or seek to where our cursor resumes. */
         uint512_t hashLast = 0;
-        if(!LLD::Ledger->ReadLast(hashGenesis, hashLast))
-            throw Exception(-144, "No transactions found");
+        if(!fIndexed)
+        {
+            /* Get the transaction at our cursor's sequence. */
+            if(hashCursor != 0)
+            {
+                TAO::Ledger::Transaction txCursor;
+                if(!Indexing::ReadSequence(hashCursor, nCursor, hashLast, txCursor))
+                    throw Exception(-57, "Invalid Parameter [cursor]");
+            }
+            else if(!LLD::Ledger->ReadLast(hashGenesis, hashLast))
+                throw Exception(-144, "No transactions found");
+        }
 
         /* Build our object list and sort on insert. */
         std::set<encoding::json, CompareResults> setHistory({}, CompareResults(strOrder, strColumn));
 
+        /* Build our return value. */
+        encoding::json jRet = encoding::json::array();
+
         /* Loop until genesis. */
-        while(hashLast != 0)
+        uint32_t nTotal = 0;
+        while(!config::fShutdown.load())
         {
             /* Get the transaction from disk. */
             TAO::Ledger::Transaction tx;
-            if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
-                throw Exception(-108, "Failed to read transaction");
+            if(fIndexed)
+            {
+                /* Check for the end of our index. */
+                if(nIndex < 0 || nIndex >= nCount)
+                    break;
+
+                /* Get the txid at this sequence. */
+                uint512_t hashTx;
+                if(!LLD::Logical->ReadRegisterTx(hashRegister, nIndex, hashTx))
+                    throw Exception(-108, "Failed to read transaction");
 
-            /* Set the next last. */
-            hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+                /* Get the transaction from disk. */
+                if(!LLD::Ledger->ReadTx(hashTx, tx))
+                    throw Exception(-108, "Failed to read transaction");
+
+                /* Set the next sequence. */
+                nIndex += (fAscending ? 1 : -1);
+            }
+            else
+            {
+                /* Check for the end of our sigchains. */
+                if(hashLast == 0)
+                    break;
+
+                /* Get the transaction from disk. */
+                if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                    throw Exception(-108, "Failed to read transaction");
+
+                /* Set the next last. */
+                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+            }
+
+            /* Track the results from this transaction for our cursors. */
+            const uint32_t nBegin = jRet.size();
 
             /* Loop through our contracts to check if they match our address. */
-            for(int32_t nContract = tx.Size() - 1; nContract >= 0; --nContract)
+            for(uint32_t n = 0; n < tx.Size(); ++n)
             {
-                /* Get the contract. */
-                const TAO::Operation::Contract& rContract = tx[nContract];
+                /* Get the contract in the order of our results. */
+                const TAO::Operation::Contract& rContract = tx[fIndexed && fAscending ? n : tx.Size() - 1 - n];
 
                 /* Unpack the contract address. */
                 uint256_t hashContract;
@@ -177,11 +248,20 @@ namespace TAO::API
                 if(!FilterFieldname(jParams, jRegister))
                     continue;
 
+                /* Add results in order when cursor paging. */
+                if(fCursor)
+                {
+                    /* Check the offset. */
+                    if(++nTotal > nOffset)
+                        jRet.push_back(jRegister);
+                }
+
                 /* Insert into set and automatically sort. */
-                setHistory.insert(jRegister);
+                else
+                    setHistory.insert(jRegister);
 
-                /* Jump sigchains on CLAIM. */
-                if(nPrimitive == TAO::Operation::OP::CLAIM)
+                /* Jump sigchains on CLAIM, which our index doesn't need since it holds every owner's transactions. */
+                if(nPrimitive == TAO::Operation::OP::CLAIM && !fIndexed)
                 {
                     /* Grab our tx-id now. */
                     rContract.SeekToPrimitive(false);
@@ -190,13 +270,38 @@ namespace TAO::API
                     break;
                 }
             }
+
+            /* Check for results from this transaction when cursor paging. */
+            if(fCursor && jRet.size() > nBegin)
+            {
+                /* Find where the next page resumes, which is after this transaction so its results aren't split. */
+                std::string strCursor;
+                if(fIndexed && nIndex >= 0 && nIndex < nCount)
+                    strCursor = GetCursor(hashRegister, nIndex);
+
+                /* Get the sequence of the next transaction in our walk. */
+                TAO::Ledger::Transaction txNext;
+                if(!fIndexed && hashLast != 0 && LLD::Ledger->ReadTx(hashLast, txNext, TAO::Ledger::FLAGS::MEMPOOL))
+                    strCursor = GetCursor(txNext.hashGenesis, txNext.nSequence);
+
+                /* Add our cursor to these results. */
+                for(uint32_t n = nBegin; n < jRet.size(); ++n)
+                {
+                    if(!strCursor.empty() && jRet[n].is_object())
+                        jRet[n]["cursor"] = strCursor;
+                }
+
+                /* Check the limit once this transaction is complete. */
+                if(jRet.size() >= nLimit)
+                    break;
+            }
         }
 
-        /* Build our return value. */
-        encoding::json jRet = encoding::json::array();
+        /* Check for cursor paging, which has built our results already. */
+        if(fCursor)
+            return jRet;
 
         /* Handle paging and offsets. */
-        uint32_t nTotal = 0;
         for(const auto& jRegister : setHistory)
         {
             /* Check the offset. */
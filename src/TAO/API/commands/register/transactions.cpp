@@ -17,9 +17,11 @@ ________________________________________________________________________________
 #include <TAO/API/include/compare.h>
 #include <TAO/API/include/extract.h>
 #include <TAO/API/include/filter.h>
+#include <TAO/API/include/get.h>
 #include <TAO/API/include/json.h>
 
 #include <TAO/API/types/exception.h>
+#include <TAO/API/types/indexing.h>
 #include <TAO/API/types/commands/register.h>
 
 #include <TAO/Ledger/types/transaction.h>
@@ -60,14 +62,35 @@ namespace TAO::API
         /* Get the params to apply to the response. */
         ExtractList(jParams, strOrder, strColumn, nLimit, nOffset);
 
-        /* Get the last transaction. */
+        /* Check for cursor paging, which returns results in sigchain order and stops once our page is full. */
+        uint256_t hashCursor = 0;
+        uint32_t nCursor = 0;
+
+        const bool fCursor = ExtractCursor(jParams, hashCursor, nCursor);
+        if(fCursor && strOrder != "desc")
+            throw Exception(-57, "Invalid Parameter [order], cursor paging requires [order=desc]");
+
+        /* Get the last transaction, or seek to where our cursor resumes. */
         uint512_t hashLast = 0;
-        if(!LLD::Ledger->ReadLast(hashGenesis, hashLast))
+        if(hashCursor != 0)
+        {
+            /* Get the transaction at our cursor's sequence. */
+            TAO::Ledger::Transaction txCursor;
+            if(!Indexing::ReadSequence(hashCursor, nCursor, hashLast, txCursor))
+                throw Exception(-57, "Invalid Parameter [cursor]");
+        }
+        else if(!LLD::Ledger->ReadLast(hashGenesis, hashLast))
             throw Exception(-144, "No transactions found");
 
         /* Build our object list and sort on insert. */
         std::set<encoding::json, CompareResults> setTransactions({}, CompareResults(strOrder, strColumn));
 
+        /* Build our return value. */
+        encoding::json jRet = encoding::json::array();
+
+        /* Track our results for cursor paging. */
+        uint32_t nTotal = 0;
+
         /* Loop until genesis. */
         while(hashLast != 0)
         {
@@ -176,15 +199,36 @@ namespace TAO::API
             if(!FilterFieldname(jParams, jTransaction))
                 continue;
 
+            /* Add results in sigchain order when cursor paging. */
+            if(fCursor)
+            {
+                /* Check the offset. */
+                if(++nTotal <= nOffset)
+                    continue;
+
+                /* Add our cursor to resume from the next transaction in our walk. */
+                TAO::Ledger::Transaction txNext;
+                if(hashLast != 0 && jTransaction.is_object() && LLD::Ledger->ReadTx(hashLast, txNext, TAO::Ledger::FLAGS::MEMPOOL))
+                    jTransaction["cursor"] = GetCursor(txNext.hashGenesis, txNext.nSequence);
+
+                jRet.push_back(jTransaction);
+
+                /* Check the limit */
+                if(jRet.size() == nLimit)
+                    break;
+
+                continue;
+            }
+
             /* Insert into set and automatically sort. */
             setTransactions.insert(jTransaction);
         }
 
-        /* Build our return value. */
-        encoding::json jRet = encoding::json::array();
+        /* Check for cursor paging, which has built our results already. */
+        if(fCursor)
+            return jRet;
 
         /* Handle paging and offsets. */
-        uint32_t nTotal = 0;
         for(const auto& jTransaction : setTransactions)
         {
             /* Check the offset. */
@@ -27,8 +27,10 @@ ________________________________________________________________________________
 
 #include <TAO/Register/include/names.h>
 
+#include <Util/include/encoding.h>
 #include <Util/include/math.h>
 #include <Util/include/string.h>
+#include <Util/templates/datastream.h>
 
 #include <Util/types/precision.h>
 
@@ -681,6 +683,41 @@ namespace TAO::API
     }
 
 
+    /* Extracts a continuation cursor returned by a previous page of results. */
+    bool ExtractCursor(const encoding::json& jParams, uint256_t &hashKey, uint32_t &nSequence)
+    {
+        /* Check that cursor paging was requested at all. */
+        if(jParams.find("cursor") == jParams.end())
+            return false;
+
+        /* An empty cursor starts from our first result. */
+        hashKey   = 0;
+        nSequence = 0;
+        if(!CheckParameter(jParams, "cursor", "string"))
+            return true;
+
+        /* Decode our cursor, checking it holds a version, key, and sequence. */
+        std::vector<uint8_t> vCursor;
+        if(!encoding::DecodeBase58Check(jParams["cursor"].get<std::string>(), vCursor) || vCursor.size() != 37)
+            throw Exception(-57, "Invalid Parameter [cursor]");
+
+        /* Check our version. */
+        DataStream ssCursor(vCursor, SER_NETWORK, 1);
+
+        uint8_t nVersion = 0;
+        ssCursor >> nVersion;
+
+        if(nVersion != CURSOR_VERSION)
+            throw Exception(-57, "Invalid Parameter [cursor]");
+
+        /* Deserialize our key and sequence. */
+        ssCursor >> hashKey;
+        ssCursor >> nSequence;
+
+        return true;
+    }
+
+
     /** ExtractBoolean
      *
      *  Extract a boolean value from input parameters.
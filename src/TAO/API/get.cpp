@@ -11,6 +11,7 @@
 
 ____________________________________________________________________________________________*/
 
+#include <TAO/API/include/constants.h>
 #include <TAO/API/include/get.h>
 #include <TAO/API/include/list.h>
 
@@ -32,7 +33,9 @@ ________________________________________________________________________________
 
 #include <LLD/include/global.h>
 
+#include <Util/include/encoding.h>
 #include <Util/include/math.h>
+#include <Util/templates/datastream.h>
 #include <Util/types/precision.h>
 
 /* Global TAO namespace. */
@@ -772,4 +775,15 @@ namespace TAO::API
 
         return "STANDARD"; //this is our dummy type
     }
+
+
+    /* Returns an opaque continuation cursor to resume paging from a given sequence. */
+    std::string GetCursor(const uint256_t& hashKey, const uint32_t nSequence)
+    {
+        /* Serialize our key and sequence. */
+        DataStream ssCursor(SER_NETWORK, 1);
+        ssCursor << uint8_t(CURSOR_VERSION) << hashKey << nSequence;
+
+        return encoding::EncodeBase58Check(ssCursor.Bytes());
+    }
 } // End TAO namespace
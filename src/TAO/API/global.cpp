@@ -32,6 +32,7 @@ ________________________________________________________________________________
 #include <TAO/API/types/commands.h>
 #include <TAO/API/types/indexing.h>
 #include <TAO/API/types/notifications.h>
+#include <TAO/API/types/workers.h>
 
 #include <Util/include/debug.h>
 
@@ -83,6 +84,9 @@ namespace TAO::API
 
         /* Fire up notifications processors. */
         Notifications::Initialize();
+
+        /* Start our workers for running commands off of the data threads. */
+        Workers::Initialize();
     }
 
 
@@ -91,6 +95,9 @@ namespace TAO::API
     {
         debug::log(0, FUNCTION, "Shutting down API");
 
+        /* Stop our workers before our commands are deleted. */
+        Workers::Shutdown();
+
         /* Shutdown notifications subsystem. */
         Notifications::Shutdown();
 
@@ -31,6 +31,10 @@ namespace TAO::API
     const uint256_t ADDRESS_NONE = uint256_t(1);
 
 
+    /** The version of our serialized continuation cursors. **/
+    const uint8_t CURSOR_VERSION = 1;
+
+
     /** Namespace to hold ticker constants. */
     namespace TOKEN
     {
@@ -289,6 +289,20 @@ namespace TAO::API
     void ExtractList(const encoding::json& jParams, std::string &strOrder, std::string &strSort, uint32_t &nLimit, uint32_t &nOffset);
 
 
+    /** ExtractCursor
+     *
+     *  Extracts a continuation cursor returned by a previous page of results. An empty cursor starts from the first result.
+     *
+     *  @param[in] jParams The parameters passed into the request
+     *  @param[out] hashKey The sigchain or register the cursor is paging through, zero when starting from the first result.
+     *  @param[out] nSequence The sequence number to resume paging from.
+     *
+     *  @return true if cursor paging was requested.
+     *
+     **/
+    bool ExtractCursor(const encoding::json& jParams, uint256_t &hashKey, uint32_t &nSequence);
+
+
     /** ExtractBoolean
      *
      *  Extract a boolean value from input parameters.
@@ -192,4 +192,17 @@ namespace TAO::API
      **/
     std::string GetRegisterForm(const uint8_t nType);
 
+
+    /** GetCursor
+     *
+     *  Returns an opaque continuation cursor to resume paging from a given sequence.
+     *
+     *  @param[in] hashKey The sigchain or register that results are being paged through.
+     *  @param[in] nSequence The sequence number to resume paging from.
+     *
+     *  @return The cursor encoded as a base58 string.
+     *
+     **/
+    std::string GetCursor(const uint256_t& hashKey, const uint32_t nSequence);
+
 }
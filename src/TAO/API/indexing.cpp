@@ -40,8 +40,8 @@ ________________________________________________________________________________
 /* Global TAO namespace. */
 namespace TAO::API
 {
-    /* Queue to handle dispatch requests. */
-    util::atomic::lock_unique_ptr<std::queue<uint512_t>> Indexing::DISPATCH;
+    /* Queue to handle dispatch requests, flagged true for connected and false for disconnected transactions. */
+    util::atomic::lock_unique_ptr<std::queue<std::pair<uint512_t, bool>>> Indexing::DISPATCH;
 
 
     /* Thread for running dispatch. */
@@ -78,7 +78,7 @@ namespace TAO::API
         /* Read our list of active login sessions. */
 
         /* Initialize our thread objects now. */
-        Indexing::DISPATCH      = util::atomic::lock_unique_ptr<std::queue<uint512_t>>(new std::queue<uint512_t>());
+        Indexing::DISPATCH      = util::atomic::lock_unique_ptr<std::queue<std::pair<uint512_t, bool>>>(new std::queue<std::pair<uint512_t, bool>>());
         Indexing::EVENTS_THREAD = std::thread(&Indexing::Manager);
 
 
@@ -292,13 +292,23 @@ namespace TAO::API
     /*  Index a new block hash to relay thread.*/
     void Indexing::PushTransaction(const uint512_t& hashTx)
     {
-        DISPATCH->push(hashTx);
+        DISPATCH->push(std::make_pair(hashTx, true));
         CONDITION.notify_all();
 
         debug::log(3, FUNCTION, "Pushing ", hashTx.SubString(), " To Indexing Queue.");
     }
 
 
+    /* Dispatch a disconnected transaction to relay thread. */
+    void Indexing::PopTransaction(const uint512_t& hashTx)
+    {
+        DISPATCH->push(std::make_pair(hashTx, false));
+        CONDITION.notify_all();
+
+        debug::log(3, FUNCTION, "Pushing ", hashTx.SubString(), " To De-indexing Queue.");
+    }
+
+
     /* Handle relays of all events for LLP when processing block. */
     void Indexing::Manager()
     {
@@ -330,14 +340,21 @@ namespace TAO::API
                 return;
 
             /* Grab the next entry in the queue. */
-            const uint512_t hashTx = DISPATCH->front();
+            const std::pair<uint512_t, bool> pairDispatch = DISPATCH->front();
             DISPATCH->pop();
 
+            /* Reverse our indexes for disconnected transactions. */
+            if(!pairDispatch.second)
+            {
+                DeindexSigchain(pairDispatch.first);
+                continue;
+            }
+
             /* Fire off indexing now. */
-            IndexSigchain(hashTx);
+            IndexSigchain(pairDispatch.first);
 
             /* Write our last index now. */
-            LLD::Logical->WriteLastIndex(hashTx);
+            LLD::Logical->WriteLastIndex(pairDispatch.first);
         }
     }
 
@@ -415,6 +432,87 @@ namespace TAO::API
     }
 
 
+    /* Reverse the command-set indexes of a tritium transaction that has been disconnected. */
+    void Indexing::DeindexSigchain(const uint512_t& hashTx)
+    {
+        /* Only tritium transactions have command-set indexes. */
+        if(hashTx.GetType() != TAO::Ledger::TRITIUM)
+            return;
+
+        /* Make sure the transaction is on disk. */
+        TAO::Ledger::Transaction tx;
+        if(!LLD::Ledger->ReadTx(hashTx, tx))
+        {
+            debug::warning(FUNCTION, "De-indexing Failed: could not find ", hashTx.SubString(), " on disk");
+            return;
+        }
+
+        /* Iterate the transaction contracts in reverse order. */
+        for(uint32_t nContract = tx.Size(); nContract > 0; --nContract)
+        {
+            /* Grab contract reference. */
+            const TAO::Operation::Contract& rContract = tx[nContract - 1];
+
+            {
+                LOCK(REGISTERED_MUTEX);
+
+                /* Loop through registered commands. */
+                for(const auto& strCommands : REGISTERED)
+                    Commands::Instance(strCommands)->Deindex(rContract, nContract - 1);
+            }
+        }
+    }
+
+
+    /* Read a transaction by its sequence number in a sigchain. */
+    bool Indexing::ReadSequence(const uint256_t& hashGenesis, const uint32_t nSequence, uint512_t &hashTx, TAO::Ledger::Transaction &tx)
+    {
+        /* Check our index first, making sure it wasn't left over from a transaction that is no longer in the sigchain. */
+        if(LLD::Logical->ReadSigchainTx(hashGenesis, nSequence, hashTx)
+        && LLD::Ledger->ReadTx(hashTx, tx, TAO::Ledger::FLAGS::MEMPOOL)
+        && tx.hashGenesis == hashGenesis && tx.nSequence == nSequence)
+            return true;
+
+        /* Start from the sequence after ours if it is indexed, so that walking a sigchain backwards only reads each transaction once. */
+        uint512_t hashLast = 0;
+        if(LLD::Logical->ReadSigchainTx(hashGenesis, nSequence + 1, hashLast)
+        && LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL)
+        && tx.hashGenesis == hashGenesis && tx.nSequence == nSequence + 1)
+            hashLast = tx.hashPrevTx;
+
+        /* Otherwise get the last transaction in our sigchain. */
+        else if(!LLD::Ledger->ReadLast(hashGenesis, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
+            return false;
+
+        /* Walk back to our sequence, indexing every transaction we pass so we only walk once. */
+        while(hashLast != 0 && !config::fShutdown.load())
+        {
+            /* Get the transaction from disk. */
+            if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                return false;
+
+            /* Check for sequences past the end of our sigchain. */
+            if(tx.nSequence < nSequence)
+                return false;
+
+            /* Write our sequence index. */
+            LLD::Logical->WriteSigchainTx(hashGenesis, tx.nSequence, hashLast);
+
+            /* Check if we have found our sequence. */
+            if(tx.nSequence == nSequence)
+            {
+                hashTx = hashLast;
+                return true;
+            }
+
+            /* Set the next last. */
+            hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+        }
+
+        return false;
+    }
+
+
     /* Broadcast our unconfirmed transactions if there are any. */
     void Indexing::BroadcastUnconfirmed(const uint256_t& hashGenesis)
     {
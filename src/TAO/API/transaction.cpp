@@ -353,6 +353,10 @@ namespace TAO::API
         if(!LLD::Logical->WriteTx(hash, *this))
             return debug::error(FUNCTION, "failed to write ", VARIABLE(hash.SubString()));
 
+        /* Index our transaction by its sequence in our sigchain. */
+        if(!LLD::Logical->WriteSigchainTx(hashGenesis, nSequence, hash))
+            return debug::error(FUNCTION, "failed to write sequence index for ", VARIABLE(hash.SubString()));
+
         /* Write our last index to the database. */
         if(hashNextTx == 0 && !LLD::Logical->WriteLast(hashGenesis, hash))
             return debug::error(FUNCTION, "failed to write last index for ", VARIABLE(hashGenesis.SubString()));
@@ -402,6 +406,11 @@ namespace TAO::API
         if(!LLD::Logical->EraseTx(hash))
             return debug::error(FUNCTION, "failed to erase ", VARIABLE(hash.SubString()));
 
+        /* Erase our sequence index if it still points to this transaction. */
+        uint512_t hashSequence;
+        if(LLD::Logical->ReadSigchainTx(hashGenesis, nSequence, hashSequence) && hashSequence == hash)
+            LLD::Logical->EraseSigchainTx(hashGenesis, nSequence);
+
         /* De-index our transaction level data now. */
         deindex_registers(hash);
         deindex_events(hash);
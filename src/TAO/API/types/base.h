@@ -201,6 +201,18 @@ namespace TAO::API
          *
          **/
         virtual void Index(const TAO::Operation::Contract& rContract, const uint32_t nContract) { }
+
+
+        /** Deindex
+         *
+         *  Generic handler for reversing indexes for this specific command-set when a contract is disconnected.
+         *  This handler takes a contract and reverses the indexes that command's logic built for it.
+         *
+         *  @param[in] rContract The contract we are reversing indexes for.
+         *  @param[in] nContract The contract-id we are reversing for.
+         *
+         **/
+        virtual void Deindex(const TAO::Operation::Contract& rContract, const uint32_t nContract) { }
     };
 
 
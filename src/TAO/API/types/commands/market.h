@@ -17,6 +17,8 @@ ________________________________________________________________________________
 
 #include <TAO/Operation/types/contract.h>
 
+#include <memory>
+
 /* Global TAO namespace. */
 namespace TAO::API
 {
@@ -28,17 +30,76 @@ namespace TAO::API
      **/
     class Market : public Derived<Market>
     {
+        /** Order
+         *
+         *  An open order held in an order book, with its formatted JSON built ahead of time.
+         *
+         **/
+        struct Order
+        {
+            /** The txid and contract-id of the order. **/
+            std::pair<uint512_t, uint32_t> pairOrder;
+
+
+            /** The register address the order is debiting from. **/
+            uint256_t hashRegister;
+
+
+            /** The price of the order, used for sorting. **/
+            double dPrice;
+
+
+            /** The timestamp of the order, used for sorting orders with the same price. **/
+            uint64_t nTimestamp;
+
+
+            /** The formatted JSON for the order. **/
+            encoding::json jOrder;
+        };
+
+
+        /** OrderBook
+         *
+         *  Price sorted view of the open orders for a market pair, so that listing orders doesn't need to read,
+         *  format, and sort every order on each request.
+         *
+         **/
+        struct OrderBook
+        {
+            /** Our bids sorted by highest price first. **/
+            std::vector<std::shared_ptr<const Order>> vBids;
+
+
+            /** Our asks sorted by lowest price first. **/
+            std::vector<std::shared_ptr<const Order>> vAsks;
+        };
+
 
         /** Handle for fee parameters. **/
         std::map<uint256_t, std::pair<uint256_t, uint64_t>> mapFees;
 
 
+        /** Order books that have been loaded by market pair. **/
+        std::map<std::pair<uint256_t, uint256_t>, OrderBook> mapBooks;
+
+
+        /** Count of changes made to our open orders, so a book loaded without holding BOOK_MUTEX can tell it missed one. **/
+        uint64_t nBookUpdates;
+
+
+        /** Mutex to protect our order books and open orders. **/
+        std::mutex BOOK_MUTEX;
+
+
     public:
 
         /** Default Constructor. **/
         Market()
         : Derived<Market>()
         , mapFees        ()
+        , mapBooks       ()
+        , nBookUpdates   (0)
+        , BOOK_MUTEX     ()
         {
         }
 
@@ -66,6 +127,10 @@ namespace TAO::API
         void Index(const TAO::Operation::Contract& rContract, const uint32_t nContract) override;
 
 
+        /* Generic handler for reversing indexes for this specific command-set. */
+        void Deindex(const TAO::Operation::Contract& rContract, const uint32_t nContract) override;
+
+
         /** Create
          *
          *  Create an order on the market
@@ -157,5 +222,125 @@ namespace TAO::API
          **/
         __attribute__((pure)) encoding::json OrderToJSON(const TAO::Operation::Contract& rContract, const uint256_t& hashBase);
 
+
+    private:
+
+        /** GetBook
+         *
+         *  Get a copy of the order book for a market pair, loading it from our open orders if needed. Orders are shared
+         *  with our loaded book, so the copy can be listed after BOOK_MUTEX is released.
+         *
+         *  @param[in] pairMarket The market pair ordering.
+         *
+         *  @return a copy of the order book.
+         *
+         **/
+        OrderBook GetBook(const std::pair<uint256_t, uint256_t>& pairMarket);
+
+
+        /** LoadBook
+         *
+         *  Read and sort the open orders for a market pair from disk, without holding BOOK_MUTEX.
+         *
+         *  @param[in] pairMarket The market pair ordering.
+         *  @param[out] tBook The order book to load.
+         *
+         **/
+        void LoadBook(const std::pair<uint256_t, uint256_t>& pairMarket, OrderBook &tBook);
+
+
+        /** BuildOrder
+         *
+         *  Read an order from disk and build its order book entry.
+         *
+         *  @param[in] pairOrder The txid and contract-id of the order.
+         *  @param[in] pairMarket The market pair ordering for the book.
+         *  @param[out] tOrder The order book entry.
+         *
+         *  @return true if the order is a valid order for the market.
+         *
+         **/
+        bool BuildOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket,
+                        Order &tOrder);
+
+
+        /** InsertOrder
+         *
+         *  Insert an order into one side of an order book, keeping it sorted by price. Requires BOOK_MUTEX.
+         *
+         *  @param[in] pOrder The order book entry to insert.
+         *  @param[in] fDesc Flag to sort by highest price first.
+         *  @param[out] vOrders The side of the order book to insert into.
+         *
+         **/
+        void InsertOrder(const std::shared_ptr<const Order>& pOrder, const bool fDesc,
+                         std::vector<std::shared_ptr<const Order>> &vOrders);
+
+
+        /** AddOrder
+         *
+         *  Add an open order to any order books it belongs in that have been loaded, reading the order before
+         *  taking BOOK_MUTEX.
+         *
+         *  @param[in] pairOrder The txid and contract-id of the order.
+         *  @param[in] pairMarket The market pair the order is listed in.
+         *
+         **/
+        void AddOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket);
+
+
+        /** RemoveOrder
+         *
+         *  Remove a closed order from any order books it was loaded into.
+         *
+         *  @param[in] pairOrder The txid and contract-id of the order.
+         *  @param[in] pairMarket The market pair the order was listed in.
+         *
+         **/
+        void RemoveOrder(const std::pair<uint512_t, uint32_t>& pairOrder, const std::pair<uint256_t, uint256_t>& pairMarket);
+
+
+        /** ExtractOrder
+         *
+         *  Get the market pair an exchange order contract is listed in.
+         *
+         *  @param[in] rContract The order's contract.
+         *  @param[out] pairMarket The market pair the order is listed in.
+         *
+         *  @return true if the contract is a valid exchange order.
+         *
+         **/
+        bool ExtractOrder(const TAO::Operation::Contract& rContract, std::pair<uint256_t, uint256_t> &pairMarket);
+
+
+        /** ClaimedOrder
+         *
+         *  Get the market pair for an order that is being claimed, reading the order itself if it was indexed before
+         *  orders were mapped to their market.
+         *
+         *  @param[in] pairOrder The txid and contract-id of the order.
+         *  @param[out] pairMarket The market pair the order is listed in.
+         *
+         *  @return true if the claimed contract is an exchange order.
+         *
+         **/
+        bool ClaimedOrder(const std::pair<uint512_t, uint32_t>& pairOrder, std::pair<uint256_t, uint256_t> &pairMarket);
+
+
+        /** ListBook
+         *
+         *  List one side of an order book that are still open, applying filters and paging.
+         *
+         *  @param[in] vOrders The side of the order book to list.
+         *  @param[in] jParams The parameters from the API call.
+         *  @param[in] nLimit The maximum number of orders to return.
+         *  @param[in] nOffset The number of orders to skip over.
+         *
+         *  @return The list of orders in JSON.
+         *
+         **/
+        encoding::json ListBook(const std::vector<std::shared_ptr<const Order>>& vOrders, const encoding::json& jParams,
+                                const uint32_t nLimit, const uint32_t nOffset);
+
     };
 }
@@ -40,8 +40,8 @@ namespace TAO::API
      **/
     class Indexing
     {
-        /** Queue to handle dispatch requests. **/
-        static util::atomic::lock_unique_ptr<std::queue<uint512_t>> DISPATCH;
+        /** Queue to handle dispatch requests, flagged true for connected and false for disconnected transactions. **/
+        static util::atomic::lock_unique_ptr<std::queue<std::pair<uint512_t, bool>>> DISPATCH;
 
 
         /** Thread for running dispatch. **/
@@ -110,6 +110,16 @@ namespace TAO::API
         static void PushTransaction(const uint512_t& hashTx);
 
 
+        /** PopTransaction
+         *
+         *  Dispatch a disconnected transaction to relay thread, so its indexes are reversed in order with new blocks.
+         *
+         *  @param[in] hashTx The txid to dispatch de-indexing for.
+         *
+         **/
+        static void PopTransaction(const uint512_t& hashTx);
+
+
         /** Register
          *
          *  Register a new command-set to indexing by class type.
@@ -148,6 +158,33 @@ namespace TAO::API
         static void IndexSigchain(const uint512_t& hash);
 
 
+        /** DeindexSigchain
+         *
+         *  Reverse the command-set indexes of a tritium transaction that has been disconnected.
+         *
+         *  @param[in] hash The txid of the transaction
+         *
+         **/
+        static void DeindexSigchain(const uint512_t& hash);
+
+
+        /** ReadSequence
+         *
+         *  Read a transaction by its sequence number in a sigchain, building our sequence index back from the next
+         *  indexed sequence, or the last transaction in the sigchain, if the sequence was never indexed.
+         *
+         *  @param[in] hashGenesis The sigchain genesis that we are reading from.
+         *  @param[in] nSequence The sequence number of the transaction to read.
+         *  @param[out] hashTx The txid of the transaction.
+         *  @param[out] tx The transaction that was read.
+         *
+         *  @return true if the sigchain has a transaction at this sequence.
+         *
+         **/
+        static bool ReadSequence(const uint256_t& hashGenesis, const uint32_t nSequence,
+                                 uint512_t &hashTx, TAO::Ledger::Transaction &tx);
+
+
         /** BroadcastUnconfirmed
          *
          *  Broadcast our unconfirmed transactions if there are any.
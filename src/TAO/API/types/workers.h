@@ -0,0 +1,145 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO::API
+{
+
+    /** @class
+     *
+     *  This class is responsible for running API commands off of the LLP data threads.
+     *  Each class of command has its own bounded queue and threads, so that cheap reads don't wait behind
+     *  heavy scans or transactions being built, and a burst of logins deriving credentials can only ever hold
+     *  its own few threads.
+     *
+     **/
+    class Workers
+    {
+    public:
+
+        /** The classes of commands that are queued separately. **/
+        enum CLASS : uint8_t
+        {
+            READ  = 0, //cheap lookups of a single record
+            SCAN  = 1, //lists and history that scan many records
+            BUILD = 2, //commands that build transactions
+            LOGIN = 3, //commands that derive credentials from a username and password
+
+            TOTAL = 4,
+        };
+
+
+    private:
+
+        /** Queue of tasks for each class of command. **/
+        static std::queue<std::function<void()>> QUEUES[CLASS::TOTAL];
+
+
+        /** Mutex to protect each of our queues. **/
+        static std::mutex QUEUE_MUTEX[CLASS::TOTAL];
+
+
+        /** Condition variable to wake up the threads of each queue. **/
+        static std::condition_variable CONDITION[CLASS::TOTAL];
+
+
+        /** Track the list of threads for processing. **/
+        static std::vector<std::thread> vThreads;
+
+
+        /** The maximum tasks waiting in each queue. **/
+        static uint32_t nMaxQueue[CLASS::TOTAL];
+
+
+        /** Flag to tell if our threads are running. **/
+        static std::atomic<bool> fActive;
+
+
+    public:
+
+        /** Initialize
+         *
+         *  Start the worker threads for each class of command.
+         *
+         **/
+        static void Initialize();
+
+
+        /** Shutdown
+         *
+         *  Stop the worker threads, dropping any tasks that haven't started yet.
+         *
+         **/
+        static void Shutdown();
+
+
+        /** Active
+         *
+         *  Check if the worker threads are running.
+         *
+         *  @return true if commands can be submitted to the workers.
+         *
+         **/
+        static bool Active();
+
+
+        /** Classify
+         *
+         *  Get the class of a command by the verb of its method.
+         *
+         *  @param[in] strCommands The commands the method belongs to.
+         *  @param[in] strMethod The method being invoked.
+         *
+         *  @return the class of queue to run the command on.
+         *
+         **/
+        static uint8_t Classify(const std::string& strCommands, const std::string& strMethod);
+
+
+        /** Submit
+         *
+         *  Add a task to the queue for a class of command.
+         *
+         *  @param[in] nClass The class of queue to add the task to.
+         *  @param[in] fnTask The task to run.
+         *
+         *  @return false if the workers aren't running or the queue is full.
+         *
+         **/
+        static bool Submit(const uint8_t nClass, const std::function<void()>& fnTask);
+
+
+    private:
+
+        /** Thread
+         *
+         *  Run tasks from the queue of a given class until shutdown.
+         *
+         *  @param[in] nClass The class of queue this thread runs.
+         *
+         **/
+        static void Thread(const uint8_t nClass);
+
+    };
+}
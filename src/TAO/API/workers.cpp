@@ -0,0 +1,218 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/API/types/workers.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+
+#include <set>
+
+/* Global TAO namespace. */
+namespace TAO::API
+{
+    /* Queue of tasks for each class of command. */
+    std::queue<std::function<void()>> Workers::QUEUES[Workers::CLASS::TOTAL];
+
+
+    /* Mutex to protect each of our queues. */
+    std::mutex Workers::QUEUE_MUTEX[Workers::CLASS::TOTAL];
+
+
+    /* Condition variable to wake up the threads of each queue. */
+    std::condition_variable Workers::CONDITION[Workers::CLASS::TOTAL];
+
+
+    /* Track the list of threads for processing. */
+    std::vector<std::thread> Workers::vThreads;
+
+
+    /* The maximum tasks waiting in each queue. */
+    uint32_t Workers::nMaxQueue[Workers::CLASS::TOTAL] = { 256, 256, 256, 32 };
+
+
+    /* Flag to tell if our threads are running. */
+    std::atomic<bool> Workers::fActive(false);
+
+
+    /* Start the worker threads for each class of command. */
+    void Workers::Initialize()
+    {
+        /* Check if our workers are disabled, which runs commands on the data threads. */
+        if(!config::GetBoolArg("-apiworkers", true))
+            return;
+
+        /* Get our queue limits, keeping logins short since each one holds its argon2 memory while it runs. */
+        const uint32_t nQueue = std::max(config::GetArg("-apiqueue", 256), int64_t(1));
+        for(uint8_t nClass = 0; nClass < CLASS::LOGIN; ++nClass)
+            nMaxQueue[nClass] = nQueue;
+
+        nMaxQueue[CLASS::LOGIN] = std::max(config::GetArg("-apiloginqueue", 32), int64_t(1));
+
+        /* Get the total threads for each class of command. */
+        const int64_t nThreads[CLASS::TOTAL] =
+        {
+            std::max(config::GetArg("-apireadthreads",  4), int64_t(1)),
+            std::max(config::GetArg("-apiscanthreads",  2), int64_t(1)),
+            std::max(config::GetArg("-apibuildthreads", 2), int64_t(1)),
+            std::max(config::GetArg("-apiloginthreads", 2), int64_t(1))
+        };
+
+        /* Start our threads. */
+        fActive.store(true);
+        for(uint8_t nClass = 0; nClass < CLASS::TOTAL; ++nClass)
+        {
+            for(int64_t nThread = 0; nThread < nThreads[nClass]; ++nThread)
+                vThreads.push_back(std::thread(&Workers::Thread, nClass));
+        }
+
+        debug::log(0, FUNCTION, "Started ", nThreads[CLASS::READ], " read, ", nThreads[CLASS::SCAN], " scan, ",
+            nThreads[CLASS::BUILD], " build, and ", nThreads[CLASS::LOGIN], " login API worker threads");
+    }
+
+
+    /* Stop the worker threads, dropping any tasks that haven't started yet. */
+    void Workers::Shutdown()
+    {
+        /* Check that our workers were started. */
+        if(!fActive.load())
+            return;
+
+        /* Tell our threads to stop. */
+        fActive.store(false);
+        for(uint8_t nClass = 0; nClass < CLASS::TOTAL; ++nClass)
+        {
+            LOCK(QUEUE_MUTEX[nClass]);
+            CONDITION[nClass].notify_all();
+        }
+
+        /* Loop and join all threads. */
+        for(auto& tThread : vThreads)
+            tThread.join();
+
+        vThreads.clear();
+
+        /* Clear any remaining tasks. */
+        for(uint8_t nClass = 0; nClass < CLASS::TOTAL; ++nClass)
+        {
+            LOCK(QUEUE_MUTEX[nClass]);
+            QUEUES[nClass] = std::queue<std::function<void()>>();
+        }
+    }
+
+
+    /* Check if the worker threads are running. */
+    bool Workers::Active()
+    {
+        return fActive.load();
+    }
+
+
+    /* Get the class of a command by the verb of its method. */
+    uint8_t Workers::Classify(const std::string& strCommands, const std::string& strMethod)
+    {
+        /* Commands that derive a sigchain's credentials from its username and password. */
+        static const std::set<std::string> setLogin =
+        {
+            "sessions/create", "sessions/unlock", "profiles/create", "profiles/recover", "profiles/update"
+        };
+        /* Verbs that scan over many records. */
+        static const std::set<std::string> setScan =
+        {
+            "list", "history", "transactions", "recent", "notifications"
+        };
+
+        /* Verbs that build transactions, or derive keys from a pin. */
+        static const std::set<std::string> setBuild =
+        {
+            "burn", "cancel", "claim", "create", "credit", "debit", "erase", "execute", "load", "lock", "migrate",
+            "pay", "recover", "rename", "save", "set", "submit", "terminate", "tokenize", "transfer", "unlock",
+            "update", "void"
+        };
+
+        /* Get the verb of our method. */
+        const std::string strVerb = strMethod.substr(0, strMethod.find('/'));
+        if(setLogin.count(strCommands + "/" + strVerb))
+            return CLASS::LOGIN;
+
+        if(setScan.count(strVerb))
+            return CLASS::SCAN;
+
+        if(setBuild.count(strVerb))
+            return CLASS::BUILD;
+
+        return CLASS::READ;
+    }
+
+
+    /* Add a task to the queue for a class of command. */
+    bool Workers::Submit(const uint8_t nClass, const std::function<void()>& fnTask)
+    {
+        /* Check that our class is valid. */
+        if(nClass >= CLASS::TOTAL)
+            return false;
+
+        {
+            LOCK(QUEUE_MUTEX[nClass]);
+
+            /* Check that our workers are running. */
+            if(!fActive.load())
+                return false;
+
+            /* Check that our queue has room. */
+            if(QUEUES[nClass].size() >= nMaxQueue[nClass])
+                return false;
+
+            QUEUES[nClass].push(fnTask);
+        }
+        CONDITION[nClass].notify_one();
+
+        return true;
+    }
+
+
+    /* Run tasks from the queue of a given class until shutdown. */
+    void Workers::Thread(const uint8_t nClass)
+    {
+        while(true)
+        {
+            /* Wait for tasks in the queue. */
+            std::function<void()> fnTask;
+            {
+                std::unique_lock<std::mutex> QUEUE_LOCK(QUEUE_MUTEX[nClass]);
+                CONDITION[nClass].wait(QUEUE_LOCK, [nClass]{ return !fActive.load() || !QUEUES[nClass].empty(); });
+
+                /* Check for shutdown. */
+                if(!fActive.load())
+                    return;
+
+                fnTask = std::move(QUEUES[nClass].front());
+                QUEUES[nClass].pop();
+            }
+
+            /* Reset this thread's errors for the new command. */
+            debug::GetLastError();
+
+            /* Catch anything our task didn't, so a bad command can't take down a worker. */
+            try
+            {
+                fnTask();
+            }
+            catch(const std::exception& e)
+            {
+                debug::error(FUNCTION, "API worker: ", e.what());
+            }
+        }
+    }
+}
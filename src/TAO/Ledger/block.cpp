@@ -301,16 +301,24 @@ namespace TAO
             uint32_t j = 0;
             for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) >> 1)
             {
+                /* Lay out the leaf pairs of this level back to back so they are hashed as one batch. */
+                std::vector<uint8_t> vLevel;
+                vLevel.reserve(((nSize + 1) / 2) * 128);
+
                 for(i = 0; i < nSize; i += 2)
                 {
                     /* get the references to the left and right leaves in the merkle tree */
                     const uint512_t& hashLeft  = vMerkleTree[j + i];
                     const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
 
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
+                    vLevel.insert(vLevel.end(), BEGIN(hashLeft),  END(hashLeft));
+                    vLevel.insert(vLevel.end(), BEGIN(hashRight), END(hashRight));
                 }
 
+                /* Hash the whole level at once. */
+                const std::vector<uint512_t> vHashes = LLC::SK512(vLevel, 128);
+                vMerkleTree.insert(vMerkleTree.end(), vHashes.begin(), vHashes.end());
+
                 j += nSize;
             }
 
@@ -331,16 +339,24 @@ namespace TAO
             uint32_t j = 0;
             for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) / 2)
             {
+                /* Lay out the leaf pairs of this level back to back so they are hashed as one batch. */
+                std::vector<uint8_t> vLevel;
+                vLevel.reserve(((nSize + 1) / 2) * 128);
+
                 for(i = 0; i < nSize; i += 2)
                 {
                     /* get the references to the left and right leaves in the merkle tree */
                     const uint512_t& hashLeft  = vMerkleTree[j + i];
                     const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
 
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
+                    vLevel.insert(vLevel.end(), BEGIN(hashLeft),  END(hashLeft));
+                    vLevel.insert(vLevel.end(), BEGIN(hashRight), END(hashRight));
                 }
 
+                /* Hash the whole level at once. */
+                const std::vector<uint512_t> vHashes = LLC::SK512(vLevel, 128);
+                vMerkleTree.insert(vMerkleTree.end(), vHashes.begin(), vHashes.end());
+
                 j += nSize;
             }
 
@@ -21,8 +21,11 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/create.h>
 #include <TAO/Ledger/include/genesis_block.h>
+#include <TAO/Ledger/include/headers.h>
 #include <TAO/Ledger/include/timelocks.h>
 
+#include <TAO/Ledger/types/metrics.h>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -411,6 +414,14 @@ namespace TAO
                 }
             }
 
+            /* Load our header index for the most recent blocks. */
+            if(!config::fClient.load() && !HeaderIndex::Initialize())
+                return debug::error(FUNCTION, "failed to load header index");
+
+            /* Build our chain metrics buckets if they haven't been indexed yet. */
+            if(!config::fClient.load() && !IndexMetrics())
+                debug::warning(FUNCTION, "failed to index metrics, ledger/metrics will be incomplete");
+
             tStateBest.load().print();
 
             /* Log the weights. */
@@ -41,6 +41,9 @@ ________________________________________________________________________________
 
 #include <TAO/Operation/include/enum.h>
 
+#include <TAO/Register/include/unpack.h>
+#include <TAO/Register/types/state.h>
+
 #include <TAO/API/include/global.h>
 #include <TAO/API/types/authentication.h>
 #include <TAO/API/types/indexing.h>
@@ -61,6 +64,46 @@ namespace TAO::Ledger
     static memory::atomic<TAO::Ledger::TritiumBlock> tBlockCache[4];
 
 
+    /* Mutex to protect the transactions shared between all block templates. */
+    static std::mutex TEMPLATE_MUTEX;
+
+
+    /* The transactions shared between all block templates, and the best chain and mempool generation they were built on. */
+    static std::vector<std::pair<uint8_t, uint512_t>> vTemplateTx;
+    static uint1024_t hashTemplateBest = 0;
+    static uint64_t nTemplateGeneration = 0;
+    static uint64_t nTemplateTime = 0;
+
+
+    /* The registers, sigchains, and transactions that a template transaction depends on, or that an accepted one changes. */
+    struct TemplateDependencies
+    {
+        /* The register and sigchain addresses. */
+        std::set<uint256_t> setAddresses;
+
+        /* The transaction hashes. */
+        std::set<uint512_t> setTransactions;
+    };
+
+
+    /* The transactions that failed to validate against our template's best chain, with what they depended on, so they are
+     * only validated again once a transaction we accept changes one of their dependencies. */
+    static std::map<uint512_t, TemplateDependencies> mapTemplateRejected;
+
+
+    /* Add a transaction to the block, tracking the serialized size of the block as it grows. */
+    static void add_transaction(TAO::Ledger::TritiumBlock& block, const uint8_t nType, const uint512_t& hash, uint64_t &nSize);
+
+
+    /* Add the registers, sigchain, and transactions that a transaction reads from or writes to. */
+    static void add_dependencies(const TAO::Ledger::Transaction& tx, const std::map<uint256_t, TAO::Register::State>& mapStates,
+                                 TemplateDependencies &rDependencies);
+
+
+    /* Build the list of transactions from memory pool that are valid for the next block. */
+    static void build_transactions(TAO::Ledger::TritiumBlock& block, bool fIncremental);
+
+
     /* Create a new transaction object from signature chain. */
     bool CreateTransaction(const memory::encrypted_ptr<TAO::Ledger::Credentials>& pCredentials, const SecureString& pin,
                            TAO::Ledger::Transaction& tx, const uint8_t nScheme)
@@ -156,95 +199,319 @@ namespace TAO::Ledger
 
     /* Gets a list of transactions from memory pool for current block. */
     void AddTransactions(TAO::Ledger::TritiumBlock& block)
+    {
+        LOCK(TEMPLATE_MUTEX);
+
+        /* Get the state that our transactions would be built on. */
+        const uint1024_t hashBest   = ChainState::hashBestChain.load();
+        const uint64_t nGeneration  = mempool.Generation();
+        const uint64_t nExpiration  = config::GetArg("-blockrefresh", 60);
+
+        /* Check if our shared transactions are still current, so every miner doesn't re-validate the same mempool. */
+        if(hashTemplateBest == hashBest
+        && nTemplateGeneration == nGeneration
+        && runtime::unifiedtimestamp() < nTemplateTime + nExpiration)
+        {
+            block.vtx = vTemplateTx;
+            return;
+        }
+
+        /* Build our transactions from the memory pool, only validating what changed if our best chain is the same. */
+        build_transactions(block, hashTemplateBest == hashBest);
+
+        /* Cache our transactions for the next block template. */
+        vTemplateTx         = block.vtx;
+        hashTemplateBest    = hashBest;
+        nTemplateGeneration = nGeneration;
+        nTemplateTime       = runtime::unifiedtimestamp();
+    }
+
+
+    /* Add a transaction to the block, tracking the serialized size of the block as it grows. */
+    void add_transaction(TAO::Ledger::TritiumBlock& block, const uint8_t nType, const uint512_t& hash, uint64_t &nSize)
+    {
+        /* Account for our vector's length growing. */
+        const uint64_t nCount = block.vtx.size();
+        nSize += GetSizeOfCompactSize(nCount + 1) - GetSizeOfCompactSize(nCount);
+
+        /* Add the transaction to the block. */
+        block.vtx.push_back(std::make_pair(nType, hash));
+        nSize += ::GetSerializeSize(block.vtx.back(), uint32_t(SER_NETWORK), LLP::PROTOCOL_VERSION);
+    }
+
+
+    /* Add the registers, sigchain, and transactions that a transaction reads from or writes to. */
+    void add_dependencies(const TAO::Ledger::Transaction& tx, const std::map<uint256_t, TAO::Register::State>& mapStates,
+                          TemplateDependencies &rDependencies)
+    {
+        /* Our sigchain and the transaction before it. */
+        rDependencies.setAddresses.insert(tx.hashGenesis);
+        rDependencies.setTransactions.insert(tx.hashPrevTx);
+
+        /* The registers that had their pre-states checked. */
+        for(const auto& rState : mapStates)
+            rDependencies.setAddresses.insert(rState.first);
+
+        /* The registers and transactions named by our contracts, which covers the contracts we didn't get to verify. */
+        for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+        {
+            const TAO::Operation::Contract& rContract = tx[nContract];
+            rContract.Bind(&tx);
+
+            uint256_t hashAddress = 0;
+            if(TAO::Register::Unpack(rContract, hashAddress))
+                rDependencies.setAddresses.insert(hashAddress);
+
+            uint512_t hashPrevTx = 0;
+            if(TAO::Register::Unpack(rContract, hashPrevTx))
+                rDependencies.setTransactions.insert(hashPrevTx);
+
+            uint32_t nPrevContract = 0;
+            if(TAO::Register::Unpack(rContract, hashPrevTx, nPrevContract))
+                rDependencies.setTransactions.insert(hashPrevTx);
+        }
+    }
+
+
+    /* Build the list of transactions from memory pool that are valid for the next block. */
+    void build_transactions(TAO::Ledger::TritiumBlock& block, bool fIncremental)
     {
         /* Clear the transactions. */
         block.vtx.clear();
 
+        /* Track our block size as we add to it, rather than serializing the whole block for every transaction. */
+        uint64_t nSize = ::GetSerializeSize(block, SER_NETWORK, LLP::PROTOCOL_VERSION);
+
         /* Check the memory pool. */
         std::vector<uint512_t> vMempool;
         mempool.List(vMempool);
 
-        /* Start a ACID transaction (to be disposed). */
-        LLD::TxnBegin(FLAGS::MINER);
+        /* Get the transactions that were accepted into our last template on this best chain. */
+        const std::set<uint512_t> setMempool(vMempool.begin(), vMempool.end());
 
-        /* Loop through the list of transactions. */
-        std::set<uint512_t> setDependents;
-        for(const auto& hash : vMempool)
+        std::vector<uint512_t> vAccepted;
+        if(fIncremental)
         {
-            /* Check the Size limits of the Current Block. */
-            if(::GetSerializeSize(block, SER_NETWORK, LLP::PROTOCOL_VERSION) + 256 >= MAX_BLOCK_SIZE)
-                break;
-
-            /* Get the transaction from the memory pool. */
-            TAO::Ledger::Transaction tx;
-            if(!mempool.Get(hash, tx))
-                continue;
-
-            /* Don't add transactions that are coinbase or coinstake. */
-            if(tx.IsCoinBase() || tx.IsCoinStake())
+            for(const auto& tx : vTemplateTx)
             {
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - tx is coinbase/coinstake");
-                continue;
+                if(tx.first == TRANSACTION::TRITIUM)
+                    vAccepted.push_back(tx.second);
             }
 
-            /* Check for failed dependants. */
-            if(setDependents.count(tx.hashPrevTx))
+            /* Our accepted transactions can only be reused if they are all still in the pool. */
+            for(const auto& hash : vAccepted)
             {
-                setDependents.insert(hash);
-
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - INVALID dependent");
-                continue;
+                if(!setMempool.count(hash))
+                {
+                    fIncremental = false;
+                    break;
+                }
             }
+        }
 
-            /* Check for timestamp violations. */
-            if(tx.nTimestamp > runtime::unifiedtimestamp() + runtime::maxdrift())
-            {
-                setDependents.insert(hash);
+        /* Start over if our last template can't be built on. */
+        if(!fIncremental)
+        {
+            vAccepted.clear();
+            mapTemplateRejected.clear();
+        }
 
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - timesamp too far in future");
-                continue;
-            }
+        /* Forget the rejections that have left the pool. */
+        for(auto it = mapTemplateRejected.begin(); it != mapTemplateRejected.end(); )
+        {
+            if(!setMempool.count(it->first))
+                it = mapTemplateRejected.erase(it);
+            else
+                ++it;
+        }
+
+        /* Find the candidates that haven't been validated against this best chain yet. */
+        const std::set<uint512_t> setAccepted(vAccepted.begin(), vAccepted.end());
+
+        std::vector<uint512_t> vCandidates;
+        for(const auto& hash : vMempool)
+        {
+            if(!setAccepted.count(hash) && !mapTemplateRejected.count(hash))
+                vCandidates.push_back(hash);
+        }
 
-            /* Check the pre-states and post-states. */
-            if(!tx.Verify(FLAGS::MINER))
+        /* Start a ACID transaction (to be disposed). */
+        const bool fCandidates = !vCandidates.empty();
+        if(fCandidates)
+            LLD::TxnBegin(FLAGS::MINER);
+
+        /* Add the transactions we already validated, which only need their states connected if there are new candidates. */
+        for(const auto& hash : vAccepted)
+        {
+            /* Connect the states that our new candidates may depend on. */
+            if(fCandidates)
             {
-                setDependents.insert(hash);
+                /* Get the transaction from the memory pool. */
+                TAO::Ledger::Transaction tx;
+                if(!mempool.Get(hash, tx) || !tx.Connect(FLAGS::MINER))
+                {
+                    debug::log(2, FUNCTION, "Rebuilding transactions - ", hash.SubString(), " failed to reconnect");
 
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - failed to verify");
-                continue;
+                    /* Start over from the memory pool. */
+                    LLD::TxnAbort(FLAGS::MINER);
+                    return build_transactions(block, false);
+                }
             }
 
-            /* Check to see if this transaction connects. */
-            if(!tx.Connect(FLAGS::MINER))
+            /* Add the transaction to the block. */
+            add_transaction(block, TRANSACTION::TRITIUM, hash, nSize);
+        }
+
+        /* Loop through our candidates, and then through the rejections that the transactions we accepted may have fixed. */
+        std::set<uint512_t> setDeferred;
+        while(!vCandidates.empty())
+        {
+            /* Track what the transactions we accept change. */
+            TemplateDependencies tChanged;
+            bool fCreated = false;
+
+            /* Loop through the list of transactions. */
+            for(const auto& hash : vCandidates)
             {
-                setDependents.insert(hash);
+                /* Check the Size limits of the Current Block. */
+                if(nSize + 256 >= MAX_BLOCK_SIZE)
+                    break;
 
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - failed to connect");
-                continue;
+                /* Get the transaction from the memory pool. */
+                TAO::Ledger::Transaction tx;
+                if(!mempool.Get(hash, tx))
+                    continue;
+
+                /* Don't add transactions that are coinbase or coinstake. */
+                if(tx.IsCoinBase() || tx.IsCoinStake())
+                {
+                    mapTemplateRejected[hash];
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - tx is coinbase/coinstake");
+                    continue;
+                }
+
+                /* Check for dependants that may be valid in a later template. */
+                if(setDeferred.count(tx.hashPrevTx))
+                {
+                    setDeferred.insert(hash);
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - DEFERRED dependent");
+                    continue;
+                }
+
+                /* Check for failed dependants. */
+                if(mapTemplateRejected.count(tx.hashPrevTx))
+                {
+                    add_dependencies(tx, {}, mapTemplateRejected[hash]);
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - INVALID dependent");
+                    continue;
+                }
+
+                /* Check for timestamp violations, which aren't cached since they pass with time. */
+                if(tx.nTimestamp > runtime::unifiedtimestamp() + runtime::maxdrift())
+                {
+                    setDeferred.insert(hash);
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - timesamp too far in future");
+                    continue;
+                }
+
+                /* Check the pre-states and post-states. */
+                std::map<uint256_t, TAO::Register::State> mapStates;
+                if(!tx.Verify(FLAGS::MINER, mapStates))
+                {
+                    add_dependencies(tx, mapStates, mapTemplateRejected[hash]);
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - failed to verify");
+                    continue;
+                }
+
+                /* Check to see if this transaction connects. */
+                if(!tx.Connect(FLAGS::MINER))
+                {
+                    add_dependencies(tx, mapStates, mapTemplateRejected[hash]);
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - failed to connect");
+                    continue;
+                }
+
+                /* Check that the hashlast is on disk. If it is not, then the sig chain genesis must also be in this block.  If for
+                   any reason the genesis transaction should be in this block but failed one of the above rules, then we could end
+                   up with a subsequent transaction also in this block for which the genesis is not going to exist.  In which case
+                   we need to omit this transaction also. The simplest solution for this is to skip any transactions that are not
+                   the first in the sequence if the hash last is not currently on disk. If a sig chain transcation and subsequent
+                   transaction genuinely should be in the same block, then ths will just result in the subsequent transaction being
+                   left out of this block and included in the next.*/
+                uint512_t hashLast = 0;
+                if(!tx.IsFirst() && !LLD::Ledger->ReadLast(tx.hashGenesis, hashLast))
+                {
+                    mapTemplateRejected[hash];
+
+                    debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - genesis not on disk");
+                    continue;
+                }
+
+                /* Add the transaction to the block. */
+                add_transaction(block, TRANSACTION::TRITIUM, hash, nSize);
+
+                /* Track what it changed so we know which rejections to validate again. */
+                add_dependencies(tx, mapStates, tChanged);
+                tChanged.setTransactions.insert(hash);
+
+                /* New registers can be read by contracts that don't name them where we can unpack, such as an account's token. */
+                for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+                {
+                    if(tx[nContract].Primitive() == TAO::Operation::OP::CREATE)
+                        fCreated = true;
+                }
             }
 
-            /* Check that the hashlast is on disk. If it is not, then the sig chain genesis must also be in this block.  If for
-               any reason the genesis transaction should be in this block but failed one of the above rules, then we could end
-               up with a subsequent transaction also in this block for which the genesis is not going to exist.  In which case
-               we need to omit this transaction also. The simplest solution for this is to skip any transactions that are not
-               the first in the sequence if the hash last is not currently on disk. If a sig chain transcation and subsequent
-               transaction genuinely should be in the same block, then ths will just result in the subsequent transaction being
-               left out of this block and included in the next.*/
-            uint512_t hashLast = 0;
-            if(!tx.IsFirst() && !LLD::Ledger->ReadLast(tx.hashGenesis, hashLast))
+            /* Retry the rejections that depended on anything we accepted, in the order of our memory pool. */
+            vCandidates.clear();
+            for(const auto& hash : vMempool)
             {
-                setDependents.insert(hash);
+                auto it = mapTemplateRejected.find(hash);
+                if(it == mapTemplateRejected.end())
+                    continue;
 
-                debug::log(2, FUNCTION, "Skipping transaction ", hash.SubString(), " - genesis not on disk");
-                continue;
-            }
+                /* Rejections without dependencies only change with our best chain. */
+                if(it->second.setAddresses.empty() && it->second.setTransactions.empty())
+                    continue;
 
-            /* Add the transaction to the block. */
-            block.vtx.push_back(std::make_pair(TRANSACTION::TRITIUM, hash));
+                /* Check if any of its registers, its sigchain, or the transactions it claims have changed. */
+                bool fChanged = fCreated;
+                for(const auto& hashAddress : it->second.setAddresses)
+                {
+                    if(fChanged)
+                        break;
+
+                    if(tChanged.setAddresses.count(hashAddress))
+                        fChanged = true;
+                }
+
+                for(const auto& hashTx : it->second.setTransactions)
+                {
+                    if(fChanged)
+                        break;
+
+                    if(tChanged.setTransactions.count(hashTx))
+                        fChanged = true;
+                }
+
+                /* Validate it again against our new states. */
+                if(fChanged)
+                {
+                    vCandidates.push_back(hash);
+                    mapTemplateRejected.erase(it);
+                }
+            }
         }
 
         /* Abort the temporary ACID transaction. */
-        LLD::TxnAbort(FLAGS::MINER);
+        if(fCandidates)
+            LLD::TxnAbort(FLAGS::MINER);
 
         /* Clear for legacy. */
         vMempool.clear();
@@ -258,7 +525,7 @@ namespace TAO::Ledger
         for(const auto& hash : vMempool)
         {
             /* Check the Size limits of the Current Block. */
-            if(::GetSerializeSize(block, SER_NETWORK, LLP::PROTOCOL_VERSION) + 256 >= MAX_BLOCK_SIZE)
+            if(nSize + 256 >= MAX_BLOCK_SIZE)
                 break;
 
             /* Get the transaction from the memory pool. */
@@ -315,7 +582,7 @@ namespace TAO::Ledger
                 tx.print();
 
             /* Add the transaction to the block. */
-            block.vtx.push_back(std::make_pair(TRANSACTION::LEGACY, hash));
+            add_transaction(block, TRANSACTION::LEGACY, hash, nSize);
         }
     }
 
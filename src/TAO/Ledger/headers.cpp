@@ -0,0 +1,513 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/headers.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/include/runtime.h>
+
+#include <unordered_map>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Default Constructor. */
+        BlockHeader::BlockHeader()
+        : hashBlock      (0)
+        , hashPrevBlock  (0)
+        , nChainTrust    (0)
+        , nMoneySupply   (0)
+        , nTime          (0)
+        , nHeight        (0)
+        , nChannel       (0)
+        , nChannelHeight (0)
+        , nBits          (0)
+        {
+        }
+
+
+        /* Constructor from a block state. */
+        BlockHeader::BlockHeader(const BlockState& state)
+        : hashBlock      (state.GetHash())
+        , hashPrevBlock  (state.hashPrevBlock)
+        , nChainTrust    (state.nChainTrust)
+        , nMoneySupply   (state.nMoneySupply)
+        , nTime          (state.GetBlockTime())
+        , nHeight        (state.nHeight)
+        , nChannel       (state.GetChannel())
+        , nChannelHeight (state.nChannelHeight)
+        , nBits          (state.nBits)
+        {
+        }
+
+
+        namespace HeaderIndex
+        {
+            /* A header in our index, with pointers to the ancestors that are also in memory. */
+            struct HeaderNode
+            {
+                /* Pointer to the hash of this block, which is the key in our index. */
+                const uint1024_t* phashBlock;
+
+                /* The hash of the previous block, to continue on disk past our oldest header. */
+                uint1024_t hashPrevBlock;
+
+                /* The previous header, or nullptr if it isn't in memory. */
+                const HeaderNode* pprev;
+
+                /* The header at our skip height, or nullptr if it isn't in memory. */
+                const HeaderNode* pskip;
+
+                /* The values copied from the block state. */
+                uint64_t nChainTrust;
+                uint64_t nMoneySupply;
+                uint64_t nTime;
+                uint32_t nHeight;
+                uint32_t nChannel;
+                uint32_t nChannelHeight;
+                uint32_t nBits;
+            };
+
+
+            /* The low bits of a block hash are already uniformly distributed, so we use them directly. */
+            struct HeaderHasher
+            {
+                size_t operator()(const uint1024_t& hashBlock) const
+                {
+                    return hashBlock.Get64();
+                }
+            };
+
+
+            /* Mutex to protect our index. */
+            std::mutex INDEX_MUTEX;
+
+
+            /* The headers in our index by block hash. */
+            std::unordered_map<uint1024_t, HeaderNode, HeaderHasher> mapHeaders;
+
+
+            /* The header of our best chain. */
+            const HeaderNode* pBest = nullptr;
+
+
+            /* The lowest height that is kept in our index. */
+            uint32_t nLowest = 0;
+
+
+            /* The total headers to keep below our best chain, or 0 to keep every header. */
+            uint32_t nDepth = 50000;
+
+
+            /* Turn off the lowest set bit of a height. */
+            uint32_t invert_lowest(const uint32_t nHeight)
+            {
+                return nHeight & (nHeight - 1);
+            }
+
+
+            /* Get the height a header skips back to, spread out so that any ancestor can be reached in O(log n) steps. */
+            uint32_t skip_height(const uint32_t nHeight)
+            {
+                /* The first two blocks can only skip to the genesis. */
+                if(nHeight < 2)
+                    return 0;
+
+                /* Odd heights skip a little less far back so that paths don't line up with their previous header. */
+                return (nHeight & 1) ? invert_lowest(invert_lowest(nHeight - 1)) + 1 : invert_lowest(nHeight);
+            }
+
+
+            /* Walk back to the ancestor at a given height, stopping early at the oldest header that is in memory. */
+            const HeaderNode* ancestor(const HeaderNode* pnode, const uint32_t nHeight)
+            {
+                while(pnode->nHeight > nHeight)
+                {
+                    /* Get the skip heights for this header and the previous one. */
+                    const uint32_t nSkip     = skip_height(pnode->nHeight);
+                    const uint32_t nSkipPrev = skip_height(pnode->nHeight - 1);
+
+                    /* Only skip if the previous header wouldn't get us there in a better skip. */
+                    if(pnode->pskip && (nSkip == nHeight || (nSkip > nHeight && !(nSkipPrev + 2 < nSkip && nSkipPrev >= nHeight))))
+                        pnode = pnode->pskip;
+
+                    /* Otherwise step back one header at a time. */
+                    else if(pnode->pprev)
+                        pnode = pnode->pprev;
+
+                    /* We have reached our oldest header. */
+                    else
+                        break;
+                }
+
+                return pnode;
+            }
+
+
+            /* Copy a header out of our index. */
+            BlockHeader to_header(const HeaderNode& node)
+            {
+                BlockHeader header;
+                header.hashBlock      = *node.phashBlock;
+                header.hashPrevBlock  = node.hashPrevBlock;
+                header.nChainTrust    = node.nChainTrust;
+                header.nMoneySupply   = node.nMoneySupply;
+                header.nTime          = node.nTime;
+                header.nHeight        = node.nHeight;
+                header.nChannel       = node.nChannel;
+                header.nChannelHeight = node.nChannelHeight;
+                header.nBits          = node.nBits;
+
+                return header;
+            }
+
+
+            /* Read a header from disk when it isn't in our index. */
+            bool read_header(const uint1024_t& hashBlock, BlockHeader &header)
+            {
+                /* Check for genesis. */
+                if(hashBlock == 0)
+                    return false;
+
+                /* Read the block state from the ledger. */
+                BlockState state;
+                if(!LLD::Ledger->ReadBlock(hashBlock, state))
+                    return false;
+
+                header = BlockHeader(state);
+
+                return true;
+            }
+
+
+            /* Add a header to our index, linking it to its ancestors. Must be called with INDEX_MUTEX held. */
+            void insert_header(const BlockHeader& header)
+            {
+                /* Skip headers that are deeper than our index. */
+                if(header.nHeight < nLowest)
+                    return;
+
+                /* Check that this header isn't indexed already. */
+                const auto pairInsert = mapHeaders.emplace(header.hashBlock, HeaderNode());
+                if(!pairInsert.second)
+                    return;
+
+                /* Copy over our header values. */
+                HeaderNode& node    = pairInsert.first->second;
+                node.phashBlock     = &pairInsert.first->first;
+                node.hashPrevBlock  = header.hashPrevBlock;
+                node.pprev          = nullptr;
+                node.pskip          = nullptr;
+                node.nChainTrust    = header.nChainTrust;
+                node.nMoneySupply   = header.nMoneySupply;
+                node.nTime          = header.nTime;
+                node.nHeight        = header.nHeight;
+                node.nChannel       = header.nChannel;
+                node.nChannelHeight = header.nChannelHeight;
+                node.nBits          = header.nBits;
+
+                /* Link to our previous header if it is in memory. */
+                const auto it = mapHeaders.find(header.hashPrevBlock);
+                if(header.nHeight == 0 || it == mapHeaders.end() || it->second.nHeight + 1 != header.nHeight)
+                    return;
+
+                node.pprev = &it->second;
+
+                /* Link to our skip ancestor if it is in memory. */
+                const HeaderNode* pskip = ancestor(node.pprev, skip_height(header.nHeight));
+                if(pskip->nHeight == skip_height(header.nHeight))
+                    node.pskip = pskip;
+            }
+
+
+            /* Load the headers for the most recent blocks of the best chain. */
+            bool Initialize()
+            {
+                /* Track our timing. */
+                runtime::timer tElapsed;
+                tElapsed.Start();
+
+                /* Get our configured depth. */
+                const uint32_t nMaxDepth = std::max(config::GetArg("-headerdepth", 50000), int64_t(0));
+
+                /* Read our headers back from the best chain. */
+                std::vector<BlockHeader> vHeaders;
+                BlockState state = ChainState::tStateBest.load();
+                while(!config::fShutdown.load())
+                {
+                    /* Add our header. */
+                    vHeaders.push_back(BlockHeader(state));
+
+                    /* Check for genesis or our maximum depth. */
+                    if(state.hashPrevBlock == 0 || (nMaxDepth > 0 && vHeaders.size() > nMaxDepth))
+                        break;
+
+                    /* Iterate backwards. */
+                    state = state.Prev();
+                    if(!state)
+                        return debug::error(FUNCTION, "failed to read block ", vHeaders.back().hashPrevBlock.SubString());
+                }
+
+                /* Check that we read any headers. */
+                if(vHeaders.empty())
+                    return false;
+
+                {
+                    LOCK(INDEX_MUTEX);
+
+                    /* Reset our index to the new depth. */
+                    mapHeaders.clear();
+                    mapHeaders.reserve(vHeaders.size());
+                    nDepth  = nMaxDepth;
+                    nLowest = vHeaders.back().nHeight;
+
+                    /* Insert in ascending height so each header can link to its ancestors. */
+                    for(auto it = vHeaders.rbegin(); it != vHeaders.rend(); ++it)
+                        insert_header(*it);
+
+                    /* Set our best header. */
+                    pBest = &mapHeaders.at(vHeaders.front().hashBlock);
+                }
+
+                debug::log(0, FUNCTION, "Loaded ", vHeaders.size(), " block headers in ", tElapsed.ElapsedMilliseconds(), " ms");
+
+                return true;
+            }
+
+
+            /* Add the header of a newly indexed block state. */
+            void Insert(const BlockState& state)
+            {
+                /* Build our header outside of the lock, since it hashes the block. */
+                const BlockHeader header = BlockHeader(state);
+
+                LOCK(INDEX_MUTEX);
+                insert_header(header);
+            }
+
+
+            /* Set the header of the best chain, and prune any headers that are deeper than our depth. */
+            void SetBest(const uint1024_t& hashBest)
+            {
+                LOCK(INDEX_MUTEX);
+
+                /* Check for our best header. */
+                const auto itBest = mapHeaders.find(hashBest);
+                if(itBest == mapHeaders.end())
+                {
+                    pBest = nullptr;
+                    return;
+                }
+
+                /* Set our best header. */
+                pBest = &itBest->second;
+
+                /* Check if we need to prune. */
+                if(nDepth == 0 || pBest->nHeight <= nDepth)
+                    return;
+
+                /* Only prune after an extra eighth of our depth, so that pruning stays amortized over many blocks. */
+                const uint32_t nNewLowest = pBest->nHeight - nDepth;
+                if(nNewLowest < nLowest + std::max(nDepth / 8, 1u))
+                    return;
+
+                /* Unlink any ancestors that are about to be pruned, by height so we don't touch them. */
+                for(auto& pairHeader : mapHeaders)
+                {
+                    HeaderNode& node = pairHeader.second;
+                    if(node.nHeight < nNewLowest)
+                        continue;
+
+                    if(node.nHeight - 1 < nNewLowest)
+                        node.pprev = nullptr;
+
+                    if(skip_height(node.nHeight) < nNewLowest)
+                        node.pskip = nullptr;
+                }
+
+                /* Prune our headers that are now too deep. */
+                for(auto it = mapHeaders.begin(); it != mapHeaders.end(); )
+                {
+                    if(it->second.nHeight < nNewLowest)
+                        it = mapHeaders.erase(it);
+                    else
+                        ++it;
+                }
+
+                nLowest = nNewLowest;
+            }
+
+
+            /* Get the header for a given block. */
+            bool GetHeader(const uint1024_t& hashBlock, BlockHeader &header)
+            {
+                {
+                    LOCK(INDEX_MUTEX);
+
+                    /* Check our index first. */
+                    const auto it = mapHeaders.find(hashBlock);
+                    if(it != mapHeaders.end())
+                    {
+                        header = to_header(it->second);
+                        return true;
+                    }
+                }
+
+                return read_header(hashBlock, header);
+            }
+
+
+            /* Get the last header produced on a given channel, starting from and including a given block. */
+            bool GetLastHeader(const uint1024_t& hashBlock, const uint32_t nChannel, BlockHeader &header)
+            {
+                /* Track the next block to read from disk. */
+                uint1024_t hashNext = hashBlock;
+                {
+                    LOCK(INDEX_MUTEX);
+
+                    /* Walk back in memory as far as we can. */
+                    const auto it = mapHeaders.find(hashBlock);
+                    if(it != mapHeaders.end())
+                    {
+                        const HeaderNode* pnode = &it->second;
+                        while(true)
+                        {
+                            /* Return false on genesis. */
+                            if(pnode->nHeight == 0)
+                            {
+                                header = to_header(*pnode);
+                                return false;
+                            }
+
+                            /* Return true on channel found. */
+                            if(pnode->nChannel == nChannel)
+                            {
+                                header = to_header(*pnode);
+                                return true;
+                            }
+
+                            /* Check for our oldest header. */
+                            if(!pnode->pprev)
+                                break;
+
+                            pnode = pnode->pprev;
+                        }
+
+                        /* Continue on disk from past our oldest header. */
+                        hashNext = pnode->hashPrevBlock;
+                    }
+                }
+
+                /* Walk back the rest of the way on disk. */
+                while(read_header(hashNext, header))
+                {
+                    /* Return false on genesis. */
+                    if(header.nHeight == 0)
+                        return false;
+
+                    /* Return true on channel found. */
+                    if(header.nChannel == nChannel)
+                        return true;
+
+                    hashNext = header.hashPrevBlock;
+                }
+
+                return false;
+            }
+
+
+            /* Get the ancestor of a given block at a given height. */
+            bool GetAncestor(const uint1024_t& hashBlock, const uint32_t nHeight, BlockHeader &header)
+            {
+                /* Track the next block to read from disk. */
+                uint1024_t hashNext = hashBlock;
+                {
+                    LOCK(INDEX_MUTEX);
+
+                    /* Skip back in memory as far as we can. */
+                    const auto it = mapHeaders.find(hashBlock);
+                    if(it != mapHeaders.end())
+                    {
+                        /* Check that the height is below our block. */
+                        if(it->second.nHeight < nHeight)
+                            return false;
+
+                        /* Check if we found our ancestor. */
+                        const HeaderNode* pnode = ancestor(&it->second, nHeight);
+                        if(pnode->nHeight == nHeight)
+                        {
+                            header = to_header(*pnode);
+                            return true;
+                        }
+
+                        /* Continue on disk from past our oldest header. */
+                        hashNext = pnode->hashPrevBlock;
+                    }
+                }
+
+                /* Walk back the rest of the way on disk. */
+                while(read_header(hashNext, header))
+                {
+                    /* Check if we have reached our height. */
+                    if(header.nHeight <= nHeight)
+                        return (header.nHeight == nHeight);
+
+                    hashNext = header.hashPrevBlock;
+                }
+
+                return false;
+            }
+
+
+            /* Check if a given block is in the best chain. */
+            bool IsInMainChain(const uint1024_t& hashBlock)
+            {
+                {
+                    LOCK(INDEX_MUTEX);
+
+                    /* Check our block is the best chain's ancestor at its height. */
+                    const auto it = mapHeaders.find(hashBlock);
+                    if(it != mapHeaders.end() && pBest)
+                    {
+                        /* Check that the block isn't past our best chain. */
+                        if(it->second.nHeight > pBest->nHeight)
+                            return false;
+
+                        /* Both headers are in memory, so our ancestor will be too. */
+                        const HeaderNode* pnode = ancestor(pBest, it->second.nHeight);
+                        if(pnode->nHeight == it->second.nHeight)
+                            return (pnode == &it->second);
+                    }
+                }
+
+                /* Fall back to checking our block on disk. */
+                BlockState state;
+                if(!LLD::Ledger->ReadBlock(hashBlock, state))
+                    return false;
+
+                return state.IsInMainChain();
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_HEADERS_H
+#define NEXUS_TAO_LEDGER_INCLUDE_HEADERS_H
+
+#include <LLC/types/uint1024.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+        /* Forward declarations. */
+        class BlockState;
+
+
+        /** BlockHeader
+         *
+         *  Compact copy of the block state values needed to walk the chain without reading blocks from disk.
+         *
+         **/
+        struct BlockHeader
+        {
+            /** The hash of this block. **/
+            uint1024_t hashBlock;
+
+
+            /** The hash of the previous block. **/
+            uint1024_t hashPrevBlock;
+
+
+            /** The total chain trust up to this block. **/
+            uint64_t nChainTrust;
+
+
+            /** The total money supply up to this block. **/
+            uint64_t nMoneySupply;
+
+
+            /** The block timestamp. **/
+            uint64_t nTime;
+
+
+            /** The height of this block. **/
+            uint32_t nHeight;
+
+
+            /** The channel this block was produced on. **/
+            uint32_t nChannel;
+
+
+            /** The height of this block in its channel. **/
+            uint32_t nChannelHeight;
+
+
+            /** The difficulty bits of this block. **/
+            uint32_t nBits;
+
+
+            /** Default Constructor. **/
+            BlockHeader();
+
+
+            /** Constructor from a block state. **/
+            BlockHeader(const BlockState& state);
+
+        };
+
+
+        /** HeaderIndex
+         *
+         *  Memory resident tree of the most recent block headers, with skip list ancestors so that retargeting,
+         *  channel lookups, and locators don't need to read a full block state from disk for every step back.
+         *  The index only holds the last -headerdepth blocks, and any walk past the oldest header continues on
+         *  disk, so callers get the same answers regardless of depth.
+         *
+         **/
+        namespace HeaderIndex
+        {
+
+            /** Initialize
+             *
+             *  Load the headers for the most recent blocks of the best chain.
+             *
+             *  @return true if the headers loaded successfully.
+             *
+             **/
+            bool Initialize();
+
+
+            /** Insert
+             *
+             *  Add the header of a newly indexed block state.
+             *
+             *  @param[in] state The block state to add.
+             *
+             **/
+            void Insert(const BlockState& state);
+
+
+            /** SetBest
+             *
+             *  Set the header of the best chain, and prune any headers that are deeper than our depth.
+             *
+             *  @param[in] hashBest The hash of the new best block.
+             *
+             **/
+            void SetBest(const uint1024_t& hashBest);
+
+
+            /** GetHeader
+             *
+             *  Get the header for a given block.
+             *
+             *  @param[in] hashBlock The hash of the block to get.
+             *  @param[out] header The header that was found.
+             *
+             *  @return true if the header was found.
+             *
+             **/
+            bool GetHeader(const uint1024_t& hashBlock, BlockHeader &header);
+
+
+            /** GetLastHeader
+             *
+             *  Get the last header produced on a given channel, starting from and including a given block.
+             *
+             *  @param[in] hashBlock The hash of the block to search back from.
+             *  @param[in] nChannel The channel to search for.
+             *  @param[out] header The header that was found, or the genesis if none was found.
+             *
+             *  @return true if a header was found before reaching the genesis.
+             *
+             **/
+            bool GetLastHeader(const uint1024_t& hashBlock, const uint32_t nChannel, BlockHeader &header);
+
+
+            /** GetAncestor
+             *
+             *  Get the ancestor of a given block at a given height.
+             *
+             *  @param[in] hashBlock The hash of the block to search back from.
+             *  @param[in] nHeight The height of the ancestor to get.
+             *  @param[out] header The ancestor that was found.
+             *
+             *  @return true if the ancestor was found.
+             *
+             **/
+            bool GetAncestor(const uint1024_t& hashBlock, const uint32_t nHeight, BlockHeader &header);
+
+
+            /** IsInMainChain
+             *
+             *  Check if a given block is in the best chain.
+             *
+             *  @param[in] hashBlock The hash of the block to check.
+             *
+             *  @return true if the block is in the best chain.
+             *
+             **/
+            bool IsInMainChain(const uint1024_t& hashBlock);
+
+        }
+    }
+}
+
+#endif
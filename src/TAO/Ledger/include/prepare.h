@@ -0,0 +1,76 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_INCLUDE_PREPARE_H
+#define NEXUS_TAO_LEDGER_INCLUDE_PREPARE_H
+
+#include <Legacy/types/transaction.h>
+
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/templates/datastream.h>
+
+#include <map>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** PreparedTx
+         *
+         *  A block transaction that was read, and where possible verified, ahead of connecting it.
+         *
+         **/
+        struct PreparedTx
+        {
+            /** The tritium transaction, if this is one. **/
+            TAO::Ledger::Transaction tx;
+
+
+            /** The legacy transaction, if this is one. **/
+            Legacy::Transaction txLegacy;
+
+
+            /** The inputs of our legacy transaction. **/
+            std::map<uint512_t, std::pair<uint8_t, DataStream> > mapInputs;
+
+
+            /** Flags for which of our work is done. **/
+            bool fRead     = false;
+            bool fInputs   = false;
+            bool fVerified = false;
+        };
+
+
+        /** PrepareConnect
+         *
+         *  Read the transactions of a block and verify their pre-states across our verification threads. A
+         *  transaction's pre-states are only verified ahead of time when no earlier transaction in the block touches
+         *  the same registers or sigchain, so that it sees the same states it would when connected in order.
+         *
+         *  @param[in] vtx The transactions of the block to prepare.
+         *  @param[out] vPrepared The prepared transactions, one for each transaction in the block.
+         *
+         **/
+        void PrepareConnect(const std::vector<std::pair<uint8_t, uint512_t> >& vtx, std::vector<PreparedTx> &vPrepared);
+
+    }
+}
+
+#endif
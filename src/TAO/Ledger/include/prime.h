@@ -15,6 +15,8 @@ ________________________________________________________________________________
 #ifndef NEXUS_TAO_LEDGER_INCLUDE_PRIME_H
 #define NEXUS_TAO_LEDGER_INCLUDE_PRIME_H
 
+#include <vector>
+
 #include <LLC/types/uint1024.h>
 
 /* Global TAO namespace. */
@@ -102,6 +104,17 @@ namespace TAO
         bool PrimeCheck(const uint1024_t& hashTest);
 
 
+        /** PrimeCheck
+         *
+         *  Determines which numbers of a prime cluster are prime, testing them in one batch.
+         *
+         *  @param[in] vTests The numbers to test for primality.
+         *  @param[out] vPrimes The result of the prime tests for each number, in the same order.
+         *
+         **/
+        void PrimeCheck(const std::vector<uint1024_t>& vTests, std::vector<bool> &vPrimes);
+
+
         /** FermatTest
          *
          *  Used after Miller-Rabin and Divisor tests to verify primality.
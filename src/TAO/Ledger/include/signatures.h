@@ -0,0 +1,156 @@
+/*__________________________________________________________________________________________
+
+			Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+			(c) Copyright The Nexus Developers 2014 - 2023
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+
+#include <Util/templates/singleton.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO::Ledger
+{
+    /* Forward declarations. */
+    class Transaction;
+
+
+    /** SignatureCache
+     *
+     *  Cache of transaction signatures that have already been verified, so that a transaction verified when it
+     *  is accepted into the memory pool is not verified again when its block is checked.
+     *
+     **/
+    namespace SignatureCache
+    {
+        /** Has
+         *
+         *  Check if a transaction's signature has already been verified.
+         *
+         *  @param[in] tx The transaction to check.
+         *
+         *  @return true if the same key and signature have been verified for this transaction.
+         *
+         **/
+        bool Has(const Transaction& tx);
+
+
+        /** Add
+         *
+         *  Add a transaction with a valid signature to the cache.
+         *
+         *  @param[in] tx The transaction that was verified.
+         *
+         **/
+        void Add(const Transaction& tx);
+    }
+
+
+    /** @class
+     *
+     *  This class is responsible for verifying transaction signatures in parallel.
+     *  The calling thread works through the batch alongside the pool threads, so a batch never waits on a busy pool.
+     *
+     **/
+    class SignatureVerifier : public Singleton<SignatureVerifier>
+    {
+        /** Queue of verification tasks for the pool threads. **/
+        std::queue<std::function<void()>> QUEUE;
+
+
+        /** Mutex to protect our queue. **/
+        std::mutex QUEUE_MUTEX;
+
+
+        /** Condition variable to wake up the pool threads. **/
+        std::condition_variable CONDITION;
+
+
+        /** Threads for running verifications. **/
+        std::vector<std::thread> THREADS;
+
+
+        /** Flag to tell the pool threads to stop. **/
+        std::atomic<bool> fStop;
+
+
+    public:
+
+        /** Default Constructor. **/
+        SignatureVerifier();
+
+
+        /** Default Destructor. **/
+        ~SignatureVerifier();
+
+
+        /** Active
+         *
+         *  Check if the verification pool has been initialized.
+         *
+         *  @return true if the pool is running.
+         *
+         **/
+        static bool Active();
+
+
+        /** Verify
+         *
+         *  Verify the signatures for a batch of transactions across the pool threads.
+         *
+         *  @param[in] vtx The transactions to verify.
+         *  @param[out] vValid The results of each verification, in the same order.
+         *
+         **/
+        void Verify(const std::vector<const Transaction*>& vtx, std::vector<uint8_t> &vValid);
+
+
+        /** Run
+         *
+         *  Run a task for every index of a batch across the pool threads, returning once all of them are complete.
+         *
+         *  @param[in] nSize The number of indexes in the batch.
+         *  @param[in] fnTask The task to run for each index, which must not throw.
+         *
+         **/
+        void Run(const uint32_t nSize, const std::function<void(const uint32_t)>& fnTask);
+
+
+    private:
+
+        /** Thread
+         *
+         *  Run verification tasks from the queue until shutdown.
+         *
+         **/
+        void Thread();
+    };
+
+
+    /** VerifySignatures
+     *
+     *  Verify the signatures for a batch of transactions, in parallel when the verification pool is running.
+     *  Signatures that are already in the signature cache are not verified again.
+     *
+     *  @param[in] vtx The transactions to verify.
+     *
+     *  @return true if all of the signatures are valid.
+     *
+     **/
+    bool VerifySignatures(const std::vector<Transaction>& vtx);
+}
@@ -17,6 +17,7 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/headers.h>
 #include <TAO/Ledger/types/state.h>
 
 /* Global Legacy namespace. */
@@ -126,22 +127,24 @@ namespace TAO
             /* Step iterator */
             uint32_t nStep = 1;
 
-            /* Make a copy of the state. */
-            TAO::Ledger::BlockState statePrev = state;
+            /* Track the hash and height we are stepping back from. */
+            uint1024_t hashBlock = state.GetHash();
+            uint32_t nHeight     = state.nHeight;
 
             /* Loop back valid blocks. */
-            while(!statePrev.IsNull())
+            while(!state.IsNull())
             {
                 /* Break when locator size is large enough. */
                 if(vHave.size() > 22)
                     break;
 
-                /* Loop back the total blocks of step iterator. */
-                for(int i = 0; !statePrev.IsNull() && i < nStep; ++i)
-                    statePrev = statePrev.Prev();
+                /* Break when stepping back would pass the genesis. */
+                if(nStep > nHeight)
+                    break;
 
-                /* Check for null before we push to our list. */
-                if(statePrev.IsNull())
+                /* Skip back the total blocks of step iterator using our header index. */
+                TAO::Ledger::BlockHeader header;
+                if(!TAO::Ledger::HeaderIndex::GetAncestor(hashBlock, nHeight - nStep, header))
                     break;
 
                 /* After 10 blocks, start taking exponential steps back. */
@@ -149,7 +152,11 @@ namespace TAO
                     nStep = nStep * 2;
 
                 /* Push back the current state hash. */
-                vHave.push_back(statePrev.GetHash());
+                vHave.push_back(header.hashBlock);
+
+                /* Continue from this header. */
+                hashBlock = header.hashBlock;
+                nHeight   = header.nHeight;
             }
 
             /* Push the genesis. */
@@ -51,6 +51,7 @@ namespace TAO
         , mapRejected        ( )
         , mapInputs          ( )
         , setOrphansByIndex  ( )
+        , nGeneration        (0)
         {
         }
 
@@ -75,6 +76,7 @@ namespace TAO
 
             /* Add to the map. */
             mapLedger[hashTx] = tx;
+            ++nGeneration;
 
             return true;
         }
@@ -83,11 +85,20 @@ namespace TAO
         /* Accepts a transaction with validation rules. */
         bool Mempool::Accept(const TAO::Ledger::Transaction& tx, LLP::TritiumNode* pnode)
         {
-            RECURSIVE(MUTEX);
-
             /* Get the transaction hash. */
             uint512_t hashTx = tx.GetHash();
 
+            /* Verify our signature before locking, so that bursts from many nodes verify in parallel. */
+            if(!ChainState::Synchronizing() && !LLD::Ledger->HasTx(hashTx, FLAGS::MEMPOOL) && !tx.VerifySignature())
+            {
+                RECURSIVE(MUTEX);
+
+                mapRejected.insert(hashTx);
+                return debug::error(FUNCTION, "tx ", hashTx.SubString(), " REJECTED: ", debug::GetLastError());
+            }
+
+            RECURSIVE(MUTEX);
+
             try
             {
                 /* Check for transaction on disk. */
@@ -213,6 +224,7 @@ namespace TAO
 
                 /* Set the internal memory. */
                 mapLedger[hashTx] = tx;
+                ++nGeneration;
 
                 /* Update map claimed if not first tx. */
                 if(!tx.IsFirst())
@@ -462,6 +474,7 @@ namespace TAO
                 mapClaimed.erase(tx.hashPrevTx);
                 mapOrphans.erase(tx.hashPrevTx);
                 mapLedger.erase(hashTx);
+                ++nGeneration;
 
                 return true;
             }
@@ -477,6 +490,7 @@ namespace TAO
                     mapInputs.erase(tx.vin[i].prevout);
 
                 mapLegacy.erase(hashTx);
+                ++nGeneration;
             }
 
             return false;
@@ -733,5 +747,12 @@ namespace TAO
 
             return static_cast<uint32_t>(mapLedger.size() + mapLegacy.size());
         }
+
+
+        /* Gets the generation of the memory pool, which changes every time a transaction is added or removed. */
+        uint64_t Mempool::Generation() const
+        {
+            return nGeneration.load();
+        }
     }
 }
@@ -0,0 +1,497 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Legacy/include/evaluate.h>
+#include <Legacy/types/transaction.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/include/unpack.h>
+#include <TAO/Register/types/object.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+
+#include <TAO/Ledger/types/metrics.h>
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/debug.h>
+
+#include <cmath>
+#include <map>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Subtract without wrapping below zero, for buckets that were only partially indexed. */
+        static inline void subtract(uint64_t &nValue, const uint64_t nAmount)
+        {
+            nValue = (nValue > nAmount) ? nValue - nAmount : 0;
+        }
+
+
+        /* Default Constructor. */
+        Metrics::Metrics()
+        : nBlocks       { 0, 0, 0 }
+        , nTransactions (0)
+        , nContracts    (0)
+        , nDebits       (0)
+        , nCredits      (0)
+        , nMoved        (0)
+        , nTrust        (0)
+        , nGenesis      (0)
+        , nDeposits     (0)
+        , nWithdraws    (0)
+        , nMining       (0)
+        , nStaking      (0)
+        , nStakeChange  (0)
+        , vAccounts     ( )
+        {
+        }
+
+
+        /* Copy constructor. */
+        Metrics::Metrics(const Metrics& metrics)
+        : nBlocks       { metrics.nBlocks[0], metrics.nBlocks[1], metrics.nBlocks[2] }
+        , nTransactions (metrics.nTransactions)
+        , nContracts    (metrics.nContracts)
+        , nDebits       (metrics.nDebits)
+        , nCredits      (metrics.nCredits)
+        , nMoved        (metrics.nMoved)
+        , nTrust        (metrics.nTrust)
+        , nGenesis      (metrics.nGenesis)
+        , nDeposits     (metrics.nDeposits)
+        , nWithdraws    (metrics.nWithdraws)
+        , nMining       (metrics.nMining)
+        , nStaking      (metrics.nStaking)
+        , nStakeChange  (metrics.nStakeChange)
+        , vAccounts     (metrics.vAccounts)
+        {
+        }
+
+
+        /* Move constructor. */
+        Metrics::Metrics(Metrics&& metrics) noexcept
+        : nBlocks       { metrics.nBlocks[0], metrics.nBlocks[1], metrics.nBlocks[2] }
+        , nTransactions (std::move(metrics.nTransactions))
+        , nContracts    (std::move(metrics.nContracts))
+        , nDebits       (std::move(metrics.nDebits))
+        , nCredits      (std::move(metrics.nCredits))
+        , nMoved        (std::move(metrics.nMoved))
+        , nTrust        (std::move(metrics.nTrust))
+        , nGenesis      (std::move(metrics.nGenesis))
+        , nDeposits     (std::move(metrics.nDeposits))
+        , nWithdraws    (std::move(metrics.nWithdraws))
+        , nMining       (std::move(metrics.nMining))
+        , nStaking      (std::move(metrics.nStaking))
+        , nStakeChange  (std::move(metrics.nStakeChange))
+        , vAccounts     (std::move(metrics.vAccounts))
+        {
+        }
+
+
+        /* Copy assignment. */
+        Metrics& Metrics::operator=(const Metrics& metrics)
+        {
+            nBlocks[0]    = metrics.nBlocks[0];
+            nBlocks[1]    = metrics.nBlocks[1];
+            nBlocks[2]    = metrics.nBlocks[2];
+            nTransactions = metrics.nTransactions;
+            nContracts    = metrics.nContracts;
+            nDebits       = metrics.nDebits;
+            nCredits      = metrics.nCredits;
+            nMoved        = metrics.nMoved;
+            nTrust        = metrics.nTrust;
+            nGenesis      = metrics.nGenesis;
+            nDeposits     = metrics.nDeposits;
+            nWithdraws    = metrics.nWithdraws;
+            nMining       = metrics.nMining;
+            nStaking      = metrics.nStaking;
+            nStakeChange  = metrics.nStakeChange;
+            vAccounts     = metrics.vAccounts;
+
+            return *this;
+        }
+
+
+        /* Move assignment. */
+        Metrics& Metrics::operator=(Metrics&& metrics) noexcept
+        {
+            nBlocks[0]    = metrics.nBlocks[0];
+            nBlocks[1]    = metrics.nBlocks[1];
+            nBlocks[2]    = metrics.nBlocks[2];
+            nTransactions = std::move(metrics.nTransactions);
+            nContracts    = std::move(metrics.nContracts);
+            nDebits       = std::move(metrics.nDebits);
+            nCredits      = std::move(metrics.nCredits);
+            nMoved        = std::move(metrics.nMoved);
+            nTrust        = std::move(metrics.nTrust);
+            nGenesis      = std::move(metrics.nGenesis);
+            nDeposits     = std::move(metrics.nDeposits);
+            nWithdraws    = std::move(metrics.nWithdraws);
+            nMining       = std::move(metrics.nMining);
+            nStaking      = std::move(metrics.nStaking);
+            nStakeChange  = std::move(metrics.nStakeChange);
+            vAccounts     = std::move(metrics.vAccounts);
+
+            return *this;
+        }
+
+
+        /* Default Destructor. */
+        Metrics::~Metrics()
+        {
+        }
+
+
+        /* Get the bucket that a given timestamp falls into. */
+        uint64_t Metrics::Bucket(const uint64_t nTime)
+        {
+            return nTime / BUCKET_SECONDS;
+        }
+
+
+        /* Reset all of the metrics to zero. */
+        void Metrics::SetNull()
+        {
+            *this = Metrics();
+        }
+
+
+        /* Add the activity of a tritium transaction. */
+        void Metrics::Add(const Transaction& tx)
+        {
+            /* Increment our totals. */
+            ++nTransactions;
+            nContracts += tx.Size();
+
+            /* Iterate all of our contracts. */
+            for(uint32_t n = 0; n < tx.Size(); ++n)
+            {
+                /* Get a reference of our contract. */
+                const TAO::Operation::Contract& rContract = tx[n];
+
+                /* Check for an available address that was modified. */
+                uint256_t hashAddress;
+                if(TAO::Register::Unpack(rContract, hashAddress))
+                    AddAccount(hashAddress);
+
+                /* Get our total NXS being spent. */
+                uint64_t nTotal = 0;
+                if(!TAO::Register::Unpack(rContract, nTotal))
+                    continue;
+
+                /* Check our primitive for what to track. */
+                switch(rContract.Primitive())
+                {
+                    /* Check for trust transactions. */
+                    case TAO::Operation::OP::TRUST:
+                    {
+                        /* Accumulate our trust totals. */
+                        ++nTrust;
+                        nStaking += nTotal;
+
+                        /* Jump to starting OP */
+                        rContract.SeekToPrimitive();
+
+                        /* Skip to stake change. */
+                        rContract.Seek(73);
+
+                        /* Get our stake change value. */
+                        int64_t nChange = 0;
+                        rContract >> nChange;
+
+                        /* Adjust our current stake. */
+                        nStakeChange += nChange;
+
+                        break;
+                    }
+
+                    /* Check for stake genesis transactions. */
+                    case TAO::Operation::OP::GENESIS:
+                    {
+                        /* Accumulate our inflation totals. */
+                        ++nGenesis;
+                        nStaking += nTotal;
+
+                        /* Get our pre-state to find stake. */
+                        TAO::Register::Object tPreState = rContract.PreState();
+
+                        /* Our balance is our committed stake. */
+                        if(tPreState.Parse())
+                            nStakeChange += tPreState.get<uint64_t>("balance");
+
+                        break;
+                    }
+
+                    /* Track the NXS moved by debits. */
+                    case TAO::Operation::OP::DEBIT:
+                    {
+                        ++nDebits;
+
+                        /* Only NXS accounts count towards supply moved. */
+                        TAO::Register::Object tPreState = rContract.PreState();
+                        if(tPreState.Parse() && tPreState.Check("token") && tPreState.get<uint256_t>("token") == 0)
+                            nMoved += nTotal;
+
+                        break;
+                    }
+
+                    /* Check for credits from legacy. */
+                    case TAO::Operation::OP::CREDIT:
+                    {
+                        ++nCredits;
+
+                        /* Check only for credits from legacy. */
+                        uint512_t hashPrevTx;
+                        if(TAO::Register::Unpack(rContract, hashPrevTx) && hashPrevTx.GetType() == TAO::Ledger::LEGACY)
+                            nWithdraws += nTotal;
+
+                        break;
+                    }
+
+                    /* Check for a legacy deposit. */
+                    case TAO::Operation::OP::LEGACY:
+                    {
+                        nDeposits += nTotal;
+                        break;
+                    }
+
+                    /* Check for our coinbase minting. */
+                    case TAO::Operation::OP::COINBASE:
+                    {
+                        nMining += nTotal;
+                        break;
+                    }
+                }
+            }
+        }
+
+
+        /* Add the activity of a legacy transaction. */
+        void Metrics::Add(const Legacy::Transaction& tx)
+        {
+            /* Increment our totals. */
+            ++nTransactions;
+
+            /* Loop through all of our outputs to check. */
+            for(const Legacy::TxOut& out : tx.vout)
+            {
+                /* See if we are sending to register. */
+                uint256_t hashAddress;
+                if(Legacy::ExtractRegister(out.scriptPubKey, hashAddress))
+                    AddAccount(hashAddress);
+
+                /* Check for legacy to legacy transacitons. */
+                Legacy::NexusAddress addrAccount;
+                if(Legacy::ExtractAddress(out.scriptPubKey, addrAccount))
+                    AddAccount(addrAccount.GetHash256());
+            }
+        }
+
+
+        /* Add a block to the counts for its channel. */
+        void Metrics::AddBlock(const uint32_t nChannel)
+        {
+            if(nChannel < 3)
+                ++nBlocks[nChannel];
+        }
+
+
+        /* Add an account address to our unique accounts sketch. */
+        void Metrics::AddAccount(const uint256_t& hashAddress)
+        {
+            /* Allocate our registers on first use so empty buckets stay small on disk. */
+            if(vAccounts.size() != ACCOUNT_REGISTERS)
+                vAccounts.resize(ACCOUNT_REGISTERS, 0);
+
+            /* Mix our address bits, register addresses carry their type in the high byte. */
+            uint64_t nHash = hashAddress.Get64(0);
+            nHash ^= nHash >> 33;
+            nHash *= 0xff51afd7ed558ccdULL;
+            nHash ^= nHash >> 33;
+            nHash *= 0xc4ceb9fe1a85ec53ULL;
+            nHash ^= nHash >> 33;
+
+            /* The low bits pick our register, the rest give us our rank. */
+            const uint32_t nRegister = static_cast<uint32_t>(nHash % ACCOUNT_REGISTERS);
+            const uint64_t nBits     = (nHash / ACCOUNT_REGISTERS) | (uint64_t(1) << 54);
+
+            /* Keep the longest run of trailing zeros seen. */
+            const uint8_t nRank = static_cast<uint8_t>(__builtin_ctzll(nBits) + 1);
+            if(nRank > vAccounts[nRegister])
+                vAccounts[nRegister] = nRank;
+        }
+
+
+        /* Estimate the total unique accounts seen. */
+        uint64_t Metrics::Accounts() const
+        {
+            /* Check for an empty sketch. */
+            if(vAccounts.empty())
+                return 0;
+
+            /* Get our harmonic mean of the registers. */
+            double dSum = 0;
+            uint32_t nZeros = 0;
+            for(const uint8_t nRank : vAccounts)
+            {
+                dSum += std::ldexp(1.0, -static_cast<int32_t>(nRank));
+                if(nRank == 0)
+                    ++nZeros;
+            }
+
+            /* Get our raw estimate. */
+            const double dRegisters = static_cast<double>(vAccounts.size());
+            double dEstimate = (0.7213 / (1.0 + 1.079 / dRegisters)) * dRegisters * dRegisters / dSum;
+
+            /* Use linear counting for small cardinalities. */
+            if(dEstimate <= 2.5 * dRegisters && nZeros > 0)
+                dEstimate = dRegisters * std::log(dRegisters / nZeros);
+
+            return static_cast<uint64_t>(dEstimate + 0.5);
+        }
+
+
+        /* Merge the metrics from another bucket into this one. */
+        Metrics& Metrics::operator+=(const Metrics& metrics)
+        {
+            nBlocks[0]    += metrics.nBlocks[0];
+            nBlocks[1]    += metrics.nBlocks[1];
+            nBlocks[2]    += metrics.nBlocks[2];
+            nTransactions += metrics.nTransactions;
+            nContracts    += metrics.nContracts;
+            nDebits       += metrics.nDebits;
+            nCredits      += metrics.nCredits;
+            nMoved        += metrics.nMoved;
+            nTrust        += metrics.nTrust;
+            nGenesis      += metrics.nGenesis;
+            nDeposits     += metrics.nDeposits;
+            nWithdraws    += metrics.nWithdraws;
+            nMining       += metrics.nMining;
+            nStaking      += metrics.nStaking;
+            nStakeChange  += metrics.nStakeChange;
+
+            /* Merge our sketches by keeping the highest rank of each register. */
+            if(metrics.vAccounts.size() == ACCOUNT_REGISTERS)
+            {
+                if(vAccounts.size() != ACCOUNT_REGISTERS)
+                    vAccounts.resize(ACCOUNT_REGISTERS, 0);
+
+                for(uint32_t n = 0; n < ACCOUNT_REGISTERS; ++n)
+                    vAccounts[n] = std::max(vAccounts[n], metrics.vAccounts[n]);
+            }
+
+            return *this;
+        }
+
+
+        /* Remove the metrics of a block from this bucket. */
+        Metrics& Metrics::operator-=(const Metrics& metrics)
+        {
+            subtract(nBlocks[0],    metrics.nBlocks[0]);
+            subtract(nBlocks[1],    metrics.nBlocks[1]);
+            subtract(nBlocks[2],    metrics.nBlocks[2]);
+            subtract(nTransactions, metrics.nTransactions);
+            subtract(nContracts,    metrics.nContracts);
+            subtract(nDebits,       metrics.nDebits);
+            subtract(nCredits,      metrics.nCredits);
+            subtract(nMoved,        metrics.nMoved);
+            subtract(nTrust,        metrics.nTrust);
+            subtract(nGenesis,      metrics.nGenesis);
+            subtract(nDeposits,     metrics.nDeposits);
+            subtract(nWithdraws,    metrics.nWithdraws);
+            subtract(nMining,       metrics.nMining);
+            subtract(nStaking,      metrics.nStaking);
+
+            nStakeChange -= metrics.nStakeChange;
+
+            return *this;
+        }
+
+
+        /* Build the metrics buckets for the most recent blocks if they have not been indexed yet. */
+        bool IndexMetrics()
+        {
+            /* Check if we have already built our buckets. */
+            uint32_t nIndexed = 0;
+            if(LLD::Ledger->ReadMetricsHeight(nIndexed))
+                return true;
+
+            /* Grab our best block. */
+            const BlockState tBestBlock = ChainState::tStateBest.load();
+            debug::log(0, FUNCTION, "Indexing metrics from height ", tBestBlock.nHeight);
+
+            /* Iterate backwards until we have covered our window. */
+            std::map<uint64_t, Metrics> mapBuckets;
+
+            BlockState tPrevBlock = tBestBlock;
+            while(!tPrevBlock.IsNull() && tPrevBlock.GetBlockTime() + Metrics::WINDOW_SECONDS > tBestBlock.GetBlockTime())
+            {
+                /* Check for shutdown. */
+                if(config::fShutdown.load())
+                    return false;
+
+                /* Get the bucket for this block. */
+                Metrics& rBucket = mapBuckets[Metrics::Bucket(tPrevBlock.GetBlockTime())];
+                rBucket.AddBlock(tPrevBlock.GetChannel());
+
+                /* Check through all the transactions. */
+                for(const auto& proof : tPrevBlock.vtx)
+                {
+                    /* Add our tritium transactions. */
+                    if(proof.first == TRANSACTION::TRITIUM)
+                    {
+                        TAO::Ledger::Transaction tx;
+                        if(LLD::Ledger->ReadTx(proof.second, tx))
+                            rBucket.Add(tx);
+                    }
+
+                    /* Add our legacy transactions. */
+                    else if(proof.first == TRANSACTION::LEGACY)
+                    {
+                        Legacy::Transaction tx;
+                        if(LLD::Legacy->ReadTx(proof.second, tx))
+                            rBucket.Add(tx);
+                    }
+                }
+
+                /* Iterate to previous block. */
+                tPrevBlock = tPrevBlock.Prev();
+            }
+
+            /* Write all of our buckets to disk. */
+            for(const auto& pairBucket : mapBuckets)
+            {
+                if(!LLD::Ledger->WriteMetrics(pairBucket.first, pairBucket.second))
+                    return debug::error(FUNCTION, "failed to write metrics bucket ", pairBucket.first);
+            }
+
+            /* Mark our buckets as built. */
+            if(!LLD::Ledger->WriteMetricsHeight(tBestBlock.nHeight))
+                return debug::error(FUNCTION, "failed to write metrics height");
+
+            debug::log(0, FUNCTION, "Indexed ", mapBuckets.size(), " metrics buckets");
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <Legacy/include/signature.h>
+
+#include <TAO/Register/types/state.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/prepare.h>
+#include <TAO/Ledger/include/signatures.h>
+
+#include <Util/include/debug.h>
+
+#include <set>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Read the transactions of a block and verify their pre-states across our verification threads. */
+        void PrepareConnect(const std::vector<std::pair<uint8_t, uint512_t> >& vtx, std::vector<PreparedTx> &vPrepared)
+        {
+            /* Build an entry for every transaction. */
+            const uint32_t nSize = static_cast<uint32_t>(vtx.size());
+            vPrepared.clear();
+            vPrepared.resize(nSize);
+
+            /* The registers and sigchain touched by each tritium transaction that verified against our last block. */
+            std::vector<std::set<uint256_t> > vTouched(nSize);
+            std::vector<uint8_t> vPassed(nSize, 0);
+
+            /* Check our legacy signatures when connect would, so that it finds them in the signature cache. */
+            const bool fSignatures = !ChainState::Synchronizing();
+
+            /* Work on our transactions in parallel, since none of this writes to our databases. */
+            SignatureVerifier::Instance().Run(nSize, [&](const uint32_t n)
+            {
+                PreparedTx& tPrepared = vPrepared[n];
+                try
+                {
+                    /* Verify tritium pre-states against our last block, tracking which registers they touch. */
+                    if(vtx[n].first == TRANSACTION::TRITIUM)
+                    {
+                        if(!LLD::Ledger->ReadTx(vtx[n].second, tPrepared.tx))
+                            return;
+
+                        tPrepared.fRead = true;
+
+                        /* Failures are left for connect, which reports them in block order. */
+                        std::map<uint256_t, TAO::Register::State> mapStates;
+                        if(!tPrepared.tx.Verify(FLAGS::BLOCK, mapStates))
+                            return;
+
+                        for(const auto& pairState : mapStates)
+                            vTouched[n].insert(pairState.first);
+
+                        vTouched[n].insert(tPrepared.tx.hashGenesis);
+                        vPassed[n] = 1;
+                    }
+
+                    /* Fetch legacy inputs, which are all on disk before their block is connected. */
+                    else if(vtx[n].first == TRANSACTION::LEGACY)
+                    {
+                        if(!LLD::Legacy->ReadTx(vtx[n].second, tPrepared.txLegacy))
+                            return;
+
+                        tPrepared.fRead = true;
+                        if(!tPrepared.txLegacy.FetchInputs(tPrepared.mapInputs))
+                            return;
+
+                        tPrepared.fInputs = true;
+                        if(!fSignatures || tPrepared.txLegacy.IsCoinBase())
+                            return;
+
+                        /* Verify our legacy signatures into the cache, which connect checks again with its spends. */
+                        Legacy::SignatureHasher hasher(tPrepared.txLegacy);
+                        for(uint32_t nIn = static_cast<uint32_t>(tPrepared.txLegacy.IsCoinStake()); nIn < tPrepared.txLegacy.vin.size(); ++nIn)
+                        {
+                            /* Tritium inputs are verified by script in connect. */
+                            const auto& pairInput = tPrepared.mapInputs.at(tPrepared.txLegacy.vin[nIn].prevout.hash);
+                            if(pairInput.first != TAO::Ledger::LEGACY)
+                                continue;
+
+                            Legacy::Transaction txPrev;
+                            DataStream ssInput = pairInput.second;
+                            ssInput.SetPos(0);
+                            ssInput >> txPrev;
+
+                            Legacy::VerifySignature(txPrev, tPrepared.txLegacy, nIn, 0, &hasher);
+                        }
+                    }
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, e.what());
+                }
+            });
+
+            /* Walk our conflict graph in block order, only keeping verifications with no earlier conflicts. */
+            std::set<uint256_t> setTouched;
+            for(uint32_t n = 0; n < nSize; ++n)
+            {
+                /* Legacy transactions don't touch any registers. */
+                if(vtx[n].first != TRANSACTION::TRITIUM)
+                    continue;
+
+                /* We don't know what a failed verification would have touched, so nothing after it can be trusted. */
+                if(!vPassed[n])
+                    break;
+
+                /* Check for any earlier transaction touching the same registers or sigchain. */
+                bool fConflict = false;
+                for(const auto& hashAddress : vTouched[n])
+                {
+                    if(!setTouched.insert(hashAddress).second)
+                        fConflict = true;
+                }
+
+                vPrepared[n].fVerified = !fConflict;
+            }
+        }
+    }
+}
@@ -12,12 +12,15 @@
 ____________________________________________________________________________________________*/
 
 #include <TAO/Ledger/include/prime.h>
+#include <LLC/include/montgomery.h>
 #include <LLC/types/bignum.h>
 #include <openssl/bn.h>
 
 #include <Util/include/debug.h>
 #include <Util/include/softfloat.h>
 
+#include <algorithm>
+
 
 /* Global TAO namespace. */
 namespace TAO
@@ -54,8 +57,13 @@ namespace TAO
             uint1024_t hashNext = hashPrime;
             if(!vOffsets.empty())
             {
-                /* Loop through offsets pattern. */
+                /* Check that we have our fractional difficulty. */
                 uint32_t nSize = vOffsets.size();
+                if(nSize < 4)
+                    return 0.0;
+
+                /* Loop through offsets pattern. */
+                std::vector<uint1024_t> vCluster;
                 for(uint32_t n = 0; n < nSize - 4; ++n)
                 {
                     /* Get the offset. */
@@ -67,12 +75,19 @@ namespace TAO
 
                     /* Set the next offset position. */
                     hashNext += nOffset;
+                    vCluster.push_back(hashNext);
+                }
 
-                    /* Check prime at offset. */
-                    if(!fVerify || PrimeCheck(hashNext))
-                        ++nClusterSize;
+                /* Check the primes at every offset in one batch. */
+                if(fVerify)
+                {
+                    std::vector<bool> vPrimes;
+                    PrimeCheck(vCluster, vPrimes);
 
+                    nClusterSize += std::count(vPrimes.begin(), vPrimes.end(), true);
                 }
+                else
+                    nClusterSize += vCluster.size();
 
                 /* Get fractional difficulty. */
                 uint32_t nFraction = 0;
@@ -184,9 +199,40 @@ namespace TAO
         }
 
 
+        /* Determines which numbers of a prime cluster are prime, testing them in one batch. */
+        void PrimeCheck(const std::vector<uint1024_t>& vTests, std::vector<bool> &vPrimes)
+        {
+            vPrimes.assign(vTests.size(), false);
+
+            /* Small Prime Divisor Tests */
+            std::vector<uint32_t> vIndexes;
+            std::vector<uint1024_t> vCandidates;
+            for(uint32_t n = 0; n < vTests.size(); ++n)
+            {
+                if(!SmallDivisors(vTests[n]) || vTests[n] <= uint1024_t(1))
+                    continue;
+
+                vIndexes.push_back(n);
+                vCandidates.push_back(vTests[n]);
+            }
+
+            /* Fermat Test, the remaining candidates are all odd so they go straight to montgomery. */
+            std::vector<uint1024_t> vRemainders;
+            LLC::FermatTest(vCandidates, vRemainders);
+
+            for(uint32_t n = 0; n < vIndexes.size(); ++n)
+                vPrimes[vIndexes[n]] = (vRemainders[n] == 1);
+        }
+
+
         /* Used after Miller-Rabin and Divisor tests to verify primality. */
         uint1024_t FermatTest(const uint1024_t& hashTest)
         {
+            /* Odd numbers use our native montgomery exponentiation. */
+            if((hashTest.get(0) & 1) && hashTest > uint1024_t(1))
+                return LLC::FermatTest(hashTest);
+
+            /* Even numbers can't be put into montgomery form, so fall back to OpenSSL. */
             LLC::CAutoBN_CTX pctx;
 
             LLC::CBigNum bnPrime(hashTest);
@@ -18,6 +18,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/difficulty.h>
 #include <TAO/Ledger/include/retarget.h>
 #include <TAO/Ledger/include/constants.h>
+#include <TAO/Ledger/include/headers.h>
 
 #include <TAO/Ledger/types/state.h>
 
@@ -37,25 +38,27 @@ namespace TAO
         /* Gets the average timespan of given number of blocks. */
         uint64_t GetAverageTimespan(const BlockState& rBlock, const uint32_t nMaximum)
         {
-            /* Cache our last block state. */
-            BlockState tLastBlock = rBlock;
+            /* Cache our last block time and the block to search back from. */
+            uint64_t nLastTime = rBlock.GetBlockTime();
+            uint1024_t hashPrev = rBlock.hashPrevBlock;
 
             /* Loop until we have all timespans. */
             uint64_t nTotalTime = 0, nTotal = 0;
             do
             {
-                /* Get the next block state. */
-                BlockState tNextBlock = tLastBlock.Prev();
-                if(!TAO::Ledger::GetLastState(tNextBlock, rBlock.nChannel))
+                /* Get the next block header. */
+                BlockHeader tNextBlock;
+                if(!HeaderIndex::GetLastHeader(hashPrev, rBlock.nChannel, tNextBlock))
                     break;
 
                 /* Calculate our timespan. */
                 const uint32_t nTimespan =
-                    (tLastBlock.GetBlockTime() - tNextBlock.GetBlockTime());
+                    (nLastTime - tNextBlock.nTime);
 
                 /* Adjust our aggregate value. */
                 nTotalTime += nTimespan;
-                tLastBlock = tNextBlock;
+                nLastTime   = tNextBlock.nTime;
+                hashPrev    = tNextBlock.hashPrevBlock;
             }
             while(++nTotal < nMaximum);
 
@@ -69,17 +72,19 @@ namespace TAO
             uint64_t nIterator = 0, nWeightedAverage = 0;
 
             /* Find the introductory block. */
-            BlockState first = state;
+            uint64_t nFirstTime = state.GetBlockTime();
+            uint1024_t hashPrev = state.hashPrevBlock;
             for(int32_t nIndex = nDepth; nIndex > 0; --nIndex)
             {
-                /* Find the previous block. */
-                BlockState last = first.Prev();
-                if(!GetLastState(last, state.GetChannel()))
+                /* Find the previous block header. */
+                BlockHeader last;
+                if(!HeaderIndex::GetLastHeader(hashPrev, state.GetChannel(), last))
                     break;
 
                 /* Calculate the time. */
-                uint64_t nTime = std::max(first.GetBlockTime() - last.GetBlockTime(), uint64_t(1)) * nIndex * 3;
-                first = last;
+                uint64_t nTime = std::max(nFirstTime - last.nTime, uint64_t(1)) * nIndex * 3;
+                nFirstTime = last.nTime;
+                hashPrev   = last.hashPrevBlock;
 
                 /* Weight the iterator based on the weight constant. */
                 nIterator += (nIndex * 3);
@@ -120,9 +125,9 @@ namespace TAO
             if(!GetLastState(first, 0))
                 return bnProofOfWorkStart[0].GetCompact();
 
-            /* Get Last Block Index [2nd block back in Channel]. */
-            BlockState last = first.Prev();
-            if(!GetLastState(last, 0))
+            /* Get Last Block Header [2nd block back in Channel]. */
+            BlockHeader last;
+            if(!HeaderIndex::GetLastHeader(first.hashPrevBlock, 0, last))
                 return bnProofOfWorkStart[0].GetCompact();
 
             /* Get the Block Time and Target Spacing. */
@@ -200,7 +205,7 @@ namespace TAO
 
                 debug::log(2,
                     "RETARGET weighted time=", nBlockTime,
-                    " actual time =", std::max(first.GetBlockTime() - last.GetBlockTime(), (uint64_t) 1),
+                    " actual time =", std::max(first.GetBlockTime() - last.nTime, (uint64_t) 1),
                     "[", ((100.0 * static_cast<double>(nLowerBound)) / static_cast<double>(nUpperBound)), "%]\n",
                     "\tchain time: [", nBlockTarget, " / ", nBlockTime, "]\n",
                     "\tdifficulty: [", std::fixed, GetDifficulty(first.nBits, 0), " to ", std::fixed, GetDifficulty(bnNew.GetCompact(), 0), "]\n",
@@ -222,14 +227,14 @@ namespace TAO
             if(!GetLastState(first, 1))
                 return bnProofOfWorkStart[1].getuint32();
 
-            /* Get Last Block Index [2nd block back in Channel]. */
-            BlockState last = first.Prev();
-            if(!GetLastState(last, 1))
+            /* Get Last Block Header [2nd block back in Channel]. */
+            BlockHeader last;
+            if(!HeaderIndex::GetLastHeader(first.hashPrevBlock, 1, last))
                 return bnProofOfWorkStart[1].getuint32();
 
             /* Standard Time Proportions */
             uint64_t nBlockTime = ((state.nVersion >= 4) ?
-                GetWeightedTimes(first, state.nVersion >= 7 ? 2 : 5) : std::max(first.GetBlockTime() - last.GetBlockTime(), (uint64_t)1));
+                GetWeightedTimes(first, state.nVersion >= 7 ? 2 : 5) : std::max(first.GetBlockTime() - last.nTime, (uint64_t)1));
 
             /* Check for minimum difficulty reset for testnet. */
             if(config::fTestNet.load() && nBlockTime > 3600) //if more than one hour since last block, reset difficulty
@@ -339,7 +344,7 @@ namespace TAO
 
                 debug::log(2,
                     "RETARGET weighted time=", nBlockTime,
-                    " actual time ", std::max(first.GetBlockTime() - last.GetBlockTime(), (uint64_t) 1),
+                    " actual time ", std::max(first.GetBlockTime() - last.nTime, (uint64_t) 1),
                     ", [", nMod * 100.0, " %]\n",
                     "\tchain time: [", nBlockTarget, " / ", nBlockTime, "]\n",
                     "\treleased reward: ", first.nReleasedReserve[0] / Legacy::COIN,
@@ -363,14 +368,14 @@ namespace TAO
             if(!GetLastState(first, 2))
                 return bnProofOfWorkStart[2].GetCompact();
 
-            /* Get Last Block Index [2nd block back in Channel]. */
-            BlockState last = first.Prev();
-            if(!GetLastState(last, 2))
+            /* Get Last Block Header [2nd block back in Channel]. */
+            BlockHeader last;
+            if(!HeaderIndex::GetLastHeader(first.hashPrevBlock, 2, last))
                 return bnProofOfWorkStart[2].GetCompact();
 
             /* Get the Block Times with Minimum of 1 to Prevent Time Warps. */
             uint64_t nBlockTime = ((state.nVersion >= 4) ?
-                GetWeightedTimes(first, state.nVersion >= 7 ? 2 : 5) : std::max(first.GetBlockTime() - last.GetBlockTime(), (uint64_t) 1));
+                GetWeightedTimes(first, state.nVersion >= 7 ? 2 : 5) : std::max(first.GetBlockTime() - last.nTime, (uint64_t) 1));
 
             /* Check for minimum difficulty reset for testnet. */
             if(config::fTestNet.load() && nBlockTime > 3600) //if more than one hour since last block, reset difficulty
@@ -478,7 +483,7 @@ namespace TAO
                 convert::i64todays(GetChainAge(first.GetBlockTime()), nDays, nHours, nMinutes);
 
                 debug::log(2,
-                    "RETARGET weighted time=", nBlockTime, " actual time ", std::max(first.GetBlockTime() - last.GetBlockTime(), (uint64_t) 1),
+                    "RETARGET weighted time=", nBlockTime, " actual time ", std::max(first.GetBlockTime() - last.nTime, (uint64_t) 1),
                     " [", (100.0 * static_cast<double>(nLowerBound)) / static_cast<double>(nUpperBound), " %]\n",
                     "\tchain time: [", nBlockTarget, " / ", nBlockTime, "]\n",
                     "\treleased reward: ", first.nReleasedReserve[0] / Legacy::COIN,
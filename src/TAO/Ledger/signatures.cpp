@@ -0,0 +1,238 @@
+/*__________________________________________________________________________________________
+
+			Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+			(c) Copyright The Nexus Developers 2014 - 2023
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To The Voice of The People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+
+#include <LLD/cache/template_lru.h>
+
+#include <LLP/include/version.h>
+
+#include <TAO/Ledger/include/signatures.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/templates/datastream.h>
+
+/* Global TAO namespace. */
+namespace TAO::Ledger
+{
+
+    namespace SignatureCache
+    {
+        /* The maximum signatures to keep in our cache. */
+        const uint32_t MAX_SIGNATURES = 65536;
+
+
+        /* Digests of verified keys and signatures by txid. */
+        LLD::TemplateLRU<uint512_t, uint512_t> cacheSignatures(MAX_SIGNATURES);
+
+
+        /* Get the digest of a transaction's key type, public key, and signature. The public key is length prefixed
+         * so that bytes can't be moved between the key and the signature without changing the digest. */
+        uint512_t signature_digest(const Transaction& tx)
+        {
+            DataStream ssKey(SER_GETHASH, LLP::PROTOCOL_VERSION);
+            ssKey << tx.nKeyType << tx.vchPubKey;
+
+            return LLC::SK512(ssKey.Bytes(), tx.vchSig.begin(), tx.vchSig.end());
+        }
+
+
+        /* Check if a transaction's signature has already been verified. */
+        bool Has(const Transaction& tx)
+        {
+            /* Check for our txid in the cache. */
+            uint512_t hashDigest = 0;
+            if(!cacheSignatures.Get(tx.GetHash(), hashDigest))
+                return false;
+
+            /* The txid doesn't cover the signature, so check it is the same one we verified. */
+            return hashDigest == signature_digest(tx);
+        }
+
+
+        /* Add a transaction with a valid signature to the cache. */
+        void Add(const Transaction& tx)
+        {
+            cacheSignatures.Put(tx.GetHash(), signature_digest(tx));
+        }
+    }
+
+
+    /* Default Constructor. */
+    SignatureVerifier::SignatureVerifier()
+    : QUEUE       ( )
+    , QUEUE_MUTEX ( )
+    , CONDITION   ( )
+    , THREADS     ( )
+    , fStop       (false)
+    {
+        /* The calling thread always verifies too, so we only need threads for the remaining cores. */
+        const int64_t nThreads =
+            config::GetArg("-verifythreads", std::max(int64_t(std::thread::hardware_concurrency()) - 1, int64_t(0)));
+
+        /* Start our pool threads. */
+        for(int64_t n = 0; n < nThreads; ++n)
+            THREADS.emplace_back(std::bind(&SignatureVerifier::Thread, this));
+
+        debug::log(0, FUNCTION, "Started ", THREADS.size(), " signature verification threads");
+    }
+
+
+    /* Default Destructor. */
+    SignatureVerifier::~SignatureVerifier()
+    {
+        /* Tell our threads to stop once the queue is empty. */
+        fStop.store(true);
+        CONDITION.notify_all();
+
+        /* Cleanup our pool threads. */
+        for(auto& tThread : THREADS)
+        {
+            if(tThread.joinable())
+                tThread.join();
+        }
+    }
+
+
+    /* Check if the verification pool has been initialized. */
+    bool SignatureVerifier::Active()
+    {
+        return INSTANCE.load() != nullptr;
+    }
+
+
+    /* Verify the signatures for a batch of transactions across the pool threads. */
+    void SignatureVerifier::Verify(const std::vector<const Transaction*>& vtx, std::vector<uint8_t> &vValid)
+    {
+        /* Set our default results. */
+        vValid.assign(vtx.size(), 0);
+
+        /* Verify each transaction into its own result. */
+        Run(static_cast<uint32_t>(vtx.size()), [&](const uint32_t n)
+        {
+            vValid[n] = vtx[n]->VerifySignature() ? 1 : 0;
+        });
+    }
+
+
+    /* Run a task for every index of a batch across the pool threads. */
+    void SignatureVerifier::Run(const uint32_t nSize, const std::function<void(const uint32_t)>& fnTask)
+    {
+        /* Check for an empty batch. */
+        if(nSize == 0)
+            return;
+
+        /* Shared state for this batch between this thread and the pool threads. */
+        std::atomic<uint32_t> nNext(0);
+        std::atomic<uint32_t> nFinished(0);
+        std::mutex FINISHED_MUTEX;
+        std::condition_variable FINISHED;
+
+        /* Claim indexes one at a time until the batch is empty. */
+        const std::function<void()> fnClaim = [&]()
+        {
+            for(uint32_t n = nNext++; n < nSize; n = nNext++)
+                fnTask(n);
+        };
+
+        /* Only wake up as many threads as there is work for, since this thread takes a share too. */
+        const uint32_t nTasks = std::min(uint32_t(THREADS.size()), nSize - 1);
+        {
+            LOCK(QUEUE_MUTEX);
+            for(uint32_t n = 0; n < nTasks; ++n)
+            {
+                QUEUE.push([&]()
+                {
+                    fnClaim();
+
+                    /* Signal this thread's share is complete. */
+                    LOCK(FINISHED_MUTEX);
+                    ++nFinished;
+                    FINISHED.notify_one();
+                });
+            }
+        }
+        CONDITION.notify_all();
+
+        /* Take our own share of the batch. */
+        fnClaim();
+
+        /* Wait for the pool threads to finish, since their tasks reference this stack frame. */
+        std::unique_lock<std::mutex> FINISHED_LOCK(FINISHED_MUTEX);
+        FINISHED.wait(FINISHED_LOCK, [&]{ return nFinished.load() == nTasks; });
+    }
+
+
+    /* Run verification tasks from the queue until shutdown. */
+    void SignatureVerifier::Thread()
+    {
+        while(true)
+        {
+            /* Wait for tasks in the queue. */
+            std::function<void()> fnTask;
+            {
+                std::unique_lock<std::mutex> QUEUE_LOCK(QUEUE_MUTEX);
+                CONDITION.wait(QUEUE_LOCK, [this]{ return fStop.load() || !QUEUE.empty(); });
+
+                /* Only stop once all queued tasks are complete, since their callers are waiting on them. */
+                if(QUEUE.empty())
+                    return;
+
+                fnTask = std::move(QUEUE.front());
+                QUEUE.pop();
+            }
+
+            fnTask();
+        }
+    }
+
+
+    /* Verify the signatures for a batch of transactions. */
+    bool VerifySignatures(const std::vector<Transaction>& vtx)
+    {
+        /* Skip over transactions that were verified already. */
+        std::vector<const Transaction*> vVerify;
+        for(const auto& tx : vtx)
+        {
+            if(!SignatureCache::Has(tx))
+                vVerify.push_back(&tx);
+        }
+
+        /* Check if there is anything left to verify. */
+        if(vVerify.empty())
+            return true;
+
+        /* Verify across the pool when there is more than one transaction. */
+        std::vector<uint8_t> vValid;
+        if(vVerify.size() > 1 && SignatureVerifier::Active())
+            SignatureVerifier::Instance().Verify(vVerify, vValid);
+        else
+        {
+            vValid.reserve(vVerify.size());
+            for(const auto& ptx : vVerify)
+                vValid.push_back(ptx->VerifySignature() ? 1 : 0);
+        }
+
+        /* Check all of our results. */
+        for(uint32_t n = 0; n < vVerify.size(); ++n)
+        {
+            if(!vValid[n])
+                return debug::error(FUNCTION, "tx ", vVerify[n]->GetHash().SubString(), " has invalid signature");
+        }
+
+        return true;
+    }
+}
@@ -39,14 +39,18 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/difficulty.h>
 #include <TAO/Ledger/include/dispatch.h>
 #include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/headers.h>
 #include <TAO/Ledger/include/prime.h>
 #include <TAO/Ledger/include/stake_change.h>
 #include <TAO/Ledger/include/supply.h>
 #include <TAO/Ledger/include/timelocks.h>
 #include <TAO/Ledger/include/retarget.h>
+#include <TAO/Ledger/include/prepare.h>
+#include <TAO/Ledger/include/signatures.h>
 
 #include <TAO/Ledger/types/genesis.h>
 #include <TAO/Ledger/types/mempool.h>
+#include <TAO/Ledger/types/metrics.h>
 #include <TAO/Ledger/types/client.h>
 
 
@@ -61,27 +65,28 @@ namespace TAO
         /* Get the block state object. */
         bool GetLastState(BlockState &state, uint32_t nChannel)
         {
-            /* Get the genesis block hash. */
-            uint1024_t hashGenesis =  ChainState::Genesis();
+            /* Return false on genesis. */
+            if(state.nHeight == 0)
+                return false;
 
-            /* Loop back 1440 blocks. */
-            while(true)
-            {
-                /* Return false on genesis. */
-                if(state.nHeight == 0)
-                    return false;
+            /* Return true on channel found. */
+            if(state.GetChannel() == nChannel)
+                return true;
 
-                /* Return true on channel found. */
-                if(state.GetChannel() == nChannel)
+            /* Find the block in our header index, so we only read the one block we need from disk. */
+            BlockHeader header;
+            if(HeaderIndex::GetLastHeader(state.hashPrevBlock, nChannel, header))
+            {
+                /* Read the block state from the ledger. */
+                BlockState stateLast;
+                if(LLD::Ledger->ReadBlock(header.hashBlock, stateLast))
+                {
+                    state = std::move(stateLast);
                     return true;
-
-                /* Iterate backwards. */
-                state = state.Prev();
-                if(!state)
-                    break;
+                }
             }
 
-            /* If the max depth expired, return the genesis. */
+            /* If the search reached genesis, return the genesis. */
             state = ChainState::tStateGenesis;
 
             return false;
@@ -753,6 +758,9 @@ namespace TAO
             if(!LLD::Ledger->WriteBlock(GetHash(), *this))
                 return debug::error(FUNCTION, "block state failed to write");
 
+            /* Add the block to our header index. */
+            HeaderIndex::Insert(*this);
+
             /* Signal to set the best chain. */
             if(nVersion >= 7 && !IsHybrid())
             {
@@ -848,6 +856,10 @@ namespace TAO
 
                 /* Set the genesis block. */
                 ChainState::tStateGenesis = *this;
+
+                /* Add the genesis to our header index. */
+                HeaderIndex::Insert(*this);
+                HeaderIndex::SetBest(hash);
             }
             else
             {
@@ -1034,6 +1046,9 @@ namespace TAO
                 ChainState::nBestChainTrust    = nChainTrust;
                 ChainState::nBestHeight        = nHeight;
 
+                /* Move our header index to the new best chain. */
+                HeaderIndex::SetBest(hash);
+
                 /* Write the best chain pointer. */
                 if(!LLD::Ledger->WriteBestChain(hash))
                     return debug::error(FUNCTION, "failed to write best chain");
@@ -1062,14 +1077,27 @@ namespace TAO
             /* Reset the transaction fees. */
             nFees = 0;
 
+            /* Track the chain metrics of this block. */
+            Metrics tMetrics;
+            tMetrics.AddBlock(GetChannel());
+
             debug::log(3, "BLOCK BEGIN-------------------------------------");
 
-            /* Check through all the transactions. */
-            for(const auto& proof : vtx)
+            /* Read and verify what we can ahead of time when we have threads to share the work. */
+            std::vector<PreparedTx> vPrepared;
+            if(vtx.size() > 1 && SignatureVerifier::Active())
+                PrepareConnect(vtx, vPrepared);
+
+            /* Check through all the transactions, connecting them in block order. */
+            for(uint32_t nIndex = 0; nIndex < vtx.size(); ++nIndex)
             {
                 /* Get the transaction hash. */
+                const auto& proof = vtx[nIndex];
                 const uint512_t& hash = proof.second;
 
+                /* Get our prepared transaction if we have one. */
+                PreparedTx* pPrepared = vPrepared.empty() ? nullptr : &vPrepared[nIndex];
+
                 /* Only work on tritium transactions for now. */
                 if(proof.first == TRANSACTION::TRITIUM)
                 {
@@ -1082,7 +1110,9 @@ namespace TAO
 
                     /* Make sure the transaction is on disk. */
                     TAO::Ledger::Transaction tx;
-                    if(!LLD::Ledger->ReadTx(hash, tx))
+                    if(pPrepared && pPrepared->fRead)
+                        tx = std::move(pPrepared->tx);
+                    else if(!LLD::Ledger->ReadTx(hash, tx))
                         return debug::error(FUNCTION, "transaction not on disk");
 
                     if(config::nVerbose >= 3)
@@ -1101,8 +1131,8 @@ namespace TAO
                             return debug::error(FUNCTION, "last hash mismatch ", VARIABLE(hashLast.SubString()));
                     }
 
-                    /* Verify the Ledger Pre-States. */
-                    if(!tx.Verify(FLAGS::BLOCK)) //NOTE: double checking this for now in post-processing
+                    /* Verify the Ledger Pre-States, unless we already did against the same states. */
+                    if(!(pPrepared && pPrepared->fVerified) && !tx.Verify(FLAGS::BLOCK)) //NOTE: double checking this for now in post-processing
                         return false;
 
                     /* Connect the transaction. */
@@ -1153,6 +1183,9 @@ namespace TAO
                         }
                     }
 
+                    /* Add the transaction to our metrics. */
+                    tMetrics.Add(tx);
+
                     /* Keep track of total contracts processed. */
                     nTotalContracts += tx.Size();
                     swContract.stop();
@@ -1168,12 +1201,16 @@ namespace TAO
 
                     /* Make sure the transaction isn't on disk. */
                     Legacy::Transaction tx;
-                    if(!LLD::Legacy->ReadTx(hash, tx))
+                    if(pPrepared && pPrepared->fRead)
+                        tx = std::move(pPrepared->txLegacy);
+                    else if(!LLD::Legacy->ReadTx(hash, tx))
                         return debug::error(FUNCTION, "transaction not on disk");
 
                     /* Fetch the inputs. */
                     std::map<uint512_t, std::pair<uint8_t, DataStream> > inputs;
-                    if(!tx.FetchInputs(inputs))
+                    if(pPrepared && pPrepared->fInputs)
+                        inputs = std::move(pPrepared->mapInputs);
+                    else if(!tx.FetchInputs(inputs))
                         return debug::error(FUNCTION, "failed to fetch the inputs");
 
                     /* Connect the inputs. */
@@ -1185,6 +1222,9 @@ namespace TAO
                     Legacy::Wallet::Instance().AddToWalletIfInvolvingMe(tx, *this, true);
                     #endif
 
+                    /* Add the transaction to our metrics. */
+                    tMetrics.Add(tx);
+
                     /* Keep track of total inputs proceessed. */
                     nTotalInputs += tx.vin.size();
                     swScript.stop();
@@ -1226,6 +1266,14 @@ namespace TAO
             if(config::GetBoolArg("-indexheight"))
                 LLD::Ledger->IndexBlock(nHeight, hashBlock);
 
+            /* Add this block to the metrics for its time bucket. */
+            Metrics tBucket;
+            LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime), tBucket);
+
+            tBucket += tMetrics;
+            if(!LLD::Ledger->WriteMetrics(Metrics::Bucket(nTime), tBucket))
+                return debug::error(FUNCTION, "failed to update metrics");
+
             /* Update chain pointer for previous block. */
             if(!prev.IsNull())
             {
@@ -1245,6 +1293,10 @@ namespace TAO
         /** Disconnect a block state from the chain. **/
         bool BlockState::Disconnect()
         {
+            /* Track the chain metrics of this block. */
+            Metrics tMetrics;
+            tMetrics.AddBlock(GetChannel());
+
             /* Disconnect the transctions in reverse order to preserve sigchain ordering. */
             for(auto proof = vtx.rbegin(); proof != vtx.rend(); ++proof)
             {
@@ -1263,6 +1315,13 @@ namespace TAO
                     if(!tx.Disconnect())
                         return debug::error(FUNCTION, "failed to disconnect transaction");
 
+                    /* Add the transaction to our metrics. */
+                    tMetrics.Add(tx);
+
+                    /* Reverse our logical indexing in API. */
+                    if(nTime > NEXUS_TRITIUM_TIMELOCK)
+                        TAO::API::Indexing::PopTransaction(hash);
+
                     /* Make sure this sigchain needs to be de-indexed. */
                     if(LLD::Logical->HasFirst(tx.hashGenesis))
                     {
@@ -1294,6 +1353,9 @@ namespace TAO
                     if(!tx.Disconnect(*this))
                         return debug::error(FUNCTION, "failed to connect inputs");
 
+                    /* Add the transaction to our metrics. */
+                    tMetrics.Add(tx);
+
                     /* Wallets need to refund inputs when disonnecting coinstake */
                     #ifndef NO_WALLET
                     if(tx.IsCoinStake() && Legacy::Wallet::Instance().IsFromMe(tx))
@@ -1309,6 +1371,15 @@ namespace TAO
             if(config::GetBoolArg("-indexheight"))
                 LLD::Ledger->EraseIndex(nHeight);
 
+            /* Remove this block from the metrics for its time bucket. */
+            Metrics tBucket;
+            if(LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime), tBucket))
+            {
+                tBucket -= tMetrics;
+                if(!LLD::Ledger->WriteMetrics(Metrics::Bucket(nTime), tBucket))
+                    return debug::error(FUNCTION, "failed to update metrics");
+            }
+
             /* Update the previous state's next pointer. */
             BlockState prev = Prev();
             if(!prev.IsNull())
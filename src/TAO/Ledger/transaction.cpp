@@ -45,6 +45,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/dispatch.h>
 #include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/signatures.h>
 #include <TAO/Ledger/include/stake.h>
 #include <TAO/Ledger/include/stake_change.h>
 #include <TAO/Ledger/include/timelocks.h>
@@ -512,45 +513,59 @@ namespace TAO
                 }
             }
 
-            /* Verify the block signature (if not synchronizing) */
-            if(!TAO::Ledger::ChainState::Synchronizing())
+            /* Verify the transaction signature (if not synchronizing) */
+            if(!TAO::Ledger::ChainState::Synchronizing() && !VerifySignature())
+                return false;
+
+            return true;
+        }
+
+
+        /* Verify the transaction signature against its public key. */
+        bool Transaction::VerifySignature() const
+        {
+            /* Check if we have verified this signature already. */
+            if(SignatureCache::Has(*this))
+                return true;
+
+            /* Switch based on signature type. */
+            switch(nKeyType)
             {
-                /* Switch based on signature type. */
-                switch(nKeyType)
+                /* Support for the FALCON signature scheeme. */
+                case SIGNATURE::FALCON:
                 {
-                    /* Support for the FALCON signature scheeme. */
-                    case SIGNATURE::FALCON:
-                    {
-                        /* Create the FL Key object. */
-                        LLC::FLKey key;
-
-                        /* Set the public key and verify. */
-                        key.SetPubKey(vchPubKey);
-                        if(!key.Verify(GetHash().GetBytes(), vchSig))
-                            return debug::error(FUNCTION, "invalid transaction signature");
+                    /* Create the FL Key object. */
+                    LLC::FLKey key;
 
-                        break;
-                    }
+                    /* Set the public key and verify. */
+                    key.SetPubKey(vchPubKey);
+                    if(!key.Verify(GetHash().GetBytes(), vchSig))
+                        return debug::error(FUNCTION, "invalid transaction signature");
 
-                    /* Support for the BRAINPOOL signature scheme. */
-                    case SIGNATURE::BRAINPOOL:
-                    {
-                        /* Create EC Key object. */
-                        LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+                    break;
+                }
 
-                        /* Set the public key and verify. */
-                        key.SetPubKey(vchPubKey);
-                        if(!key.Verify(GetHash().GetBytes(), vchSig))
-                            return debug::error(FUNCTION, "invalid transaction signature");
+                /* Support for the BRAINPOOL signature scheme. */
+                case SIGNATURE::BRAINPOOL:
+                {
+                    /* Create EC Key object. */
+                    LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
 
-                        break;
-                    }
+                    /* Set the public key and verify. */
+                    key.SetPubKey(vchPubKey);
+                    if(!key.Verify(GetHash().GetBytes(), vchSig))
+                        return debug::error(FUNCTION, "invalid transaction signature");
 
-                    default:
-                        return debug::error(FUNCTION, "unknown signature type");
+                    break;
                 }
+
+                default:
+                    return debug::error(FUNCTION, "unknown signature type");
             }
 
+            /* Add to our cache so it isn't verified again. */
+            SignatureCache::Add(*this);
+
             return true;
         }
 
@@ -561,6 +576,13 @@ namespace TAO
             /* Create a temporary map for pre-states. */
             std::map<uint256_t, TAO::Register::State> mapStates;
 
+            return Verify(nFlags, mapStates);
+        }
+
+
+        /* Verify a transaction contracts, keeping the states of the registers they touched. */
+        bool Transaction::Verify(const uint8_t nFlags, std::map<uint256_t, TAO::Register::State> &mapStates) const
+        {
             /* Run through all the contracts. */
             for(const auto& contract : vContracts)
             {
@@ -996,8 +1018,8 @@ namespace TAO
                 if(fApplyTxFee)
                     TAO::Operation::TxCost(contract, nCost);
 
-                /* Index our registers here now if not -client mode and setting enabled. */
-                if(!config::fClient.load() && config::fIndexRegister.load())
+                /* Index our registers here now if not -client mode and setting enabled, only once connected in a block. */
+                if(nFlags == FLAGS::BLOCK && !config::fClient.load() && config::fIndexRegister.load())
                 {
                     /* Unpack the address we will be working on. */
                     uint256_t hashAddress;
@@ -1117,8 +1139,8 @@ namespace TAO
                 if(!TAO::Register::Rollback(*contract, nFlags))
                     return false;
 
-                /* Erase our register index here now if not -client mode and setting enabled. */
-                if(!config::fClient.load() && config::fIndexRegister.load())
+                /* Erase our register index here now if not -client mode and setting enabled, only when disconnecting a block. */
+                if(nFlags == FLAGS::BLOCK && !config::fClient.load() && config::fIndexRegister.load())
                 {
                     /* Unpack the address we will be working on. */
                     uint256_t hashAddress;
@@ -26,6 +26,8 @@ ________________________________________________________________________________
 
 #include <Util/include/mutex.h>
 
+#include <atomic>
+
 namespace LLP
 {
     class TritiumNode;
@@ -89,6 +91,10 @@ namespace TAO
             /** Set to keep track of duplicate orphans by index. **/
             std::set<uint512_t> setOrphansByIndex;
 
+
+            /** Counter that changes every time a transaction is added to or removed from the pool. **/
+            std::atomic<uint64_t> nGeneration;
+
         public:
 
             /** Default Constructor. **/
@@ -330,6 +336,15 @@ namespace TAO
              *
              **/
             uint32_t SizeLegacy();
+
+
+            /** Generation
+             *
+             *  Gets the generation of the memory pool, which changes every time a transaction is added or removed.
+             *  Used to tell if anything built from the pool's contents is still current.
+             *
+             **/
+            uint64_t Generation() const;
         };
 
         extern Mempool mempool;
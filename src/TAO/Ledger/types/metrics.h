@@ -0,0 +1,268 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_METRICS_H
+#define NEXUS_TAO_LEDGER_TYPES_METRICS_H
+
+#include <LLC/types/uint1024.h>
+#include <Util/templates/serialize.h>
+#include <vector>
+
+/* Forward declarations. */
+namespace Legacy { class Transaction; }
+
+/* Global TAO namespace. */
+namespace TAO
+{
+    /* Ledger layer namespace. */
+    namespace Ledger
+    {
+        /* Forward declarations. */
+        class Transaction;
+
+
+        /** Metrics
+         *
+         *  Aggregate chain activity over a bucket of time.
+         *
+         *  Every connected block adds its activity into the bucket for its block time and every disconnected block
+         *  removes it again, so that ledger/metrics only needs to sum a handful of buckets rather than reading every
+         *  transaction in its window. Unique accounts are tracked with a small HyperLogLog sketch, which can be
+         *  merged between buckets but not subtracted, so disconnected blocks leave their accounts behind.
+         *
+         **/
+        class Metrics
+        {
+        public:
+
+            /** The total seconds covered by each bucket. **/
+            static const uint64_t BUCKET_SECONDS = 3600;
+
+
+            /** The total seconds of history that are indexed when building the buckets for the first time. **/
+            static const uint64_t WINDOW_SECONDS = 86400 * 28;
+
+
+            /** The total registers in our unique accounts sketch. **/
+            static const uint32_t ACCOUNT_REGISTERS = 512;
+
+
+            /** The blocks found on each channel (stake, prime, hash). **/
+            uint64_t nBlocks[3];
+
+
+            /** The total transactions in this bucket. **/
+            uint64_t nTransactions;
+
+
+            /** The total contracts in this bucket. **/
+            uint64_t nContracts;
+
+
+            /** The total debit contracts. **/
+            uint64_t nDebits;
+
+
+            /** The total credit contracts. **/
+            uint64_t nCredits;
+
+
+            /** The total NXS moved by debit contracts. **/
+            uint64_t nMoved;
+
+
+            /** The total trust contracts. **/
+            uint64_t nTrust;
+
+
+            /** The total stake genesis contracts. **/
+            uint64_t nGenesis;
+
+
+            /** The total NXS sent to legacy outputs, such as exchange deposits. **/
+            uint64_t nDeposits;
+
+
+            /** The total NXS credited from legacy transactions, such as exchange withdraws. **/
+            uint64_t nWithdraws;
+
+
+            /** The total NXS minted from mining. **/
+            uint64_t nMining;
+
+
+            /** The total NXS minted from staking. **/
+            uint64_t nStaking;
+
+
+            /** The net change in stake. **/
+            int64_t nStakeChange;
+
+
+            /** HyperLogLog registers estimating unique accounts. **/
+            std::vector<uint8_t> vAccounts;
+
+
+            //Object serialization for storage
+            IMPLEMENT_SERIALIZE
+            (
+                READWRITE(nBlocks[0]);
+                READWRITE(nBlocks[1]);
+                READWRITE(nBlocks[2]);
+                READWRITE(nTransactions);
+                READWRITE(nContracts);
+                READWRITE(nDebits);
+                READWRITE(nCredits);
+                READWRITE(nMoved);
+                READWRITE(nTrust);
+                READWRITE(nGenesis);
+                READWRITE(nDeposits);
+                READWRITE(nWithdraws);
+                READWRITE(nMining);
+                READWRITE(nStaking);
+                READWRITE(nStakeChange);
+                READWRITE(vAccounts);
+            )
+
+
+            /** Default Constructor. **/
+            Metrics();
+
+
+            /** Copy constructor. **/
+            Metrics(const Metrics& metrics);
+
+
+            /** Move constructor. **/
+            Metrics(Metrics&& metrics) noexcept;
+
+
+            /** Copy assignment. **/
+            Metrics& operator=(const Metrics& metrics);
+
+
+            /** Move assignment. **/
+            Metrics& operator=(Metrics&& metrics) noexcept;
+
+
+            /** Default Destructor. **/
+            ~Metrics();
+
+
+            /** Bucket
+             *
+             *  Get the bucket that a given timestamp falls into.
+             *
+             *  @param[in] nTime The timestamp to check.
+             *
+             *  @return the bucket index for the timestamp.
+             *
+             **/
+            static uint64_t Bucket(const uint64_t nTime);
+
+
+            /** SetNull
+             *
+             *  Reset all of the metrics to zero.
+             *
+             **/
+            void SetNull();
+
+
+            /** Add
+             *
+             *  Add the activity of a tritium transaction.
+             *
+             *  @param[in] tx The transaction to add.
+             *
+             **/
+            void Add(const Transaction& tx);
+
+
+            /** Add
+             *
+             *  Add the activity of a legacy transaction.
+             *
+             *  @param[in] tx The transaction to add.
+             *
+             **/
+            void Add(const Legacy::Transaction& tx);
+
+
+            /** AddBlock
+             *
+             *  Add a block to the counts for its channel.
+             *
+             *  @param[in] nChannel The channel the block was found on.
+             *
+             **/
+            void AddBlock(const uint32_t nChannel);
+
+
+            /** AddAccount
+             *
+             *  Add an account address to our unique accounts sketch.
+             *
+             *  @param[in] hashAddress The address to add.
+             *
+             **/
+            void AddAccount(const uint256_t& hashAddress);
+
+
+            /** Accounts
+             *
+             *  Estimate the total unique accounts seen.
+             *
+             *  @return the estimated number of unique accounts.
+             *
+             **/
+            uint64_t Accounts() const;
+
+
+            /** operator+=
+             *
+             *  Merge the metrics from another bucket into this one.
+             *
+             *  @param[in] metrics The metrics to merge.
+             *
+             **/
+            Metrics& operator+=(const Metrics& metrics);
+
+
+            /** operator-=
+             *
+             *  Remove the metrics of a block from this bucket. Accounts can't be removed from the sketch so they
+             *  are left as is.
+             *
+             *  @param[in] metrics The metrics to remove.
+             *
+             **/
+            Metrics& operator-=(const Metrics& metrics);
+
+        };
+
+
+        /** IndexMetrics
+         *
+         *  Build the metrics buckets for the most recent blocks if they have not been indexed yet, so that
+         *  existing nodes have a full window of history from their first start.
+         *
+         *  @return true if the metrics were indexed successfully.
+         *
+         **/
+        bool IndexMetrics();
+    }
+}
+
+#endif
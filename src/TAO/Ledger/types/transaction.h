@@ -16,6 +16,7 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/enum.h>
 
+#include <map>
 #include <vector>
 
 namespace TAO::API { class Transaction; }
@@ -237,6 +238,17 @@ namespace TAO::Ledger
         bool Check(const uint8_t nFlags = 0) const;
 
 
+        /** VerifySignature
+         *
+         *  Verify the transaction signature against its public key. Signatures that have already been verified
+         *  are found in the signature cache and are not verified again.
+         *
+         *  @return true if the signature is valid.
+         *
+         **/
+        bool VerifySignature() const;
+
+
         /** Verify
          *
          *  Verify a transaction contracts.
@@ -247,6 +259,19 @@ namespace TAO::Ledger
         bool Verify(const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK) const;
 
 
+        /** Verify
+         *
+         *  Verify a transaction contracts, keeping the states of the registers they touched.
+         *
+         *  @param[in] nFlags The flags to read the register pre-states with.
+         *  @param[out] mapStates The post-states of every register the contracts touched, by address.
+         *
+         *  @return true if transaction is valid.
+         *
+         **/
+        bool Verify(const uint8_t nFlags, std::map<uint256_t, TAO::Register::State> &mapStates) const;
+
+
         /** CheckTrust
          *
          *  Check that the claimed trust score and stake reward are correct.
@@ -0,0 +1,124 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/cache/template_lru.h>
+#include <LLD/hash/xxh3.h>
+
+#include <TAO/Register/types/layout.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Register Layer namespace. */
+    namespace Register
+    {
+
+        /* The maximum layouts to keep in our cache, since nonstandard objects can have any layout. */
+        const uint32_t MAX_LAYOUTS = 4096;
+
+
+        /* Shared layouts by the hash of their schema. */
+        LLD::TemplateLRU<uint64_t, std::shared_ptr<const Layout> > cacheLayouts(MAX_LAYOUTS);
+
+
+        /* Default constructor. */
+        Layout::Layout()
+        : vSchema   ( )
+        , mapFields ( )
+        , vMembers  ( )
+        {
+        }
+
+
+        /* Copy Constructor. */
+        Layout::Layout(const Layout& layout)
+        : vSchema   (layout.vSchema)
+        , mapFields (layout.mapFields)
+        , vMembers  (layout.vMembers)
+        {
+        }
+
+
+        /* Move Constructor. */
+        Layout::Layout(Layout&& layout) noexcept
+        : vSchema   (std::move(layout.vSchema))
+        , mapFields (std::move(layout.mapFields))
+        , vMembers  (std::move(layout.vMembers))
+        {
+        }
+
+
+        /* Copy Assignment operator overload */
+        Layout& Layout::operator=(const Layout& layout)
+        {
+            vSchema   = layout.vSchema;
+            mapFields = layout.mapFields;
+            vMembers  = layout.vMembers;
+
+            return *this;
+        }
+
+
+        /* Move Assignment operator overload */
+        Layout& Layout::operator=(Layout&& layout) noexcept
+        {
+            vSchema   = std::move(layout.vSchema);
+            mapFields = std::move(layout.mapFields);
+            vMembers  = std::move(layout.vMembers);
+
+            return *this;
+        }
+
+
+        /* Default Destructor */
+        Layout::~Layout()
+        {
+        }
+
+
+        /* Find the position of a field by its name. */
+        const std::pair<uint16_t, bool>* Layout::Find(const std::string& strName) const
+        {
+            /* Check that the name exists in the layout. */
+            const auto it = mapFields.find(strName);
+            if(it == mapFields.end())
+                return nullptr;
+
+            return &it->second;
+        }
+
+
+        /* Get a cached layout by its schema. */
+        std::shared_ptr<const Layout> Layout::Get(const std::vector<uint8_t>& vSchema)
+        {
+            /* Check our cache for this hash. */
+            std::shared_ptr<const Layout> pLayout;
+            if(!cacheLayouts.Get(XXH3_64bits(vSchema.data(), vSchema.size()), pLayout))
+                return nullptr;
+
+            /* Check the whole schema, since a layout from another schema would misread the object. */
+            if(pLayout->vSchema != vSchema)
+                return nullptr;
+
+            return pLayout;
+        }
+
+
+        /* Add a layout to the cache by its schema. */
+        void Layout::Put(const std::shared_ptr<const Layout>& pLayout)
+        {
+            cacheLayouts.Put(XXH3_64bits(pLayout->vSchema.data(), pLayout->vSchema.size()), pLayout);
+        }
+    }
+}
@@ -17,6 +17,8 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/timelocks.h>
 
+#include <algorithm>
+
 
 /* Global TAO namespace. */
 namespace TAO
@@ -30,7 +32,7 @@ namespace TAO
         Object::Object()
         : State     (uint8_t(REGISTER::OBJECT))
         , vchSystem (512, 0) //system memory by default is 512 bytes
-        , mapData   ()
+        , pLayout   ()
         {
         }
 
@@ -39,7 +41,7 @@ namespace TAO
         Object::Object(const Object& object)
         : State     (object)
         , vchSystem (object.vchSystem)
-        , mapData   (object.mapData)
+        , pLayout   (object.pLayout)
         {
         }
 
@@ -48,7 +50,7 @@ namespace TAO
         Object::Object(Object&& object) noexcept
         : State     (std::move(object))
         , vchSystem (std::move(object.vchSystem))
-        , mapData   (std::move(object.mapData))
+        , pLayout   (std::move(object.pLayout))
         {
         }
 
@@ -66,7 +68,7 @@ namespace TAO
             hashChecksum = object.hashChecksum;
 
             nReadPos     = 0; //don't copy over read position
-            mapData      = object.mapData;
+            pLayout      = object.pLayout;
 
             return *this;
         }
@@ -85,7 +87,7 @@ namespace TAO
             hashChecksum = std::move(object.hashChecksum);
 
             nReadPos     = 0; //don't copy over read position
-            mapData      = std::move(object.mapData);
+            pLayout      = std::move(object.pLayout);
 
             return *this;
         }
@@ -101,7 +103,7 @@ namespace TAO
         Object::Object(const State& state)
         : State     (state)
         , vchSystem ()
-        , mapData   ()
+        , pLayout   ()
         {
         }
 
@@ -118,7 +120,7 @@ namespace TAO
                 OBJECTS::NONSTANDARD;
 
             /* Search object register for key types. */
-            if(mapData.size() == 1
+            if(pLayout && pLayout->mapFields.size() == 1
             && Check("namespace", TYPES::STRING, false))
             {
                 /* If it only contains one field called namespace then it must be a namespace */
@@ -126,7 +128,7 @@ namespace TAO
                 nStandard = OBJECTS::NAMESPACE;
 
             }
-            else if(mapData.size() == 9
+            else if(pLayout && pLayout->mapFields.size() == 9
             && Check("auth",    TYPES::UINT256_T, true)
             && Check("lisp",    TYPES::UINT256_T, true)
             && Check("network", TYPES::UINT256_T, true)
@@ -140,7 +142,7 @@ namespace TAO
                 /* Set the return value. */
                 nStandard = OBJECTS::CRYPTO;
             }
-            else if(mapData.size() == 3
+            else if(pLayout && pLayout->mapFields.size() == 3
             && Check("namespace", TYPES::STRING, false)
             && Check("name",      TYPES::STRING, false)
             && Check("address")) /* Name registers can store different types in the address so don't check the field type */
@@ -205,8 +207,8 @@ namespace TAO
         /* Get the cost to create this object register.*/
         uint64_t Object::Cost() const
         {
-            /* Check the map for empty. */
-            if(mapData.empty())
+            /* Check that we are parsed. */
+            if(!pLayout)
                 throw debug::exception(FUNCTION, "cannot get cost when object isn't parsed");
 
             /* Switch based on standard types. */
@@ -279,23 +281,34 @@ namespace TAO
             && this->nType != REGISTER::SYSTEM)
                 return debug::error(FUNCTION, "register has invalid type ", std::hex, uint32_t(this->nType));
 
-            /* Check the map for empty. */
-            if(!mapData.empty())
+            /* Check that we aren't already parsed. */
+            if(pLayout)
                 return false;
 
+            /* Our schema is the state without its values, which is all that decides where our fields are. */
+            std::vector<uint8_t> vSchema;
+            vSchema.reserve(vchState.size());
+
+            /* Track the name and binary position of each field in case we need to build our layout. */
+            std::vector<std::pair<std::pair<uint32_t, uint32_t>, std::pair<uint16_t, bool> > > vFields;
+
             /* Reset the read position. */
             nReadPos   = 0;
 
             /* Read until end of state. */
             while(!end())
             {
-                /* Deserialize the named value. */
-                std::string strName;
-                *this >> strName;
+                /* Deserialize the size of our name, which we skip over rather than copying. */
+                const uint32_t nBegin = nReadPos;
+                const uint64_t nName  = ReadCompactSize(*this);
 
-                /* Disallow duplicate value entries. */
-                if(mapData.count(strName))
-                    return debug::error(FUNCTION, "duplicate value entries");
+                /* Check for reads past the end of our state. */
+                if(nReadPos + nName > vchState.size())
+                    throw std::runtime_error(debug::safe_printstr(FUNCTION, "reached end of stream ", nReadPos));
+
+                /* Skip over our name. */
+                const uint32_t nNameBegin = nReadPos;
+                nReadPos += nName;
 
                 /* Deserialize the type. */
                 uint8_t nCode;
@@ -314,166 +327,143 @@ namespace TAO
                     *this >> nCode;
                 }
 
+                /* Track the binary position of type. */
+                const uint32_t nHeader = nReadPos;
+                vFields.push_back(std::make_pair(std::make_pair(nNameBegin, uint32_t(nName)), std::make_pair(uint16_t(nHeader - 1), fMutable)));
+
                 /* Switch between supported types. */
                 switch(nCode)
                 {
-
                     /* Standard type for C++ uint8_t. */
                     case TYPES::UINT8_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 2;
-
+                        nReadPos += 1;
                         break;
                     }
 
-
                     /* Standard type for C++ uint16_t. */
                     case TYPES::UINT16_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 3;
-
+                        nReadPos += 2;
                         break;
                     }
 
-
                     /* Standard type for C++ uint32_t. */
                     case TYPES::UINT32_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 5;
-
+                        nReadPos += 4;
                         break;
                     }
 
-
                     /* Standard type for C++ uint64_t. */
                     case TYPES::UINT64_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 9;
-
+                        nReadPos += 8;
                         break;
                     }
 
-
                     /* Standard type for Custom uint256_t */
                     case TYPES::UINT256_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 33;
-
+                        nReadPos += 32;
                         break;
                     }
 
-
                     /* Standard type for Custom uint512_t */
                     case TYPES::UINT512_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 65;
-
+                        nReadPos += 64;
                         break;
                     }
 
-
                     /* Standard type for Custom uint1024_t */
                     case TYPES::UINT1024_T:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate the types size plus type byte. */
-                        nReadPos += 129;
-
+                        nReadPos += 128;
                         break;
                     }
 
-
-                    /* Standard type for STL string */
+                    /* Standard type for STL string or STL vector with C++ type uint8_t */
                     case TYPES::STRING:
+                    case TYPES::BYTES:
                     {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate to start of size. */
-                        ++nReadPos;
-
-                        /* Find the serialized size of type. */
+                        /* Find the serialized size of type, which is part of our schema since it moves the fields after it. */
                         const uint64_t nSize =
                             ReadCompactSize(*this);
 
-                        /* Iterate the type size */
+                        /* Add our header to the schema, then iterate the type size. */
+                        vSchema.insert(vSchema.end(), vchState.begin() + nBegin, vchState.begin() + nReadPos);
                         nReadPos += nSize;
 
-                        break;
+                        continue;
                     }
 
+                    /* Fail if types are unknown. */
+                    default:
+                        return debug::error(FUNCTION, "malformed object register (unexpected instruction ", uint32_t(nCode), ")");
+                }
 
-                    /* Standard type for STL vector with C++ type uint8_t */
-                    case TYPES::BYTES:
-                    {
-                        /* Track the binary position of type. */
-                        mapData.emplace(strName, std::make_pair(--nReadPos, fMutable));
-
-                        /* Iterate to start of size. */
-                        ++nReadPos;
+                /* Add our name and type to the schema. */
+                vSchema.insert(vSchema.end(), vchState.begin() + nBegin, vchState.begin() + nHeader);
+            }
 
-                        /* Find the serialized size of type. */
-                        const uint64_t nSize =
-                            ReadCompactSize(*this);
+            /* Check our cache for another object with the same schema. */
+            pLayout = Layout::Get(vSchema);
+            if(pLayout)
+                return true;
 
-                        /* Iterate the type size */
-                        nReadPos += nSize;
+            /* Build a new layout for this schema. */
+            std::shared_ptr<Layout> pNew = std::make_shared<Layout>();
+            pNew->mapFields.reserve(vFields.size());
+            pNew->vMembers.reserve(vFields.size());
 
-                        break;
-                    }
+            /* Add our fields by name. */
+            for(const auto& tField : vFields)
+            {
+                /* Get the name of this field. */
+                const std::string strName =
+                    std::string(vchState.begin() + tField.first.first, vchState.begin() + tField.first.first + tField.first.second);
 
+                /* Disallow duplicate value entries. */
+                if(!pNew->mapFields.emplace(strName, tField.second).second)
+                    return debug::error(FUNCTION, "duplicate value entries");
 
-                    /* Fail if types are unknown. */
-                    default:
-                        return debug::error(FUNCTION, "malformed object register (unexpected instruction ", uint32_t(nCode), ")");
-                }
+                pNew->vMembers.push_back(strName);
             }
 
+            /* Keep our members sorted by name. */
+            std::sort(pNew->vMembers.begin(), pNew->vMembers.end());
+
+            /* Share our new layout. */
+            pNew->vSchema = std::move(vSchema);
+            Layout::Put(pNew);
+
+            pLayout = pNew;
+
             return true;
         }
 
 
+        /* Check if a field in the object register is mutable. */
+        bool Object::Mutable(const std::string& strName) const
+        {
+            /* Check that the name exists in the object. */
+            const std::pair<uint16_t, bool>* pField = field(strName);
+            if(!pField)
+                return false;
+
+            return pField->second;
+        }
+
+
         /* Get a list of field names for this Object. */
         std::vector<std::string> Object::Members() const
         {
-            /* Declare the vector of field names to return */
-            std::vector<std::string> vFieldNames;
-
-            /* Check the map for empty. */
-            if(mapData.empty()) //TODO: this should either throw, or this method should return by reference
+            /* Check that we are parsed. */
+            if(!pLayout) //TODO: this method should return by reference
                 throw debug::exception(FUNCTION, "object is not parsed");
 
-            /* Iterate data map and pull field names out into return vector */
-            for(const auto& fieldName : mapData)
-                vFieldNames.push_back(fieldName.first);
-
-            return vFieldNames;
+            return pLayout->vMembers;
         }
 
 
@@ -484,16 +474,13 @@ namespace TAO
             if(this->nType != TAO::Register::REGISTER::OBJECT)
                 return false;
 
-            /* Check the map for empty. */
-            if(mapData.empty())
-                return false;
-
             /* Check that the name exists in the object. */
-            if(!mapData.count(strName))
+            const std::pair<uint16_t, bool>* pField = field(strName);
+            if(!pField)
                 return false;
 
             /* Find the binary position of value. */
-            nReadPos = mapData[strName].first;
+            nReadPos = pField->first;
 
             /* Deserialize the type specifier. */
             *this >> nType;
@@ -513,16 +500,13 @@ namespace TAO
             if(this->nType != TAO::Register::REGISTER::OBJECT)
                 return false;
 
-            /* Check the map for empty. */
-            if(mapData.empty())
-                return false;
-
             /* Check that the name exists in the object. */
-            if(!mapData.count(strName))
+            const std::pair<uint16_t, bool>* pField = field(strName);
+            if(!pField)
                 return false;
 
             /* Find the binary position of value. */
-            nReadPos = mapData[strName].first;
+            nReadPos = pField->first;
 
             /* Deserialize the type specifier. */
             uint8_t nCheck;
@@ -532,7 +516,7 @@ namespace TAO
             if(nType != nCheck)
                 return false;
 
-            return (fMutable == mapData[strName].second);
+            return (fMutable == pField->second);
         }
 
 
@@ -543,12 +527,8 @@ namespace TAO
             if(this->nType != TAO::Register::REGISTER::OBJECT)
                 return false;
 
-            /* Check the map for empty. */
-            if(mapData.empty())
-                return false;
-
             /* Check that the name exists in the object. */
-            return mapData.count(strName) > 0;
+            return field(strName) != nullptr;
         }
 
 
@@ -559,8 +539,8 @@ namespace TAO
             if(this->nType != TAO::Register::REGISTER::OBJECT)
                 return false;
 
-            /* Check the map for empty. */
-            if(mapData.empty())
+            /* Check that we are parsed. */
+            if(!pLayout)
                 return false;
 
             /* Get the type for given name. */
@@ -616,20 +596,21 @@ namespace TAO
         /* Write into the object register a value of type bytes. */
         bool Object::Write(const std::string& strName, const std::string& strValue)
         {
-            /* Check the map for empty. */
-            if(mapData.empty())
+            /* Check that we are parsed. */
+            if(!pLayout)
                 return debug::error(FUNCTION, "object is not parsed");
 
             /* Check that the name exists in the object. */
-            if(!mapData.count(strName))
+            const std::pair<uint16_t, bool>* pField = pLayout->Find(strName);
+            if(!pField)
                 return false;
 
             /* Check that the value is mutable (writes allowed). */
-            if(!mapData[strName].second)
+            if(!pField->second)
                 return debug::error(FUNCTION, "cannot set value for READONLY data member");
 
             /* Find the binary position of value. */
-            nReadPos = mapData[strName].first;
+            nReadPos = pField->first;
 
             /* Deserialize the type specifier. */
             uint8_t nType;
@@ -658,20 +639,21 @@ namespace TAO
         /* Write into the object register a value of type bytes. */
         bool Object::Write(const std::string& strName, const std::vector<uint8_t>& vData)
         {
-            /* Check the map for empty. */
-            if(mapData.empty())
+            /* Check that we are parsed. */
+            if(!pLayout)
                 return debug::error(FUNCTION, "object is not parsed");
 
             /* Check that the name exists in the object. */
-            if(!mapData.count(strName))
+            const std::pair<uint16_t, bool>* pField = pLayout->Find(strName);
+            if(!pField)
                 return false;
 
             /* Check that the value is mutable (writes allowed). */
-            if(!mapData[strName].second)
+            if(!pField->second)
                 return debug::error(FUNCTION, "cannot set value for READONLY data member");
 
             /* Find the binary position of value. */
-            nReadPos = mapData[strName].first;
+            nReadPos = pField->first;
 
             /* Deserialize the type specifier. */
             uint8_t nType;
@@ -697,6 +679,17 @@ namespace TAO
         }
 
 
+        /* Find the binary position of a field if we are parsed. */
+        const std::pair<uint16_t, bool>* Object::field(const std::string& strName) const
+        {
+            /* Check that we are parsed. */
+            if(!pLayout)
+                return nullptr;
+
+            return pLayout->Find(strName);
+        }
+
+
         /* Helper function that uses template deduction to find type enum. */
         uint8_t Object::type(const uint8_t n) const
         {
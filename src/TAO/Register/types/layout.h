@@ -0,0 +1,116 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_REGISTER_INCLUDE_LAYOUT_H
+#define NEXUS_TAO_REGISTER_INCLUDE_LAYOUT_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <inttypes.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Register Layer namespace. */
+    namespace Register
+    {
+
+        /** Layout
+         *
+         *  The binary positions of the fields in an object register.
+         *
+         *  Objects with the same field names, types, and value sizes (such as every account or token) have the same
+         *  layout, so layouts are shared from a cache keyed by their schema rather than built for every object.
+         *
+         **/
+        class Layout
+        {
+        public:
+
+            /** The object's state with its values taken out, which identifies this layout. **/
+            std::vector<uint8_t> vSchema;
+
+
+            /** The binary position of each field and whether it is mutable, by name. **/
+            std::unordered_map<std::string, std::pair<uint16_t, bool> > mapFields;
+
+
+            /** The names of our fields in sorted order. **/
+            std::vector<std::string> vMembers;
+
+
+            /** Default constructor. **/
+            Layout();
+
+
+            /** Copy Constructor. **/
+            Layout(const Layout& layout);
+
+
+            /** Move Constructor. **/
+            Layout(Layout&& layout) noexcept;
+
+
+            /** Copy Assignment operator overload **/
+            Layout& operator=(const Layout& layout);
+
+
+            /** Move Assignment operator overload **/
+            Layout& operator=(Layout&& layout) noexcept;
+
+
+            /** Default Destructor **/
+            ~Layout();
+
+
+            /** Find
+             *
+             *  Find the position of a field by its name.
+             *
+             *  @param[in] strName The name of the field to find.
+             *
+             *  @return Pointer to the field's position and mutable flag, or nullptr if it doesn't exist.
+             *
+             **/
+            const std::pair<uint16_t, bool>* Find(const std::string& strName) const;
+
+
+            /** Get
+             *
+             *  Get a cached layout by its schema.
+             *
+             *  @param[in] vSchema The schema of the object being parsed.
+             *
+             *  @return The shared layout, or nullptr if this schema isn't cached.
+             *
+             **/
+            static std::shared_ptr<const Layout> Get(const std::vector<uint8_t>& vSchema);
+
+
+            /** Put
+             *
+             *  Add a layout to the cache by its schema.
+             *
+             *  @param[in] pLayout The layout to share with other objects.
+             *
+             **/
+            static void Put(const std::shared_ptr<const Layout>& pLayout);
+        };
+    }
+}
+
+#endif
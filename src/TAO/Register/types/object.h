@@ -16,8 +16,11 @@ ________________________________________________________________________________
 #define NEXUS_TAO_REGISTER_INCLUDE_OBJECT_H
 
 #include <TAO/Register/types/state.h>
+#include <TAO/Register/types/layout.h>
 #include <TAO/Register/include/enum.h>
 
+#include <memory>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -38,8 +41,8 @@ namespace TAO
 
         public:
 
-            /** Internal map for managing object data members and their binary positions. **/
-            mutable std::map< std::string, std::pair<uint16_t, bool> > mapData; //internal map for data members
+            /** The binary positions of our data members, shared with every object of the same layout. **/
+            mutable std::shared_ptr<const Layout> pLayout;
 
 
             /** Default constructor. **/
@@ -117,6 +120,18 @@ namespace TAO
             bool Parse() const;
 
 
+            /** Mutable
+             *
+             *  Check if a field in the object register is mutable.
+             *
+             *  @param[in] strName The name of the field to check
+             *
+             *  @return True if the field exists and is mutable.
+             *
+             **/
+            bool Mutable(const std::string& strName) const;
+
+
             /** Members
              *
              *  Get a list of variable names for this Object.
@@ -190,16 +205,17 @@ namespace TAO
             template<typename Type>
             bool Read(const std::string& strName, Type& value) const
             {
-                /* Check the map for empty. */
-                if(mapData.empty() && !Parse())
+                /* Check that we are parsed. */
+                if(!pLayout && !Parse())
                     return debug::error(FUNCTION, "object failed to parse");
 
                 /* Check that the name exists in the object. */
-                if(!mapData.count(strName))
+                const std::pair<uint16_t, bool>* pField = pLayout->Find(strName);
+                if(!pField)
                     return false;
 
                 /* Find the binary position of value. */
-                nReadPos = mapData[strName].first;
+                nReadPos = pField->first;
 
                 /* Deserialize the type specifier. */
                 uint8_t nType;
@@ -234,15 +250,16 @@ namespace TAO
             bool Write(const std::string& strName, const Type& value)
             {
                 /* Check that the name exists in the object. */
-                if(!mapData.count(strName))
+                const std::pair<uint16_t, bool>* pField = (pLayout ? pLayout->Find(strName) : nullptr);
+                if(!pField)
                     return false;
 
                 /* Check that the value is mutable (writes allowed). */
-                if(!mapData[strName].second)
+                if(!pField->second)
                     return debug::error(FUNCTION, "cannot set value for READONLY data member");
 
                 /* Find the binary position of value. */
-                nReadPos = mapData[strName].first;
+                nReadPos = pField->first;
 
                 /* Deserialize the type specifier. */
                 uint8_t nType;
@@ -342,6 +359,18 @@ namespace TAO
 
         private:
 
+            /** field
+             *
+             *  Find the binary position of a field and whether it is mutable.
+             *
+             *  @param[in] strName The name of the field to find.
+             *
+             *  @return Pointer to the field, or nullptr if we aren't parsed or it doesn't exist.
+             *
+             **/
+            const std::pair<uint16_t, bool>* field(const std::string& strName) const;
+
+
             /** type
              *
              *  Helper function that uses template deduction to find type enum.
@@ -26,6 +26,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/create.h>
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/dispatch.h>
+#include <TAO/Ledger/include/signatures.h>
 #include <TAO/Ledger/types/stake_minter.h>
 #include <TAO/Ledger/include/timelocks.h>
 
@@ -204,6 +205,10 @@ int main(int argc, char** argv)
         TAO::Ledger::Dispatch::Initialize();
 
 
+        /* Initialize signature verification threads. */
+        TAO::Ledger::SignatureVerifier::Initialize();
+
+
         /* Initialize ChainState. */
         TAO::Ledger::ChainState::Initialize();
 
@@ -296,6 +301,10 @@ int main(int argc, char** argv)
     LLP::Shutdown();
 
 
+    /* Shutdown signature verification threads. */
+    TAO::Ledger::SignatureVerifier::Shutdown();
+
+
     /* Shutdown LLL sub-systems. */
     LLD::Shutdown();
 
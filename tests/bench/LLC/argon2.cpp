@@ -0,0 +1,66 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/argon2.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <set>
+
+/* Hash our credentials with the given argon2 parameters. */
+void argon2_bench(const std::string& strName, const uint32_t nCost, const uint32_t nMemory, const uint32_t nIterations)
+{
+    const std::string strUsername = "username";
+    const std::vector<uint8_t> vSalt(strUsername.begin(), strUsername.end());
+
+    /* Check that each of our hashes is unique. */
+    std::set<uint512_t> setHashes;
+
+    runtime::timer timer;
+    timer.Start();
+    for(uint32_t n = 0; n < nIterations; ++n)
+    {
+        /* Change our password each iteration the same as a new key id would. */
+        std::string strPassword = "password";
+        std::vector<uint8_t> vPassword(strPassword.begin(), strPassword.end());
+        vPassword.insert(vPassword.end(), (uint8_t*)&n, (uint8_t*)&n + sizeof(n));
+
+        setHashes.insert(LLC::Argon2_512(vPassword, vSalt, std::vector<uint8_t>(), nCost, nMemory));
+    }
+
+    /* Our bytes processed is the memory filled, which is in kilobytes. */
+    bench::Report(strName, nIterations, timer.ElapsedMicroseconds(), uint64_t(nMemory) * 1024 * nCost * nIterations);
+    REQUIRE(setHashes.size() == nIterations);
+}
+
+
+TEST_CASE( "Argon2 Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin Argon2 Benchmarks =====");
+
+    /* Small parameters to measure the core itself. */
+    argon2_bench("LLC::Argon2_512::1x4MB", 1, (1 << 12), 32);
+
+    /* The parameters our credentials use, which can be set with the same arguments as the node. */
+    argon2_bench("LLC::Argon2_512::Credentials",
+        std::max(1u, uint32_t(config::GetArg("-argon2", 12))),
+        uint32_t(1 << std::max(4u, uint32_t(config::GetArg("-argon2_memory", 16)))), 4);
+
+    debug::log(0, "===== End Argon2 Benchmarks =====\n");
+}
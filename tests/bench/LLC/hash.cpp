@@ -0,0 +1,81 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/include/random.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <cstring>
+
+/* Run a hash over our data, with a new nonce each iteration so that the hash caches are missed. */
+template<typename Hash>
+void hash_bench(const std::string& strName, const uint32_t nSize, const uint32_t nIterations, const Hash& xHash, const bool fCached = false)
+{
+    /* Fill our data with random bytes. */
+    std::vector<uint8_t> vData(nSize, 0);
+    for(uint32_t n = 0; n < nSize; n += 8)
+    {
+        const uint64_t nRand = LLC::GetRand();
+        std::memcpy(&vData[n], &nRand, std::min(uint32_t(8), nSize - n));
+    }
+
+    /* Track our results so the hashes can't be optimized out. */
+    uint64_t nCheck = 0;
+
+    runtime::timer timer;
+    timer.Start();
+    for(uint32_t n = 0; n < nIterations; ++n)
+    {
+        if(!fCached)
+            std::memcpy(&vData[0], &n, sizeof(n));
+
+        nCheck += xHash(vData);
+    }
+
+    bench::Report(strName, nIterations, timer.ElapsedMicroseconds(), uint64_t(nSize) * nIterations);
+    REQUIRE(nCheck != 0);
+}
+
+
+TEST_CASE( "SK Hash Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin SK Hash Benchmarks =====");
+
+    /* Our hashes reduced to 64 bits. */
+    const auto SK256  = [](const std::vector<uint8_t>& vData) { return LLC::SK256(vData).Get64(); };
+    const auto SK512  = [](const std::vector<uint8_t>& vData) { return LLC::SK512(vData).Get64(); };
+    const auto SK1024 = [](const std::vector<uint8_t>& vData) { return LLC::SK1024(vData.begin(), vData.end()).Get64(); };
+
+    /* Small inputs the size of keys and headers. */
+    hash_bench("LLC::SK256::64B",   64, 100000, SK256);
+    hash_bench("LLC::SK512::64B",   64, 100000, SK512);
+    hash_bench("LLC::SK1024::216B", 216, 100000, SK1024);
+
+    /* Large inputs the size of transactions and blocks. */
+    hash_bench("LLC::SK256::64KB",  65536, 256, SK256);
+    hash_bench("LLC::SK512::64KB",  65536, 256, SK512);
+    hash_bench("LLC::SK1024::64KB", 65536, 256, SK1024);
+
+    /* Repeated inputs served from the hash caches. */
+    hash_bench("LLC::SK256::64B::cached",   64, 100000, SK256,  true);
+    hash_bench("LLC::SK512::64B::cached",   64, 100000, SK512,  true);
+    hash_bench("LLC::SK1024::216B::cached", 216, 100000, SK1024, true);
+
+    debug::log(0, "===== End SK Hash Benchmarks =====\n");
+}
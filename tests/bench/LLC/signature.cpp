@@ -0,0 +1,81 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/include/eckey.h>
+#include <LLC/include/flkey.h>
+#include <LLC/include/random.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+/* Sign and verify our transaction sized hashes with a given key type. */
+template<typename KeyType>
+void signature_bench(const std::string& strName, KeyType& key, const uint32_t nIterations)
+{
+    /* Build our messages the size of a transaction hash. */
+    std::vector<std::vector<uint8_t>> vMessages(nIterations);
+    for(uint32_t n = 0; n < nIterations; ++n)
+        vMessages[n] = LLC::GetRand512().GetBytes();
+
+    /* Sign each message. */
+    std::vector<std::vector<uint8_t>> vSignatures(nIterations);
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(uint32_t n = 0; n < nIterations; ++n)
+            REQUIRE(key.Sign(vMessages[n], vSignatures[n]));
+
+        bench::Report(strName + "::Sign", nIterations, timer.ElapsedMicroseconds());
+    }
+
+    /* Verify each signature. */
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(uint32_t n = 0; n < nIterations; ++n)
+            REQUIRE(key.Verify(vMessages[n], vSignatures[n]));
+
+        bench::Report(strName + "::Verify", nIterations, timer.ElapsedMicroseconds());
+    }
+}
+
+
+TEST_CASE( "Signature Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin Signature Benchmarks =====");
+
+    /* Falcon keys used for sigchain transactions. */
+    {
+        LLC::FLKey key;
+        key.MakeNewKey();
+
+        signature_bench("LLC::FLKey", key, 1000);
+    }
+
+    /* Brainpool keys used for sigchain transactions. */
+    {
+        LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+        key.MakeNewKey(true);
+
+        signature_bench("LLC::ECKey::BRAINPOOL_P512_T1", key, 1000);
+    }
+
+    debug::log(0, "===== End Signature Benchmarks =====\n");
+}
@@ -3,6 +3,8 @@
 #include <LLC/include/random.h>
 
 #include <LLD/cache/binary_lru.h>
+#include <LLD/include/enum.h>
+#include <LLD/templates/key.h>
 
 #include <LLD/include/version.h>
 
@@ -16,7 +18,7 @@ TEST_CASE( "Binary LRU Benchmarks", "[LLD]")
     debug::log(0, "===== Begin Binary LRU Benchmarks =====");
 
     //benchmarks
-    LLD::BinaryLRU* cache = new LLD::BinaryLRU();
+    LLD::BinaryLRU* cache = new LLD::BinaryLRU(1024 * 1024 * 64);
     uint256_t hash = LLC::GetRand256();
     {
         runtime::timer timer;
@@ -30,7 +32,7 @@ TEST_CASE( "Binary LRU Benchmarks", "[LLD]")
             DataStream ssData(SER_LLD, LLD::DATABASE_VERSION);
             ssData << uint1024_t(4934943);
 
-            cache->Put(ssKey.Bytes(), ssData.Bytes());
+            cache->Put(LLD::SectorKey(LLD::STATE::READY, ssKey.Bytes(), 0, 0, 0), ssKey.Bytes(), ssData.Bytes());
         }
 
         uint64_t nTime = timer.ElapsedMicroseconds();
@@ -0,0 +1,167 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLP/include/global.h>
+#include <LLP/include/version.h>
+#include <LLP/templates/socket.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <cstring>
+
+/* Write a tritium message to our raw socket, flushing until it is sent in full. */
+void write_message(LLP::Socket& socket, const uint16_t nMsg, const DataStream& ssData)
+{
+    const std::vector<uint8_t> vBytes = LLP::TritiumNode::NewMessage(nMsg, ssData).GetBytes();
+
+    socket.Write(vBytes, vBytes.size());
+    while(socket.Buffered() > 0 && !socket.Errors())
+        socket.Flush();
+}
+
+
+/* Read the messages available on our raw socket, returning the total pongs that were received. */
+uint32_t read_pongs(LLP::Socket& socket, std::vector<uint8_t>& vBuffer)
+{
+    /* Read everything available into our buffer. */
+    const uint32_t nAvailable = socket.Available();
+    if(nAvailable > 0)
+    {
+        const uint64_t nSize = vBuffer.size();
+        vBuffer.resize(nSize + nAvailable);
+
+        const int32_t nRead = socket.Read(&vBuffer[nSize], nAvailable);
+        vBuffer.resize(nSize + std::max(0, nRead));
+    }
+
+    /* Parse out our complete packets, which are the message, flags, and length headers followed by data. */
+    uint32_t nPongs = 0;
+    uint64_t nPos   = 0;
+    while(vBuffer.size() - nPos >= 8)
+    {
+        uint16_t nMsg = 0;
+        std::memcpy(&nMsg, &vBuffer[nPos], 2);
+
+        uint32_t nLength = 0;
+        std::memcpy(&nLength, &vBuffer[nPos + 4], 4);
+
+        /* Wait for the rest of this packet. */
+        if(vBuffer.size() - nPos < 8 + nLength)
+            break;
+
+        if(nMsg == LLP::TritiumNode::ACTION::PONG)
+            ++nPongs;
+
+        nPos += 8 + nLength;
+    }
+    vBuffer.erase(vBuffer.begin(), vBuffer.begin() + nPos);
+
+    return nPongs;
+}
+
+
+TEST_CASE( "Tritium Server Benchmarks", "[LLP]")
+{
+    debug::log(0, "===== Begin Tritium Server Benchmarks =====");
+
+    /* Create a tritium server listening on our loopback only. */
+    const uint16_t nPort = static_cast<uint16_t>(config::GetArg("-benchport", 18888));
+
+    LLP::Config CONFIG     = LLP::Config(nPort);
+    CONFIG.ENABLE_LISTEN   = true;
+    CONFIG.ENABLE_UPNP     = false;
+    CONFIG.ENABLE_METERS   = false;
+    CONFIG.ENABLE_DDOS     = false;
+    CONFIG.ENABLE_MANAGER  = false;
+    CONFIG.ENABLE_SSL      = false;
+    CONFIG.ENABLE_REMOTE   = false;
+    CONFIG.REQUIRE_SSL     = false;
+    CONFIG.PORT_SSL        = 0;
+    CONFIG.MAX_INCOMING    = 8;
+    CONFIG.MAX_CONNECTIONS = 8;
+    CONFIG.MAX_THREADS     = 1;
+    CONFIG.SOCKET_TIMEOUT  = 30;
+
+    LLP::TRITIUM_SERVER = new LLP::Server<LLP::TritiumNode>(CONFIG);
+
+    /* Connect our raw client to the server. */
+    const LLP::BaseAddress addr = LLP::BaseAddress("127.0.0.1", nPort);
+
+    LLP::Socket socket;
+    REQUIRE(socket.Attempt(addr));
+
+    /* Send our version message with a session that isn't our own. */
+    uint64_t nSession = LLC::GetRand();
+    while(nSession == 0 || nSession == LLP::SESSION_ID)
+        nSession = LLC::GetRand();
+
+    {
+        DataStream ssVersion(SER_NETWORK, LLP::PROTOCOL_VERSION);
+        ssVersion << LLP::PROTOCOL_VERSION << nSession << std::string("benchmark") << addr;
+
+        write_message(socket, LLP::TritiumNode::ACTION::VERSION, ssVersion);
+    }
+
+    /* Send our pings with a window of outstanding messages, counting the pongs that come back. */
+    const uint32_t nMessages = 100000;
+    const uint32_t nWindow   = 256;
+    {
+        std::vector<uint8_t> vBuffer;
+
+        uint32_t nSent = 0;
+        uint32_t nReceived = 0;
+
+        runtime::timer timer;
+        timer.Start();
+        while(nReceived < nMessages)
+        {
+            /* Fill up our window. */
+            while(nSent < nMessages && nSent - nReceived < nWindow)
+            {
+                DataStream ssPing(SER_NETWORK, LLP::PROTOCOL_VERSION);
+                ssPing << uint64_t(nSent++);
+
+                write_message(socket, LLP::TritiumNode::ACTION::PING, ssPing);
+            }
+
+            /* Check that our server is still responding. */
+            const uint32_t nPongs = read_pongs(socket, vBuffer);
+            if(nPongs == 0)
+            {
+                REQUIRE(socket.Errors() == false);
+                REQUIRE(timer.ElapsedMilliseconds() < 60000);
+
+                runtime::sleep(0);
+            }
+
+            nReceived += nPongs;
+        }
+
+        /* Each ping and pong are a header and an eight byte nonce. */
+        bench::Report("LLP::TritiumNode::PingPong", nMessages, timer.ElapsedMicroseconds(), uint64_t(nMessages) * 32);
+    }
+
+    /* Close our connection, our server stays up until shutdown the same as in our unit tests. */
+    socket.Close();
+
+    debug::log(0, "===== End Tritium Server Benchmarks =====\n");
+}
@@ -0,0 +1,294 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+
+#include <LLD/include/global.h>
+#include <LLD/include/version.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/signatures.h>
+#include <TAO/Ledger/types/credentials.h>
+#include <TAO/Ledger/types/state.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <TAO/Operation/include/enum.h>
+#include <TAO/Operation/types/stream.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/address.h>
+#include <TAO/Register/types/object.h>
+
+#include <Util/include/args.h>
+#include <Util/include/config.h>
+#include <Util/include/debug.h>
+#include <Util/include/filesystem.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <fstream>
+
+/* The version of our fixture files, bump this if the workload changes. */
+const uint32_t FIXTURE_VERSION = 1;
+
+
+/* Get the secret for a sigchain at a given sequence, so that our chains can be generated the same way every time. */
+uint512_t replay_secret(const uint32_t nChain, const uint32_t nSequence)
+{
+    DataStream ssSecret(SER_LLD, LLD::DATABASE_VERSION);
+    ssSecret << std::string("replay") << nChain << nSequence;
+
+    return LLC::SK512(ssSecret.Bytes());
+}
+
+
+/* Get the address of a register on a sigchain, so that our registers are the same every time. */
+TAO::Register::Address replay_address(const uint256_t& hashGenesis, const std::string& strName, const uint8_t nType)
+{
+    DataStream ssAddress(SER_LLD, LLD::DATABASE_VERSION);
+    ssAddress << hashGenesis << strName;
+
+    uint256_t hashAddress = LLC::SK256(ssAddress.Bytes());
+    hashAddress.SetType(nType);
+
+    return TAO::Register::Address(hashAddress);
+}
+
+
+/* Delete and create our databases again, so that our replay always starts from an empty ledger. */
+void replay_reset()
+{
+    delete LLD::Contract;
+    delete LLD::Register;
+    delete LLD::Local;
+    delete LLD::Ledger;
+    delete LLD::Trust;
+    delete LLD::Legacy;
+
+    const std::string strPath = config::GetDataDir();
+    if(filesystem::exists(strPath))
+        REQUIRE(filesystem::remove_directories(strPath));
+
+    /* Create our instances the same as our benchmark main. */
+    LLD::Contract = new LLD::ContractDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+    LLD::Register = new LLD::RegisterDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+    LLD::Local    = new LLD::LocalDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+    LLD::Ledger   = new LLD::LedgerDB(
+        LLD::FLAGS::CREATE | LLD::FLAGS::WRITE,
+        256 * 256 * 16,
+        4 * 1024 * 1024);
+
+    LLD::Trust    = new LLD::TrustDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+    LLD::Legacy   = new LLD::LegacyDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+}
+
+
+/* Connect a block of transactions in one database transaction, the same as a block being accepted. */
+bool replay_block(const std::vector<TAO::Ledger::Transaction>& vtx, const uint32_t nBlock, const bool fSignatures = true)
+{
+    /* Verify our signatures in parallel the same as our block checks. */
+    if(fSignatures && !TAO::Ledger::VerifySignatures(vtx))
+        return false;
+
+    /* Our block state only needs a unique hash for our indexes. */
+    TAO::Ledger::BlockState state;
+    state.nHeight = nBlock + 1;
+    state.nTime   = vtx.empty() ? 0 : vtx[0].nTimestamp;
+
+    const uint1024_t hashBlock = state.GetHash();
+
+    LLD::TxnBegin();
+    for(const auto& tx : vtx)
+    {
+        const uint512_t hashTx = tx.GetHash();
+        if(!tx.Verify() || !tx.Connect(TAO::Ledger::FLAGS::BLOCK)
+        || !LLD::Ledger->WriteTx(hashTx, tx) || !LLD::Ledger->IndexBlock(hashTx, hashBlock))
+        {
+            LLD::TxnAbort();
+            return false;
+        }
+
+        state.vtx.push_back(std::make_pair(TAO::Ledger::TRANSACTION::TRITIUM, hashTx));
+    }
+
+    /* Write our block state so our transaction indexes have something to point to. */
+    if(!LLD::Ledger->WriteBlock(hashBlock, state))
+    {
+        LLD::TxnAbort();
+        return false;
+    }
+    LLD::TxnCommit();
+
+    return true;
+}
+
+
+/* Generate our chain of blocks, where each block has one transaction from every sigchain.
+ * The first transaction of each sigchain creates an account and an object, every other one writes to the object. */
+std::vector<std::vector<TAO::Ledger::Transaction>> replay_generate(const uint32_t nChains, const uint32_t nBlocks)
+{
+    using namespace TAO::Operation;
+
+    const uint64_t nTimestamp = runtime::unifiedtimestamp() - nBlocks;
+
+    std::vector<uint256_t> vGenesis(nChains);
+    std::vector<uint512_t> vPrevTx(nChains);
+
+    std::vector<std::vector<TAO::Ledger::Transaction>> vBlocks(nBlocks);
+    for(uint32_t nBlock = 0; nBlock < nBlocks; ++nBlock)
+    {
+        for(uint32_t nChain = 0; nChain < nChains; ++nChain)
+        {
+            /* Get our genesis for this chain. */
+            if(nBlock == 0)
+                vGenesis[nChain] = TAO::Ledger::Credentials::Genesis(SecureString(("replay" + debug::safe_printstr(nChain)).c_str()));
+
+            const uint256_t& hashGenesis = vGenesis[nChain];
+            const TAO::Register::Address hashObject = replay_address(hashGenesis, "replay", TAO::Register::Address::OBJECT);
+
+            TAO::Ledger::Transaction tx;
+            tx.hashGenesis = hashGenesis;
+            tx.nSequence   = nBlock;
+            tx.hashPrevTx  = vPrevTx[nChain];
+            tx.nTimestamp  = nTimestamp + nBlock;
+            tx.nKeyType    = TAO::Ledger::SIGNATURE::BRAINPOOL;
+            tx.nNextType   = TAO::Ledger::SIGNATURE::BRAINPOOL;
+            tx.NextHash(replay_secret(nChain, nBlock + 1));
+
+            /* Create our registers on the first transaction. */
+            if(nBlock == 0)
+            {
+                const TAO::Register::Address hashAccount =
+                    replay_address(hashGenesis, "default", TAO::Register::Address::ACCOUNT);
+
+                TAO::Register::Object object;
+                object << std::string("counter") << uint8_t(TAO::Register::TYPES::MUTABLE) << uint8_t(TAO::Register::TYPES::UINT64_T) << uint64_t(0)
+                       << std::string("data")    << uint8_t(TAO::Register::TYPES::MUTABLE) << uint8_t(TAO::Register::TYPES::BYTES)    << std::vector<uint8_t>(64, 0);
+
+                tx[0] << uint8_t(OP::CREATE) << hashAccount << uint8_t(TAO::Register::REGISTER::OBJECT) << TAO::Register::CreateAccount(0).GetState();
+                tx[1] << uint8_t(OP::CREATE) << hashObject  << uint8_t(TAO::Register::REGISTER::OBJECT) << object.GetState();
+            }
+
+            /* Otherwise write to our object. */
+            else
+            {
+                Stream stream;
+                stream << std::string("counter") << uint8_t(OP::TYPES::UINT64_T) << uint64_t(nBlock)
+                       << std::string("data")    << uint8_t(OP::TYPES::BYTES)    << std::vector<uint8_t>(64, uint8_t(nBlock));
+
+                tx[0] << uint8_t(OP::WRITE) << hashObject << stream.Bytes();
+            }
+
+            REQUIRE(tx.Build());
+            REQUIRE(tx.Sign(replay_secret(nChain, nBlock)));
+
+            vPrevTx[nChain] = tx.GetHash();
+            vBlocks[nBlock].push_back(tx);
+        }
+
+        /* Connect our block, since the next block is built from these states. Signatures aren't verified here so that
+         * our replay doesn't find them in the signature cache. */
+        REQUIRE(replay_block(vBlocks[nBlock], nBlock, false));
+    }
+
+    return vBlocks;
+}
+
+
+TEST_CASE( "Block Replay Benchmarks", "[ledger]")
+{
+    debug::log(0, "===== Begin Block Replay Benchmarks =====");
+
+    /* Our workload, which can be changed to replay larger chains. */
+    const uint32_t nChains = static_cast<uint32_t>(config::GetArg("-benchchains", 16));
+    const uint32_t nBlocks = static_cast<uint32_t>(config::GetArg("-benchblocks", 64));
+
+    /* Fees are a policy of the network, so we disable them here the same as hybrid networks. */
+    const bool fHybrid = config::fHybrid.load();
+    config::fHybrid.store(true);
+
+    /* Our fixtures live outside of our data directory so that they aren't removed between runs. */
+    const std::string strFixtures = config::GetArg("-benchfixtures", config::GetDataDir(false) + "fixtures/");
+    const std::string strFile     = strFixtures + "replay_" + debug::safe_printstr(nChains, "x", nBlocks) + ".dat";
+
+    /* Load our fixture if it exists. */
+    std::vector<std::vector<TAO::Ledger::Transaction>> vBlocks;
+    if(filesystem::exists(strFile))
+    {
+        std::ifstream stream(strFile, std::ios::in | std::ios::binary);
+        std::vector<uint8_t> vData((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        uint32_t nVersion = 0;
+
+        DataStream ssFixture(vData, SER_LLD, LLD::DATABASE_VERSION);
+        ssFixture >> nVersion;
+
+        if(nVersion == FIXTURE_VERSION)
+            ssFixture >> vBlocks;
+    }
+
+    /* Otherwise generate our chain and write it to our fixtures for the next run. */
+    if(vBlocks.empty())
+    {
+        debug::log(0, "Generating replay fixture ", strFile);
+
+        replay_reset();
+        vBlocks = replay_generate(nChains, nBlocks);
+
+        DataStream ssFixture(SER_LLD, LLD::DATABASE_VERSION);
+        ssFixture << FIXTURE_VERSION << vBlocks;
+
+        REQUIRE(filesystem::create_directories(strFixtures));
+
+        std::ofstream stream(strFile, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write((char*)ssFixture.data(), ssFixture.size());
+        REQUIRE(stream.good());
+    }
+
+    /* Replay our chain into an empty ledger. */
+    replay_reset();
+    {
+        uint64_t nTransactions = 0;
+
+        runtime::timer timer;
+        timer.Start();
+        for(uint32_t nBlock = 0; nBlock < vBlocks.size(); ++nBlock)
+        {
+            REQUIRE(replay_block(vBlocks[nBlock], nBlock));
+            nTransactions += vBlocks[nBlock].size();
+        }
+
+        const uint64_t nTime = timer.ElapsedMicroseconds();
+        bench::Report("TAO::Ledger::Replay::Blocks", vBlocks.size(), nTime);
+        bench::Report("TAO::Ledger::Replay::Transactions", nTransactions, nTime);
+    }
+
+    /* Check our last states were replayed. */
+    for(uint32_t nChain = 0; nChain < nChains; ++nChain)
+    {
+        const uint256_t hashGenesis = vBlocks[0][nChain].hashGenesis;
+
+        TAO::Register::Object object;
+        REQUIRE(LLD::Register->ReadObject(replay_address(hashGenesis, "replay", TAO::Register::Address::OBJECT), object));
+        REQUIRE(object.get<uint64_t>("counter") == uint64_t(vBlocks.size() - 1));
+    }
+
+    config::fHybrid.store(fHybrid);
+
+    debug::log(0, "===== End Block Replay Benchmarks =====\n");
+}
@@ -66,7 +66,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -91,7 +91,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -117,7 +117,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -143,7 +143,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -169,7 +169,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -195,7 +195,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -221,7 +221,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -247,7 +247,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
@@ -274,7 +274,7 @@ TEST_CASE( "Validation Script Benchmarks", "[operation]")
             for(int i = 0; i < 1000000; i++)
             {
                 REQUIRE(script.Execute());
-                script.Reset();
+                script.reset();
             }
         }
 
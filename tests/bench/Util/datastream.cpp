@@ -0,0 +1,150 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+#include <LLC/types/uint1024.h>
+
+#include <LLD/include/version.h>
+
+#include <LLP/include/version.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <bench/include/report.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+TEST_CASE( "DataStream Benchmarks", "[Util]")
+{
+    debug::log(0, "===== Begin DataStream Benchmarks =====");
+
+    /* Keys the same as our ledger database uses for transactions. */
+    const uint32_t nKeys = 1000000;
+    const uint512_t hashTx = LLC::GetRand512();
+
+    uint64_t nKeyBytes = 0;
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(uint32_t n = 0; n < nKeys; ++n)
+        {
+            DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+            ssKey << std::make_pair(std::string("tx"), hashTx + n);
+
+            nKeyBytes += ssKey.size();
+        }
+
+        bench::Report("Util::DataStream::WriteKey", nKeys, timer.ElapsedMicroseconds(), nKeyBytes);
+    }
+
+    {
+        DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+        ssKey << std::make_pair(std::string("tx"), hashTx);
+
+        runtime::timer timer;
+        timer.Start();
+
+        std::pair<std::string, uint512_t> pairKey;
+        for(uint32_t n = 0; n < nKeys; ++n)
+        {
+            ssKey.Reset();
+            ssKey >> pairKey;
+        }
+
+        bench::Report("Util::DataStream::ReadKey", nKeys, timer.ElapsedMicroseconds(), ssKey.size() * nKeys);
+        REQUIRE(pairKey.second == hashTx);
+    }
+
+    /* Lists of hashes the same as our indexes and inventory messages. */
+    std::vector<uint256_t> vHashes(1000);
+    for(auto& hash : vHashes)
+        hash = LLC::GetRand256();
+
+    const uint32_t nLists = 10000;
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        uint64_t nBytes = 0;
+        for(uint32_t n = 0; n < nLists; ++n)
+        {
+            DataStream ssData(SER_NETWORK, LLP::PROTOCOL_VERSION);
+            ssData << vHashes;
+
+            nBytes += ssData.size();
+        }
+
+        bench::Report("Util::DataStream::WriteHashes", nLists, timer.ElapsedMicroseconds(), nBytes);
+    }
+
+    {
+        DataStream ssData(SER_NETWORK, LLP::PROTOCOL_VERSION);
+        ssData << vHashes;
+
+        runtime::timer timer;
+        timer.Start();
+
+        std::vector<uint256_t> vRead;
+        for(uint32_t n = 0; n < nLists; ++n)
+        {
+            ssData.Reset();
+            ssData >> vRead;
+        }
+
+        bench::Report("Util::DataStream::ReadHashes", nLists, timer.ElapsedMicroseconds(), ssData.size() * nLists);
+        REQUIRE(vRead == vHashes);
+    }
+
+    /* Large blobs the same as our block and sector records. */
+    const std::vector<uint8_t> vBlob(1024 * 1024, 0xaa);
+    const uint32_t nBlobs = 1000;
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        uint64_t nBytes = 0;
+        for(uint32_t n = 0; n < nBlobs; ++n)
+        {
+            DataStream ssData(SER_LLD, LLD::DATABASE_VERSION);
+            ssData << vBlob;
+
+            nBytes += ssData.size();
+        }
+
+        bench::Report("Util::DataStream::WriteBlob", nBlobs, timer.ElapsedMicroseconds(), nBytes);
+    }
+
+    {
+        DataStream ssData(SER_LLD, LLD::DATABASE_VERSION);
+        ssData << vBlob;
+
+        runtime::timer timer;
+        timer.Start();
+
+        std::vector<uint8_t> vRead;
+        for(uint32_t n = 0; n < nBlobs; ++n)
+        {
+            ssData.Reset();
+            ssData >> vRead;
+        }
+
+        bench::Report("Util::DataStream::ReadBlob", nBlobs, timer.ElapsedMicroseconds(), ssData.size() * nBlobs);
+        REQUIRE(vRead == vBlob);
+    }
+
+    debug::log(0, "===== End DataStream Benchmarks =====\n");
+}
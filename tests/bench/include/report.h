@@ -0,0 +1,47 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/* Benchmark helpers shared between our benchmark suites. */
+namespace bench
+{
+
+    /** Report
+     *
+     *  Log a benchmark result, and append it as one line of json to our results file so that runs can be
+     *  compared against each other. Results are written to -benchresults, or benchmarks.json in the base
+     *  data directory if not set, since our network data directory is removed at the start of every run.
+     *
+     *  @param[in] strName The name of the benchmark, as Module::Target::Case.
+     *  @param[in] nOps The number of operations that were timed.
+     *  @param[in] nMicroseconds The total time of all operations.
+     *  @param[in] nBytes The total bytes processed by all operations, or zero if not applicable.
+     *
+     **/
+    void Report(const std::string& strName, const uint64_t nOps, const uint64_t nMicroseconds, const uint64_t nBytes = 0);
+
+
+    /** Results
+     *
+     *  Get the path of the file our results are appended to.
+     *
+     *  @return The path of our results file.
+     *
+     **/
+    std::string Results();
+
+}
@@ -0,0 +1,80 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <bench/include/report.h>
+
+#include <Util/include/args.h>
+#include <Util/include/config.h>
+#include <Util/include/debug.h>
+#include <Util/include/json.h>
+#include <Util/include/mutex.h>
+#include <Util/include/runtime.h>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+
+namespace bench
+{
+    /* Mutex to keep our result lines from interleaving. */
+    std::mutex REPORT_MUTEX;
+
+
+    /* Log a benchmark result, and append it as one line of json to our results file. */
+    void Report(const std::string& strName, const uint64_t nOps, const uint64_t nMicroseconds, const uint64_t nBytes)
+    {
+        /* Very fast cases can finish under our timer's resolution. */
+        const uint64_t nTime = std::max(nMicroseconds, uint64_t(1));
+
+        /* Build our result. */
+        encoding::json jResult =
+        {
+            {"name",         strName},
+            {"ops",          nOps},
+            {"microseconds", nTime},
+            {"opspersecond", (nOps * 1000000.0) / nTime},
+            {"nanosperop",   nOps > 0 ? (nTime * 1000.0) / nOps : 0.0},
+            {"timestamp",    runtime::unifiedtimestamp()}
+        };
+
+        /* Add our throughput if we processed any data. */
+        if(nBytes > 0)
+        {
+            jResult["bytes"]          = nBytes;
+            jResult["bytespersecond"] = (nBytes * 1000000.0) / nTime;
+        }
+
+        /* Log our human readable result. */
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, strName, ANSI_COLOR_RESET, " ", nOps, " ops in ", nTime, " us (",
+            jResult["opspersecond"].get<double>(), " ops / second)");
+
+        LOCK(REPORT_MUTEX);
+
+        /* Append our result to the results file. */
+        std::ofstream stream(Results(), std::ios::out | std::ios::app);
+        if(!stream.is_open())
+        {
+            debug::error(FUNCTION, "failed to open results file ", Results());
+            return;
+        }
+
+        stream << jResult.dump() << std::endl;
+    }
+
+
+    /* Get the path of the file our results are appended to. */
+    std::string Results()
+    {
+        return config::GetArg("-benchresults", config::GetDataDir(false) + "benchmarks.json");
+    }
+}
@@ -287,3 +287,46 @@ TEST_CASE( "Argon2 Hashing Tests", "[LLC]")
     REQUIRE(ret == ARGON2_SALT_TOO_SHORT);
     printf("Fail on salt too short: PASS\n");
 }
+
+
+TEST_CASE( "Argon2 Core Tests", "[LLC]")
+{
+    const argon2_type types[] = { Argon2_d, Argon2_i, Argon2_id };
+    const uint32_t versions[] = { ARGON2_VERSION_10, ARGON2_VERSION_13 };
+    const uint32_t lanes[]    = { 1, 2, 4 };
+
+    /* Every core we dispatch to must give the same output as the reference core. */
+    for(const argon2_type type : types)
+    {
+        for(const uint32_t version : versions)
+        {
+            for(const uint32_t p : lanes)
+            {
+                for(uint32_t t = 1; t <= 3; ++t)
+                {
+                    unsigned char ref[64];
+                    REQUIRE(argon2_select_core(ARGON2_CORE_REF) == 1);
+                    REQUIRE(argon2_hash(t, 1 << 10, p, "password", strlen("password"), "somesalt", strlen("somesalt"),
+                                        ref, sizeof(ref), NULL, 0, type, version) == ARGON2_OK);
+
+                    const argon2_core cores[] = { ARGON2_CORE_SSE2, ARGON2_CORE_AVX2, ARGON2_CORE_AUTO };
+                    for(const argon2_core core : cores)
+                    {
+                        /* Skip over cores that this build or cpu doesn't have. */
+                        if(!argon2_select_core(core))
+                            continue;
+
+                        unsigned char out[64];
+                        REQUIRE(argon2_hash(t, 1 << 10, p, "password", strlen("password"), "somesalt", strlen("somesalt"),
+                                            out, sizeof(out), NULL, 0, type, version) == ARGON2_OK);
+
+                        REQUIRE(memcmp(out, ref, sizeof(out)) == 0);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Put back our default core. */
+    REQUIRE(argon2_select_core(ARGON2_CORE_AUTO) == 1);
+}
@@ -14,6 +14,7 @@ ________________________________________________________________________________
 #include <LLC/types/uint1024.h>
 #include <LLC/types/bignum.h>
 #include <LLC/include/random.h>
+#include <LLC/include/montgomery.h>
 #include <LLC/prime/fermat.h>
 #include <openssl/bn.h>
 #include <unit/catch2/catch.hpp>
@@ -82,3 +83,35 @@ TEST_CASE("Fermat Tests", "[LLC]")
 
 
 }
+
+
+TEST_CASE("Montgomery Fermat Tests", "[LLC]")
+{
+    std::vector<uint1024_t> vTests;
+    for(uint32_t i = 0; i < 1000; ++i)
+    {
+        uint1024_t bn1 = LLC::GetRand1024();
+
+        /* Cover both full width numbers and shorter ones. */
+        if(i % 2 == 0)
+            bn1 |= (uint1024_t(1) << 1023);
+        else
+            bn1 >>= (i % 1000);
+
+        bn1 |= 1; //make odd
+        if(bn1 == 1)
+            bn1 = 3;
+
+        REQUIRE(LLC::FermatTest(bn1).GetHex() == FermatTest2(LLC::CBigNum(bn1)).getuint1024().GetHex());
+
+        vTests.push_back(bn1);
+    }
+
+    /* Batch results should match the single tests. */
+    std::vector<uint1024_t> vRemainders;
+    LLC::FermatTest(vTests, vRemainders);
+
+    REQUIRE(vRemainders.size() == vTests.size());
+    for(uint32_t i = 0; i < vTests.size(); ++i)
+        REQUIRE(vRemainders[i] == LLC::FermatTest(vTests[i]));
+}
@@ -0,0 +1,117 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/macro.h>
+#include <LLC/hash/SK.h>
+#include <LLC/hash/SK/KeccakF-1600-interface.h>
+#include <LLC/include/random.h>
+
+#include <TAO/Ledger/types/block.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <cstring>
+
+/* Fill a message with random bytes. */
+std::vector<uint8_t> random_message(const uint32_t nSize)
+{
+    std::vector<uint8_t> vData(nSize, 0);
+    for(uint32_t n = 0; n < nSize; n += 8)
+    {
+        const uint64_t nRand = LLC::GetRand();
+        std::memcpy(&vData[n], &nRand, std::min(uint32_t(8), nSize - n));
+    }
+
+    return vData;
+}
+
+
+/* Fold a merkle root level by level with the scalar SK512, the same way as our merkle trees were built before batching. */
+uint512_t scalar_merkle(std::vector<uint512_t> vLevel)
+{
+    while(vLevel.size() > 1)
+    {
+        std::vector<uint512_t> vNext;
+        for(uint32_t i = 0; i < vLevel.size(); i += 2)
+        {
+            const uint512_t& hashLeft  = vLevel[i];
+            const uint512_t& hashRight = vLevel[std::min(i + 1, uint32_t(vLevel.size() - 1))];
+
+            vNext.push_back(LLC::SK512(BEGIN(hashLeft), END(hashLeft), BEGIN(hashRight), END(hashRight)));
+        }
+
+        vLevel.swap(vNext);
+    }
+
+    return vLevel.empty() ? 0 : vLevel[0];
+}
+
+
+/* Check our batch hashes against our scalar hashes for the permutation that is currently in use. */
+void check_batches()
+{
+    const std::vector<uint32_t> vCounts = { 1, 3, 4, 5, 9 };
+    for(const uint32_t nCount : vCounts)
+    {
+        /* Batches of equal length messages the size of our merkle leaf pairs. */
+        {
+            std::vector<uint8_t> vData;
+            std::vector<std::vector<uint8_t>> vMessages;
+            for(uint32_t n = 0; n < nCount; ++n)
+            {
+                vMessages.push_back(random_message(128));
+                vData.insert(vData.end(), vMessages.back().begin(), vMessages.back().end());
+            }
+
+            const std::vector<uint512_t> vEqual = LLC::SK512(vData, 128);
+
+            REQUIRE(vEqual.size() == nCount);
+            for(uint32_t n = 0; n < nCount; ++n)
+                REQUIRE(vEqual[n] == LLC::SK512(vMessages[n].begin(), vMessages[n].end()));
+        }
+
+        /* Merkle roots over the same number of leaves. */
+        {
+            std::vector<uint512_t> vLeaves;
+            std::vector<std::pair<uint8_t, uint512_t>> vPairs;
+            for(uint32_t n = 0; n < nCount; ++n)
+            {
+                vLeaves.push_back(LLC::GetRand512());
+                vPairs.push_back(std::make_pair(uint8_t(0), vLeaves.back()));
+            }
+
+            const uint512_t hashRoot = scalar_merkle(vLeaves);
+
+            TAO::Ledger::Block block;
+            REQUIRE(block.BuildMerkleTree(vLeaves) == hashRoot);
+            REQUIRE(block.BuildMerkleTree(vPairs)  == hashRoot);
+        }
+    }
+}
+
+
+TEST_CASE( "SK512 Batch Tests", "[LLC]")
+{
+    //check the generic permutation
+    REQUIRE_FALSE(KeccakF1600_StatePermute4_SetAVX2(false));
+    check_batches();
+
+    //check the AVX2 permutation when this processor supports it
+    if(KeccakF1600_StatePermute4_SetAVX2(true))
+        check_batches();
+    else
+        WARN("AVX2 not supported, only the generic permutation was checked");
+
+    //an empty batch has no hashes
+    REQUIRE(LLC::SK512(std::vector<uint8_t>(), 128).empty());
+}
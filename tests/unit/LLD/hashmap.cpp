@@ -0,0 +1,181 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/keychain/hashmap.h>
+#include <LLD/templates/key.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/filesystem.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <iomanip>
+#include <set>
+
+/* Hashmap with a handful of buckets, so that every bucket is spread over many hashmap files. */
+class HashmapTestDB : public LLD::BinaryHashMap
+{
+public:
+
+    HashmapTestDB(const std::string& strPath)
+    : BinaryHashMap(strPath, LLD::FLAGS::CREATE | LLD::FLAGS::FORCE, 64)
+    {
+    }
+
+
+    /* Get the number of hashmap files a key's bucket reaches. */
+    uint32_t Files(const std::vector<uint8_t>& vKey)
+    {
+        return hashmap[GetBucket(vKey)];
+    }
+
+
+    /* Get the number of hashmap files our fingerprints can't rule out for a key, which is the number of disk reads for a lookup. */
+    uint32_t Candidates(const std::vector<uint8_t>& vKey)
+    {
+        std::vector<uint8_t> vCompressed = vKey;
+        CompressKey(vCompressed, HASHMAP_MAX_KEY_SIZE);
+
+        const uint32_t nBucket = GetBucket(vKey);
+        const uint8_t nFingerprint = GetFingerprint(&vCompressed[0], vCompressed.size());
+
+        uint32_t nCandidates = 0;
+        for(uint16_t nFile = 0; nFile < hashmap[nBucket]; ++nFile)
+            if(!Filtered(nFile, nBucket, nFingerprint))
+                ++nCandidates;
+
+        return nCandidates;
+    }
+};
+
+
+/* Build a fixed length test key, using long keys for every third key so that compressed keys are covered. */
+std::vector<uint8_t> hashmap_key(const std::string& strPrefix, const uint32_t n)
+{
+    std::string strKey = debug::safe_printstr(strPrefix, std::setfill('0'), std::setw(8), n);
+    if(n % 3 == 0)
+        strKey += std::string(48, 'x');
+
+    return std::vector<uint8_t>(strKey.begin(), strKey.end());
+}
+
+
+/* Check that present keys are always found and missing keys never are, returning the fingerprint false positives. */
+uint32_t hashmap_check(HashmapTestDB* pDB, const std::set<uint32_t>& setErased, uint32_t& nMissingFiles)
+{
+    //every present key is found at its location, and every erased key is gone
+    for(uint32_t n = 0; n < 1000; ++n)
+    {
+        const std::vector<uint8_t> vKey = hashmap_key("present.", n);
+
+        LLD::SectorKey cKey;
+        if(setErased.count(n))
+        {
+            REQUIRE_FALSE(pDB->Get(vKey, cKey));
+            continue;
+        }
+
+        REQUIRE(pDB->Get(vKey, cKey));
+        REQUIRE(cKey.nSectorStart == n);
+        REQUIRE(pDB->Candidates(vKey) >= 1);
+    }
+
+    //keys that were never written are never found, and only cost a disk read on a fingerprint collision
+    uint32_t nFalsePositives = 0;
+    for(uint32_t n = 0; n < 1000; ++n)
+    {
+        const std::vector<uint8_t> vKey = hashmap_key("missing.", n);
+
+        LLD::SectorKey cKey;
+        REQUIRE_FALSE(pDB->Get(vKey, cKey));
+
+        nFalsePositives += pDB->Candidates(vKey);
+        nMissingFiles   += pDB->Files(vKey);
+    }
+
+    return nFalsePositives;
+}
+
+
+TEST_CASE( "Hashmap Fingerprint Tests", "[LLD]")
+{
+    //start from an empty keychain
+    const std::string strPath = config::GetDataDir() + "_HASHMAPTEST/";
+    if(filesystem::exists(strPath))
+        REQUIRE(filesystem::remove_directories(strPath));
+
+    HashmapTestDB* pDB = new HashmapTestDB(strPath);
+
+    //write enough keys that each bucket spans many hashmap files
+    for(uint32_t n = 0; n < 1000; ++n)
+        REQUIRE(pDB->Put(LLD::SectorKey(LLD::STATE::READY, hashmap_key("present.", n), 0, n, 10)));
+
+    std::set<uint32_t> setErased;
+    {
+        uint32_t nFiles = 0;
+        const uint32_t nFalsePositives = hashmap_check(pDB, setErased, nFiles);
+
+        //our fingerprints rule out nearly every file for a missing key, collisions are 1 in 255
+        REQUIRE(nFiles > 10000);
+        REQUIRE(nFalsePositives * 50 < nFiles);
+    }
+
+    //erasing keys clears their fingerprints without hiding the keys that remain
+    for(uint32_t n = 0; n < 1000; n += 7)
+    {
+        REQUIRE(pDB->Erase(hashmap_key("present.", n)));
+        setErased.insert(n);
+    }
+
+    {
+        uint32_t nFiles = 0;
+        const uint32_t nFalsePositives = hashmap_check(pDB, setErased, nFiles);
+        REQUIRE(nFalsePositives * 50 < nFiles);
+    }
+
+    //our fingerprints are rebuilt from disk when the keychain is reopened
+    delete pDB;
+    pDB = new HashmapTestDB(strPath);
+
+    {
+        uint32_t nFiles = 0;
+        const uint32_t nFalsePositives = hashmap_check(pDB, setErased, nFiles);
+        REQUIRE(nFalsePositives * 50 < nFiles);
+    }
+
+    //erased keys can be written again after a reopen
+    for(const uint32_t n : setErased)
+        REQUIRE(pDB->Put(LLD::SectorKey(LLD::STATE::READY, hashmap_key("present.", n), 0, n, 10)));
+
+    setErased.clear();
+    {
+        uint32_t nFiles = 0;
+        hashmap_check(pDB, setErased, nFiles);
+    }
+
+    delete pDB;
+
+    //without our fingerprints every file is read, and lookups give the same results
+    config::mapArgs["-lldfilter"] = "0";
+    pDB = new HashmapTestDB(strPath);
+    config::mapArgs.erase("-lldfilter");
+
+    {
+        uint32_t nFiles = 0;
+        const uint32_t nFalsePositives = hashmap_check(pDB, setErased, nFiles);
+        REQUIRE(nFalsePositives == nFiles);
+    }
+
+    delete pDB;
+}
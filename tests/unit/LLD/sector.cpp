@@ -0,0 +1,399 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/templates/sector.h>
+#include <LLD/cache/binary_lru.h>
+#include <LLD/keychain/hashmap.h>
+
+#include <Util/include/args.h>
+#include <Util/include/filesystem.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+/* Sector database that can move to a new sector file without filling the current one. */
+class SectorTestDB : public LLD::SectorDatabase<LLD::BinaryHashMap, LLD::BinaryLRU>
+{
+public:
+
+    SectorTestDB(const std::string& strName = "_SECTORTEST", const uint8_t nFlags = LLD::FLAGS::CREATE | LLD::FLAGS::FORCE)
+    : SectorDatabase(strName, nFlags, 256 * 256, 1024 * 1024)
+    {
+    }
+
+
+    /* Mark our current sector file as full, so our next append starts a new one. */
+    void NextFile()
+    {
+        nCurrentFileSize = LLD::MAX_SECTOR_FILE_SIZE + 1;
+    }
+
+
+    /* Get the sector file we are appending to. */
+    uint32_t CurrentFile() const
+    {
+        return nCurrentFile;
+    }
+
+
+    /* Get the size of a sector file on disk. */
+    int64_t FileSize(const uint32_t nFile) const
+    {
+        return filesystem::size(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile));
+    }
+
+
+    /* Get the bytes of a sector file that are memory mapped. */
+    uint64_t MappedSize(const uint32_t nFile)
+    {
+        std::shared_lock<std::shared_mutex> lock(MAPPING_MUTEX);
+
+        const auto it = mapMemory.find(nFile);
+        if(it == mapMemory.end())
+            return 0;
+
+        return it->second->Size();
+    }
+
+
+    /* Turn memory mapped reads on or off. */
+    void SetMemoryMap(const bool fEnabled)
+    {
+        fMemoryMap = fEnabled;
+    }
+
+
+    /* Drop a record from our cache so that it is read from disk. */
+    template<typename KeyType>
+    void Uncache(const KeyType& key)
+    {
+        DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+        ssKey << key;
+
+        cachePool->Remove(ssKey.Bytes());
+    }
+};
+
+
+/* Build a record of the given size filled with a single byte. */
+std::vector<uint8_t> sector_record(const uint32_t nSize, const uint8_t nByte)
+{
+    return std::vector<uint8_t>(nSize, nByte);
+}
+
+
+/* Read a record from disk rather than from our cache. */
+std::vector<uint8_t> sector_disk_read(SectorTestDB* pDB, const uint32_t n)
+{
+    pDB->Uncache(std::make_pair(std::string("record"), n));
+
+    std::vector<uint8_t> vRecord;
+    REQUIRE(pDB->Read(std::make_pair(std::string("record"), n), vRecord));
+
+    return vRecord;
+}
+
+
+/* Check every record and key that our commits wrote. */
+void check_sector(SectorTestDB* pDB)
+{
+    //records updated in place and records that grew
+    for(uint32_t n = 0; n < 30; ++n)
+    {
+        std::vector<uint8_t> vRecord;
+        REQUIRE(pDB->Read(std::make_pair(std::string("record"), n), vRecord));
+
+        if(n % 10 == 0)
+            REQUIRE(vRecord == sector_record(80, n + 100));
+        else
+            REQUIRE(vRecord == sector_record(40, n + 100));
+    }
+
+    //keychain only entries
+    for(uint32_t n = 0; n < 5; ++n)
+        REQUIRE(pDB->Exists(std::make_pair(std::string("keychain"), n)));
+
+    //an index to a keychain only entry from the same transaction
+    REQUIRE(pDB->Exists(std::string("alias.keychain")));
+
+    //an index to a record updated in the same transaction
+    std::vector<uint8_t> vRecord;
+    REQUIRE(pDB->Read(std::string("alias.record"), vRecord));
+    REQUIRE(vRecord == sector_record(40, 107));
+}
+
+
+TEST_CASE( "Sector Commit Tests", "[LLD]")
+{
+    //start from an empty database
+    const std::string strPath = config::GetDataDir() + "_SECTORTEST";
+    if(filesystem::exists(strPath))
+        REQUIRE(filesystem::remove_directories(strPath));
+
+    SectorTestDB* pDB = new SectorTestDB();
+
+    //write our records into three sector files, one transaction each
+    for(uint32_t nFile = 0; nFile < 3; ++nFile)
+    {
+        pDB->TxnBegin();
+        for(uint32_t n = nFile * 10; n < nFile * 10 + 10; ++n)
+            REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(40, n)));
+
+        REQUIRE(pDB->TxnCommit());
+        REQUIRE(pDB->CurrentFile() == nFile);
+
+        pDB->NextFile();
+    }
+
+    //track our file sizes to check that same size updates are written in place
+    std::vector<int64_t> vSizes;
+    for(uint32_t nFile = 0; nFile < 3; ++nFile)
+        vSizes.push_back(pDB->FileSize(nFile));
+
+    //update every record in one transaction, growing the first record of each file
+    pDB->TxnBegin();
+    for(uint32_t n = 0; n < 30; ++n)
+    {
+        if(n % 10 == 0)
+            REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(80, n + 100)));
+        else
+            REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(40, n + 100)));
+    }
+
+    //add keychain only entries and indexes in the same transaction
+    for(uint32_t n = 0; n < 5; ++n)
+        REQUIRE(pDB->Write(std::make_pair(std::string("keychain"), n)));
+
+    REQUIRE(pDB->Index(std::string("alias.keychain"), std::make_pair(std::string("keychain"), uint32_t(3))));
+    REQUIRE(pDB->Index(std::string("alias.record"), std::make_pair(std::string("record"), uint32_t(7))));
+
+    REQUIRE(pDB->TxnCommit());
+
+    //same size updates didn't grow our files, and grown records were appended to a new file
+    for(uint32_t nFile = 0; nFile < 3; ++nFile)
+        REQUIRE(pDB->FileSize(nFile) == vSizes[nFile]);
+
+    REQUIRE(pDB->CurrentFile() == 3);
+
+    //check our records before and after re-opening the database
+    check_sector(pDB);
+
+    delete pDB;
+    pDB = new SectorTestDB();
+
+    REQUIRE(pDB->CurrentFile() == 3);
+    check_sector(pDB);
+
+    delete pDB;
+}
+
+
+TEST_CASE( "Sector Memory Map Tests", "[LLD]")
+{
+    //our platform must be able to map sector files
+    REQUIRE(LLD::MemoryMapSupported());
+
+    //start from an empty database with memory mapped reads
+    const std::string strPath = config::GetDataDir() + "_SECTORMMAP";
+    if(filesystem::exists(strPath))
+        REQUIRE(filesystem::remove_directories(strPath));
+
+    config::mapArgs["-lldmmap"] = "1";
+    SectorTestDB* pDB = new SectorTestDB("_SECTORMMAP");
+    config::mapArgs.erase("-lldmmap");
+
+    //files that are empty or missing can't be mapped
+    {
+        LLD::MemoryMap mapEmpty(strPath + "/datachain/_block.00000");
+        REQUIRE_FALSE(mapEmpty.IsMapped());
+
+        LLD::MemoryMap mapMissing(strPath + "/datachain/_block.99999");
+        REQUIRE_FALSE(mapMissing.IsMapped());
+    }
+
+    //reading our first records maps the file as it is now
+    for(uint32_t n = 0; n < 10; ++n)
+        REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(40, n)));
+
+    for(uint32_t n = 0; n < 10; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(40, n));
+
+    const uint64_t nMapped = pDB->MappedSize(0);
+    REQUIRE(nMapped == uint64_t(pDB->FileSize(0)));
+
+    //records appended past our mapping remap the file once it has grown
+    for(uint32_t n = 10; n < 20; ++n)
+        REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(40, n)));
+
+    REQUIRE(pDB->MappedSize(0) == nMapped);
+    for(uint32_t n = 10; n < 20; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(40, n));
+
+    REQUIRE(pDB->MappedSize(0) > nMapped);
+    REQUIRE(pDB->MappedSize(0) == uint64_t(pDB->FileSize(0)));
+
+    //records before the remap are still read correctly
+    for(uint32_t n = 0; n < 10; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(40, n));
+
+    //in place updates are visible through our existing mapping
+    const uint64_t nRemapped = pDB->MappedSize(0);
+    REQUIRE(pDB->Write(std::make_pair(std::string("record"), uint32_t(3)), sector_record(40, 203)));
+    REQUIRE(sector_disk_read(pDB, 3) == sector_record(40, 203));
+    REQUIRE(pDB->MappedSize(0) == nRemapped);
+
+    //records in a new sector file get their own mapping
+    pDB->NextFile();
+    REQUIRE(pDB->Write(std::make_pair(std::string("record"), uint32_t(20)), sector_record(40, 20)));
+    REQUIRE(sector_disk_read(pDB, 20) == sector_record(40, 20));
+    REQUIRE(pDB->MappedSize(1) == uint64_t(pDB->FileSize(1)));
+
+    //reads fall back to our file streams and give the same records
+    pDB->SetMemoryMap(false);
+    for(uint32_t n = 0; n < 21; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(40, n == 3 ? 203 : n));
+
+    //records appended while falling back are read by the mapping once it is turned back on
+    REQUIRE(pDB->Write(std::make_pair(std::string("record"), uint32_t(21)), sector_record(40, 21)));
+    pDB->SetMemoryMap(true);
+
+    REQUIRE(sector_disk_read(pDB, 21) == sector_record(40, 21));
+    REQUIRE(pDB->MappedSize(1) == uint64_t(pDB->FileSize(1)));
+
+    delete pDB;
+}
+
+
+/* Check every record and index that our compaction test wrote. */
+void check_compacted(SectorTestDB* pDB)
+{
+    for(uint32_t n = 0; n < 30; ++n)
+    {
+        if(n < 9 || (n >= 10 && n < 20))
+            REQUIRE(sector_disk_read(pDB, n) == sector_record(80, n + 100));
+        else
+            REQUIRE(sector_disk_read(pDB, n) == sector_record(40, n));
+    }
+
+    //an index shares its record's sector, so both must be relocated together
+    std::vector<uint8_t> vRecord;
+    REQUIRE(pDB->Read(std::string("alias.record"), vRecord));
+    REQUIRE(vRecord == sector_record(40, 9));
+}
+
+
+TEST_CASE( "Sector Compaction Tests", "[LLD]")
+{
+    //start from an empty database whose records can be moved
+    const std::string strPath = config::GetDataDir() + "_SECTORCOMPACT";
+    if(filesystem::exists(strPath))
+        REQUIRE(filesystem::remove_directories(strPath));
+
+    SectorTestDB* pDB = new SectorTestDB("_SECTORCOMPACT", LLD::FLAGS::CREATE | LLD::FLAGS::FORCE | LLD::FLAGS::COMPACT);
+
+    //write our records into three sector files
+    for(uint32_t nFile = 0; nFile < 3; ++nFile)
+    {
+        for(uint32_t n = nFile * 10; n < nFile * 10 + 10; ++n)
+            REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(40, n)));
+
+        pDB->NextFile();
+    }
+
+    //every record in our first file is the same size on disk
+    const int64_t nRecordSize = pDB->FileSize(0) / 10;
+
+    pDB->TxnBegin();
+    REQUIRE(pDB->Index(std::string("alias.record"), std::make_pair(std::string("record"), uint32_t(9))));
+    REQUIRE(pDB->TxnCommit());
+
+    //nothing is sparse enough to compact yet
+    REQUIRE_FALSE(pDB->Compact());
+
+    //grow most of our first file's records and all of our second's, so they are appended to our current file
+    for(uint32_t n = 0; n < 20; ++n)
+    {
+        if(n != 9)
+            REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(80, n + 100)));
+    }
+
+    REQUIRE(pDB->CurrentFile() == 3);
+    check_compacted(pDB);
+
+    //read every key from disk while we compact online
+    std::atomic<bool> fStop(false);
+    std::atomic<uint32_t> nFailed(0);
+    std::atomic<uint32_t> nReads(0);
+    std::thread tReader([&]()
+    {
+        while(!fStop.load() || nReads.load() < 1000)
+        {
+            for(uint32_t n = 0; n < 30; ++n)
+            {
+                pDB->Uncache(std::make_pair(std::string("record"), n));
+
+                std::vector<uint8_t> vRecord;
+                if(!pDB->Read(std::make_pair(std::string("record"), n), vRecord) || vRecord.empty())
+                    ++nFailed;
+
+                ++nReads;
+            }
+        }
+    });
+
+    //our empty second file is released, and our sparse first file is compacted and released
+    const int64_t nAppended = pDB->FileSize(3);
+    REQUIRE(pDB->Compact());
+
+    fStop = true;
+    tReader.join();
+
+    REQUIRE(nFailed.load() == 0);
+
+    REQUIRE(pDB->FileSize(0) == 0);
+    REQUIRE(pDB->FileSize(1) == 0);
+    REQUIRE(pDB->FileSize(2) > 0);
+
+    //our live record was copied once for both of its keys
+    REQUIRE(pDB->FileSize(3) == nAppended + nRecordSize);
+
+    //nothing else is left to compact
+    REQUIRE_FALSE(pDB->Compact());
+    check_compacted(pDB);
+
+    //our relocated keys survive a reopen
+    delete pDB;
+    pDB = new SectorTestDB("_SECTORCOMPACT", LLD::FLAGS::CREATE | LLD::FLAGS::FORCE | LLD::FLAGS::COMPACT);
+
+    check_compacted(pDB);
+
+    //make our third file sparse and compact it offline
+    for(uint32_t n = 20; n < 26; ++n)
+        REQUIRE(pDB->Write(std::make_pair(std::string("record"), n), sector_record(80, n + 100)));
+
+    REQUIRE(pDB->Compact(true));
+    REQUIRE(pDB->FileSize(2) == 0);
+
+    for(uint32_t n = 20; n < 30; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(n < 26 ? 80 : 40, n < 26 ? n + 100 : n));
+
+    delete pDB;
+    pDB = new SectorTestDB("_SECTORCOMPACT", LLD::FLAGS::CREATE | LLD::FLAGS::FORCE | LLD::FLAGS::COMPACT);
+
+    for(uint32_t n = 20; n < 30; ++n)
+        REQUIRE(sector_disk_read(pDB, n) == sector_record(n < 26 ? 80 : 40, n < 26 ? n + 100 : n));
+
+    delete pDB;
+}
@@ -0,0 +1,117 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/templates/data.h>
+#include <LLP/types/apinode.h>
+
+#include <TAO/API/types/workers.h>
+
+#include <Util/include/args.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+
+
+TEST_CASE( "API Node Pipelining Tests", "[LLP]")
+{
+    //our requests don't need to be authorized
+    config::mapArgs["-apiauth"] = "0";
+
+    //start our workers if our tests haven't, with one thread for each queue
+    const bool fWorkers = TAO::API::Workers::Active();
+    if(!fWorkers)
+    {
+        config::mapArgs["-apireadthreads"] = "1";
+        TAO::API::Workers::Initialize();
+    }
+
+    REQUIRE(TAO::API::Workers::Active());
+
+    //hold every read thread so that our first request waits in its queue
+    const int64_t nThreads = std::max(config::GetArg("-apireadthreads", 4), int64_t(1));
+
+    std::atomic<bool> fRelease(false);
+    std::atomic<int64_t> nBlocked(0);
+    for(int64_t n = 0; n < nThreads; ++n)
+    {
+        REQUIRE(TAO::API::Workers::Submit(TAO::API::Workers::CLASS::READ, [&fRelease, &nBlocked]()
+        {
+            ++nBlocked;
+            while(!fRelease.load())
+                runtime::sleep(1);
+        }));
+    }
+
+    while(nBlocked.load() < nThreads)
+        runtime::sleep(1);
+
+    int32_t nSockets[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, nSockets) == 0);
+
+    std::string strResponses;
+    {
+        LLP::DataThread<LLP::APINode> tThread(0, false, 0, 0, 30);
+        tThread.AddConnection(LLP::Socket(nSockets[0], LLP::BaseAddress()), nullptr);
+
+        //a good request that is run by our workers, followed by a malformed one that is answered without running a command
+        const std::string strRequests =
+            "GET /missing/get/info HTTP/1.1\r\nConnection: keep-alive\r\n\r\n"
+            "POST /missing/get/info HTTP/1.1\r\nConnection: keep-alive\r\nContent-Type: application/json\r\n"
+            "Content-Length: 4\r\n\r\n{bad";
+
+        REQUIRE(send(nSockets[1], strRequests.data(), strRequests.size(), 0) == static_cast<int32_t>(strRequests.size()));
+
+        //give our data thread time to parse both requests while our first one is still waiting
+        runtime::sleep(200);
+        fRelease.store(true);
+
+        //read until we have both of our responses
+        std::vector<char> vBuffer(4096);
+        while(true)
+        {
+            const std::string::size_type nFirst = strResponses.find("HTTP/1.1 ");
+            if(nFirst != std::string::npos && strResponses.find("HTTP/1.1 ", nFirst + 1) != std::string::npos)
+                break;
+
+            pollfd tPoll = { nSockets[1], POLLIN, 0 };
+            REQUIRE(poll(&tPoll, 1, 5000) == 1);
+
+            const int32_t nRead = recv(nSockets[1], &vBuffer[0], vBuffer.size(), 0);
+            REQUIRE(nRead > 0);
+
+            strResponses.append(&vBuffer[0], nRead);
+        }
+    }
+
+    close(nSockets[1]);
+
+    //our responses are in the order of our requests, the missing command first and our parse error second
+    const std::string::size_type nFirst  = strResponses.find("HTTP/1.1 ");
+    const std::string::size_type nSecond = strResponses.find("HTTP/1.1 ", nFirst + 1);
+
+    REQUIRE(strResponses.substr(nFirst,  12) == "HTTP/1.1 404");
+    REQUIRE(strResponses.substr(nSecond, 12) == "HTTP/1.1 500");
+
+    //put our workers back how we found them
+    if(!fWorkers)
+    {
+        TAO::API::Workers::Shutdown();
+        config::mapArgs.erase("-apireadthreads");
+    }
+
+    config::mapArgs.erase("-apiauth");
+}
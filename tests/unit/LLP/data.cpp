@@ -0,0 +1,118 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/templates/data.h>
+#include <LLP/types/time.h>
+
+#include <Util/include/args.h>
+#include <Util/include/convert.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+
+
+/* Our time node's messages, which it keeps to itself. */
+const uint8_t TIME_OFFSET = 2;
+const uint8_t GET_OFFSET  = 64;
+
+
+/* Send a burst of packets in one write, returning the milliseconds between our first and last response. */
+uint64_t data_burst(const uint32_t nPackets)
+{
+    //our time node needs no samples to accept connections on testnet
+    const bool fTestNet = config::fTestNet.load();
+    config::fTestNet.store(true);
+
+    int32_t nSockets[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, nSockets) == 0);
+
+    uint64_t nElapsed = 0;
+    {
+        LLP::DataThread<LLP::TimeNode> tThread(0, false, 0, 0, 30);
+        tThread.AddConnection(LLP::Socket(nSockets[0], LLP::BaseAddress()), nullptr);
+
+        //build our requests in one buffer so they arrive in a single read
+        std::vector<uint8_t> vBurst;
+        for(uint32_t n = 0; n < nPackets; ++n)
+        {
+            LLP::Packet tRequest;
+            tRequest.HEADER = GET_OFFSET;
+            tRequest.LENGTH = 4;
+            tRequest.DATA   = convert::uint2bytes(static_cast<uint32_t>(runtime::unifiedtimestamp()));
+
+            const std::vector<uint8_t> vBytes = tRequest.GetBytes();
+            vBurst.insert(vBurst.end(), vBytes.begin(), vBytes.end());
+        }
+
+        REQUIRE(send(nSockets[1], &vBurst[0], vBurst.size(), 0) == static_cast<int32_t>(vBurst.size()));
+
+        //each response is a header, a length, and a four byte offset
+        const uint32_t nExpected = nPackets * 9;
+
+        runtime::timer tElapsed;
+        bool fFirst = false;
+
+        uint32_t nReceived = 0;
+        std::vector<uint8_t> vBuffer(nExpected);
+        while(nReceived < nExpected)
+        {
+            //give up if a response takes much longer than a poll interval
+            pollfd tPoll = { nSockets[1], POLLIN, 0 };
+            REQUIRE(poll(&tPoll, 1, 1000) == 1);
+
+            const int32_t nRead = recv(nSockets[1], &vBuffer[nReceived], nExpected - nReceived, 0);
+            REQUIRE(nRead > 0);
+
+            //start timing from our first response, so that thread startup isn't counted
+            if(!fFirst)
+            {
+                tElapsed.Start();
+                fFirst = true;
+            }
+
+            nReceived += nRead;
+        }
+
+        nElapsed = tElapsed.ElapsedMilliseconds();
+
+        //every response is an offset
+        for(uint32_t n = 0; n < nPackets; ++n)
+            REQUIRE(vBuffer[n * 9] == TIME_OFFSET);
+    }
+
+    close(nSockets[1]);
+    config::fTestNet.store(fTestNet);
+
+    return nElapsed;
+}
+
+
+TEST_CASE( "Data Thread Burst Tests", "[LLP]")
+{
+    //more packets than we process per read, so some are left in our receive buffer with nothing left on the socket
+    const uint32_t nPackets = LLP::MAX_PACKETS_PER_READ + 16;
+
+    //packets left in a receive buffer are processed without waiting out the epoll timeout
+    config::mapArgs["-llpepoll"] = "1";
+    REQUIRE(data_burst(nPackets) < 100);
+
+    //and without waiting out the poll timeout
+    config::mapArgs["-llpepoll"] = "0";
+    REQUIRE(data_burst(nPackets) < 100);
+
+    config::mapArgs.erase("-llpepoll");
+}
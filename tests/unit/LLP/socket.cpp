@@ -0,0 +1,196 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/templates/socket.h>
+
+#include <Util/include/args.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+/* Socket that exposes its send queue, so that we can check where a flush stopped. */
+class SocketTest : public LLP::Socket
+{
+public:
+
+    SocketTest(const int32_t nSocket)
+    : Socket(nSocket, LLP::BaseAddress())
+    {
+    }
+
+
+    /* Get the number of buffers waiting to be sent. */
+    uint64_t Queued()
+    {
+        LOCK(BUFFER_MUTEX);
+        return queueBuffer.size();
+    }
+
+
+    /* Get the bytes already sent from the front buffer. */
+    uint64_t Offset()
+    {
+        LOCK(BUFFER_MUTEX);
+        return nBufferOffset;
+    }
+};
+
+
+/* Build a shared buffer with bytes that follow on from every byte written before it. */
+std::shared_ptr<const std::vector<uint8_t>> socket_buffer(const uint64_t nSize, uint64_t &nStream)
+{
+    std::vector<uint8_t> vBuffer(nSize);
+    for(uint64_t n = 0; n < nSize; ++n)
+        vBuffer[n] = static_cast<uint8_t>((nStream++ * 7) % 251);
+
+    return std::make_shared<const std::vector<uint8_t>>(vBuffer);
+}
+
+
+/* Read everything waiting on a socket, checking that it follows on from every byte read before it. */
+uint64_t socket_drain(const int32_t nSocket, uint64_t &nStream)
+{
+    uint64_t nTotal = 0;
+
+    std::vector<uint8_t> vBuffer(65536);
+    while(true)
+    {
+        const int32_t nRead = recv(nSocket, &vBuffer[0], vBuffer.size(), MSG_DONTWAIT);
+        if(nRead <= 0)
+            break;
+
+        for(int32_t n = 0; n < nRead; ++n)
+            REQUIRE(vBuffer[n] == static_cast<uint8_t>((nStream++ * 7) % 251));
+
+        nTotal += nRead;
+    }
+
+    return nTotal;
+}
+
+
+TEST_CASE( "Socket Flush Tests", "[LLP]")
+{
+    int32_t nSockets[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, nSockets) == 0);
+
+    uint64_t nWritten = 0, nRead = 0;
+    {
+        SocketTest tSocket(nSockets[0]);
+
+        //queued buffers are shared by reference, and nothing is sent until we flush
+        std::vector<std::shared_ptr<const std::vector<uint8_t>>> vBuffers;
+        for(uint32_t n = 0; n < 100; ++n)
+        {
+            vBuffers.push_back(socket_buffer(1, nWritten));
+            REQUIRE(tSocket.Write(vBuffers.back(), false) == 1);
+            REQUIRE(vBuffers.back().use_count() == 2);
+        }
+
+        REQUIRE(tSocket.Queued()   == 100);
+        REQUIRE(tSocket.Buffered() == 100);
+
+        //one flush gathers no more than 64 buffers
+        REQUIRE(tSocket.Flush() == 64);
+        REQUIRE(tSocket.Queued()   == 36);
+        REQUIRE(tSocket.Offset()   == 0);
+        REQUIRE(tSocket.Buffered() == 36);
+
+        //buffers are released once they are sent in full
+        for(uint32_t n = 0; n < 64; ++n)
+            REQUIRE(vBuffers[n].use_count() == 1);
+
+        REQUIRE(tSocket.Flush() == 36);
+        REQUIRE(tSocket.Queued() == 0);
+        REQUIRE(socket_drain(nSockets[1], nRead) == 100);
+
+        //our send size stops a flush in the middle of a buffer, which is where the next flush picks up
+        for(uint32_t n = 0; n < 10; ++n)
+            tSocket.Write(socket_buffer(300, nWritten), false);
+
+        config::mapArgs["-maxsendsize"] = "1000";
+        REQUIRE(tSocket.Flush() == 1000);
+        REQUIRE(tSocket.Queued()   == 7);
+        REQUIRE(tSocket.Offset()   == 100);
+        REQUIRE(tSocket.Buffered() == 2000);
+
+        REQUIRE(tSocket.Flush() == 1000);
+        REQUIRE(tSocket.Queued()   == 4);
+        REQUIRE(tSocket.Offset()   == 200);
+        REQUIRE(tSocket.Buffered() == 1000);
+
+        //our send size is read on every flush
+        config::mapArgs["-maxsendsize"] = "150";
+        REQUIRE(tSocket.Flush() == 150);
+        REQUIRE(tSocket.Queued() == 3);
+        REQUIRE(tSocket.Offset() == 50);
+
+        config::mapArgs.erase("-maxsendsize");
+        REQUIRE(tSocket.Flush() == 850);
+        REQUIRE(tSocket.Queued() == 0);
+        REQUIRE(socket_drain(nSockets[1], nRead) == 3000);
+
+        //a write behind queued data is queued after it rather than sent ahead of it
+        tSocket.Write(socket_buffer(10, nWritten), false);
+        const std::shared_ptr<const std::vector<uint8_t>> pBehind = socket_buffer(10, nWritten);
+        REQUIRE(tSocket.Write(*pBehind, pBehind->size()) == 10);
+        REQUIRE(tSocket.Queued() == 2);
+
+        REQUIRE(tSocket.Flush() == 20);
+        REQUIRE(socket_drain(nSockets[1], nRead) == 20);
+
+        //fill our socket until the peer stops reading, so a send stops partway through our buffer
+        int32_t nSent = 0;
+        while(true)
+        {
+            nSent = tSocket.Write(socket_buffer(4096, nWritten), true);
+            if(nSent == 4096)
+                continue;
+
+            //nothing was sent or queued if the socket was already full
+            if(nSent < 0)
+                nWritten -= 4096;
+
+            break;
+        }
+
+        //a partial send is queued from where it stopped
+        if(nSent > 0)
+            REQUIRE(tSocket.Offset() == static_cast<uint64_t>(nSent));
+
+        for(uint32_t n = 0; n < 40; ++n)
+            tSocket.Write(socket_buffer(1000 + n, nWritten), false);
+
+        REQUIRE(tSocket.Flush() < 0);
+        REQUIRE(tSocket.Buffered() > 40000);
+
+        //reading and flushing until we are done gives back every byte in order
+        while(tSocket.Buffered() > 0)
+        {
+            socket_drain(nSockets[1], nRead);
+            tSocket.Flush();
+        }
+
+        socket_drain(nSockets[1], nRead);
+        REQUIRE(tSocket.Queued() == 0);
+        REQUIRE(tSocket.Offset() == 0);
+    }
+
+    REQUIRE(nRead == nWritten);
+
+    close(nSockets[0]);
+    close(nSockets[1]);
+}
@@ -0,0 +1,87 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/eckey.h>
+#include <LLC/include/random.h>
+
+#include <Legacy/include/enum.h>
+#include <Legacy/include/signature.h>
+
+#include <Legacy/types/script.h>
+#include <Legacy/types/transaction.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE("Legacy Signature Hash Tests", "[legacy]")
+{
+    //build a transaction with many inputs and signatures in place
+    Legacy::Transaction tx;
+    tx.nTime = 1000;
+    for(uint32_t n = 0; n < 8; ++n)
+    {
+        Legacy::TxIn txin(LLC::GetRand512(), n);
+        txin.scriptSig << std::vector<uint8_t>(72, uint8_t(n));
+
+        tx.vin.push_back(txin);
+    }
+
+    for(uint32_t n = 0; n < 3; ++n)
+    {
+        Legacy::TxOut txout;
+        txout.nValue = 1000 * (n + 1);
+        txout.scriptPubKey << Legacy::OP_DUP << std::vector<uint8_t>(33, uint8_t(n)) << Legacy::OP_CHECKSIG;
+
+        tx.vout.push_back(txout);
+    }
+
+    //script code with a codeseparator, which must be removed the same way
+    Legacy::Script scriptCode;
+    scriptCode << std::vector<uint8_t>(33, 0x02) << Legacy::OP_CODESEPARATOR << Legacy::OP_CHECKSIG;
+
+    //check our midstates give the same hash as the full serialization for every input and hash type
+    Legacy::SignatureHasher hasher(tx);
+    const std::vector<int32_t> vHashTypes =
+    {
+        Legacy::SIGHASH_ALL, Legacy::SIGHASH_NONE, Legacy::SIGHASH_SINGLE, Legacy::SIGHASH_ALL | Legacy::SIGHASH_ANYONECANPAY
+    };
+
+    for(const int32_t nHashType : vHashTypes)
+    {
+        for(uint32_t nIn = 0; nIn < tx.vin.size(); ++nIn)
+        {
+            REQUIRE(hasher.Hash(scriptCode, nIn, nHashType) == Legacy::SignatureHash(scriptCode, tx, nIn, nHashType));
+
+            //second call is served from our last hash
+            REQUIRE(hasher.Hash(scriptCode, nIn, nHashType) == Legacy::SignatureHash(scriptCode, tx, nIn, nHashType));
+        }
+    }
+
+    //sign an input and check it through the hasher and the signature cache
+    LLC::ECKey key;
+    key.MakeNewKey(true);
+
+    std::vector<uint8_t> vchSig;
+    REQUIRE(key.Sign(Legacy::SignatureHash(scriptCode, tx, 3, Legacy::SIGHASH_ALL), vchSig, 256));
+    vchSig.push_back(uint8_t(Legacy::SIGHASH_ALL));
+
+    REQUIRE(Legacy::CheckSig(vchSig, key.GetPubKey(), scriptCode, tx, 3, 0, &hasher));
+    REQUIRE(Legacy::CheckSig(vchSig, key.GetPubKey(), scriptCode, tx, 3, 0));
+
+    //the cached signature is only valid for the input it signed
+    REQUIRE_FALSE(Legacy::CheckSig(vchSig, key.GetPubKey(), scriptCode, tx, 4, 0, &hasher));
+
+    //a different signature doesn't hit the cache
+    std::vector<uint8_t> vchBad = vchSig;
+    vchBad[vchBad.size() / 2] ^= 0x01;
+    REQUIRE_FALSE(Legacy::CheckSig(vchBad, key.GetPubKey(), scriptCode, tx, 3, 0, &hasher));
+}
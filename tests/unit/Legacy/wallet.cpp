@@ -0,0 +1,155 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <Legacy/include/create.h>
+#include <Legacy/include/enum.h>
+
+#include <Legacy/types/coinbase.h>
+#include <Legacy/types/reservekey.h>
+#include <Legacy/types/transaction.h>
+#include <Legacy/wallet/wallet.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+
+#include <Util/include/mutex.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <set>
+
+
+/* Get the wallet transactions with unspent outputs by scanning every transaction in the wallet. */
+std::set<uint512_t> wallet_scan(Legacy::Wallet& wallet)
+{
+    std::set<uint512_t> setScan;
+    for(const auto& pairTx : wallet.mapWallet)
+    {
+        const Legacy::WalletTx& wtx = pairTx.second;
+        for(uint32_t n = 0; n < wtx.vout.size(); ++n)
+        {
+            if(!wtx.IsSpent(n) && wtx.vout[n].nValue > 0 && wallet.IsMine(wtx.vout[n]))
+            {
+                setScan.insert(pairTx.first);
+                break;
+            }
+        }
+    }
+
+    return setScan;
+}
+
+
+/* Get the wallet transactions with unspent outputs from our unspent index. */
+std::set<uint512_t> wallet_index(Legacy::Wallet& wallet)
+{
+    const std::vector<uint512_t> vUnspent = wallet.UnspentTransactions();
+    return std::set<uint512_t>(vUnspent.begin(), vUnspent.end());
+}
+
+
+/* Build a coinbase paying to a key from our wallet. */
+Legacy::Transaction wallet_coinbase(Legacy::ReserveKey& rKey, const int64_t nValue)
+{
+    Legacy::Coinbase coinbase;
+
+    Legacy::Transaction tx;
+    REQUIRE(Legacy::CreateCoinbase(rKey, coinbase, 1, 0, 7, tx));
+    tx.vout[0].nValue = nValue;
+
+    //keep our hash unique between tests
+    tx.vin[0].scriptSig << uint32_t(LLC::GetRand(0xffffffff));
+
+    return tx;
+}
+
+
+TEST_CASE("Wallet Unspent Index Tests", "[legacy]")
+{
+    Legacy::Wallet& wallet = Legacy::Wallet::Instance();
+    RECURSIVE(wallet.cs_wallet);
+
+    Legacy::ReserveKey* pReserveKey = new Legacy::ReserveKey(&wallet);
+
+    //coins paid to us are indexed as soon as they are added to our wallet
+    const Legacy::Transaction txFirst  = wallet_coinbase(*pReserveKey, 1000000);
+    const Legacy::Transaction txSecond = wallet_coinbase(*pReserveKey, 2000000);
+
+    REQUIRE(wallet.AddToWalletIfInvolvingMe(txFirst,  TAO::Ledger::ChainState::tStateGenesis, true));
+    REQUIRE(wallet.AddToWalletIfInvolvingMe(txSecond, TAO::Ledger::ChainState::tStateGenesis, true));
+
+    REQUIRE(wallet_index(wallet) == wallet_scan(wallet));
+    REQUIRE(wallet_index(wallet).count(txFirst.GetHash()));
+    REQUIRE(wallet_index(wallet).count(txSecond.GetHash()));
+
+    //spending a coin to someone else drops it from our index, and the spend has nothing of ours to index
+    Legacy::Transaction txSpend;
+    txSpend.nTime = txFirst.nTime + 1;
+    txSpend.vin.push_back(Legacy::TxIn(txFirst.GetHash(), 0));
+    {
+        Legacy::TxOut txout;
+        txout.nValue = 900000;
+        txout.scriptPubKey << Legacy::OP_DUP << std::vector<uint8_t>(33, uint8_t(7)) << Legacy::OP_CHECKSIG;
+
+        txSpend.vout.push_back(txout);
+    }
+
+    REQUIRE(wallet.AddToWalletIfInvolvingMe(txSpend, TAO::Ledger::ChainState::tStateGenesis, true));
+
+    REQUIRE(wallet_index(wallet) == wallet_scan(wallet));
+    REQUIRE_FALSE(wallet_index(wallet).count(txFirst.GetHash()));
+    REQUIRE_FALSE(wallet_index(wallet).count(txSpend.GetHash()));
+
+    //a coinstake spends our second coin and pays us back
+    Legacy::Transaction txStake;
+    txStake.nTime = txSecond.nTime + 1;
+    {
+        //our stake input is flagged by the fibonacci series
+        const std::vector<uint8_t> vFibonacci = { 1, 2, 3, 5, 8, 13, 21, 34 };
+
+        Legacy::TxIn txin;
+        txin.scriptSig.insert(txin.scriptSig.end(), vFibonacci.begin(), vFibonacci.end());
+
+        txStake.vin.push_back(txin);
+        txStake.vin.push_back(Legacy::TxIn(txSecond.GetHash(), 0));
+
+        Legacy::TxOut txout;
+        txout.nValue       = 2100000;
+        txout.scriptPubKey = txSecond.vout[0].scriptPubKey;
+
+        txStake.vout.push_back(txout);
+    }
+
+    REQUIRE(txStake.IsCoinStake());
+    REQUIRE(wallet.AddToWalletIfInvolvingMe(txStake, TAO::Ledger::ChainState::tStateGenesis, true));
+
+    REQUIRE(wallet_index(wallet) == wallet_scan(wallet));
+    REQUIRE_FALSE(wallet_index(wallet).count(txSecond.GetHash()));
+    REQUIRE(wallet_index(wallet).count(txStake.GetHash()));
+
+    //disconnecting our coinstake in a reorganization gives our second coin back
+    wallet.DisableTransaction(txStake);
+
+    REQUIRE(wallet_index(wallet) == wallet_scan(wallet));
+    REQUIRE(wallet_index(wallet).count(txSecond.GetHash()));
+
+    //erasing our coinstake from our wallet drops it from our index
+    REQUIRE(wallet.EraseFromWallet(txStake.GetHash()));
+
+    REQUIRE(wallet_index(wallet) == wallet_scan(wallet));
+    REQUIRE_FALSE(wallet_index(wallet).count(txStake.GetHash()));
+    REQUIRE(wallet_index(wallet).count(txSecond.GetHash()));
+
+    delete pReserveKey;
+}
@@ -0,0 +1,293 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/API/include/constants.h>
+#include <TAO/API/include/extract.h>
+#include <TAO/API/include/get.h>
+#include <TAO/API/types/authentication.h>
+#include <TAO/API/types/commands/profiles.h>
+#include <TAO/API/types/exception.h>
+#include <TAO/API/types/indexing.h>
+#include <TAO/API/types/transaction.h>
+
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/args.h>
+#include <Util/include/encoding.h>
+
+#include <unit/catch2/catch.hpp>
+
+/* Get the error code thrown by extracting a cursor. */
+int32_t cursor_error(const std::string& strCursor)
+{
+    encoding::json jParams;
+    jParams["cursor"] = strCursor;
+
+    try
+    {
+        uint256_t hashKey = 0;
+        uint32_t nSequence = 0;
+        TAO::API::ExtractCursor(jParams, hashKey, nSequence);
+    }
+    catch(const TAO::API::Exception& e)
+    {
+        return e.id;
+    }
+
+    return 0;
+}
+
+
+/* List a sigchain's txids one page at a time by following the cursors in each page. */
+std::vector<std::string> cursor_walk(const encoding::json& jBase, const uint32_t nLimit)
+{
+    std::vector<std::string> vTxids;
+
+    encoding::json jParams = jBase;
+    jParams["cursor"] = "";
+    jParams["limit"]  = nLimit;
+
+    while(true)
+    {
+        const encoding::json jPage =
+            TAO::API::Profiles().Transactions(jParams, false);
+
+        REQUIRE(jPage.size() <= nLimit);
+        for(const auto& jTx : jPage)
+            vTxids.push_back(jTx["txid"].get<std::string>());
+
+        //the last result of our sigchain has no cursor to resume from
+        if(jPage.empty() || jPage.back().find("cursor") == jPage.back().end())
+            break;
+
+        jParams["cursor"] = jPage.back()["cursor"];
+    }
+
+    return vTxids;
+}
+
+
+/* List a sigchain's txids one page at a time by offset. */
+std::vector<std::string> offset_walk(const encoding::json& jBase, const uint32_t nLimit)
+{
+    std::vector<std::string> vTxids;
+
+    encoding::json jParams = jBase;
+    jParams["limit"] = nLimit;
+
+    for(uint32_t nOffset = 0; ; nOffset += nLimit)
+    {
+        jParams["offset"] = nOffset;
+
+        const encoding::json jPage =
+            TAO::API::Profiles().Transactions(jParams, false);
+
+        for(const auto& jTx : jPage)
+            vTxids.push_back(jTx["txid"].get<std::string>());
+
+        if(jPage.size() < nLimit)
+            break;
+    }
+
+    return vTxids;
+}
+
+
+TEST_CASE( "Cursor Tests", "[API/cursor]")
+{
+    using namespace TAO::API;
+
+    //a cursor round trips its key and sequence
+    {
+        const uint256_t hashKey = LLC::GetRand256();
+        const std::string strCursor = GetCursor(hashKey, 4242);
+
+        encoding::json jParams;
+        jParams["cursor"] = strCursor;
+
+        uint256_t hashCheck = 0;
+        uint32_t nSequence = 0;
+        REQUIRE(ExtractCursor(jParams, hashCheck, nSequence));
+        REQUIRE(hashCheck == hashKey);
+        REQUIRE(nSequence == 4242);
+
+        //our cursor leads with its version
+        std::vector<uint8_t> vCursor;
+        REQUIRE(encoding::DecodeBase58Check(strCursor, vCursor));
+        REQUIRE(vCursor.size() == 37);
+        REQUIRE(vCursor[0] == CURSOR_VERSION);
+    }
+
+    //no cursor means cursor paging wasn't requested
+    {
+        encoding::json jParams;
+
+        uint256_t hashKey = 1;
+        uint32_t nSequence = 1;
+        REQUIRE_FALSE(ExtractCursor(jParams, hashKey, nSequence));
+    }
+
+    //an empty cursor starts from our first result
+    {
+        encoding::json jParams;
+        jParams["cursor"] = "";
+
+        uint256_t hashKey = 1;
+        uint32_t nSequence = 1;
+        REQUIRE(ExtractCursor(jParams, hashKey, nSequence));
+        REQUIRE(hashKey == 0);
+        REQUIRE(nSequence == 0);
+    }
+
+    //malformed cursors are invalid parameters
+    REQUIRE(cursor_error("not a cursor") == -57);
+
+    //a cursor with a valid checksum but the wrong length
+    {
+        std::vector<uint8_t> vCursor(36, 0);
+        vCursor[0] = CURSOR_VERSION;
+        REQUIRE(cursor_error(encoding::EncodeBase58Check(vCursor)) == -57);
+    }
+
+    //a cursor from an unknown version
+    {
+        std::vector<uint8_t> vCursor;
+        REQUIRE(encoding::DecodeBase58Check(GetCursor(LLC::GetRand256(), 7), vCursor));
+
+        vCursor[0] = CURSOR_VERSION + 1;
+        REQUIRE(cursor_error(encoding::EncodeBase58Check(vCursor)) == -57);
+    }
+}
+
+
+TEST_CASE( "Sigchain Paging Tests", "[API/cursor]")
+{
+    using namespace TAO::API;
+
+    //our logical database is only created with the API
+    if(!LLD::Logical)
+        LLD::Logical = new LLD::LogicalDB(LLD::FLAGS::CREATE | LLD::FLAGS::FORCE);
+
+    //use low argon2 requirements to speed up our credentials
+    config::SoftSetArg("-argon2", "0");
+    config::SoftSetArg("-argon2_memory", "0");
+
+    //create a session for our sigchain
+    const uint256_t hashSession = LLC::GetRand256();
+    uint256_t hashGenesis = 0;
+    {
+        const std::string strUsername = "paging" + std::to_string(LLC::GetRand());
+
+        Authentication::Session tSession =
+            Authentication::Session(SecureString(strUsername.c_str()), SecureString("password"));
+
+        hashGenesis = tSession.Genesis();
+
+        Authentication::Insert(hashSession, tSession);
+        Authentication::SetReady(hashSession);
+    }
+
+    //build our sigchain, only indexing the first sequences to act as a sigchain indexed before our sequence index
+    std::vector<std::string> vTxids;
+
+    uint512_t hashPrev = 0;
+    for(uint32_t nSequence = 0; nSequence < 13; ++nSequence)
+    {
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = nSequence;
+        tx.hashPrevTx  = hashPrev;
+        tx.nTimestamp  = runtime::unifiedtimestamp() + nSequence;
+
+        const uint512_t hashTx = tx.GetHash();
+        REQUIRE(LLD::Ledger->WriteTx(hashTx, tx));
+        REQUIRE(LLD::Logical->WriteTx(hashTx, TAO::API::Transaction(tx)));
+
+        if(nSequence < 4)
+            REQUIRE(LLD::Logical->WriteSigchainTx(hashGenesis, nSequence, hashTx));
+
+        vTxids.push_back(hashTx.GetHex());
+        hashPrev = hashTx;
+    }
+
+    REQUIRE(LLD::Ledger->WriteLast(hashGenesis, hashPrev));
+    REQUIRE(LLD::Logical->WriteLast(hashGenesis, hashPrev));
+
+    //missing sequences are read from the ledger and indexed as we go
+    {
+        uint512_t hashTx = 0;
+        TAO::Ledger::Transaction tx;
+        REQUIRE(Indexing::ReadSequence(hashGenesis, 7, hashTx, tx));
+        REQUIRE(hashTx.GetHex() == vTxids[7]);
+        REQUIRE(tx.nSequence == 7);
+
+        REQUIRE(LLD::Logical->ReadSigchainTx(hashGenesis, 8, hashTx));
+        REQUIRE(hashTx.GetHex() == vTxids[8]);
+
+        //our next sequence down starts from the one we just indexed
+        REQUIRE(Indexing::ReadSequence(hashGenesis, 6, hashTx, tx));
+        REQUIRE(hashTx.GetHex() == vTxids[6]);
+
+        //sequences past the end of our sigchain don't exist
+        REQUIRE_FALSE(Indexing::ReadSequence(hashGenesis, 13, hashTx, tx));
+    }
+
+    encoding::json jParams;
+    jParams["session"] = hashSession.GetHex();
+
+    //paged walks in both orders return the same txids as our unpaged call
+    for(const std::string strOrder : { "desc", "asc" })
+    {
+        jParams["order"] = strOrder;
+
+        std::vector<std::string> vExpected = vTxids;
+        if(strOrder == "desc")
+            std::reverse(vExpected.begin(), vExpected.end());
+
+        //our unpaged call
+        std::vector<std::string> vUnpaged;
+        for(const auto& jTx : Profiles().Transactions(jParams, false))
+            vUnpaged.push_back(jTx["txid"].get<std::string>());
+
+        REQUIRE(vUnpaged == vExpected);
+
+        //pages that split our sigchain unevenly, evenly, and into single transactions
+        for(const uint32_t nLimit : { 5u, 13u, 1u })
+        {
+            REQUIRE(cursor_walk(jParams, nLimit) == vUnpaged);
+            REQUIRE(offset_walk(jParams, nLimit) == vUnpaged);
+        }
+    }
+
+    //a cursor from another sigchain is an invalid parameter
+    {
+        jParams["order"]  = "desc";
+        jParams["cursor"] = GetCursor(LLC::GetRand256(), 3);
+
+        int32_t nError = 0;
+        try
+        {
+            Profiles().Transactions(jParams, false);
+        }
+        catch(const TAO::API::Exception& e)
+        {
+            nError = e.id;
+        }
+
+        REQUIRE(nError == -57);
+    }
+}
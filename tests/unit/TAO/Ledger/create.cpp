@@ -0,0 +1,166 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/include/random.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/address.h>
+
+#include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/types/credentials.h>
+#include <TAO/Ledger/types/mempool.h>
+#include <TAO/Ledger/types/tritium.h>
+
+#include <Util/include/args.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <algorithm>
+
+
+/* Build a signed transaction with a single contract creating a register. */
+TAO::Ledger::Transaction create_register(const uint256_t& hashGenesis, const uint32_t nSequence, const uint512_t& hashPrevTx,
+                                         const uint256_t& hashAddress, const TAO::Register::Object& object)
+{
+    TAO::Ledger::Transaction tx;
+    tx.hashGenesis = hashGenesis;
+    tx.nSequence   = nSequence;
+    tx.nTimestamp  = runtime::timestamp();
+    tx.nKeyType    = TAO::Ledger::SIGNATURE::BRAINPOOL;
+    tx.nNextType   = TAO::Ledger::SIGNATURE::BRAINPOOL;
+    tx.NextHash(LLC::GetRand512());
+
+    //first transactions carry our hybrid network-id
+    if(nSequence == 0)
+    {
+        const std::string strHybrid = config::GetArg("-hybrid", "");
+        tx.hashPrevTx = LLC::SK512(strHybrid.begin(), strHybrid.end());
+    }
+    else
+        tx.hashPrevTx = hashPrevTx;
+
+    tx[0] << uint8_t(TAO::Operation::OP::CREATE) << hashAddress << uint8_t(TAO::Register::REGISTER::OBJECT) << object.GetState();
+
+    REQUIRE(tx.Build());
+    tx.Sign(LLC::GetRand512());
+
+    return tx;
+}
+
+
+/* Check if a block template contains a transaction. */
+bool template_has(const TAO::Ledger::TritiumBlock& block, const uint512_t& hashTx)
+{
+    return std::find(block.vtx.begin(), block.vtx.end(), std::make_pair(uint8_t(TAO::Ledger::TRANSACTION::TRITIUM), hashTx))
+        != block.vtx.end();
+}
+
+
+TEST_CASE( "Block Template Assembly Tests", "[ledger]")
+{
+    //start from an empty memory pool, so that only our transactions are in our templates
+    std::vector<uint512_t> vExisting;
+    TAO::Ledger::mempool.List(vExisting);
+    for(const auto& hash : vExisting)
+        REQUIRE(TAO::Ledger::mempool.Remove(hash));
+
+    //our account holder's sigchain is listed before our token issuer's, so the account is validated before its token exists
+    uint256_t hashHolder = TAO::Ledger::Credentials::Genesis(std::string("template-holder" + std::to_string(LLC::GetRand())).c_str());
+    uint256_t hashIssuer = TAO::Ledger::Credentials::Genesis(std::string("template-issuer" + std::to_string(LLC::GetRand())).c_str());
+    if(hashIssuer < hashHolder)
+        std::swap(hashHolder, hashIssuer);
+
+    const TAO::Register::Address hashToken   = TAO::Register::Address(TAO::Register::Address::TOKEN);
+    const TAO::Register::Address hashAccount = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+    const TAO::Register::Address hashSecond  = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+
+    const TAO::Ledger::Transaction txAccount =
+        create_register(hashHolder, 0, 0, hashAccount, TAO::Register::CreateAccount(hashToken));
+
+    const TAO::Ledger::Transaction txToken =
+        create_register(hashIssuer, 0, 0, hashToken, TAO::Register::CreateToken(hashToken, 1000, 2));
+
+    const TAO::Ledger::Transaction txSecond =
+        create_register(hashIssuer, 1, txToken.GetHash(), hashSecond, TAO::Register::CreateAccount(hashToken));
+
+    //an account for a token that doesn't exist is left out of our template
+    REQUIRE(TAO::Ledger::mempool.AddUnchecked(txAccount));
+    {
+        TAO::Ledger::TritiumBlock block;
+        TAO::Ledger::AddTransactions(block);
+
+        REQUIRE_FALSE(template_has(block, txAccount.GetHash()));
+    }
+
+    //creating our token changes what our rejected account depends on, so it is validated again in the same template
+    REQUIRE(TAO::Ledger::mempool.AddUnchecked(txToken));
+
+    TAO::Ledger::TritiumBlock blockFirst;
+    TAO::Ledger::AddTransactions(blockFirst);
+
+    REQUIRE(template_has(blockFirst, txToken.GetHash()));
+    REQUIRE(template_has(blockFirst, txAccount.GetHash()));
+
+    //nothing changed, so our next template is the same
+    {
+        TAO::Ledger::TritiumBlock block;
+        TAO::Ledger::AddTransactions(block);
+
+        REQUIRE(block.vtx == blockFirst.vtx);
+    }
+
+    //a new transaction is added after the ones we already accepted, which stay in the same order
+    REQUIRE(TAO::Ledger::mempool.AddUnchecked(txSecond));
+    {
+        TAO::Ledger::TritiumBlock block;
+        TAO::Ledger::AddTransactions(block);
+
+        REQUIRE(block.vtx.size() >= blockFirst.vtx.size());
+        REQUIRE(std::equal(blockFirst.vtx.begin(), blockFirst.vtx.end(), block.vtx.begin()));
+
+        //our issuer's genesis isn't on disk, so its next transaction waits for a later block
+        REQUIRE_FALSE(template_has(block, txSecond.GetHash()));
+    }
+
+    //removing an accepted transaction rebuilds our template, rejecting the account that depended on it
+    REQUIRE(TAO::Ledger::mempool.Remove(txToken.GetHash()));
+    {
+        TAO::Ledger::TritiumBlock block;
+        TAO::Ledger::AddTransactions(block);
+
+        REQUIRE_FALSE(template_has(block, txToken.GetHash()));
+        REQUIRE_FALSE(template_has(block, txAccount.GetHash()));
+        REQUIRE_FALSE(template_has(block, txSecond.GetHash()));
+    }
+
+    //our token coming back accepts our account again
+    REQUIRE(TAO::Ledger::mempool.AddUnchecked(txToken));
+    {
+        TAO::Ledger::TritiumBlock block;
+        TAO::Ledger::AddTransactions(block);
+
+        REQUIRE(template_has(block, txToken.GetHash()));
+        REQUIRE(template_has(block, txAccount.GetHash()));
+    }
+
+    //leave our memory pool empty for the tests after us
+    REQUIRE(TAO::Ledger::mempool.Remove(txAccount.GetHash()));
+    REQUIRE(TAO::Ledger::mempool.Remove(txToken.GetHash()));
+    REQUIRE(TAO::Ledger::mempool.Remove(txSecond.GetHash()));
+}
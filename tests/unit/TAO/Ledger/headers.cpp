@@ -0,0 +1,166 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/include/headers.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <Util/include/args.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+/* Write a block state to disk on top of a previous one, with the minting channel only every fiftieth block. */
+TAO::Ledger::BlockState header_block(const TAO::Ledger::BlockState& statePrev, const uint32_t nSeed)
+{
+    TAO::Ledger::BlockState state;
+    state.nVersion       = 7;
+    state.nHeight        = statePrev.IsNull() ? 0 : statePrev.nHeight + 1;
+    state.hashPrevBlock  = statePrev.IsNull() ? uint1024_t(0) : statePrev.GetHash();
+    state.nChannel       = (state.nHeight % 50 == 0) ? 0 : 1 + ((state.nHeight + nSeed) % 2);
+    state.nBits          = 1000 + state.nHeight;
+    state.nNonce         = nSeed;
+    state.nTime          = 1000 + state.nHeight * 50;
+    state.nChainTrust    = state.nHeight;
+    state.nMoneySupply   = state.nHeight * 10;
+    state.nChannelHeight = state.nHeight;
+
+    REQUIRE(LLD::Ledger->WriteBlock(state.GetHash(), state));
+
+    return state;
+}
+
+
+/* Check that skipping and channel lookups in our index give the same answers as walking back one block at a time on disk. */
+void header_check(const TAO::Ledger::BlockState& stateTip)
+{
+    //walk back to genesis on disk, so we have every ancestor by height
+    std::vector<TAO::Ledger::BlockState> vChain(stateTip.nHeight + 1);
+
+    TAO::Ledger::BlockState state = stateTip;
+    while(true)
+    {
+        vChain[state.nHeight] = state;
+        if(state.nHeight == 0)
+            break;
+
+        REQUIRE(LLD::Ledger->ReadBlock(state.hashPrevBlock, state));
+    }
+
+    const uint1024_t hashTip = stateTip.GetHash();
+    for(uint32_t nHeight = 0; nHeight <= stateTip.nHeight; ++nHeight)
+    {
+        TAO::Ledger::BlockHeader header;
+        REQUIRE(TAO::Ledger::HeaderIndex::GetAncestor(hashTip, nHeight, header));
+        REQUIRE(header.hashBlock == vChain[nHeight].GetHash());
+        REQUIRE(header.nHeight   == nHeight);
+        REQUIRE(header.nChannel  == vChain[nHeight].nChannel);
+        REQUIRE(header.nTime     == vChain[nHeight].nTime);
+    }
+
+    //there are no ancestors above our tip
+    TAO::Ledger::BlockHeader header;
+    REQUIRE_FALSE(TAO::Ledger::HeaderIndex::GetAncestor(hashTip, stateTip.nHeight + 1, header));
+
+    //check our last channel lookups from a spread of starting blocks, including one channel that was never produced
+    for(uint32_t nStart = stateTip.nHeight; nStart > 0; nStart = (nStart > 7 ? nStart - 7 : 0))
+    {
+        const uint1024_t hashStart = vChain[nStart].GetHash();
+        for(uint32_t nChannel = 0; nChannel < 4; ++nChannel)
+        {
+            //walk back on disk
+            uint32_t nFound = nStart;
+            while(nFound > 0 && vChain[nFound].nChannel != nChannel)
+                --nFound;
+
+            TAO::Ledger::BlockHeader header;
+            const bool fFound = TAO::Ledger::HeaderIndex::GetLastHeader(hashStart, nChannel, header);
+
+            REQUIRE(fFound == (nFound > 0));
+            if(fFound)
+                REQUIRE(header.hashBlock == vChain[nFound].GetHash());
+        }
+    }
+}
+
+
+TEST_CASE( "Header Index Tests", "[ledger]")
+{
+    //remember our best chain so we can put our index back when we are done
+    const TAO::Ledger::BlockState stateBest = TAO::Ledger::ChainState::tStateBest.load();
+
+    //write a chain of block states that is deeper than our index
+    std::vector<TAO::Ledger::BlockState> vMain;
+    vMain.push_back(header_block(TAO::Ledger::BlockState(), 1));
+    for(uint32_t n = 0; n < 200; ++n)
+        vMain.push_back(header_block(vMain.back(), 1));
+
+    //load our index from the best chain, keeping only its most recent headers so older ones are read from disk
+    config::mapArgs["-headerdepth"] = "64";
+    TAO::Ledger::ChainState::tStateBest.store(vMain.back());
+    REQUIRE(TAO::Ledger::HeaderIndex::Initialize());
+
+    header_check(vMain.back());
+    header_check(vMain[150]);
+
+    //extend our best chain one block at a time, pruning our oldest headers as we go
+    for(uint32_t n = 0; n < 100; ++n)
+    {
+        vMain.push_back(header_block(vMain.back(), 1));
+
+        TAO::Ledger::HeaderIndex::Insert(vMain.back());
+        TAO::Ledger::HeaderIndex::SetBest(vMain.back().GetHash());
+    }
+
+    header_check(vMain.back());
+    header_check(vMain[260]);
+    header_check(vMain[100]);
+
+    //a fork that isn't our best chain shares its ancestors with our best chain, close enough to our tip to stay in our index
+    std::vector<TAO::Ledger::BlockState> vFork;
+    vFork.push_back(vMain[270]);
+    for(uint32_t n = 0; n < 50; ++n)
+    {
+        vFork.push_back(header_block(vFork.back(), 2));
+        TAO::Ledger::HeaderIndex::Insert(vFork.back());
+    }
+
+    header_check(vFork.back());
+
+    REQUIRE(TAO::Ledger::HeaderIndex::IsInMainChain(vMain[280].GetHash()));
+    REQUIRE_FALSE(TAO::Ledger::HeaderIndex::IsInMainChain(vFork[30].GetHash()));
+
+    //our fork becoming the best chain switches which blocks are in our main chain
+    TAO::Ledger::HeaderIndex::SetBest(vFork.back().GetHash());
+
+    REQUIRE(TAO::Ledger::HeaderIndex::IsInMainChain(vFork[30].GetHash()));
+    REQUIRE(TAO::Ledger::HeaderIndex::IsInMainChain(vMain[270].GetHash()));
+    REQUIRE_FALSE(TAO::Ledger::HeaderIndex::IsInMainChain(vMain[280].GetHash()));
+
+    header_check(vFork.back());
+    header_check(vMain.back());
+
+    //keeping every header gives the same answers without going to disk
+    config::mapArgs["-headerdepth"] = "0";
+    TAO::Ledger::ChainState::tStateBest.store(vFork.back());
+    REQUIRE(TAO::Ledger::HeaderIndex::Initialize());
+
+    header_check(vFork.back());
+
+    //put our index back on our original best chain
+    config::mapArgs.erase("-headerdepth");
+    TAO::Ledger::ChainState::tStateBest.store(stateBest);
+    TAO::Ledger::HeaderIndex::Initialize();
+}
@@ -0,0 +1,196 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/types/metrics.h>
+
+#include <unit/catch2/catch.hpp>
+
+/* Build the metrics of a block with the given activity. */
+TAO::Ledger::Metrics block_metrics(const uint32_t nChannel, const uint64_t nTransactions, const uint64_t nMoved,
+                                   const int64_t nStakeChange, const std::vector<uint256_t>& vAccounts)
+{
+    TAO::Ledger::Metrics tMetrics;
+    tMetrics.AddBlock(nChannel);
+    tMetrics.nTransactions = nTransactions;
+    tMetrics.nContracts    = nTransactions * 2;
+    tMetrics.nDebits       = nTransactions;
+    tMetrics.nMoved        = nMoved;
+    tMetrics.nStakeChange  = nStakeChange;
+
+    for(const auto& hashAccount : vAccounts)
+        tMetrics.AddAccount(hashAccount);
+
+    return tMetrics;
+}
+
+
+TEST_CASE( "Metrics Bucket Tests", "[ledger]")
+{
+    using TAO::Ledger::Metrics;
+
+    //buckets are hourly, starting at the first second of each hour
+    REQUIRE(Metrics::Bucket(0) == 0);
+    REQUIRE(Metrics::Bucket(Metrics::BUCKET_SECONDS - 1) == 0);
+    REQUIRE(Metrics::Bucket(Metrics::BUCKET_SECONDS) == 1);
+    REQUIRE(Metrics::Bucket(Metrics::BUCKET_SECONDS * 2 - 1) == 1);
+    REQUIRE(Metrics::Bucket(Metrics::BUCKET_SECONDS * 2) == 2);
+
+    //a block time maps to the bucket of its hour
+    const uint64_t nTime = 1700000000;
+    REQUIRE(Metrics::Bucket(nTime) == nTime / 3600);
+    REQUIRE(Metrics::Bucket(nTime - (nTime % 3600)) == Metrics::Bucket(nTime));
+    REQUIRE(Metrics::Bucket(nTime - (nTime % 3600) - 1) == Metrics::Bucket(nTime) - 1);
+
+    //channels outside of stake, prime, and hash are ignored
+    Metrics tMetrics;
+    tMetrics.AddBlock(3);
+    REQUIRE(tMetrics.nBlocks[0] + tMetrics.nBlocks[1] + tMetrics.nBlocks[2] == 0);
+}
+
+
+TEST_CASE( "Metrics Arithmetic Tests", "[ledger]")
+{
+    using TAO::Ledger::Metrics;
+
+    std::vector<uint256_t> vAccounts;
+    for(uint32_t n = 0; n < 300; ++n)
+        vAccounts.push_back(LLC::GetRand256());
+
+    //three blocks in the same bucket
+    const Metrics tBlock1 = block_metrics(0, 10, 1000, 50, std::vector<uint256_t>(vAccounts.begin(), vAccounts.begin() + 100));
+    const Metrics tBlock2 = block_metrics(1, 20, 2000, -20, std::vector<uint256_t>(vAccounts.begin() + 100, vAccounts.begin() + 200));
+    const Metrics tBlock3 = block_metrics(2, 30, 3000, 5, std::vector<uint256_t>(vAccounts.begin() + 200, vAccounts.end()));
+
+    Metrics tBucket;
+    tBucket += tBlock1;
+    tBucket += tBlock2;
+    tBucket += tBlock3;
+
+    REQUIRE(tBucket.nBlocks[0] == 1);
+    REQUIRE(tBucket.nBlocks[1] == 1);
+    REQUIRE(tBucket.nBlocks[2] == 1);
+    REQUIRE(tBucket.nTransactions == 60);
+    REQUIRE(tBucket.nContracts == 120);
+    REQUIRE(tBucket.nDebits == 60);
+    REQUIRE(tBucket.nMoved == 6000);
+    REQUIRE(tBucket.nStakeChange == 35);
+
+    //our merged sketch estimates all of the accounts within a few percent
+    const uint64_t nEstimate = tBucket.Accounts();
+    REQUIRE(nEstimate >= 270);
+    REQUIRE(nEstimate <= 330);
+
+    //merging the same accounts again doesn't change the estimate
+    {
+        Metrics tCopy = tBucket;
+        tCopy += tBlock2;
+        REQUIRE(tCopy.Accounts() == nEstimate);
+    }
+
+    //disconnect the second block
+    tBucket -= tBlock2;
+
+    REQUIRE(tBucket.nBlocks[0] == 1);
+    REQUIRE(tBucket.nBlocks[1] == 0);
+    REQUIRE(tBucket.nBlocks[2] == 1);
+    REQUIRE(tBucket.nTransactions == 40);
+    REQUIRE(tBucket.nContracts == 80);
+    REQUIRE(tBucket.nDebits == 40);
+    REQUIRE(tBucket.nMoved == 4000);
+    REQUIRE(tBucket.nStakeChange == 55);
+
+    //accounts can't be removed from our sketch, so they can only be over-estimated after a disconnect
+    REQUIRE(tBucket.Accounts() == nEstimate);
+
+    //subtraction saturates at zero
+    tBucket -= tBlock3;
+    tBucket -= tBlock3;
+
+    REQUIRE(tBucket.nBlocks[2] == 0);
+    REQUIRE(tBucket.nTransactions == 0);
+    REQUIRE(tBucket.nContracts == 0);
+    REQUIRE(tBucket.nMoved == 0);
+
+    //stake change is signed, so it isn't saturated
+    REQUIRE(tBucket.nStakeChange == 45);
+
+    //an empty sketch has no accounts, and merging an empty sketch leaves ours as is
+    Metrics tEmpty;
+    REQUIRE(tEmpty.Accounts() == 0);
+
+    tEmpty += Metrics();
+    REQUIRE(tEmpty.vAccounts.empty());
+
+    Metrics tMerged = tBlock1;
+    tMerged += Metrics();
+    REQUIRE(tMerged.vAccounts == tBlock1.vAccounts);
+}
+
+
+TEST_CASE( "Metrics Database Tests", "[ledger]")
+{
+    using TAO::Ledger::Metrics;
+
+    //connect two blocks in one bucket and one in the next, the same as BlockState::Connect
+    const uint64_t nTime = 1700000000 - (1700000000 % Metrics::BUCKET_SECONDS);
+    const std::vector<std::pair<uint64_t, Metrics>> vBlocks =
+    {
+        { nTime + 10,                          block_metrics(0, 5, 500, 0, { LLC::GetRand256() }) },
+        { nTime + Metrics::BUCKET_SECONDS - 1, block_metrics(1, 7, 700, 0, { LLC::GetRand256() }) },
+        { nTime + Metrics::BUCKET_SECONDS,     block_metrics(2, 9, 900, 0, { LLC::GetRand256() }) }
+    };
+
+    for(const auto& block : vBlocks)
+    {
+        Metrics tBucket;
+        LLD::Ledger->ReadMetrics(Metrics::Bucket(block.first), tBucket);
+
+        tBucket += block.second;
+        REQUIRE(LLD::Ledger->WriteMetrics(Metrics::Bucket(block.first), tBucket));
+    }
+
+    //check each bucket key holds its own blocks
+    Metrics tFirst, tSecond;
+    REQUIRE(LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime), tFirst));
+    REQUIRE(LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime) + 1, tSecond));
+
+    REQUIRE(tFirst.nTransactions == 12);
+    REQUIRE(tFirst.nMoved == 1200);
+    REQUIRE(tFirst.nBlocks[0] == 1);
+    REQUIRE(tFirst.nBlocks[1] == 1);
+    REQUIRE(tSecond.nTransactions == 9);
+    REQUIRE(tSecond.nBlocks[2] == 1);
+
+    //disconnect the second block, the same as BlockState::Disconnect
+    {
+        Metrics tBucket;
+        REQUIRE(LLD::Ledger->ReadMetrics(Metrics::Bucket(vBlocks[1].first), tBucket));
+
+        tBucket -= vBlocks[1].second;
+        REQUIRE(LLD::Ledger->WriteMetrics(Metrics::Bucket(vBlocks[1].first), tBucket));
+    }
+
+    REQUIRE(LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime), tFirst));
+    REQUIRE(tFirst.nTransactions == 5);
+    REQUIRE(tFirst.nMoved == 500);
+    REQUIRE(tFirst.nBlocks[1] == 0);
+    REQUIRE(tFirst.Accounts() == 2);
+
+    //our next bucket is untouched
+    REQUIRE(LLD::Ledger->ReadMetrics(Metrics::Bucket(nTime) + 1, tSecond));
+    REQUIRE(tSecond.nTransactions == 9);
+}
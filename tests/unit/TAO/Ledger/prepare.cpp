@@ -0,0 +1,205 @@
+/*__________________________________________________________________________________________
+
+            Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014]++
+
+            (c) Copyright The Nexus Developers 2014 - 2023
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/global.h>
+
+#include <TAO/Operation/include/enum.h>
+#include <TAO/Operation/include/execute.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/address.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/prepare.h>
+#include <TAO/Ledger/include/signatures.h>
+#include <TAO/Ledger/types/genesis.h>
+#include <TAO/Ledger/types/transaction.h>
+
+#include <Util/include/args.h>
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+/* Create a token on disk with its full supply in its balance, and an account to debit it to, returning its owner. */
+uint256_t prepare_token(const TAO::Register::Address& hashToken, const TAO::Register::Address& hashAccount)
+{
+    const uint256_t hashGenesis = TAO::Ledger::Genesis(LLC::GetRand256(), true);
+
+    TAO::Ledger::Transaction tx;
+    tx.hashGenesis = hashGenesis;
+    tx.nSequence   = 0;
+    tx.nTimestamp  = runtime::timestamp();
+
+    tx[0] << uint8_t(TAO::Operation::OP::CREATE) << hashToken << uint8_t(TAO::Register::REGISTER::OBJECT)
+          << TAO::Register::CreateToken(hashToken, 1000, 0).GetState();
+
+    tx[1] << uint8_t(TAO::Operation::OP::CREATE) << hashAccount << uint8_t(TAO::Register::REGISTER::OBJECT)
+          << TAO::Register::CreateAccount(hashToken).GetState();
+
+    REQUIRE(tx.Build());
+    for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+        REQUIRE(TAO::Operation::Execute(tx[nContract], TAO::Ledger::FLAGS::BLOCK));
+
+    return hashGenesis;
+}
+
+
+/* Write a debit from a token to disk, built against the token's current state. */
+std::pair<uint8_t, uint512_t> prepare_debit(const uint256_t& hashGenesis, const uint32_t nSequence,
+                                            const TAO::Register::Address& hashToken, const TAO::Register::Address& hashAccount,
+                                            const uint64_t nAmount)
+{
+    TAO::Ledger::Transaction tx;
+    tx.hashGenesis = hashGenesis;
+    tx.nSequence   = nSequence;
+    tx.nTimestamp  = runtime::timestamp();
+
+    tx[0] << uint8_t(TAO::Operation::OP::DEBIT) << hashToken << hashAccount << nAmount << uint64_t(0);
+
+    REQUIRE(tx.Build());
+    REQUIRE(LLD::Ledger->WriteTx(tx.GetHash(), tx));
+
+    return std::make_pair(uint8_t(TAO::Ledger::TRANSACTION::TRITIUM), tx.GetHash());
+}
+
+
+/* Write a debit that is built against the token's state after an earlier debit, leaving the token's state on disk as it was. */
+std::pair<uint8_t, uint512_t> prepare_chained(const uint256_t& hashGenesis, const uint32_t nSequence,
+                                              const TAO::Register::Address& hashToken, const TAO::Register::Address& hashAccount,
+                                              const uint512_t& hashPrev, const uint64_t nAmount)
+{
+    TAO::Register::State state;
+    REQUIRE(LLD::Register->ReadState(hashToken, state));
+
+    //run our earlier debit so that our new one is built on top of it
+    TAO::Ledger::Transaction txPrev;
+    REQUIRE(LLD::Ledger->ReadTx(hashPrev, txPrev));
+
+    txPrev[0].Bind(&txPrev, true);
+    REQUIRE(TAO::Operation::Execute(txPrev[0], TAO::Ledger::FLAGS::BLOCK));
+
+    const std::pair<uint8_t, uint512_t> pairDebit = prepare_debit(hashGenesis, nSequence, hashToken, hashAccount, nAmount);
+
+    //put our token back how our block will find it
+    REQUIRE(LLD::Register->WriteState(hashToken, state));
+
+    return pairDebit;
+}
+
+
+/* Build a block with two debits of the same balance, two debits in sequence, and a debit that conflicts with nothing. */
+std::vector<std::pair<uint8_t, uint512_t>> prepare_block()
+{
+    const TAO::Register::Address hashSpent   = TAO::Register::Address(TAO::Register::Address::TOKEN);
+    const TAO::Register::Address hashChained = TAO::Register::Address(TAO::Register::Address::TOKEN);
+    const TAO::Register::Address hashAlone   = TAO::Register::Address(TAO::Register::Address::TOKEN);
+
+    const TAO::Register::Address hashSpentTo   = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+    const TAO::Register::Address hashChainedTo = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+    const TAO::Register::Address hashAloneTo   = TAO::Register::Address(TAO::Register::Address::ACCOUNT);
+
+    const uint256_t hashSpentOwner   = prepare_token(hashSpent,   hashSpentTo);
+    const uint256_t hashChainedOwner = prepare_token(hashChained, hashChainedTo);
+    const uint256_t hashAloneOwner   = prepare_token(hashAlone,   hashAloneTo);
+
+    std::vector<std::pair<uint8_t, uint512_t>> vtx;
+    vtx.push_back(prepare_debit(hashAloneOwner,     1, hashAlone,   hashAloneTo,   100));
+    vtx.push_back(prepare_debit(hashChainedOwner,   1, hashChained, hashChainedTo, 100));
+    vtx.push_back(prepare_chained(hashChainedOwner, 2, hashChained, hashChainedTo, vtx.back().second, 200));
+    vtx.push_back(prepare_debit(hashSpentOwner,     1, hashSpent,   hashSpentTo,   600));
+    vtx.push_back(prepare_debit(hashSpentOwner,     2, hashSpent,   hashSpentTo,   600));
+
+    return vtx;
+}
+
+
+/* Verify and execute a block's transactions in order, skipping the verifications that were prepared, until one fails. */
+std::vector<uint8_t> prepare_connect(const std::vector<std::pair<uint8_t, uint512_t>>& vtx, const bool fPrepare,
+                                     std::vector<TAO::Ledger::PreparedTx> &vPrepared)
+{
+    vPrepared.clear();
+    if(fPrepare)
+        TAO::Ledger::PrepareConnect(vtx, vPrepared);
+
+    std::vector<uint8_t> vValid;
+    for(uint32_t n = 0; n < vtx.size(); ++n)
+    {
+        TAO::Ledger::Transaction tx;
+        REQUIRE(LLD::Ledger->ReadTx(vtx[n].second, tx));
+
+        //a prepared verification stands in for verifying against the states of the transactions before it
+        bool fValid = (fPrepare && vPrepared[n].fVerified) || tx.Verify(TAO::Ledger::FLAGS::BLOCK);
+        for(uint32_t nContract = 0; fValid && nContract < tx.Size(); ++nContract)
+        {
+            tx[nContract].Bind(&tx, true);
+            fValid = TAO::Operation::Execute(tx[nContract], TAO::Ledger::FLAGS::BLOCK);
+        }
+
+        vValid.push_back(fValid ? 1 : 0);
+        if(!fValid)
+            break;
+    }
+
+    return vValid;
+}
+
+
+TEST_CASE( "Prepare Connect Tests", "[ledger]")
+{
+    config::mapArgs["-verifythreads"] = "4";
+    TAO::Ledger::SignatureVerifier::Initialize();
+
+    //connect our block in order, verifying every transaction after the ones before it
+    std::vector<TAO::Ledger::PreparedTx> vPrepared;
+    const std::vector<uint8_t> vSequential = prepare_connect(prepare_block(), false, vPrepared);
+
+    //only our second debit of the same balance is rejected
+    REQUIRE(vSequential == std::vector<uint8_t>({ 1, 1, 1, 1, 0 }));
+
+    //preparing the same block on our verification threads gives the same results
+    const std::vector<std::pair<uint8_t, uint512_t>> vtx = prepare_block();
+    REQUIRE(prepare_connect(vtx, true, vPrepared) == vSequential);
+
+    //every transaction was read, and only our first debit on each balance was verified ahead of time
+    REQUIRE(vPrepared.size() == vtx.size());
+    for(const auto& tPrepared : vPrepared)
+        REQUIRE(tPrepared.fRead);
+
+    REQUIRE(vPrepared[0].fVerified);
+    REQUIRE(vPrepared[1].fVerified);
+
+    //a debit built on an earlier one in the block fails against our last block, so nothing after it is trusted
+    REQUIRE_FALSE(vPrepared[2].fVerified);
+    REQUIRE_FALSE(vPrepared[3].fVerified);
+    REQUIRE_FALSE(vPrepared[4].fVerified);
+
+    //two debits of the same balance both verify against our last block, but our conflict pass leaves the second for connect
+    std::vector<std::pair<uint8_t, uint512_t>> vSpent = prepare_block();
+    vSpent.erase(vSpent.begin() + 1, vSpent.begin() + 3);
+
+    std::vector<TAO::Ledger::PreparedTx> vSpentPrepared;
+    TAO::Ledger::PrepareConnect(vSpent, vSpentPrepared);
+
+    REQUIRE(vSpentPrepared[0].fVerified);
+    REQUIRE(vSpentPrepared[1].fVerified);
+    REQUIRE_FALSE(vSpentPrepared[2].fVerified);
+
+    REQUIRE(prepare_connect(vSpent, true, vPrepared) == std::vector<uint8_t>({ 1, 1, 0 }));
+
+    TAO::Ledger::SignatureVerifier::Shutdown();
+    config::mapArgs.erase("-verifythreads");
+}
@@ -11,8 +11,15 @@
 
 ____________________________________________________________________________________________*/
 
+#include <LLC/include/random.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/include/signatures.h>
 #include <TAO/Ledger/types/transaction.h>
 
+#include <Util/include/args.h>
+#include <Util/include/runtime.h>
+
 #include <unit/catch2/catch.hpp>
 
 //test greater than operator
@@ -39,3 +46,49 @@ TEST_CASE( "Transaction::operator<", "[ledger]" )
     REQUIRE(tx1 < tx2);
     REQUIRE_FALSE(tx2 < tx1);
 }
+
+
+//test batch signature verification and the signature cache
+TEST_CASE( "Transaction::VerifySignature", "[ledger]" )
+{
+    //use a pool of threads for the batch
+    config::mapArgs["-verifythreads"] = "2";
+    TAO::Ledger::SignatureVerifier::Initialize();
+
+    std::vector<TAO::Ledger::Transaction> vtx;
+    for(uint32_t n = 0; n < 8; ++n)
+    {
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = LLC::GetRand256();
+        tx.nSequence   = n;
+        tx.nTimestamp  = runtime::timestamp();
+        tx.nKeyType    = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.nNextType   = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.NextHash(LLC::GetRand512());
+
+        REQUIRE(tx.Sign(LLC::GetRand512()));
+        REQUIRE_FALSE(TAO::Ledger::SignatureCache::Has(tx));
+
+        vtx.push_back(tx);
+    }
+
+    //all signatures are valid and now cached
+    REQUIRE(TAO::Ledger::VerifySignatures(vtx));
+    for(const auto& tx : vtx)
+        REQUIRE(TAO::Ledger::SignatureCache::Has(tx));
+
+    //a different signature for the same txid is not a cache hit
+    vtx[5].vchSig[vtx[5].vchSig.size() / 2] ^= 0xff;
+    REQUIRE_FALSE(TAO::Ledger::SignatureCache::Has(vtx[5]));
+    REQUIRE_FALSE(vtx[5].VerifySignature());
+    REQUIRE_FALSE(TAO::Ledger::VerifySignatures(vtx));
+
+    //every index of a batch is run exactly once across the pool
+    std::vector<std::atomic<uint32_t>> vRuns(1000);
+    TAO::Ledger::SignatureVerifier::Instance().Run(vRuns.size(), [&](const uint32_t n) { ++vRuns[n]; });
+    for(const auto& nRuns : vRuns)
+        REQUIRE(nRuns.load() == 1);
+
+    TAO::Ledger::SignatureVerifier::Shutdown();
+    config::mapArgs.erase("-verifythreads");
+}
@@ -261,4 +261,58 @@ TEST_CASE( "Object Register Tests", "[register]")
         //check
         REQUIRE(vRead == vBytes);
     }
+
+
+    //layouts are shared between objects with the same schema
+    {
+        Object object1;
+        object1 << std::string("name") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::STRING) << std::string("first")
+                << std::string("balance") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::UINT64_T) << uint64_t(55)
+                << std::string("token") << uint8_t(TYPES::UINT256_T) << uint256_t(0);
+
+        Object object2;
+        object2 << std::string("name") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::STRING) << std::string("other")
+                << std::string("balance") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::UINT64_T) << uint64_t(77)
+                << std::string("token") << uint8_t(TYPES::UINT256_T) << uint256_t(1);
+
+        //a longer string moves the fields after it, so can't share a layout
+        Object object3;
+        object3 << std::string("name") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::STRING) << std::string("longer name")
+                << std::string("balance") << uint8_t(TYPES::MUTABLE) << uint8_t(TYPES::UINT64_T) << uint64_t(99)
+                << std::string("token") << uint8_t(TYPES::UINT256_T) << uint256_t(2);
+
+        REQUIRE(object1.Parse());
+        REQUIRE(object2.Parse());
+        REQUIRE(object3.Parse());
+
+        //check our layouts
+        REQUIRE(object1.pLayout == object2.pLayout);
+        REQUIRE(object1.pLayout != object3.pLayout);
+
+        //check our values are read through the shared layout
+        REQUIRE(object1.get<uint64_t>("balance") == 55);
+        REQUIRE(object2.get<uint64_t>("balance") == 77);
+        REQUIRE(object3.get<uint64_t>("balance") == 99);
+        REQUIRE(object3.get<std::string>("name") == "longer name");
+
+        //check our members are sorted
+        REQUIRE(object3.Members() == std::vector<std::string>({"balance", "name", "token"}));
+
+        //check our mutable flags
+        REQUIRE(object2.Mutable("balance"));
+        REQUIRE_FALSE(object2.Mutable("token"));
+        REQUIRE_FALSE(object2.Mutable("missing"));
+
+        //writes to one object don't change another with the same layout
+        REQUIRE(object2.Write("balance", uint64_t(88)));
+        REQUIRE(object1.get<uint64_t>("balance") == 55);
+        REQUIRE(object2.get<uint64_t>("balance") == 88);
+
+        //duplicate names fail to parse
+        Object object4;
+        object4 << std::string("balance") << uint8_t(TYPES::UINT64_T) << uint64_t(1)
+                << std::string("balance") << uint8_t(TYPES::UINT64_T) << uint64_t(2);
+
+        REQUIRE_FALSE(object4.Parse());
+    }
 }